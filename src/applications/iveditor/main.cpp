@@ -21,6 +21,7 @@
 #include "ivlibrary.h"
 #include "mainwindow.h"
 #include "sharedlibrary.h"
+#include "trace.h"
 
 #include <QApplication>
 #include <QDirIterator>
@@ -52,6 +53,9 @@ int main(int argc, char *argv[])
     shared::CommandLineParser cmdParser;
     plugin.populateCommandLineArguments(&cmdParser);
     cmdParser.process(a.arguments());
+    if (cmdParser.isSet(shared::CommandLineParser::Positional::TraceFile)) {
+        shared::Trace::start(cmdParser.value(shared::CommandLineParser::Positional::TraceFile));
+    }
 
     const auto args = cmdParser.positionalsSet();
     for (auto arg : args) {
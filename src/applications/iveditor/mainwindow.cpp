@@ -31,6 +31,7 @@
 #include "minimap.h"
 #include "reports/bugreportdialog.h"
 #include "settingsmanager.h"
+#include "trace.h"
 #include "ui_mainwindow.h"
 #include "zoomcontroller.h"
 
@@ -280,6 +281,16 @@ bool MainWindow::processCommandLineArg(shared::CommandLineParser::Positional arg
         if (!value.isEmpty())
             return exportXml(value);
         return false;
+    case shared::CommandLineParser::Positional::TraceFile:
+        // Started in main(), before any file is loaded
+        return shared::Trace::isEnabled();
+    case shared::CommandLineParser::Positional::MemoryReportFile:
+        if (!value.isEmpty()) {
+            // Written on exit, to cover everything loaded in the session
+            connect(qApp, &QCoreApplication::aboutToQuit, m_core, [this, value]() { m_core->saveMemoryReport(value); });
+            return true;
+        }
+        return false;
     case shared::CommandLineParser::Positional::ListScriptableActions: {
         QString list = ActionsManager::listRegisteredActions();
         std::cout << list.toStdString() << std::endl;
@@ -385,6 +396,7 @@ void MainWindow::initMenus()
     menu->addSeparator();
     auto report = menu->addAction(tr("Send report..."), this, &MainWindow::onReportRequested);
     ActionsManager::registerAction(Q_FUNC_INFO, report, "Report", "Send the debug information");
+    menu->addAction(m_core->actionMemoryReport());
     menu->addAction(tr("About"), m_core, &shared::EditorCore::showAboutDialog);
     menu->addAction(tr("About Qt"), qApp, &QApplication::aboutQt);
 }
@@ -25,6 +25,7 @@
 #include "msclibrary.h"
 #include "mscwriter.h"
 #include "sharedlibrary.h"
+#include "trace.h"
 
 #include <QApplication>
 #include <QDirIterator>
@@ -56,6 +57,9 @@ int main(int argc, char *argv[])
     shared::CommandLineParser cmdParser;
     editorCore.populateCommandLineArguments(&cmdParser);
     cmdParser.process(a.arguments());
+    if (cmdParser.isSet(shared::CommandLineParser::Positional::TraceFile)) {
+        shared::Trace::start(cmdParser.value(shared::CommandLineParser::Positional::TraceFile));
+    }
 
     msc::MainWindow w(&editorCore);
 
@@ -42,6 +42,7 @@
 #include "mscmodel.h"
 #include "settingsmanager.h"
 #include "textviewdialog.h"
+#include "trace.h"
 #include "tools/entitydeletetool.h"
 #include "ui/graphicsviewbase.h"
 #include "ui_mainwindow.h"
@@ -477,6 +478,7 @@ void MainWindow::initMenus()
     menu = menuBar()->addMenu(tr("&Help"));
     menu->addAction(tr("Help"), d->m_core, &shared::EditorCore::showHelp);
     menu->addSeparator();
+    menu->addAction(d->m_core->actionMemoryReport());
     menu->addAction(tr("About"), d->m_core, &shared::EditorCore::showAboutDialog);
     menu->addAction(tr("About Qt"), qApp, &QApplication::aboutQt);
 }
@@ -543,6 +545,17 @@ bool MainWindow::processCommandLineArg(shared::CommandLineParser::Positional arg
     case shared::CommandLineParser::Positional::DropUnsavedChangesSilently:
         d->m_dropUnsavedChangesSilently = true;
         return true;
+    case shared::CommandLineParser::Positional::TraceFile:
+        // Started in main(), before any file is loaded
+        return shared::Trace::isEnabled();
+    case shared::CommandLineParser::Positional::MemoryReportFile:
+        if (!value.isEmpty()) {
+            // Written on exit, to cover everything loaded in the session
+            connect(qApp, &QCoreApplication::aboutToQuit, d->m_core,
+                    [this, value]() { d->m_core->saveMemoryReport(value); });
+            return true;
+        }
+        return false;
     default:
         qWarning() << Q_FUNC_INFO << "Unhandled option:" << arg << value;
         break;
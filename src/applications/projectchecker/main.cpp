@@ -0,0 +1,92 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "baseitems/common/ivutils.h"
+#include "iveditor.h"
+#include "ivlibrary.h"
+#include "msclibrary.h"
+#include "projectchecker.h"
+#include "propertytemplateconfig.h"
+#include "sharedlibrary.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+
+/*!
+   Checks the MSC files of all given projects against their interface view and writes a JSON report.
+   Returns 0 if all projects are consistent, 1 if issues were found or files could not be loaded and 2 on wrong usage
+ */
+int main(int argc, char *argv[])
+{
+    shared::initSharedLibrary();
+    ivm::initIVLibrary();
+    ive::initIVEditor();
+    msc::initMscLibrary();
+
+    QCoreApplication a(argc, argv);
+    a.setOrganizationName(SC_ORGANISATION);
+    a.setOrganizationDomain(SC_ORGANISATION_DOMAIN);
+    a.setApplicationVersion(SC_VERSION);
+    a.setApplicationName(QObject::tr("Project Checker"));
+
+    QCommandLineParser cmdParser;
+    cmdParser.setApplicationDescription(
+            QObject::tr("Checks the consistency of the MSC files of projects with their interface view"));
+    cmdParser.addHelpOption();
+    cmdParser.addVersionOption();
+    const QCommandLineOption jobsOption({ "j", "jobs" }, QObject::tr("Number of projects checked in parallel"),
+            QObject::tr("count"), QString::number(0));
+    const QCommandLineOption outputOption(
+            { "o", "output" }, QObject::tr("Write the JSON report to <file> instead of stdout"), QObject::tr("file"));
+    cmdParser.addOption(jobsOption);
+    cmdParser.addOption(outputOption);
+    cmdParser.addPositionalArgument("projects", QObject::tr("Directories of the projects to check"), "<project>...");
+    cmdParser.process(a);
+
+    bool jobsOk = false;
+    const int jobs = cmdParser.value(jobsOption).toInt(&jobsOk);
+    const QStringList projects = cmdParser.positionalArguments();
+    if (projects.isEmpty() || !jobsOk || jobs < 0) {
+        QTextStream(stderr) << cmdParser.helpText();
+        return 2;
+    }
+
+    /// The property templates are shared by all models, so they are set up before any project is loaded in parallel
+    ivm::PropertyTemplateConfig::instance()->init(ive::dynamicPropertiesFilePath());
+
+    const scs::ProjectChecker checker(jobs);
+    const QJsonObject report = checker.checkProjects(projects);
+
+    QFile output;
+    bool opened = false;
+    if (cmdParser.isSet(outputOption)) {
+        output.setFileName(cmdParser.value(outputOption));
+        opened = output.open(QIODevice::WriteOnly | QIODevice::Text);
+    } else {
+        opened = output.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    if (!opened) {
+        QTextStream(stderr) << QObject::tr("Unable to write the report: %1").arg(output.errorString()) << '\n';
+        return 2;
+    }
+    output.write(QJsonDocument(report).toJson(QJsonDocument::Indented));
+
+    return report.value("ok").toBool() ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "projectchecker.h"
+
+#include "asn1compliancechecker.h"
+#include "asn1reader.h"
+#include "file.h"
+#include "ivmodel.h"
+#include "ivsystemchecks.h"
+#include "mscchart.h"
+#include "mscdocument.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
+#include "mscmodel.h"
+#include "projectmodelloader.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+namespace scs {
+
+static QJsonObject issue(const QString &fileName, const msc::MscChart *chart, const QString &check,
+        const QString &entity, const QString &details)
+{
+    return QJsonObject { { "file", fileName }, { "chart", chart ? chart->name() : QString() }, { "check", check },
+        { "entity", entity }, { "details", details } };
+}
+
+static QString failureDetails(const msc::Asn1ComplianceChecker::Failure &failure)
+{
+    switch (failure.reason) {
+    case msc::Asn1ComplianceChecker::Failure::Reason::NoDeclarations:
+        return QObject::tr("No message declarations available");
+    case msc::Asn1ComplianceChecker::Failure::Reason::ParameterCount:
+        return QObject::tr("Number of parameters does not match the declaration");
+    case msc::Asn1ComplianceChecker::Failure::Reason::InvalidParameter:
+        return QObject::tr("Parameter %1 '%2' is no valid %3")
+                .arg(failure.parameterIndex + 1)
+                .arg(failure.parameter, failure.typeName);
+    }
+    return {};
+}
+
+/*!
+   Creates a checker running up to \p jobs projects in parallel. With 0 jobs, one job per core is used
+ */
+ProjectChecker::ProjectChecker(int jobs)
+    : m_pool(new QThreadPool)
+{
+    if (jobs > 0) {
+        m_pool->setMaxThreadCount(jobs);
+    }
+}
+
+ProjectChecker::~ProjectChecker()
+{
+    delete m_pool;
+}
+
+/*!
+   Checks all projects in \p directories in parallel and returns the report of all of them, in the given order
+ */
+QJsonObject ProjectChecker::checkProjects(const QStringList &directories) const
+{
+    /// The projects are loaded on the global pool, so a project job never waits for a thread of its own pool
+    QVector<QFuture<QJsonObject>> futures;
+    for (const QString &directory : directories) {
+        futures.append(QtConcurrent::run(m_pool, &ProjectChecker::checkProject, directory));
+    }
+
+    bool ok = true;
+    QJsonArray projects;
+    for (QFuture<QJsonObject> &future : futures) {
+        const QJsonObject project = future.result();
+        ok &= project.value("ok").toBool();
+        projects.append(project);
+    }
+
+    return QJsonObject { { "ok", ok }, { "projects", projects } };
+}
+
+/*!
+   Loads the project in \p directory and checks all MSC files against the first interface view of the project.
+   Returns the report of the project, files that could not be loaded are reported as errors
+ */
+QJsonObject ProjectChecker::checkProject(const QString &directory)
+{
+    QStringList errorMessages;
+    QJsonArray issues;
+
+    ProjectModelLoader loader;
+    if (!QFileInfo(directory).isDir()) {
+        errorMessages.append(QObject::tr("%1 is no directory").arg(directory));
+    } else {
+        loader.loadDirectory(directory);
+        errorMessages += loader.errorMessages();
+    }
+
+    const QStringList ivFiles = loader.ivFiles();
+    ivm::IVModel *ivModel = ivFiles.isEmpty() ? nullptr : loader.ivModel(ivFiles.first());
+    if (!ivModel && QFileInfo(directory).isDir()) {
+        errorMessages.append(QObject::tr("No interface view found in %1").arg(directory));
+    }
+
+    IvSystemChecks checks;
+    checks.setIvModel(ivModel);
+
+    Asn1Acn::Asn1Reader asn1Reader;
+    QHash<QString, QSharedPointer<Asn1Acn::File>> asn1Files;
+    for (const QString &mscFile : loader.mscFiles()) {
+        msc::MscModel *mscModel = loader.mscModel(mscFile);
+        checks.setMscModel(mscModel);
+
+        if (ivModel) {
+            for (const auto &entry : checks.checkInstanceNames()) {
+                issues.append(issue(mscFile, entry.first, "instanceName", entry.second->name(),
+                        QObject::tr("No function with this name in the interface view")));
+            }
+            for (const auto &entry : checks.checkInstanceRelations()) {
+                issues.append(issue(mscFile, entry.first, "instanceRelation", entry.second->name(),
+                        QObject::tr("The function is nested by or nests another instance of the chart")));
+            }
+            for (const auto &entry : checks.checkMessages()) {
+                issues.append(issue(mscFile, entry.first, "message", entry.second->name(),
+                        QObject::tr("No connection for this message in the interface view")));
+            }
+        }
+
+        /// Without a data definition, there are no types the parameters have to comply to
+        if (mscModel->dataDefinitionString().isEmpty()) {
+            continue;
+        }
+        const QString asn1File = QFileInfo(mscFile).dir().absoluteFilePath(mscModel->dataDefinitionString());
+        const QSharedPointer<Asn1Acn::File> asn1Types = asn1Data(asn1File, &asn1Reader, asn1Files, &errorMessages);
+        if (!asn1Types) {
+            continue;
+        }
+        const msc::MscMessageDeclarationList *declarations =
+                mscModel->documents().isEmpty() ? nullptr : mscModel->documents().first()->messageDeclarations();
+        const msc::Asn1ComplianceChecker checker(asn1Types, declarations);
+        for (const msc::Asn1ComplianceChecker::Failure &failure : checker.check(mscModel->allCharts())) {
+            issues.append(issue(mscFile, failure.chart, "asn1Compliance", failure.message->name(),
+                    failureDetails(failure)));
+        }
+    }
+
+    QJsonArray errors;
+    for (const QString &message : qAsConst(errorMessages)) {
+        errors.append(message);
+    }
+
+    return QJsonObject { { "project", directory }, { "ok", errors.isEmpty() && issues.isEmpty() },
+        { "errors", errors }, { "issues", issues } };
+}
+
+/*!
+   Returns the parsed ASN.1 file \p fileName. Each file is parsed only once per project, as usually all MSC files of
+   a project share the same data definition
+ */
+QSharedPointer<Asn1Acn::File> ProjectChecker::asn1Data(const QString &fileName, Asn1Acn::Asn1Reader *reader,
+        QHash<QString, QSharedPointer<Asn1Acn::File>> &cache, QStringList *errorMessages)
+{
+    auto it = cache.constFind(fileName);
+    if (it != cache.constEnd()) {
+        return it.value();
+    }
+
+    QStringList parseErrors;
+    QSharedPointer<Asn1Acn::File> data(reader->parseAsn1File(QFileInfo(fileName), &parseErrors).release());
+    if (!data) {
+        errorMessages->append(QObject::tr("Unable to parse %1").arg(fileName));
+    }
+    *errorMessages += parseErrors;
+    cache.insert(fileName, data);
+    return data;
+}
+
+}
@@ -0,0 +1,58 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QSharedPointer>
+#include <QStringList>
+
+class QThreadPool;
+
+namespace Asn1Acn {
+class Asn1Reader;
+class File;
+}
+
+namespace scs {
+
+/*!
+   \class scs::ProjectChecker
+   Checks the consistency of the MSC files of projects with their interface view, without any editor or GUI.
+
+   All checks of the editors are run: the instance names and the nesting relations of the instances against the IV
+   functions, the messages against the IV connections and the message parameters against the ASN.1 types.
+   Each project is checked in one job of a thread pool, so several projects are checked in parallel.
+ */
+class ProjectChecker
+{
+public:
+    explicit ProjectChecker(int jobs = 0);
+    ~ProjectChecker();
+
+    QJsonObject checkProjects(const QStringList &directories) const;
+    static QJsonObject checkProject(const QString &directory);
+
+private:
+    static QSharedPointer<Asn1Acn::File> asn1Data(const QString &fileName, Asn1Acn::Asn1Reader *reader,
+            QHash<QString, QSharedPointer<Asn1Acn::File>> &cache, QStringList *errorMessages);
+
+    QThreadPool *m_pool = nullptr;
+};
+
+}
@@ -23,17 +23,26 @@
 #include "types/builtintypes.h"
 #include "types/userdefinedtype.h"
 
-#include <QStandardItem>
+#include <QBrush>
+#include <QColor>
 
 namespace asn1 {
 
 /*!
- * \class Asn1ItemModel
- *
- * This class is the model for the \sa Asn1TreeView.
+   One row of the model. It is created, when the parent row is fetched
  */
+struct Asn1ItemModel::Node {
+    const Asn1Acn::Types::Type *type = nullptr; ///< The type of the row, with user defined types resolved
+    QString name;
+    Node *parent = nullptr;
+    int row = 0;
+    bool fetched = false;
+    std::vector<std::unique_ptr<Node>> children;
+};
+
 Asn1ItemModel::Asn1ItemModel(QObject *parent)
-    : QStandardItemModel(1, 4, parent)
+    : QAbstractItemModel(parent)
+    , m_root(createNode(nullptr, nullptr, 0))
 {
 }
 
@@ -43,301 +52,428 @@ Asn1ItemModel::Asn1ItemModel(const std::unique_ptr<Asn1Acn::TypeAssignment> &asn
     setAsn1Model(asn1Item);
 }
 
+Asn1ItemModel::~Asn1ItemModel() { }
+
 /*!
- * \brief Asn1ItemModel::setAsn1Model Populate the values in the model from this map.
+ * \brief Asn1ItemModel::setAsn1Model Show the type of \a asn1Item in the model
+ * Only the top row is created, the child rows are created when they are fetched.
  * \param asn1Item
  */
 void Asn1ItemModel::setAsn1Model(const std::unique_ptr<Asn1Acn::TypeAssignment> &asn1Item)
 {
-    clear();
-
-    static QStringList headers = { tr("Field"), tr("Type"), tr("Value"), tr("Optional") };
-    setHorizontalHeaderLabels(headers);
-
-    ItemMap itemMap = createModelItems(asn1Item->type());
-
-    setItem(0, MODEL_NAME_INDEX, itemMap["item"]);
-    setItem(0, MODEL_TYPE_INDEX, itemMap["type"]);
-    setItem(0, MODEL_VALUE_INDEX, itemMap["value"]);
-    setItem(0, MODEL_IS_OPTIONAL_INDEX, itemMap["present"]);
+    beginResetModel();
+    m_values.clear();
+    m_checkStates.clear();
+    m_root = createNode(asn1Item ? asn1Item->type() : nullptr, nullptr, 0);
+    endResetModel();
 }
 
 /*!
- * \brief Asn1ItemModel::createModelItems Create items for the tree view from the map
- * \param asn1Item The map with the items
- * \return The created item map
+   Returns the index of the child \p row in \p column of \p parent. The children of \p parent are fetched if needed
  */
-Asn1ItemModel::ItemMap Asn1ItemModel::createModelItems(const Asn1Acn::Types::Type *asn1Item, const QString &name)
+QModelIndex Asn1ItemModel::childIndex(const QModelIndex &parent, int row, int column)
 {
-    ItemMap itemMap;
-    QString typeLimit;
-    QStandardItem *valueItem = nullptr;
-
-    QStandardItem *nameItem = new QStandardItem(name.isEmpty() ? asn1Item->identifier() : name);
-    nameItem->setEditable(false);
-
-    const QVariantMap &values = asn1Item->parameters();
+    if (canFetchMore(parent)) {
+        fetchMore(parent);
+    }
+    return index(row, column, parent);
+}
 
-    switch (asn1Item->typeEnum()) {
-    case Asn1Acn::Types::Type::INTEGER:
-    case Asn1Acn::Types::Type::REAL:
-        valueItem = createNumberItem(asn1Item);
+/*!
+   Returns the number of child rows of \p parent, no matter if they were fetched already
+ */
+int Asn1ItemModel::childCount(const QModelIndex &parent) const
+{
+    if (!parent.isValid()) {
+        return rowCount();
+    }
+    return parent.column() == MODEL_NAME_INDEX ? childCount(nodeFromIndex(parent)) : 0;
+}
 
-        if (values.contains(Asn1Acn::ASN1_MIN) && values.contains(Asn1Acn::ASN1_MAX)) {
-            typeLimit = QString(" (%1..%2)")
-                                .arg(values[Asn1Acn::ASN1_MIN].toString(), values[Asn1Acn::ASN1_MAX].toString());
-        }
-        break;
-    case Asn1Acn::Types::Type::BOOLEAN:
-        valueItem = createBoolItem(asn1Item);
-        break;
-    case Asn1Acn::Types::Type::SEQUENCE:
-        valueItem = createChildItems(asn1Item, nameItem);
-        break;
-    case Asn1Acn::Types::Type::SEQUENCEOF:
-        valueItem = createSequenceOfItem(asn1Item, nameItem);
-        if (values.contains(Asn1Acn::ASN1_MIN) && values.contains(Asn1Acn::ASN1_MAX)) {
-            if (values[Asn1Acn::ASN1_MIN] == values[Asn1Acn::ASN1_MAX])
-                typeLimit = QString(tr(" Size(%1)")).arg(values[Asn1Acn::ASN1_MIN].toString());
-            else
-                typeLimit = QString(tr(" Size(%1..%2)"))
-                                    .arg(values[Asn1Acn::ASN1_MIN].toString(), values[Asn1Acn::ASN1_MAX].toString());
-        }
-        break;
-    case Asn1Acn::Types::Type::ENUMERATED:
-        valueItem = createEnumeratedItem(asn1Item);
-        break;
-    case Asn1Acn::Types::Type::CHOICE:
-        valueItem = createChoiceItem(asn1Item, nameItem);
-        break;
-    case Asn1Acn::Types::Type::STRING:
-    case Asn1Acn::Types::Type::OCTETSTRING:
-    case Asn1Acn::Types::Type::BITSTRING:
-    case Asn1Acn::Types::Type::NUMERICSTRING:
-    case Asn1Acn::Types::Type::IA5STRING:
-        valueItem = createItem(asn1Item);
-        if (values.contains(Asn1Acn::ASN1_MIN) && values.contains(Asn1Acn::ASN1_MAX)) {
-            if (values[Asn1Acn::ASN1_MIN] == values[Asn1Acn::ASN1_MAX])
-                typeLimit = QString(tr(" Length(%1)")).arg(values[Asn1Acn::ASN1_MIN].toString());
-            else
-                typeLimit = QString(tr(" Length(%1..%2)"))
-                                    .arg(values[Asn1Acn::ASN1_MIN].toString(), values[Asn1Acn::ASN1_MAX].toString());
-        }
-        break;
-    case Asn1Acn::Types::Type::USERDEFINED: {
-        auto userType = static_cast<const Asn1Acn::Types::UserdefinedType *>(asn1Item);
-        if (userType->referencedType()) {
-            return createModelItems(userType->referencedType()->type(), asn1Item->identifier());
-        } else if (!asn1Item->children().empty()) {
-            valueItem = createItem(asn1Item->children().at(0).get());
-        }
-        break;
+QModelIndex Asn1ItemModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (column < 0 || column >= columnCount()) {
+        return {};
     }
-    default:
-        if (!asn1Item->children().empty()) {
-            valueItem = createChildItems(asn1Item, nameItem);
-            valueItem->setEditable(false);
-        }
+    if (!parent.isValid()) {
+        return row == 0 ? createIndex(row, column, m_root.get()) : QModelIndex();
     }
-
-    if (!valueItem) {
-        valueItem = createItem(asn1Item);
+    if (parent.column() != MODEL_NAME_INDEX) {
+        return {};
     }
 
-    QStandardItem *typeItem = new QStandardItem(asn1Item->typeName() + typeLimit);
-    typeItem->setData(QBrush(QColor("gray")), Qt::ForegroundRole);
-    typeItem->setEditable(false);
-
-    itemMap["item"] = nameItem;
-    itemMap["type"] = typeItem;
-    itemMap["value"] = valueItem;
-    itemMap["present"] = createPresentItem(asn1Item);
+    const Node *node = nodeFromIndex(parent);
+    if (row < 0 || row >= static_cast<int>(node->children.size())) {
+        return {};
+    }
+    return createIndex(row, column, node->children.at(row).get());
+}
 
-    return itemMap;
+QModelIndex Asn1ItemModel::parent(const QModelIndex &child) const
+{
+    const Node *node = nodeFromIndex(child);
+    if (!node || !node->parent) {
+        return {};
+    }
+    return createIndex(node->parent->row, MODEL_NAME_INDEX, node->parent);
 }
 
-/*!
- * \brief Asn1ItemModel::createNumberItem Create an item with the type number
- * \param asn1Item
- * \return
- */
-QStandardItem *Asn1ItemModel::createNumberItem(const Asn1Acn::Types::Type *asn1Item)
+int Asn1ItemModel::rowCount(const QModelIndex &parent) const
 {
-    // set default value (min range):
-    const QVariantMap &values = asn1Item->parameters();
-    return createItem(asn1Item, values[Asn1Acn::ASN1_MIN].toString());
+    if (!parent.isValid()) {
+        return 1;
+    }
+    return parent.column() == MODEL_NAME_INDEX ? static_cast<int>(nodeFromIndex(parent)->children.size()) : 0;
 }
 
-/*!
- * \brief Asn1ItemModel::createBoolItem  Create an item with the type bool
- * \param asn1Item
- * \return
- */
-QStandardItem *Asn1ItemModel::createBoolItem(const Asn1Acn::Types::Type *asn1Item)
+int Asn1ItemModel::columnCount(const QModelIndex &) const
 {
-    static const QVariantList choices { QString("true"), QString("false") };
+    return MODEL_IS_OPTIONAL_INDEX + 1;
+}
 
-    QStandardItem *item = createItem(asn1Item, "false");
-    item->setData(choices, CHOICE_LIST_ROLE);
+bool Asn1ItemModel::hasChildren(const QModelIndex &parent) const
+{
+    return childCount(parent) > 0;
+}
 
-    return item;
+bool Asn1ItemModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (!parent.isValid() || parent.column() != MODEL_NAME_INDEX) {
+        return false;
+    }
+    const Node *node = nodeFromIndex(parent);
+    return !node->fetched && childCount(node) > 0;
 }
 
 /*!
- * \brief Asn1ItemModel::createSequenceItem Create an item with the type sequence
- * \param asn1Item
- * \param parent
- * \return
+   Creates the direct child rows of \p parent
  */
-QStandardItem *Asn1ItemModel::createChildItems(const Asn1Acn::Types::Type *asn1Item, QStandardItem *parent)
+void Asn1ItemModel::fetchMore(const QModelIndex &parent)
 {
-    QList<QStandardItem *> typeItems;
-    QList<QStandardItem *> valueItems;
-    QList<QStandardItem *> presentItems;
-
-    for (const std::unique_ptr<Asn1Acn::Types::Type> &sequence : asn1Item->children()) {
-        ItemMap chilItem = createModelItems(sequence.get());
-
-        parent->appendRow(chilItem["item"]);
+    if (!canFetchMore(parent)) {
+        return;
+    }
 
-        typeItems.append(chilItem["type"]);
-        valueItems.append(chilItem["value"]);
-        presentItems.append(chilItem["present"]);
+    Node *node = nodeFromIndex(parent);
+    node->fetched = true;
+    const int count = childCount(node);
+    const bool isSequenceOf = node->type->typeEnum() == Asn1Acn::Types::Type::SEQUENCEOF;
+
+    beginInsertRows(parent, 0, count - 1);
+    node->children.reserve(count);
+    for (int row = 0; row < count; ++row) {
+        const Asn1Acn::Types::Type *childType =
+                isSequenceOf ? node->type->children().front().get() : node->type->children().at(row).get();
+        node->children.push_back(createNode(childType, node, row));
     }
+    endInsertRows();
+}
 
-    parent->appendColumn(typeItems);
-    parent->appendColumn(valueItems);
-    parent->appendColumn(presentItems);
+QVariant Asn1ItemModel::data(const QModelIndex &index, int role) const
+{
+    const Node *node = nodeFromIndex(index);
+    if (!node || !node->type) {
+        return {};
+    }
 
-    return new QStandardItem();
+    switch (index.column()) {
+    case MODEL_NAME_INDEX:
+        return nameData(node, role);
+    case MODEL_TYPE_INDEX:
+        return typeData(node, role);
+    case MODEL_VALUE_INDEX:
+        return valueData(node, role);
+    case MODEL_IS_OPTIONAL_INDEX:
+        return presentData(node, role);
+    }
+    return {};
 }
 
 /*!
- * \brief Asn1ItemModel::createSequenceOfItem Create an item with the type sequence of
- * \param asn1Item
- * \param parent
- * \return
+   Sets the text of a value, or the check state of the optional column
  */
-QStandardItem *Asn1ItemModel::createSequenceOfItem(const Asn1Acn::Types::Type *asn1Item, QStandardItem *parent)
+bool Asn1ItemModel::setData(const QModelIndex &index, const QVariant &value, int role)
 {
-    QList<QStandardItem *> typeItems;
-    QList<QStandardItem *> valueItems;
-    QList<QStandardItem *> presentItems;
+    const Node *node = nodeFromIndex(index);
+    if (!node || !node->type) {
+        return false;
+    }
 
-    if (!asn1Item->children().empty()) {
-        const Asn1Acn::Types::Type *type = asn1Item->children().at(0).get();
+    if (index.column() == MODEL_VALUE_INDEX && (role == Qt::EditRole || role == Qt::DisplayRole)) {
+        m_values.insert(node, value);
+    } else if (index.column() == MODEL_IS_OPTIONAL_INDEX && role == Qt::CheckStateRole) {
+        m_checkStates.insert(node, static_cast<Qt::CheckState>(value.toInt()));
+    } else {
+        return false;
+    }
 
-        if (type != nullptr) {
-            for (int x = 0; x < asn1Item->parameters()[Asn1Acn::ASN1_MAX].toInt(); ++x) {
-                ItemMap chilItem = createModelItems(type);
+    Q_EMIT dataChanged(index, index, { role });
+    return true;
+}
 
-                chilItem["item"]->setText(QString(tr("elem%1")).arg(x + 1));
-                parent->appendRow(chilItem["item"]);
+Qt::ItemFlags Asn1ItemModel::flags(const QModelIndex &index) const
+{
+    const Node *node = nodeFromIndex(index);
+    if (!node || !node->type) {
+        return Qt::NoItemFlags;
+    }
 
-                typeItems.append(chilItem["type"]);
-                valueItems.append(chilItem["value"]);
-                presentItems.append(chilItem["present"]);
-            }
+    switch (index.column()) {
+    case MODEL_VALUE_INDEX:
+        if (isGroupRow(node) && node->type->typeEnum() != Asn1Acn::Types::Type::SEQUENCE) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        }
+        return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable;
+    case MODEL_IS_OPTIONAL_INDEX:
+        if (node->type->parameters().value(Asn1Acn::ASN1_IS_OPTIONAL).toBool()) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable | Qt::ItemIsUserCheckable;
         }
+        return Qt::ItemIsSelectable | Qt::ItemIsEditable;
+    default:
+        return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
     }
+}
 
-    parent->appendColumn(typeItems);
-    parent->appendColumn(valueItems);
-    parent->appendColumn(presentItems);
+QVariant Asn1ItemModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractItemModel::headerData(section, orientation, role);
+    }
 
-    return createNumberItem(asn1Item);
+    switch (section) {
+    case MODEL_NAME_INDEX:
+        return tr("Field");
+    case MODEL_TYPE_INDEX:
+        return tr("Type");
+    case MODEL_VALUE_INDEX:
+        return tr("Value");
+    case MODEL_IS_OPTIONAL_INDEX:
+        return tr("Optional");
+    }
+    return {};
 }
 
-/*!
- * \brief Asn1ItemModel::createEnumeratedItem Create an item with the type values
- * \param asn1Item
- * \return
- */
-QStandardItem *Asn1ItemModel::createEnumeratedItem(const Asn1Acn::Types::Type *asn1Item)
+Asn1ItemModel::Node *Asn1ItemModel::nodeFromIndex(const QModelIndex &index) const
 {
-    const QVariantMap &values = asn1Item->parameters();
-    return createItem(asn1Item, values[Asn1Acn::ASN1_VALUES].toList().at(0).toString());
+    return index.isValid() ? static_cast<Node *>(index.internalPointer()) : nullptr;
 }
 
 /*!
- * \brief Asn1ItemModel::createChoiceItem Create an item with the type choice
- * \param asn1Item
- * \param parent
- * \return
+ * \brief Asn1ItemModel::createNode Create the row for \a type
+ * User defined types are shown as the referenced type, with the name of the user defined type
  */
-QStandardItem *Asn1ItemModel::createChoiceItem(const Asn1Acn::Types::Type *asn1Item, QStandardItem *parent)
+std::unique_ptr<Asn1ItemModel::Node> Asn1ItemModel::createNode(
+        const Asn1Acn::Types::Type *type, Node *parent, int row) const
 {
-    QList<QStandardItem *> typeItems;
-    QList<QStandardItem *> valueItems;
-    QList<QStandardItem *> presentItems;
-    QVariantList chilsNames;
-
-    for (const std::unique_ptr<Asn1Acn::Types::Type> &choice : asn1Item->children()) {
-        ItemMap choiceItem = createModelItems(choice.get());
-        parent->appendRow(choiceItem["item"]);
-        typeItems.append(choiceItem["type"]);
-        valueItems.append(choiceItem["value"]);
-        presentItems.append(choiceItem["present"]);
-        chilsNames.append(choice->identifier());
+    QString name;
+    while (type && type->typeEnum() == Asn1Acn::Types::Type::USERDEFINED) {
+        auto userType = static_cast<const Asn1Acn::Types::UserdefinedType *>(type);
+        if (!userType->referencedType()) {
+            break;
+        }
+        name = type->identifier();
+        type = userType->referencedType()->type();
     }
 
-    parent->appendColumn(typeItems);
-    parent->appendColumn(valueItems);
-    parent->appendColumn(presentItems);
+    auto node = std::make_unique<Node>();
+    node->type = type;
+    node->name = (name.isEmpty() && type) ? type->identifier() : name;
+    node->parent = parent;
+    node->row = row;
+    return node;
+}
 
-    QStandardItem *item = createItem(asn1Item, chilsNames[0].toString());
-    item->setData(chilsNames, CHOICE_LIST_ROLE);
+/*!
+   Returns the number of child rows of \p node
+ */
+int Asn1ItemModel::childCount(const Node *node) const
+{
+    if (!node || !node->type) {
+        return 0;
+    }
 
-    return item;
+    const Asn1Acn::Types::Type *type = node->type;
+    switch (type->typeEnum()) {
+    case Asn1Acn::Types::Type::SEQUENCEOF:
+        return type->children().empty() ? 0 : std::max(0, type->parameters().value(Asn1Acn::ASN1_MAX).toInt());
+    case Asn1Acn::Types::Type::INTEGER:
+    case Asn1Acn::Types::Type::REAL:
+    case Asn1Acn::Types::Type::BOOLEAN:
+    case Asn1Acn::Types::Type::ENUMERATED:
+    case Asn1Acn::Types::Type::STRING:
+    case Asn1Acn::Types::Type::OCTETSTRING:
+    case Asn1Acn::Types::Type::BITSTRING:
+    case Asn1Acn::Types::Type::NUMERICSTRING:
+    case Asn1Acn::Types::Type::IA5STRING:
+    case Asn1Acn::Types::Type::USERDEFINED:
+        return 0;
+    default:
+        return static_cast<int>(type->children().size());
+    }
 }
 
 /*!
- * \brief Asn1ItemModel::createItem Create an item for the model with \a text
- * \param asn1Item Map used to set the type, min/max and choice list
- * \param text The view text
- * \return The created item
+   Returns true for rows that only group their children. Their value has no type information
  */
-QStandardItem *Asn1ItemModel::createItem(const Asn1Acn::Types::Type *asn1Item, const QString &text)
+bool Asn1ItemModel::isGroupRow(const Node *node) const
 {
-    QStandardItem *item = new QStandardItem(text);
-
-    Asn1Acn::Types::Type::ASN1Type asntype = asn1Item->typeEnum();
-    if (asntype == Asn1Acn::Types::Type::USERDEFINED) {
-        auto userType = static_cast<const Asn1Acn::Types::UserdefinedType *>(asn1Item);
-        if (userType->referencedType()) {
-            asntype = userType->referencedType()->typeEnum();
-        }
+    switch (node->type->typeEnum()) {
+    case Asn1Acn::Types::Type::SEQUENCE:
+        return true;
+    case Asn1Acn::Types::Type::INTEGER:
+    case Asn1Acn::Types::Type::REAL:
+    case Asn1Acn::Types::Type::BOOLEAN:
+    case Asn1Acn::Types::Type::SEQUENCEOF:
+    case Asn1Acn::Types::Type::ENUMERATED:
+    case Asn1Acn::Types::Type::CHOICE:
+    case Asn1Acn::Types::Type::STRING:
+    case Asn1Acn::Types::Type::OCTETSTRING:
+    case Asn1Acn::Types::Type::BITSTRING:
+    case Asn1Acn::Types::Type::NUMERICSTRING:
+    case Asn1Acn::Types::Type::IA5STRING:
+    case Asn1Acn::Types::Type::USERDEFINED:
+        return false;
+    default:
+        return !node->type->children().empty();
     }
+}
 
-    item->setData(asntype, ASN1TYPE_ROLE);
-    const QVariantMap &values = asn1Item->parameters();
-    if (values.contains(Asn1Acn::ASN1_MIN))
-        item->setData(values[Asn1Acn::ASN1_MIN], MIN_RANGE_ROLE);
+QVariant Asn1ItemModel::nameData(const Node *node, int role) const
+{
+    if (role != Qt::DisplayRole && role != Qt::EditRole) {
+        return {};
+    }
+    if (node->parent && node->parent->type->typeEnum() == Asn1Acn::Types::Type::SEQUENCEOF) {
+        return QString(tr("elem%1")).arg(node->row + 1);
+    }
+    return node->name;
+}
 
-    if (values.contains(Asn1Acn::ASN1_MAX))
-        item->setData(values[Asn1Acn::ASN1_MAX], MAX_RANGE_ROLE);
+QVariant Asn1ItemModel::typeData(const Node *node, int role) const
+{
+    if (role == Qt::ForegroundRole) {
+        return QBrush(QColor("gray"));
+    }
+    if (role != Qt::DisplayRole && role != Qt::EditRole) {
+        return {};
+    }
 
-    if (values.contains(Asn1Acn::ASN1_VALUES))
-        item->setData(values[Asn1Acn::ASN1_VALUES], CHOICE_LIST_ROLE);
+    QString typeLimit;
+    const QVariantMap &values = node->type->parameters();
+    if (values.contains(Asn1Acn::ASN1_MIN) && values.contains(Asn1Acn::ASN1_MAX)) {
+        const bool isFixed = values[Asn1Acn::ASN1_MIN] == values[Asn1Acn::ASN1_MAX];
+        const QString min = values[Asn1Acn::ASN1_MIN].toString();
+        const QString max = values[Asn1Acn::ASN1_MAX].toString();
+
+        switch (node->type->typeEnum()) {
+        case Asn1Acn::Types::Type::INTEGER:
+        case Asn1Acn::Types::Type::REAL:
+            typeLimit = QString(" (%1..%2)").arg(min, max);
+            break;
+        case Asn1Acn::Types::Type::SEQUENCEOF:
+            typeLimit = isFixed ? QString(tr(" Size(%1)")).arg(min) : QString(tr(" Size(%1..%2)")).arg(min, max);
+            break;
+        case Asn1Acn::Types::Type::STRING:
+        case Asn1Acn::Types::Type::OCTETSTRING:
+        case Asn1Acn::Types::Type::BITSTRING:
+        case Asn1Acn::Types::Type::NUMERICSTRING:
+        case Asn1Acn::Types::Type::IA5STRING:
+            typeLimit =
+                    isFixed ? QString(tr(" Length(%1)")).arg(min) : QString(tr(" Length(%1..%2)")).arg(min, max);
+            break;
+        default:
+            break;
+        }
+    }
 
-    return item;
+    return node->type->typeName() + typeLimit;
 }
 
-QStandardItem *Asn1ItemModel::createPresentItem(const Asn1Acn::Types::Type *asn1Item)
+QVariant Asn1ItemModel::valueData(const Node *node, int role) const
 {
-    QStandardItem *item = new QStandardItem();
+    if (isGroupRow(node)) {
+        return (role == Qt::DisplayRole || role == Qt::EditRole) ? m_values.value(node) : QVariant();
+    }
 
-    const QVariantMap &values = asn1Item->parameters();
-    if (values[Asn1Acn::ASN1_IS_OPTIONAL].toBool() == true) {
-        item->setCheckState(Qt::Unchecked);
-        item->setCheckable(true);
-    } else {
-        item->setEnabled(false);
+    // Not resolved user types use the type of their child for the value
+    const Asn1Acn::Types::Type *type = node->type;
+    if (type->typeEnum() == Asn1Acn::Types::Type::USERDEFINED && !type->children().empty()) {
+        type = type->children().front().get();
     }
+    const QVariantMap &values = type->parameters();
 
-    item->setData(values[Asn1Acn::ASN1_IS_OPTIONAL], OPTIONAL_ROLE);
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole: {
+        const auto it = m_values.constFind(node);
+        return it != m_values.constEnd() ? it.value() : QVariant(defaultValue(node));
+    }
+    case ASN1TYPE_ROLE: {
+        Asn1Acn::Types::Type::ASN1Type asnType = type->typeEnum();
+        if (asnType == Asn1Acn::Types::Type::USERDEFINED) {
+            auto userType = static_cast<const Asn1Acn::Types::UserdefinedType *>(type);
+            if (userType->referencedType()) {
+                asnType = userType->referencedType()->typeEnum();
+            }
+        }
+        return static_cast<int>(asnType);
+    }
+    case MIN_RANGE_ROLE:
+        return values.value(Asn1Acn::ASN1_MIN);
+    case MAX_RANGE_ROLE:
+        return values.value(Asn1Acn::ASN1_MAX);
+    case CHOICE_LIST_ROLE:
+        if (node->type->typeEnum() == Asn1Acn::Types::Type::BOOLEAN) {
+            static const QVariantList choices { QString("true"), QString("false") };
+            return choices;
+        }
+        if (node->type->typeEnum() == Asn1Acn::Types::Type::CHOICE) {
+            QVariantList childNames;
+            for (const std::unique_ptr<Asn1Acn::Types::Type> &choice : node->type->children()) {
+                childNames.append(choice->identifier());
+            }
+            return childNames;
+        }
+        return values.value(Asn1Acn::ASN1_VALUES);
+    }
+    return {};
+}
 
-    return item;
+QVariant Asn1ItemModel::presentData(const Node *node, int role) const
+{
+    const QVariantMap &values = node->type->parameters();
+    switch (role) {
+    case Qt::CheckStateRole:
+        if (values.value(Asn1Acn::ASN1_IS_OPTIONAL).toBool()) {
+            return m_checkStates.value(node, Qt::Unchecked);
+        }
+        return {};
+    case OPTIONAL_ROLE:
+        return values.value(Asn1Acn::ASN1_IS_OPTIONAL);
+    }
+    return {};
+}
+
+/*!
+   Returns the value shown before a value was set: the minimum of numbers, the first entry of enumerations and choices
+ */
+QString Asn1ItemModel::defaultValue(const Node *node) const
+{
+    const QVariantMap &values = node->type->parameters();
+    switch (node->type->typeEnum()) {
+    case Asn1Acn::Types::Type::INTEGER:
+    case Asn1Acn::Types::Type::REAL:
+    case Asn1Acn::Types::Type::SEQUENCEOF:
+        return values.value(Asn1Acn::ASN1_MIN).toString();
+    case Asn1Acn::Types::Type::BOOLEAN:
+        return QString("false");
+    case Asn1Acn::Types::Type::ENUMERATED:
+        return values.value(Asn1Acn::ASN1_VALUES).toList().value(0).toString();
+    case Asn1Acn::Types::Type::CHOICE:
+        return node->type->children().empty() ? QString() : node->type->children().front()->identifier();
+    default:
+        return {};
+    }
 }
 
 } // namespace asn1
@@ -17,11 +17,11 @@
 
 #pragma once
 
-#include <QMap>
-#include <QStandardItemModel>
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QVariant>
 #include <memory>
-
-class QStandardItem;
+#include <vector>
 
 namespace Asn1Acn {
 namespace Types {
@@ -32,30 +32,60 @@ class TypeAssignment;
 
 namespace asn1 {
 
-class Asn1ItemModel : public QStandardItemModel
+/*!
+   \class asn1::Asn1ItemModel
+   This class is the model for the \sa Asn1TreeView.
+
+   The rows are created lazily: a row gets its child rows, when a view expands it (\ref canFetchMore and
+   \ref fetchMore), or when \ref childIndex is asked for one of them. So expanding a row only costs its direct
+   children, also for big SEQUENCE OF types or types with many choices.
+   The rows only point into the type tree. Values and check states set by \ref setData are kept in side tables,
+   the other data is taken from the type when it is requested.
+ */
+class Asn1ItemModel : public QAbstractItemModel
 {
     Q_OBJECT
 
 public:
     Asn1ItemModel(QObject *parent = nullptr);
     Asn1ItemModel(const std::unique_ptr<Asn1Acn::TypeAssignment> &asn1Item, QObject *parent = nullptr);
+    ~Asn1ItemModel() override;
 
     void setAsn1Model(const std::unique_ptr<Asn1Acn::TypeAssignment> &asn1Item);
 
-private:
-    using ItemMap = QMap<QString, QStandardItem *>;
+    QModelIndex childIndex(const QModelIndex &parent, int row, int column = 0);
+    int childCount(const QModelIndex &parent) const;
 
-    ItemMap createModelItems(const Asn1Acn::Types::Type *asn1Item, const QString &name = {});
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
 
-    QStandardItem *createNumberItem(const Asn1Acn::Types::Type *asn1Item);
-    QStandardItem *createBoolItem(const Asn1Acn::Types::Type *asn1Item);
-    QStandardItem *createChildItems(const Asn1Acn::Types::Type *asn1Item, QStandardItem *parent);
-    QStandardItem *createSequenceOfItem(const Asn1Acn::Types::Type *asn1Item, QStandardItem *parent);
-    QStandardItem *createEnumeratedItem(const Asn1Acn::Types::Type *asn1Item);
-    QStandardItem *createChoiceItem(const Asn1Acn::Types::Type *asn1Item, QStandardItem *parent);
-    QStandardItem *createItem(const Asn1Acn::Types::Type *asn1Item, const QString &text = QString());
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
-    QStandardItem *createPresentItem(const Asn1Acn::Types::Type *asn1Item);
+private:
+    struct Node;
+
+    Node *nodeFromIndex(const QModelIndex &index) const;
+    std::unique_ptr<Node> createNode(const Asn1Acn::Types::Type *type, Node *parent, int row) const;
+    int childCount(const Node *node) const;
+    bool isGroupRow(const Node *node) const;
+
+    QVariant nameData(const Node *node, int role) const;
+    QVariant typeData(const Node *node, int role) const;
+    QVariant valueData(const Node *node, int role) const;
+    QVariant presentData(const Node *node, int role) const;
+    QString defaultValue(const Node *node) const;
+
+    std::unique_ptr<Node> m_root;
+    QHash<const Node *, QVariant> m_values;
+    QHash<const Node *, Qt::CheckState> m_checkStates;
 };
 
 } // namespace asn1
@@ -23,8 +23,6 @@
 #include "typeassignment.h"
 
 #include <QHeaderView>
-#include <QStandardItem>
-#include <QStandardItemModel>
 
 namespace asn1 {
 
@@ -50,6 +48,7 @@ Asn1TreeView::Asn1TreeView(QWidget *parent)
 
 /*!
  * \brief Asn1TreeView::setAsn1Model Set the model of a row to \a asn1Item
+ * Only the top row is expanded, deeper rows are loaded when the user expands them.
  */
 void Asn1TreeView::setAsn1Model(const std::unique_ptr<Asn1Acn::TypeAssignment> &asn1Item, int row)
 {
@@ -59,9 +58,9 @@ void Asn1TreeView::setAsn1Model(const std::unique_ptr<Asn1Acn::TypeAssignment> &
     header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
     header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
 
-    hideExtraFields(m_ItemModel->item(0, 0), true, row);
-
-    expandAll();
+    const QModelIndex rootIndex = m_ItemModel->index(row, MODEL_NAME_INDEX);
+    hideExtraFields(rootIndex);
+    expand(rootIndex);
 }
 
 /*!
@@ -73,43 +72,53 @@ void Asn1TreeView::setAsn1Value(const QVariantMap &asn1Value)
         return;
     }
 
-    QStandardItem *nameItem = m_ItemModel->item(0, 0);
-
-    int row = nameItem->row();
-    QString asnType = m_ItemModel->item(row, MODEL_TYPE_INDEX)->text();
+    const QModelIndex nameIndex = m_ItemModel->index(0, MODEL_NAME_INDEX);
+    const int row = nameIndex.row();
+    const QModelIndex valueIndex = nameIndex.sibling(row, MODEL_VALUE_INDEX);
+    QString asnType = nameIndex.sibling(row, MODEL_TYPE_INDEX).data().toString();
 
     if (asnType.startsWith("sequenceOf", Qt::CaseInsensitive)) {
         int seqOfSize = asn1Value["seqofvalue"].toList().count();
-        m_ItemModel->item(row, MODEL_VALUE_INDEX)->setText(QString::number(seqOfSize));
-        setChildValue(nameItem, asn1Value["seqofvalue"], seqOfSize);
+        m_ItemModel->setData(valueIndex, QString::number(seqOfSize));
+        setChildValue(nameIndex, asn1Value["seqofvalue"], seqOfSize);
     } else if (asnType.startsWith("choice", Qt::CaseInsensitive)) {
         QString choiceValue = asn1Value["choice"].toMap()["name"].toString();
 
-        m_ItemModel->item(row, MODEL_VALUE_INDEX)->setText(choiceValue);
+        m_ItemModel->setData(valueIndex, choiceValue);
 
-        setChildValue(nameItem, asn1Value["choice"], -1, itemChoiceIndex(nameItem, choiceValue));
+        setChildValue(nameIndex, asn1Value["choice"], -1, itemChoiceIndex(nameIndex, choiceValue));
     } else if (asnType.startsWith("integer", Qt::CaseInsensitive) || asnType.startsWith("double", Qt::CaseInsensitive)
             || asnType.startsWith("real", Qt::CaseInsensitive) || asnType.startsWith("string", Qt::CaseInsensitive)
             || asnType.startsWith("enumerated", Qt::CaseInsensitive)) {
-        m_ItemModel->item(row, MODEL_VALUE_INDEX)->setText(asn1Value["value"].toString());
+        m_ItemModel->setData(valueIndex, asn1Value["value"].toString());
     } else if (asnType.startsWith("bool", Qt::CaseInsensitive)) {
-        m_ItemModel->item(row, MODEL_VALUE_INDEX)->setText(asn1Value["value"].toString().toLower());
+        m_ItemModel->setData(valueIndex, asn1Value["value"].toString().toLower());
     } else if (asnType.startsWith("sequence", Qt::CaseInsensitive)) {
-        setChildValue(nameItem, asn1Value["children"]);
+        setChildValue(nameIndex, asn1Value["children"]);
     }
 
-    hideExtraFields(nameItem, true, row);
-    expandAll();
+    hideExtraFields(nameIndex);
+    expandFetched(nameIndex);
 }
 
 QString Asn1TreeView::getAsn1Value() const
 {
-    return m_ItemModel ? getItemValue(m_ItemModel->item(0, 0)) : QString();
+    return m_ItemModel ? getItemValue(m_ItemModel->index(0, MODEL_NAME_INDEX)) : QString();
+}
+
+/*!
+   Rows of choices and sequence ofs that are not used are hidden as soon as they are loaded
+ */
+void Asn1TreeView::rowsInserted(const QModelIndex &parent, int start, int end)
+{
+    QTreeView::rowsInserted(parent, start, end);
+    updateRowVisibility(parent);
 }
 
 void Asn1TreeView::onSequenceOfSizeChanged(const QModelIndex &index, const QVariant &value, const QVariant &maxRange)
 {
-    for (int x = 0; x < maxRange.toInt(); ++x)
+    const int rowCount = qMin(maxRange.toInt(), model()->rowCount(index));
+    for (int x = 0; x < rowCount; ++x)
         setRowHidden(x, index, x < value.toInt() ? false : true);
 
     expand(index);
@@ -117,60 +126,79 @@ void Asn1TreeView::onSequenceOfSizeChanged(const QModelIndex &index, const QVari
 
 void Asn1TreeView::onChoiceFieldChanged(const QModelIndex &index, const QVariant &length, const QVariant &currentIndex)
 {
-    for (int x = 0; x < length.toInt(); ++x)
+    const int rowCount = qMin(length.toInt(), model()->rowCount(index));
+    for (int x = 0; x < rowCount; ++x)
         setRowHidden(x, index, x == currentIndex.toInt() ? false : true);
 
     expand(index);
 }
 
 /*!
- * \brief Asn1TreeView::hideExtraFields Hide a value row
- * \param item
- * \param hide
- * \param row
+ * \brief Asn1TreeView::hideExtraFields Hide the not used rows of \a index and all its loaded children
+ * \param index
  */
-void Asn1TreeView::hideExtraFields(const QStandardItem *item, bool hide, int row)
+void Asn1TreeView::hideExtraFields(const QModelIndex &index)
 {
-    QStandardItemModel *model = qobject_cast<QStandardItemModel *>(this->model());
-    auto asnType = static_cast<Asn1Acn::Types::Type::ASN1Type>(
-            model->item(row, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE).toInt());
-
-    if (asnType == Asn1Acn::Types::Type::CHOICE && hide) {
-        const QVariantList &choices = model->item(row, MODEL_VALUE_INDEX)->data(CHOICE_LIST_ROLE).toList();
-        onChoiceFieldChanged(model->item(row)->index(), choices.size(),
-                choices.indexOf(model->item(row, MODEL_VALUE_INDEX)->text()));
-    } else if (asnType == Asn1Acn::Types::Type::SEQUENCEOF && hide) {
-        onSequenceOfSizeChanged(model->item(row)->index(), model->item(row, MODEL_VALUE_INDEX)->text(),
-                model->item(row, MODEL_VALUE_INDEX)->data(MAX_RANGE_ROLE));
+    updateRowVisibility(index);
+
+    for (int x = 0; x < m_ItemModel->rowCount(index); ++x) {
+        hideExtraFields(m_ItemModel->index(x, MODEL_NAME_INDEX, index));
     }
+}
 
-    for (int x = 0; x < item->rowCount(); ++x) {
-        hideExtraFields(item->child(x));
-
-        asnType = static_cast<Asn1Acn::Types::Type::ASN1Type>(
-                item->child(x, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE).toInt());
-        if (asnType == Asn1Acn::Types::Type::SEQUENCEOF)
-            onSequenceOfSizeChanged(item->child(x)->index(), item->child(x, MODEL_VALUE_INDEX)->text(),
-                    item->child(x, MODEL_VALUE_INDEX)->data(MAX_RANGE_ROLE));
-        else if (asnType == Asn1Acn::Types::Type::CHOICE) {
-            const QVariantList &choices = item->child(x, MODEL_VALUE_INDEX)->data(CHOICE_LIST_ROLE).toList();
-            onChoiceFieldChanged(item->child(x)->index(), choices.size(),
-                    choices.indexOf(item->child(x, MODEL_VALUE_INDEX)->text()));
-        }
+/*!
+ * \brief Asn1TreeView::updateRowVisibility Show only the selected row of a choice, or the used rows of a sequence of
+ * \param index
+ */
+void Asn1TreeView::updateRowVisibility(const QModelIndex &index)
+{
+    if (!index.isValid()) {
+        return;
+    }
+
+    const QModelIndex valueIndex = index.sibling(index.row(), MODEL_VALUE_INDEX);
+    const int rowCount = m_ItemModel->rowCount(index);
+    auto asnType = static_cast<Asn1Acn::Types::Type::ASN1Type>(valueIndex.data(ASN1TYPE_ROLE).toInt());
+
+    if (asnType == Asn1Acn::Types::Type::CHOICE) {
+        const int currentIndex = valueIndex.data(CHOICE_LIST_ROLE).toList().indexOf(valueIndex.data().toString());
+        for (int x = 0; x < rowCount; ++x)
+            setRowHidden(x, index, x != currentIndex);
+    } else if (asnType == Asn1Acn::Types::Type::SEQUENCEOF) {
+        const int size = valueIndex.data().toInt();
+        for (int x = 0; x < rowCount; ++x)
+            setRowHidden(x, index, x >= size);
+    }
+}
+
+/*!
+ * \brief Asn1TreeView::expandFetched Expand \a index and all its children that are loaded already
+ * \param index
+ */
+void Asn1TreeView::expandFetched(const QModelIndex &index)
+{
+    const int rowCount = m_ItemModel->rowCount(index);
+    if (rowCount == 0) {
+        return;
+    }
+
+    expand(index);
+    for (int x = 0; x < rowCount; ++x) {
+        expandFetched(m_ItemModel->index(x, MODEL_NAME_INDEX, index));
     }
 }
 
 /*!
  * \brief Asn1TreeView::setChildRowValue Update the value of a child row
- * \param rootItem
+ * \param rootIndex
  * \param childIndex
  * \param asn1Value
  */
-void Asn1TreeView::setChildRowValue(const QStandardItem *rootItem, int childIndex, const QVariant &asn1Value)
+void Asn1TreeView::setChildRowValue(const QModelIndex &rootIndex, int childIndex, const QVariant &asn1Value)
 {
-    const QStandardItem *childItem = rootItem->child(childIndex, MODEL_TYPE_INDEX);
-    const QString asnType = childItem ? rootItem->child(childIndex, MODEL_TYPE_INDEX)->text() : "";
-    auto *child = rootItem->child(childIndex, MODEL_VALUE_INDEX);
+    const QModelIndex nameIndex = m_ItemModel->childIndex(rootIndex, childIndex, MODEL_NAME_INDEX);
+    const QModelIndex valueIndex = nameIndex.sibling(childIndex, MODEL_VALUE_INDEX);
+    const QString asnType = nameIndex.sibling(childIndex, MODEL_TYPE_INDEX).data().toString();
 
     if (asn1Value.type() == QVariant::List && asn1Value.toList().count() <= childIndex) {
         return;
@@ -182,56 +210,57 @@ void Asn1TreeView::setChildRowValue(const QStandardItem *rootItem, int childInde
             || asnType.startsWith("real", Qt::CaseInsensitive) || asnType.startsWith("string", Qt::CaseInsensitive)
             || asnType.startsWith("enumerated", Qt::CaseInsensitive) || asnType == "BIT STRING"
             || asnType == "OCTET STRING" || asnType == "IA5String" || asnType == "NumericString")
-        child->setText(value.toMap()["value"].toString());
+        m_ItemModel->setData(valueIndex, value.toMap()["value"].toString());
     else if (asnType.startsWith("bool", Qt::CaseInsensitive))
-        child->setText(value.toMap()["value"].toString().toLower());
+        m_ItemModel->setData(valueIndex, value.toMap()["value"].toString().toLower());
     else if (asnType.startsWith("sequenceOf", Qt::CaseInsensitive)
             || asnType.startsWith("sequence of", Qt::CaseInsensitive)) {
         int seqOfSize = value.toMap()["seqofvalue"].toList().count();
-        child->setText(QString::number(seqOfSize));
-        setChildValue(rootItem->child(childIndex), value.toMap()["seqofvalue"], seqOfSize);
+        m_ItemModel->setData(valueIndex, QString::number(seqOfSize));
+        setChildValue(nameIndex, value.toMap()["seqofvalue"], seqOfSize);
     } else if (asnType.startsWith("sequence", Qt::CaseInsensitive)) {
         if (value.toMap().contains("children")) {
             value = value.toMap()["children"];
         }
-        setChildValue(rootItem->child(childIndex), value);
+        setChildValue(nameIndex, value);
     } else if (asnType.startsWith("choice", Qt::CaseInsensitive)) {
         value = value.toMap()["choice"];
         QString choiceValue = value.toMap()["name"].toString();
 
-        child->setText(choiceValue);
-        setChildRowValue(rootItem->child(childIndex), itemChoiceIndex(rootItem->child(childIndex), choiceValue), value);
+        m_ItemModel->setData(valueIndex, choiceValue);
+        setChildRowValue(nameIndex, itemChoiceIndex(nameIndex, choiceValue), value);
     }
 }
 
 /*!
  * \brief Asn1TreeView::setChildValue Update the value of a child
- * \param rootItem
+ * \param rootIndex
  * \param asn1Value
  * \param seqOfSize
  * \param choiceRow
  */
-void Asn1TreeView::setChildValue(const QStandardItem *rootItem, const QVariant &asn1Value, int seqOfSize, int choiceRow)
+void Asn1TreeView::setChildValue(const QModelIndex &rootIndex, const QVariant &asn1Value, int seqOfSize, int choiceRow)
 {
     if (!asn1Value.isValid())
         return;
 
     if (choiceRow != -1) {
         // asn1Value = map
-        setChildRowValue(rootItem, choiceRow, asn1Value);
-    } else if (rootItem->hasChildren()) {
-        int rowCount = seqOfSize != -1 ? seqOfSize : rootItem->rowCount();
+        setChildRowValue(rootIndex, choiceRow, asn1Value);
+    } else if (m_ItemModel->hasChildren(rootIndex)) {
+        int rowCount = seqOfSize != -1 ? seqOfSize : m_ItemModel->childCount(rootIndex);
 
         for (int x = 0; x < rowCount; ++x) {
-            setChildRowValue(rootItem, x, asn1Value);
+            setChildRowValue(rootIndex, x, asn1Value);
 
-            bool isOptional = rootItem->child(x, MODEL_IS_OPTIONAL_INDEX)->data(OPTIONAL_ROLE).toBool();
+            const QModelIndex presentIndex = m_ItemModel->childIndex(rootIndex, x, MODEL_IS_OPTIONAL_INDEX);
+            bool isOptional = presentIndex.data(OPTIONAL_ROLE).toBool();
             if (isOptional) {
                 // asn1Value = list of map
-                const auto &valueMap =
-                        findValue(rootItem->child(x, MODEL_NAME_INDEX)->text(), asn1Value.toList()[x].toMap());
-                rootItem->child(x, MODEL_IS_OPTIONAL_INDEX)
-                        ->setCheckState(valueMap.size() ? Qt::Checked : Qt::Unchecked);
+                const auto &valueMap = findValue(presentIndex.sibling(x, MODEL_NAME_INDEX).data().toString(),
+                        asn1Value.toList().value(x).toMap());
+                m_ItemModel->setData(
+                        presentIndex, valueMap.size() ? Qt::Checked : Qt::Unchecked, Qt::CheckStateRole);
             }
         }
     }
@@ -264,16 +293,17 @@ QVariantMap Asn1TreeView::findValue(const QString &name, const QVariantMap &asn1
 
 /*!
  * \brief Asn1TreeView::itemChoiceIndex Find the index with \a name
- * \param item the item to search in
+ * \param index the row to search in
  * \param name the name to search for
  * \return the index of the row or 0 if none was found
  */
-int Asn1TreeView::itemChoiceIndex(const QStandardItem *item, const QString &name) const
+int Asn1TreeView::itemChoiceIndex(const QModelIndex &index, const QString &name) const
 {
     int choiceIndex = 0;
 
-    for (choiceIndex = 0; choiceIndex < item->rowCount(); ++choiceIndex) {
-        if (name == item->child(choiceIndex, MODEL_NAME_INDEX)->text()) {
+    const int rowCount = m_ItemModel->childCount(index);
+    for (choiceIndex = 0; choiceIndex < rowCount; ++choiceIndex) {
+        if (name == m_ItemModel->childIndex(index, choiceIndex, MODEL_NAME_INDEX).data().toString()) {
             break;
         }
     }
@@ -283,44 +313,36 @@ int Asn1TreeView::itemChoiceIndex(const QStandardItem *item, const QString &name
 
 /*!
  * \brief Asn1TreeView::getItemValue Get a string representation of an item
- * \param item The item to stringify
+ * \param index The row to stringify
  * \param separator The separator between the values
  * \return The generated string
  */
-QString Asn1TreeView::getItemValue(const QStandardItem *item, const QString &separator) const
+QString Asn1TreeView::getItemValue(const QModelIndex &index, const QString &separator) const
 {
-    if (!item) {
+    if (!index.isValid()) {
         return {};
     }
 
     QString itemValue = "";
 
-    QStandardItemModel *model = qobject_cast<QStandardItemModel *>(this->model());
-
-    QModelIndex itemIndex = model->indexFromItem(item);
-    QModelIndex modelIndex = itemIndex.sibling(item->row(), MODEL_TYPE_INDEX);
-    const QString asnType = model->itemFromIndex(modelIndex)->text();
-
-    QString asnValue;
-    modelIndex = itemIndex.sibling(item->row(), MODEL_VALUE_INDEX);
-    if (modelIndex.isValid()) {
-        asnValue = model->itemFromIndex(modelIndex)->text();
-    }
+    const QString asnType = index.sibling(index.row(), MODEL_TYPE_INDEX).data().toString();
+    const QString asnValue = index.sibling(index.row(), MODEL_VALUE_INDEX).data().toString();
+    const QString name = index.data().toString();
 
-    if (!separator.isEmpty() && !item->text().isEmpty()) {
-        itemValue = QString("%1%2 ").arg(item->text(), separator);
+    if (!separator.isEmpty() && !name.isEmpty()) {
+        itemValue = QString("%1%2 ").arg(name, separator);
     }
 
     if (asnType.startsWith("bool", Qt::CaseInsensitive)) {
         itemValue += asnValue.toUpper();
     } else if (asnType.startsWith("choice", Qt::CaseInsensitive)) {
-        itemValue += getItemValue(item->child(itemChoiceIndex(item, asnValue)), " :");
+        itemValue += getItemValue(m_ItemModel->childIndex(index, itemChoiceIndex(index, asnValue)), " :");
     } else if (asnType.startsWith("sequenceOf", Qt::CaseInsensitive)
             || asnType.startsWith("sequence of", Qt::CaseInsensitive)) {
         itemValue += "{ ";
         int childCount = asnValue.toInt();
         for (int x = 0; x < childCount; ++x) {
-            itemValue += getItemValue(item->child(x), "");
+            itemValue += getItemValue(m_ItemModel->childIndex(index, x), "");
             if (x < childCount - 1) {
                 itemValue += ", ";
             }
@@ -328,9 +350,9 @@ QString Asn1TreeView::getItemValue(const QStandardItem *item, const QString &sep
         itemValue += " }";
     } else if (asnType.startsWith("sequence", Qt::CaseInsensitive)) {
         itemValue += "{ ";
-        int childCount = item->rowCount();
+        int childCount = m_ItemModel->childCount(index);
         for (int x = 0; x < childCount; ++x) {
-            itemValue += getItemValue(item->child(x), " ");
+            itemValue += getItemValue(m_ItemModel->childIndex(index, x), " ");
             if (x < childCount - 1) {
                 itemValue += ", ";
             }
@@ -338,8 +360,8 @@ QString Asn1TreeView::getItemValue(const QStandardItem *item, const QString &sep
         itemValue += " }";
     } else if (asnType.startsWith("string", Qt::CaseInsensitive)) {
         itemValue += "\"" + asnValue + "\"";
-    } else if (item->child(0, 0)) {
-        itemValue += getItemValue(item->child(0, 0), " :");
+    } else if (m_ItemModel->hasChildren(index)) {
+        itemValue += getItemValue(m_ItemModel->childIndex(index, 0), " :");
     } else {
         //(asnType == "integer" || asnType == "double" || asnType == "enumerated")
         itemValue += asnValue;
@@ -22,8 +22,6 @@
 #include <QVariantMap>
 #include <memory>
 
-class QStandardItem;
-
 namespace Asn1Acn {
 class TypeAssignment;
 }
@@ -44,21 +42,25 @@ public:
     void setAsn1Value(const QVariantMap &value);
     QString getAsn1Value() const;
 
+protected Q_SLOTS:
+    void rowsInserted(const QModelIndex &parent, int start, int end) override;
+
 private Q_SLOTS:
     void onSequenceOfSizeChanged(const QModelIndex &index, const QVariant &value, const QVariant &maxRange);
     void onChoiceFieldChanged(const QModelIndex &index, const QVariant &length, const QVariant &currentIndex);
 
 private:
-    void hideExtraFields(const QStandardItem *item, bool hide = false, int row = 0);
+    void hideExtraFields(const QModelIndex &index);
+    void updateRowVisibility(const QModelIndex &index);
+    void expandFetched(const QModelIndex &index);
 
-    void setChildValue(
-            const QStandardItem *rootItem, const QVariant &asn1Value, int seqOfSize = -1, int choiceRow = -1);
-    void setChildRowValue(const QStandardItem *rootItem, int childIndex, const QVariant &asn1Value);
+    void setChildValue(const QModelIndex &rootIndex, const QVariant &asn1Value, int seqOfSize = -1, int choiceRow = -1);
+    void setChildRowValue(const QModelIndex &rootIndex, int childIndex, const QVariant &asn1Value);
 
     QVariantMap findValue(const QString &name, const QVariantMap &asn1Value) const;
-    int itemChoiceIndex(const QStandardItem *item, const QString &name) const;
+    int itemChoiceIndex(const QModelIndex &index, const QString &name) const;
 
-    QString getItemValue(const QStandardItem *item, const QString &separator = "") const;
+    QString getItemValue(const QModelIndex &index, const QString &separator = "") const;
 
 private:
     using ItemModelPtr = QSharedPointer<Asn1ItemModel>;
@@ -24,6 +24,7 @@
 ****************************************************************************/
 #include "definitions.h"
 
+#include "file.h"
 #include "visitor.h"
 
 using namespace Asn1Acn;
@@ -44,6 +45,9 @@ void Definitions::addType(std::unique_ptr<TypeAssignment> type)
 {
     type->setParent(this);
     m_typeByNameMap[type->name()] = type.get();
+    if (auto file = dynamic_cast<File *>(parent())) {
+        file->indexType(type.get());
+    }
     m_types.push_back(std::move(type));
 }
 
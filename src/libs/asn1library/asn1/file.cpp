@@ -24,9 +24,11 @@
 ****************************************************************************/
 #include "file.h"
 
-#include "asn1valueparser.h"
+#include "asn1valuechecker.h"
 #include "visitor.h"
 
+#include <algorithm>
+
 using namespace Asn1Acn;
 
 File::File(const QString &path)
@@ -51,6 +53,9 @@ const Definitions *File::definitions(const QString &name) const
 void File::add(std::unique_ptr<Definitions> defs)
 {
     defs->setParent(this);
+    for (const std::unique_ptr<TypeAssignment> &assignment : defs->types()) {
+        indexType(assignment.get());
+    }
     m_definitionsByNameMap[defs->name()] = defs.get();
     m_definitionsList.push_back(std::move(defs));
 }
@@ -82,14 +87,16 @@ void File::clearErrors()
  */
 const std::unique_ptr<TypeAssignment> &File::typeAssignment(const QString &text) const
 {
-    for (const std::unique_ptr<Definitions> &def : m_definitionsList) {
-        for (const std::unique_ptr<TypeAssignment> &assign : def->types()) {
-            if (text == assign->name()) {
-                return assign;
-            }
-        }
+    const TypeAssignments &assignments = typeAssignments(text);
+    if (assignments.isEmpty()) {
+        return m_noType;
     }
-    return m_noType;
+
+    const TypeAssignment *assignment = assignments.first();
+    const auto definitions = static_cast<const Definitions *>(assignment->parent());
+    const auto it = std::find_if(definitions->types().cbegin(), definitions->types().cend(),
+            [assignment](const std::unique_ptr<TypeAssignment> &type) { return type.get() == assignment; });
+    return *it;
 }
 
 /*!
@@ -97,14 +104,8 @@ const std::unique_ptr<TypeAssignment> &File::typeAssignment(const QString &text)
  */
 const Types::Type *File::typeFromName(const QString &name) const
 {
-    for (const std::unique_ptr<Asn1Acn::Definitions> &definitions : m_definitionsList) {
-        for (const std::unique_ptr<Asn1Acn::TypeAssignment> &assignment : definitions->types()) {
-            if (assignment->name() == name) {
-                return assignment->type();
-            }
-        }
-    }
-    return nullptr;
+    const TypeAssignments &assignments = typeAssignments(name);
+    return assignments.isEmpty() ? nullptr : assignments.first()->type();
 }
 
 /*!
@@ -112,7 +113,7 @@ const Types::Type *File::typeFromName(const QString &name) const
  */
 bool File::hasType(const QString &typeName) const
 {
-    return typeFromName(typeName) != nullptr;
+    return !typeAssignments(typeName).isEmpty();
 }
 
 /*!
@@ -120,18 +121,55 @@ bool File::hasType(const QString &typeName) const
  */
 bool File::checkAsn1Compliance(const QString &parameter, const QString &typeName) const
 {
-    for (const std::unique_ptr<Asn1Acn::Definitions> &definitions : m_definitionsList) {
-        for (const std::unique_ptr<Asn1Acn::TypeAssignment> &typeAssignment : definitions->types()) {
-            if (typeAssignment->name() == typeName) {
-                bool ok;
-                Asn1Acn::Asn1ValueParser parser;
-                parser.parseAsn1Value(typeAssignment.get(), parameter, &ok);
-                if (ok) {
-                    return true;
-                }
-            }
+    for (const TypeAssignment *assignment : typeAssignments(typeName)) {
+        if (valueChecker(assignment)->isValid(parameter)) {
+            return true;
         }
     }
 
     return false;
 }
+
+/*!
+   Returns the checker for values of the type \p assignment. It is compiled at the first call and kept with the file
+ */
+const Asn1ValueChecker *File::valueChecker(const TypeAssignment *assignment) const
+{
+    QMutexLocker locker(&m_valueCheckersMutex);
+    std::unique_ptr<Asn1ValueChecker> &checker = m_valueCheckers[assignment];
+    if (!checker) {
+        checker = std::make_unique<Asn1ValueChecker>(assignment->type());
+    }
+    return checker.get();
+}
+
+/*!
+   Returns the checkers of all types named \p typeName. A value complies, if any of them accepts it
+ */
+QVector<const Asn1ValueChecker *> File::valueCheckers(const QString &typeName) const
+{
+    QVector<const Asn1ValueChecker *> checkers;
+    for (const TypeAssignment *assignment : typeAssignments(typeName)) {
+        checkers.append(valueChecker(assignment));
+    }
+    return checkers;
+}
+
+/*!
+   Returns all type assignments named \p name, in the order they were added
+ */
+const File::TypeAssignments &File::typeAssignments(const QString &name) const
+{
+    static const TypeAssignments noAssignments;
+    const auto it = m_typeIndex.constFind(name);
+    return it == m_typeIndex.cend() ? noAssignments : it.value();
+}
+
+/*!
+   Adds the \p assignment to the index. Called when definitions are added, and by the definitions of this file when
+   they get a new type (the AstXmlParser adds types after the definitions were added)
+ */
+void File::indexType(const TypeAssignment *assignment)
+{
+    m_typeIndex[assignment->name()].append(assignment);
+}
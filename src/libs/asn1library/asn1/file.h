@@ -30,12 +30,16 @@
 #include "typereference.h"
 #include "types/type.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QVector>
 #include <map>
 #include <memory>
 #include <vector>
 
 namespace Asn1Acn {
 
+class Asn1ValueChecker;
 class TypeAssignment;
 
 class File : public Node
@@ -74,8 +78,17 @@ public:
     bool hasType(const QString &name) const;
 
     bool checkAsn1Compliance(const QString &parameter, const QString &typeName) const;
+    const Asn1ValueChecker *valueChecker(const TypeAssignment *assignment) const;
+    QVector<const Asn1ValueChecker *> valueCheckers(const QString &typeName) const;
 
 private:
+    friend class Definitions;
+
+    using TypeAssignments = QVector<const TypeAssignment *>;
+
+    const TypeAssignments &typeAssignments(const QString &name) const;
+    void indexType(const TypeAssignment *assignment);
+
     DefinitionsList m_definitionsList;
     ReferencesMap m_referencesMap;
     References m_references;
@@ -86,6 +99,12 @@ private:
     bool m_polluted;
 
     const std::unique_ptr<TypeAssignment> m_noType;
+
+    /// Type assignments by name, updated whenever a type is added to the file or its definitions
+    QHash<QString, TypeAssignments> m_typeIndex;
+    /// The value checkers are compiled on first use, possibly from several threads
+    mutable QMutex m_valueCheckersMutex;
+    mutable std::map<const TypeAssignment *, std::unique_ptr<Asn1ValueChecker>> m_valueCheckers;
 };
 
 }
@@ -41,7 +41,7 @@ void Project::accept(Visitor &visitor) const
     visitor.visit(*this);
 }
 
-void Project::add(std::unique_ptr<File> file)
+void Project::add(std::shared_ptr<File> file)
 {
     const QString path = file->name();
 
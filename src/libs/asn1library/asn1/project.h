@@ -41,10 +41,10 @@ public:
 
     void accept(Visitor &visitor) const override;
 
-    void add(std::unique_ptr<File> file);
+    void add(std::shared_ptr<File> file);
     void remove(const QString &path);
 
-    using Files = std::vector<std::unique_ptr<File>>;
+    using Files = std::vector<std::shared_ptr<File>>; ///< Shared, so snapshots of the project can keep them alive
     const Files &files() const { return m_files; }
     File *file(const QString &path) const;
 
@@ -31,6 +31,7 @@
 
 namespace Asn1Acn {
 
+class AstBinaryReader;
 class AstXmlParser;
 class TypeAssignment;
 
@@ -89,6 +90,7 @@ protected:
     QVariantMap m_parameters;
     std::vector<std::unique_ptr<Type>> m_children;
 
+    friend class Asn1Acn::AstBinaryReader;
     friend class Asn1Acn::AstXmlParser;
     friend class Asn1Acn::TypeAssignment;
 };
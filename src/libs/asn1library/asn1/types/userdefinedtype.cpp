@@ -54,6 +54,14 @@ QString UserdefinedType::baseIconFile() const
     return QStringLiteral(":/asn1acn/images/outline/userdefined.png");
 }
 
+/*!
+   Returns the name of the module the referenced type is defined in
+ */
+const QString &UserdefinedType::module() const
+{
+    return m_module;
+}
+
 /*!
    Returns the type that this one is based on (references to)
  */
@@ -44,6 +44,7 @@ public:
 
     QString baseIconFile() const override;
 
+    const QString &module() const;
     const TypeAssignment *referencedType() const;
 
 private:
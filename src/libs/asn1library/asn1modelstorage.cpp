@@ -19,9 +19,11 @@
 
 #include "asn1/definitions.h"
 #include "asn1/file.h"
+#include "asn1/typeassignment.h"
 #include "asn1/types/builtintypes.h"
-#include "asn1reader.h"
+#include "asn1/valueassignment.h"
 #include "common.h"
+#include "memoryreport.h"
 
 #include <QDebug>
 #include <QDir>
@@ -30,6 +32,8 @@
 #include <QFileSystemWatcher>
 #include <QStandardPaths>
 #include <QTextStream>
+#include <QtConcurrentRun>
+#include <functional>
 
 namespace Asn1Acn {
 
@@ -39,18 +43,33 @@ namespace Asn1Acn {
 Asn1ModelStorage::Asn1ModelStorage(QObject *parent)
     : QObject(parent)
     , m_asn1Watcher(new QFileSystemWatcher(this))
+    , m_reader(new Asn1Reader(this))
 {
     m_reloadTimer.setSingleShot(true);
     connect(&m_reloadTimer, &QTimer::timeout, this, &Asn1Acn::Asn1ModelStorage::loadChangedFiles);
+    connect(m_asn1Watcher, &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
+        m_reloadTimer.stop();
+        m_reloadTimer.start(20);
+        m_filesToReload.insert(path);
+    });
+    connect(&m_loadWatcher, &QFutureWatcher<QVector<LoadResult>>::finished, this,
+            &Asn1Acn::Asn1ModelStorage::onLoadingFinished);
+    connect(&m_parseWatcher, &QFutureWatcher<Asn1Reader::ParseResult>::finished, this,
+            &Asn1Acn::Asn1ModelStorage::onParsingFinished);
 }
 
 /*!
    \brief Asn1ModelStorage::~Asn1ModelStorage
  */
-Asn1ModelStorage::~Asn1ModelStorage() { }
+Asn1ModelStorage::~Asn1ModelStorage()
+{
+    clear();
+}
 
 /*!
    Returns the asn types for the given file (full path).
+   If the file is not loaded yet, it is loaded before returning. If it's being loaded in the background, this waits
+   for the running batch. \sa loadNow
    If the file can't be loaded a default set of types is returned.
  */
 QSharedPointer<Asn1Acn::File> Asn1ModelStorage::asn1DataTypes(const QString &fileName) const
@@ -61,7 +80,12 @@ QSharedPointer<Asn1Acn::File> Asn1ModelStorage::asn1DataTypes(const QString &fil
 
     if (!m_store.contains(fileName)) {
         auto nonConstThis = const_cast<Asn1ModelStorage *>(this);
-        nonConstThis->loadFile(fileName);
+        if (m_loadingFiles.contains(fileName)) {
+            nonConstThis->loadNow();
+        } else {
+            nonConstThis->m_queuedFiles.removeAll(fileName);
+            nonConstThis->loadFile(fileName);
+        }
     }
 
     if (m_store.contains(fileName)) {
@@ -71,6 +95,29 @@ QSharedPointer<Asn1Acn::File> Asn1ModelStorage::asn1DataTypes(const QString &fil
     }
 }
 
+/*!
+   Returns the asn types for the given file (full path) without blocking.
+   If the file is not loaded yet, it's loaded in the background. The returned future provides a null pointer if the
+   file can't be loaded or the storage was cleared meanwhile.
+ */
+QFuture<QSharedPointer<File>> Asn1ModelStorage::asn1DataTypesAsync(const QString &fileName)
+{
+    if (!fileName.isEmpty() && !m_store.contains(fileName) && !m_pendingFiles.contains(fileName)) {
+        prefetch({ fileName });
+    }
+
+    auto it = m_pendingFiles.constFind(fileName);
+    if (it != m_pendingFiles.constEnd()) {
+        return it.value().future();
+    }
+
+    QFutureInterface<QSharedPointer<Asn1Acn::File>> ready;
+    ready.reportStarted();
+    ready.reportResult(m_store.value(fileName));
+    ready.reportFinished();
+    return ready.future();
+}
+
 /*!
    Returns if the file is already loaded in this store
  */
@@ -80,60 +127,370 @@ bool Asn1ModelStorage::contains(const QString &fileName) const
 }
 
 /*!
-   Clears the whole store
+   Starts loading all \p fileNames not loaded yet in the background.
+   Files requested before the currently running batch is done, are loaded together in the next batch.
+ */
+void Asn1ModelStorage::prefetch(const QStringList &fileNames)
+{
+    for (const QString &fileName : fileNames) {
+        if (!fileName.isEmpty() && !m_store.contains(fileName) && !m_queuedFiles.contains(fileName)
+                && !m_loadingFiles.contains(fileName)) {
+            enqueue(fileName);
+        }
+    }
+    startLoading();
+}
+
+/*!
+   Returns true, if files are loaded in the background or are waiting for it
+ */
+bool Asn1ModelStorage::isLoading() const
+{
+    return !m_queuedFiles.isEmpty() || !m_loadingFiles.isEmpty();
+}
+
+/*!
+   Blocks until all files requested by \ref prefetch or changed on disk are loaded
+ */
+void Asn1ModelStorage::waitForLoaded()
+{
+    while (isLoading()) {
+        loadNow();
+    }
+}
+
+/*!
+   Clears the whole store. Results of a running background load are dropped.
  */
 void Asn1ModelStorage::clear()
 {
     m_reloadTimer.stop();
     m_filesToReload.clear();
-    const QStringList files = m_store.keys();
+    m_queuedFiles.clear();
+    m_loadingFiles.clear();
+    m_parsingFile.clear();
+    m_reader->cancelAll();
+    for (QFutureInterface<QSharedPointer<Asn1Acn::File>> &pending : m_pendingFiles) {
+        pending.reportCanceled();
+        pending.reportFinished();
+    }
+    m_pendingFiles.clear();
+
+    const QStringList files = m_asn1Watcher->files();
     if (!files.isEmpty()) {
-        m_asn1Watcher->removePaths(m_store.keys());
+        m_asn1Watcher->removePaths(files);
     }
     m_store.clear();
 }
 
+/*!
+   Adds all loaded files to \p report
+ */
+void Asn1ModelStorage::addToMemoryReport(shared::MemoryReport *report) const
+{
+    for (const QSharedPointer<File> &file : m_store) {
+        addToMemoryReport(file.data(), report);
+    }
+}
+
+/*!
+   Adds the parsed ASN.1 tree of \p file to \p report, as "asn1.files", "asn1.definitions",
+   "asn1.typeAssignments", "asn1.types" (including all nested types) and "asn1.values"
+ */
+void Asn1ModelStorage::addToMemoryReport(const File *file, shared::MemoryReport *report)
+{
+    if (!file) {
+        return;
+    }
+
+    std::function<void(const Types::Type *)> addType = [&](const Types::Type *type) {
+        report->add(QLatin1String("asn1.types"), 1,
+                sizeof(Types::Type) + shared::MemoryReport::stringBytes(type->identifier())
+                        + shared::MemoryReport::variantBytes(type->parameters()));
+        for (const std::unique_ptr<Types::Type> &child : type->children()) {
+            addType(child.get());
+        }
+    };
+
+    report->add(QLatin1String("asn1.files"), 1,
+            sizeof(File) + shared::MemoryReport::stringBytes(file->name())
+                    + qint64(file->references().size()) * sizeof(TypeReference));
+    for (const std::unique_ptr<Definitions> &definitions : file->definitionsList()) {
+        report->add(QLatin1String("asn1.definitions"), 1,
+                sizeof(Definitions) + shared::MemoryReport::stringBytes(definitions->name()));
+        for (const std::unique_ptr<TypeAssignment> &assignment : definitions->types()) {
+            report->add(QLatin1String("asn1.typeAssignments"), 1,
+                    sizeof(TypeAssignment) + shared::MemoryReport::stringBytes(assignment->name()));
+            if (assignment->type()) {
+                addType(assignment->type());
+            }
+        }
+        for (const std::unique_ptr<ValueAssignment> &value : definitions->values()) {
+            report->add(QLatin1String("asn1.values"), 1,
+                    sizeof(ValueAssignment) + shared::MemoryReport::stringBytes(value->name()));
+        }
+    }
+}
+
 /*!
    Load the data types stored the file \sa fileName
  */
 bool Asn1ModelStorage::loadFile(const QString &fileName)
 {
-    QSharedPointer<Asn1Acn::File> asn1Data = loadData(fileName);
+    storeResult(loadData({ fileName }, m_store.keys()).first());
+    Q_EMIT dataTypesChanged({ fileName });
+    return !m_store.value(fileName).isNull();
+}
+
+/*!
+   Parses all \p fileNames. This runs in a worker thread, so it must not touch any member.
+   All files are compiled together first, so imports between them and from the \p importCandidates are resolved.
+   Files failing in that run are parsed one by one again to get the error messages of each file.
+ */
+QVector<Asn1ModelStorage::LoadResult> Asn1ModelStorage::loadData(
+        const QStringList &fileNames, const QStringList &importCandidates)
+{
+    Asn1Acn::Asn1Reader parser;
+    const QList<QFileInfo> candidateInfos = fileInfos(importCandidates);
+    QStringList errorMessages;
+    std::map<QString, std::unique_ptr<Asn1Acn::File>> parsedFiles =
+            parser.parseAsn1Files(fileInfos(fileNames), &errorMessages, candidateInfos);
 
-    m_store[fileName] = asn1Data;
-    Q_EMIT dataTypesChanged(fileName);
+    QVector<LoadResult> results;
+    results.reserve(fileNames.size());
+    for (const QString &fileName : fileNames) {
+        LoadResult result { fileName, {}, {} };
+        const QString filePath = QFileInfo(fileName).absoluteFilePath();
+        std::unique_ptr<Asn1Acn::File> asn1Data;
+        auto it = parsedFiles.find(filePath);
+        if (it != parsedFiles.end()) {
+            asn1Data = std::move(it->second);
+        } else if (fileNames.size() > 1) {
+            std::map<QString, std::unique_ptr<Asn1Acn::File>> singleFile =
+                    parser.parseAsn1Files({ QFileInfo(fileName) }, &result.errors, candidateInfos);
+            auto singleIt = singleFile.find(filePath);
+            if (singleIt != singleFile.end()) {
+                asn1Data = std::move(singleIt->second);
+            }
+        } else {
+            result.errors = errorMessages;
+        }
 
-    if (QFileInfo::exists(fileName) && !m_asn1Watcher->files().contains(fileName)) {
-        m_asn1Watcher->addPath(fileName);
-        connect(m_asn1Watcher, &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
-            m_reloadTimer.stop();
-            m_reloadTimer.start(20);
-            m_filesToReload.insert(path);
-        });
+        if (result.errors.isEmpty()) {
+            result.file = QSharedPointer<Asn1Acn::File>(asn1Data.release());
+        } else {
+            qWarning() << "Can't read file" << fileName << ":" << result.errors.join(", ");
+        }
+        results.append(result);
     }
-    return !asn1Data.isNull();
+    return results;
 }
 
-QSharedPointer<File> Asn1ModelStorage::loadData(const QString &fileName)
+QList<QFileInfo> Asn1ModelStorage::fileInfos(const QStringList &fileNames)
 {
-    QStringList errorMessages;
-    Asn1Acn::Asn1Reader parser;
-    std::unique_ptr<Asn1Acn::File> asn1Data = parser.parseAsn1File(QFileInfo(fileName), &errorMessages);
-    if (!errorMessages.isEmpty()) {
-        qWarning() << "Can't read file" << fileName << ":" << errorMessages.join(", ");
-        Q_EMIT error(fileName, errorMessages);
-        return {};
+    QList<QFileInfo> infos;
+    for (const QString &fileName : fileNames) {
+        infos.append(QFileInfo(fileName));
     }
-    Q_EMIT success(fileName);
-    return QSharedPointer<Asn1Acn::File>(asn1Data.release());
+    return infos;
 }
 
-void Asn1ModelStorage::loadChangedFiles()
+/*!
+   Puts the loaded file into the store, starts watching it and finishes the future of the request
+ */
+void Asn1ModelStorage::storeResult(const LoadResult &result)
+{
+    m_store[result.fileName] = result.file;
+    if (result.errors.isEmpty()) {
+        Q_EMIT success(result.fileName);
+    } else {
+        Q_EMIT error(result.fileName, result.errors);
+    }
+
+    if (QFileInfo::exists(result.fileName) && !m_asn1Watcher->files().contains(result.fileName)) {
+        m_asn1Watcher->addPath(result.fileName);
+    }
+
+    auto it = m_pendingFiles.find(result.fileName);
+    if (it != m_pendingFiles.end()) {
+        it.value().reportResult(result.file);
+        it.value().reportFinished();
+        m_pendingFiles.erase(it);
+    }
+}
+
+void Asn1ModelStorage::enqueue(const QString &fileName)
+{
+    if (!m_queuedFiles.contains(fileName)) {
+        m_queuedFiles.append(fileName);
+    }
+    if (!m_store.contains(fileName) && !m_pendingFiles.contains(fileName)) {
+        QFutureInterface<QSharedPointer<Asn1Acn::File>> pending;
+        pending.reportStarted();
+        m_pendingFiles.insert(fileName, pending);
+    }
+}
+
+/*!
+   Starts loading all queued files as one batch, unless a batch is running already
+ */
+void Asn1ModelStorage::startLoading()
+{
+    if (m_queuedFiles.isEmpty() || !m_loadWatcher.future().isFinished() || !m_parsingFile.isEmpty()) {
+        return;
+    }
+
+    m_loadingFiles = m_queuedFiles;
+    m_queuedFiles.clear();
+    if (m_loadingFiles.size() == 1) {
+        m_parsingFile = m_loadingFiles.first();
+        m_parseWatcher.setFuture(m_reader->parseAsn1FileAsync(QFileInfo(m_parsingFile), fileInfos(m_store.keys())));
+    } else {
+        m_loadWatcher.setFuture(QtConcurrent::run(&Asn1ModelStorage::loadData, m_loadingFiles, m_store.keys()));
+    }
+}
+
+void Asn1ModelStorage::onLoadingFinished()
+{
+    /// While a single file is parsed, m_loadingFiles belong to that parse
+    if (!m_loadWatcher.future().isFinished() || !m_parsingFile.isEmpty()) {
+        return;
+    }
+
+    /// Empty if the results were taken already or the store was cleared meanwhile
+    const QStringList loadedFiles = m_loadingFiles;
+    m_loadingFiles.clear();
+    if (!loadedFiles.isEmpty()) {
+        const QVector<LoadResult> results = m_loadWatcher.result();
+        for (const LoadResult &result : results) {
+            storeResult(result);
+        }
+        Q_EMIT dataTypesChanged(loadedFiles);
+    }
+
+    startLoading();
+}
+
+/*!
+   Stores the result of the single file parsed by the asn1 reader
+ */
+void Asn1ModelStorage::onParsingFinished()
 {
-    for (QString fileName : m_filesToReload) {
-        loadFile(fileName);
+    const QFuture<Asn1Reader::ParseResult> future = m_parseWatcher.future();
+    if (m_parsingFile.isEmpty() || !future.isFinished()) {
+        return;
     }
+
+    LoadResult result { m_parsingFile, {}, {} };
+    m_parsingFile.clear();
+    m_loadingFiles.clear();
+    if (future.resultCount() > 0) {
+        const Asn1Reader::ParseResult parsed = future.result();
+        result.errors = parsed.errorMessages;
+        if (result.errors.isEmpty()) {
+            result.file = parsed.file;
+        } else {
+            qWarning() << "Can't read file" << result.fileName << ":" << result.errors.join(", ");
+        }
+    }
+    storeResult(result);
+    Q_EMIT dataTypesChanged({ result.fileName });
+
+    startLoading();
+}
+
+/*!
+   Stores the files loaded in the background without returning to the event loop.
+   A running batch is waited for. The asynchronous parse of a single file needs the event loop of this thread, so
+   it's cancelled and the file is loaded in this thread instead. If nothing is running, the queued files are loaded
+   in this thread as well.
+ */
+void Asn1ModelStorage::loadNow()
+{
+    if (m_parsingFile.isEmpty() && !m_loadingFiles.isEmpty()) {
+        m_loadWatcher.waitForFinished();
+        onLoadingFinished();
+        return;
+    }
+
+    if (!m_parsingFile.isEmpty()) {
+        m_parsingFile.clear();
+        m_reader->cancelAll();
+    } else {
+        m_loadingFiles = m_queuedFiles;
+        m_queuedFiles.clear();
+    }
+
+    const QStringList loadedFiles = m_loadingFiles;
+    m_loadingFiles.clear();
+    if (!loadedFiles.isEmpty()) {
+        const QVector<LoadResult> results = loadData(loadedFiles, m_store.keys());
+        for (const LoadResult &result : results) {
+            storeResult(result);
+        }
+        Q_EMIT dataTypesChanged(loadedFiles);
+    }
+}
+
+/*!
+   Returns all loaded files importing from one of the \p fileNames, directly or through other files
+ */
+QStringList Asn1ModelStorage::dependentFiles(const QStringList &fileNames) const
+{
+    QHash<QString, QString> moduleFiles;
+    for (auto it = m_store.cbegin(); it != m_store.cend(); ++it) {
+        if (it.value()) {
+            for (const std::unique_ptr<Definitions> &definitions : it.value()->definitionsList()) {
+                moduleFiles.insert(definitions->name(), it.key());
+            }
+        }
+    }
+
+    auto importsFrom = [&moduleFiles](const File &file, const QString &importedFile) {
+        for (const std::unique_ptr<Definitions> &definitions : file.definitionsList()) {
+            for (const ImportedType &imported : definitions->importedTypes()) {
+                if (moduleFiles.value(imported.module()) == importedFile) {
+                    return true;
+                }
+            }
+            for (const ImportedValue &imported : definitions->importedValues()) {
+                if (moduleFiles.value(imported.module()) == importedFile) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    QStringList dependents;
+    QStringList toVisit = fileNames;
+    while (!toVisit.isEmpty()) {
+        const QString current = toVisit.takeLast();
+        for (auto it = m_store.cbegin(); it != m_store.cend(); ++it) {
+            if (!it.value() || fileNames.contains(it.key()) || dependents.contains(it.key())) {
+                continue;
+            }
+            if (importsFrom(*it.value(), current)) {
+                dependents.append(it.key());
+                toVisit.append(it.key());
+            }
+        }
+    }
+    return dependents;
+}
+
+/*!
+   Reloads the changed files and all files importing from them in the background
+ */
+void Asn1ModelStorage::loadChangedFiles()
+{
+    QStringList fileNames = m_filesToReload.values();
     m_filesToReload.clear();
+    fileNames += dependentFiles(fileNames);
+    for (const QString &fileName : qAsConst(fileNames)) {
+        enqueue(fileName);
+    }
+    startLoading();
 }
 
 }
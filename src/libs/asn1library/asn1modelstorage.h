@@ -17,18 +17,29 @@
 
 #pragma once
 
+#include "asn1reader.h"
+
 #include <QFileInfo>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
 #include <QHash>
 #include <QMap>
 #include <QObject>
 #include <QSet>
 #include <QSharedPointer>
 #include <QString>
+#include <QStringList>
 #include <QTimer>
+#include <QVector>
 #include <memory>
 
 class QFileSystemWatcher;
 
+namespace shared {
+class MemoryReport;
+}
+
 namespace Asn1Acn {
 class File;
 
@@ -38,7 +49,13 @@ class Type;
 
 /*!
    Stores shared pointers to all asn1 file objects. If needed the file i loaded (lazy loading).
-   A signal is emitted when a file loaded already is changed \sa dataTypesChanged
+   Files can be loaded in advance in the background with \ref prefetch. Loading runs in batches on the global thread
+   pool, all files of one batch are compiled with a single asn1scc run. A batch of a single file, like the one of a
+   document being opened, is parsed by Asn1Acn::Asn1Reader::parseAsn1FileAsync, so no thread waits for asn1scc.
+   When a file loaded already is changed, it's reloaded in the background together with all loaded files importing
+   from it. A signal is emitted once per loaded batch \sa dataTypesChanged
+   All loaded files are passed to the asn1 reader as files a load may import from, so a file gets the same cache key
+   whether it is loaded alone or in a batch.
  */
 class Asn1ModelStorage : public QObject
 {
@@ -48,24 +65,55 @@ public:
     ~Asn1ModelStorage();
 
     QSharedPointer<File> asn1DataTypes(const QString &fileName) const;
+    QFuture<QSharedPointer<File>> asn1DataTypesAsync(const QString &fileName);
     bool contains(const QString &fileName) const;
 
+    void prefetch(const QStringList &fileNames);
+    bool isLoading() const;
+    void waitForLoaded();
+
     void clear();
 
+    void addToMemoryReport(shared::MemoryReport *report) const;
+    static void addToMemoryReport(const File *file, shared::MemoryReport *report);
+
 Q_SIGNALS:
-    void dataTypesChanged(const QString &fileName);
+    void dataTypesChanged(const QStringList &fileNames);
     void success(const QString &fileName);
     void error(const QString &fileName, const QStringList &errors);
 
 private:
+    struct LoadResult {
+        QString fileName;
+        QSharedPointer<Asn1Acn::File> file;
+        QStringList errors;
+    };
+
     bool loadFile(const QString &fileName);
-    QSharedPointer<Asn1Acn::File> loadData(const QString &fileName);
+    static QVector<LoadResult> loadData(const QStringList &fileNames, const QStringList &importCandidates);
+    static QList<QFileInfo> fileInfos(const QStringList &fileNames);
+    void storeResult(const LoadResult &result);
+    void enqueue(const QString &fileName);
+    void startLoading();
+    void onLoadingFinished();
+    void onParsingFinished();
+    void loadNow();
+    QStringList dependentFiles(const QStringList &fileNames) const;
     Q_SLOT void loadChangedFiles();
 
     QHash<QString, QSharedPointer<Asn1Acn::File>> m_store;
     QFileSystemWatcher *m_asn1Watcher = nullptr;
     QTimer m_reloadTimer;
     QSet<QString> m_filesToReload;
+
+    QHash<QString, QFutureInterface<QSharedPointer<Asn1Acn::File>>> m_pendingFiles;
+    QStringList m_queuedFiles;
+    QStringList m_loadingFiles;
+    QFutureWatcher<QVector<LoadResult>> m_loadWatcher;
+    Asn1Reader *m_reader = nullptr;
+    /// The file parsed by m_reader, empty if no single file is loaded
+    QString m_parsingFile;
+    QFutureWatcher<Asn1Reader::ParseResult> m_parseWatcher;
 };
 
 }
@@ -18,23 +18,33 @@
 #include "asn1reader.h"
 
 #include "asn1const.h"
+#include "astbinarycache.h"
 #include "astxmlparser.h"
 #include "file.h"
+#include "trace.h"
 
 #include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
 #include <QFileInfo>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QPointer>
 #include <QProcess>
 #include <QRandomGenerator>
+#include <QRegularExpression>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QTemporaryDir>
+#include <QThread>
+#include <QXmlStreamWriter>
+#include <QtConcurrentRun>
 
 namespace Asn1Acn {
 
 QString Asn1Reader::m_mono;
 QCache<QString, QString> Asn1Reader::m_cache {};
+QMutex Asn1Reader::m_staticDataMutex;
 
 #ifdef Q_OS_WIN
 static const QString defaultParameter("--field-prefix AUTO -customStg \"%1xml.stg\"::");
@@ -42,9 +52,33 @@ static const QString defaultParameter("--field-prefix AUTO -customStg \"%1xml.st
 static const QString defaultParameter("--field-prefix AUTO -customStg %1/xml.stg:");
 #endif
 
+/*!
+   State of one asynchronous parse of an asn.1 file
+ */
+struct Asn1Reader::CompilerJob {
+    QString asn1FileName;
+    QStringList importCandidates;
+    QHash<QString, QByteArray> cacheKeys;
+    QStringList compiledFiles; ///< The file and all files it imports from, compiled together
+    QString cacheFileName;
+    bool cached = false; ///< If the cache file already exists, so the compiler doesn't need to run
+    QString tempXmlFileName;
+    QStringList errorMessages;
+    QPointer<QProcess> process;
+    QFuture<void> hashing;
+    QFutureInterface<ParseResult> result;
+    qint64 traceBegin = -1; ///< Start of the compiler run in the trace, -1 if not traced
+};
+
 Asn1Reader::Asn1Reader(QObject *parent)
     : QObject(parent)
+    , m_maxConcurrentCompilers(qMax(1, QThread::idealThreadCount()))
+{
+}
+
+Asn1Reader::~Asn1Reader()
 {
+    cancelAll();
 }
 
 /*!
@@ -78,14 +112,19 @@ std::unique_ptr<Asn1Acn::File> Asn1Reader::parseAsn1File(
     const QString fullFilePath = asn1File.absoluteFilePath();
     const QByteArray asn1FileHash = fileHash(fullFilePath);
 
-    const QString asnCacheFile =
-            QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/asn/" + asn1FileHash + ".xml";
+    const QString asnCacheFile = cachedXmlFileName(asn1FileHash);
 
     if (!QFile::exists(asnCacheFile)) {
+        QFile::remove(cachedBinaryFileName(asnCacheFile));
         convertToXML(fullFilePath, asnCacheFile, errorMessages);
     }
 
-    std::unique_ptr<Asn1Acn::File> asn1TypesData = parseAsn1XmlFile(asnCacheFile);
+    QStringList errors;
+    std::unique_ptr<Asn1Acn::File> asn1TypesData =
+            readCachedFile(asnCacheFile, { QFileInfo(asnCacheFile).fileName() }, &errors);
+    for (const QString &error : qAsConst(errors)) {
+        Q_EMIT parseError(error);
+    }
 
     return asn1TypesData;
 }
@@ -106,7 +145,12 @@ std::unique_ptr<Asn1Acn::File> Asn1Reader::parseAsn1File(
     const QString asnFile = tempDir.filePath(fi.fileName());
     const QString xmlFile = asnFile + "xml";
 
-    if (!m_cache.contains(hash)) {
+    QMutexLocker locker(&m_staticDataMutex);
+    QString *cachedXml = m_cache.object(hash);
+    QString xmlContent = cachedXml ? *cachedXml : QString();
+    locker.unlock();
+
+    if (!cachedXml) {
         QFile fileAsn(asnFile);
         if (!fileAsn.open(QIODevice::WriteOnly)) {
             return {};
@@ -123,16 +167,94 @@ std::unique_ptr<Asn1Acn::File> Asn1Reader::parseAsn1File(
         if (!fileXml.open(QIODevice::ReadOnly)) {
             return {};
         }
-        m_cache.insert(hash, new QString(fileXml.readAll()));
+        xmlContent = fileXml.readAll();
+        locker.relock();
+        m_cache.insert(hash, new QString(xmlContent));
+        locker.unlock();
     }
 
-    std::unique_ptr<Asn1Acn::File> asn1TypesData = parseAsn1XmlContent(*(m_cache[hash]), xmlFile);
+    std::unique_ptr<Asn1Acn::File> asn1TypesData = parseAsn1XmlContent(xmlContent, xmlFile);
     if (asn1TypesData) {
         asn1TypesData->setName(fileName);
     }
     return asn1TypesData;
 }
 
+/*!
+   \brief Parses a set of asn.1 files that may import each other
+   All files without an up to date cached xml are compiled with a single asn1scc invocation, together with the
+   files they import. The resulting xml is split per file, so every file gets its own cache entry. The cache key of
+   a file covers its content and the content of all files of the set it imports (directly or not). So changing one
+   file later only recompiles that file and the files depending on it.
+   \param fileInfos the asn.1 files to parse
+   \param errorMessages optional output parameter containing error messages
+   \param importCandidates files the parsed files may import from. They are part of the cache keys and compiled if
+   needed, but not returned.
+   \return The parsed files by absolute file path. Files that could not be parsed are missing.
+ */
+std::map<QString, std::unique_ptr<Asn1Acn::File>> Asn1Reader::parseAsn1Files(
+        const QList<QFileInfo> &fileInfos, QStringList *errorMessages, const QList<QFileInfo> &importCandidates)
+{
+    QStringList errors;
+    QStringList fileNames;
+    for (const QFileInfo &fileInfo : fileInfos) {
+        const QString fullFilePath = fileInfo.absoluteFilePath();
+        if (!fileInfo.exists()) {
+            errors.append(tr("ASN.1 file %1 does not exist").arg(fullFilePath));
+        } else if (!fileNames.contains(fullFilePath)) {
+            fileNames.append(fullFilePath);
+        }
+    }
+
+    QStringList hashedFiles = fileNames;
+    for (const QString &candidate : absoluteFilePaths(importCandidates)) {
+        if (!hashedFiles.contains(candidate)) {
+            hashedFiles.append(candidate);
+        }
+    }
+    QHash<QString, QStringList> dependencies;
+    const QHash<QString, QByteArray> cacheKeys = dependencyAwareHashes(hashedFiles, &dependencies);
+
+    /// Outdated files are compiled together with everything they import, asn1scc needs to see the imported modules
+    QStringList filesToCompile;
+    for (const QString &fileName : qAsConst(fileNames)) {
+        if (QFile::exists(cachedXmlFileName(cacheKeys.value(fileName)))) {
+            continue;
+        }
+        for (const QString &compiledFile : dependencies.value(fileName) + QStringList { fileName }) {
+            if (!filesToCompile.contains(compiledFile)) {
+                filesToCompile.append(compiledFile);
+            }
+        }
+    }
+
+    if (!filesToCompile.isEmpty()) {
+        const QString xmlFileName = temporaryFileName("asn1", "xml");
+        if (convertToXML(filesToCompile, xmlFileName, &errors)) {
+            splitCompiledXml(xmlFileName, filesToCompile, cacheKeys, &errors);
+        }
+        QFile::remove(xmlFileName);
+    }
+
+    std::map<QString, std::unique_ptr<Asn1Acn::File>> result;
+    for (const QString &fileName : qAsConst(fileNames)) {
+        const QString cacheFileName = cachedXmlFileName(cacheKeys.value(fileName));
+        if (!QFile::exists(cacheFileName)) {
+            continue;
+        }
+        std::unique_ptr<Asn1Acn::File> data =
+                readCachedFile(cacheFileName, { QFileInfo(fileName).fileName() }, &errors);
+        if (data) {
+            result[fileName] = std::move(data);
+        }
+    }
+
+    if (errorMessages) {
+        errorMessages->append(errors);
+    }
+    return result;
+}
+
 /*!
    Reads the file \p fileName which is a asn->xml converted file
    \return An empty unique ptr if an error occured
@@ -144,26 +266,13 @@ std::unique_ptr<Asn1Acn::File> Asn1Reader::parseAsn1XmlFile(const QString &fileN
         QFile file(fileName);
 
         if (file.open(QIODevice::ReadOnly)) {
-
             QXmlStreamReader reader(&file);
-            Asn1Acn::AstXmlParser parser(reader);
-            const bool ok = parser.parse();
-            if (!ok) {
-                Q_EMIT parseError(tr("Error parsing the asn1 file %1").arg(fileName));
-            }
-            std::map<QString, std::unique_ptr<Asn1Acn::File>> data = parser.takeData();
-            if (data.empty()) {
-                Q_EMIT parseError(tr("Invalid XML format"));
-                return {};
-            }
-
-            if (data.size() == 1) {
-                return std::move(data.begin()->second);
-            }
-
-            if (data.find(fileInfo.fileName()) != data.end()) {
-                return std::move(data[fileInfo.fileName()]);
+            QStringList errors;
+            std::unique_ptr<Asn1Acn::File> data = readXml(reader, fileName, { fileInfo.fileName() }, &errors);
+            for (const QString &error : qAsConst(errors)) {
+                Q_EMIT parseError(error);
             }
+            return data;
         } else
             Q_EMIT parseError(file.errorString());
     } else {
@@ -179,16 +288,304 @@ std::unique_ptr<Asn1Acn::File> Asn1Reader::parseAsn1XmlFile(const QString &fileN
  */
 std::unique_ptr<File> Asn1Reader::parseAsn1XmlContent(const QString &xmlContent, const QString &fileName)
 {
-    QFileInfo fileInfo(fileName);
     QXmlStreamReader reader(xmlContent);
+    QStringList errors;
+    std::unique_ptr<Asn1Acn::File> data = readXml(reader, fileName, { QFileInfo(fileName).fileName() }, &errors);
+    for (const QString &error : qAsConst(errors)) {
+        Q_EMIT parseError(error);
+    }
+    return data;
+}
+
+/*!
+   Starts parsing the asn.1 file \p fileInfo and returns immediately.
+   If there is no cached xml for the current content of the file, asn1scc is run as soon as one of the
+   \ref maxConcurrentCompilers slots is free. Cancelling the returned future stops the compiler if it's running.
+   The file is compiled together with the \p importCandidates it imports from and uses the same cache key as in
+   \ref parseAsn1Files.
+ */
+QFuture<Asn1Reader::ParseResult> Asn1Reader::parseAsn1FileAsync(
+        const QFileInfo &fileInfo, const QList<QFileInfo> &importCandidates)
+{
+    auto job = QSharedPointer<CompilerJob>::create();
+    job->asn1FileName = fileInfo.absoluteFilePath();
+    job->importCandidates = absoluteFilePaths(importCandidates);
+    job->importCandidates.removeAll(job->asn1FileName);
+    job->result.reportStarted();
+    const QFuture<ParseResult> future = job->result.future();
+
+    if (!fileInfo.exists()) {
+        job->errorMessages.append(tr("ASN.1 file %1 does not exist").arg(job->asn1FileName));
+        finishJob(job);
+        return future;
+    }
+
+    /// Hashing reads the whole file, so it's done on the thread pool as well
+    m_hashingJobs.append(job);
+    job->hashing = QtConcurrent::run([job]() {
+        QHash<QString, QStringList> dependencies;
+        const QStringList hashedFiles = job->importCandidates + QStringList { job->asn1FileName };
+        job->cacheKeys = dependencyAwareHashes(hashedFiles, &dependencies);
+        job->compiledFiles = dependencies.value(job->asn1FileName) + QStringList { job->asn1FileName };
+        job->cacheFileName = cachedXmlFileName(job->cacheKeys.value(job->asn1FileName));
+        job->cached = QFile::exists(job->cacheFileName);
+    });
+    auto watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this, [this, job, watcher]() {
+        watcher->deleteLater();
+        onHashFinished(job);
+    });
+    watcher->setFuture(job->hashing);
+    return future;
+}
+
+/*!
+   Starts parsing all \p fileInfos, see \ref parseAsn1FileAsync. The futures are in the order of the files.
+ */
+QList<QFuture<Asn1Reader::ParseResult>> Asn1Reader::parseAsn1FilesAsync(const QList<QFileInfo> &fileInfos)
+{
+    QList<QFuture<ParseResult>> futures;
+    futures.reserve(fileInfos.size());
+    for (const QFileInfo &fileInfo : fileInfos) {
+        futures.append(parseAsn1FileAsync(fileInfo));
+    }
+    return futures;
+}
+
+/*!
+   Returns the maximum number of asn1scc processes run at the same time. Defaults to the number of cores.
+ */
+int Asn1Reader::maxConcurrentCompilers() const
+{
+    return m_maxConcurrentCompilers;
+}
+
+void Asn1Reader::setMaxConcurrentCompilers(int count)
+{
+    m_maxConcurrentCompilers = qMax(1, count);
+    startQueuedJobs();
+}
+
+/*!
+   Returns the number of asynchronous jobs hashing their file, waiting for or running the asn1scc compiler
+ */
+int Asn1Reader::pendingJobsCount() const
+{
+    return m_hashingJobs.size() + m_queuedJobs.size() + m_runningJobs.size();
+}
+
+/*!
+   Cancels all asynchronous jobs waiting for or running the asn1scc compiler
+ */
+void Asn1Reader::cancelAll()
+{
+    const QList<QSharedPointer<CompilerJob>> hashing = m_hashingJobs;
+    m_hashingJobs.clear();
+    for (const QSharedPointer<CompilerJob> &job : hashing) {
+        job->hashing.waitForFinished();
+        job->result.cancel();
+        finishJob(job);
+    }
+
+    while (!m_queuedJobs.isEmpty()) {
+        QSharedPointer<CompilerJob> job = m_queuedJobs.dequeue();
+        job->result.cancel();
+        finishJob(job);
+    }
+
+    const QList<QSharedPointer<CompilerJob>> running = m_runningJobs;
+    m_runningJobs.clear();
+    for (const QSharedPointer<CompilerJob> &job : running) {
+        job->result.cancel();
+        if (job->process) {
+            job->process->disconnect(this);
+            job->process->kill();
+            job->process->waitForFinished();
+            job->process->deleteLater();
+        }
+        QFile::remove(job->tempXmlFileName);
+        finishJob(job);
+    }
+}
+
+/*!
+   Sets the command used to run the asn1 compiler, overriding the one from the settings.
+   The name of the xml output file and the asn.1 file name are appended to \p command.
+   An empty command restores the default.
+ */
+void Asn1Reader::setCompilerCommand(const QString &command)
+{
+    m_compilerCommand = command;
+}
+
+/*!
+   Continues \p job once the hash of its file is known: parses the cached xml or queues the compiler run
+ */
+void Asn1Reader::onHashFinished(const QSharedPointer<CompilerJob> &job)
+{
+    if (!m_hashingJobs.removeOne(job)) {
+        return;
+    }
+
+    if (job->result.isCanceled()) {
+        finishJob(job);
+    } else if (job->cached) {
+        startParsing(job);
+    } else {
+        m_queuedJobs.enqueue(job);
+        startQueuedJobs();
+    }
+}
+
+void Asn1Reader::startQueuedJobs()
+{
+    while (m_runningJobs.size() < m_maxConcurrentCompilers && !m_queuedJobs.isEmpty()) {
+        QSharedPointer<CompilerJob> job = m_queuedJobs.dequeue();
+        if (job->result.isCanceled()) {
+            finishJob(job);
+            continue;
+        }
+        startCompiler(job);
+    }
+}
+
+void Asn1Reader::startCompiler(const QSharedPointer<CompilerJob> &job)
+{
+    const QString command = compilerCommand();
+    if (command.isEmpty()) {
+        job->errorMessages.append(
+                tr("ASN1 parse error: Unable to run the asn1scc compiler. https://github.com/ttsiodras/asn1scc"));
+        finishJob(job);
+        return;
+    }
+
+    job->tempXmlFileName = temporaryFileName("asn1", "xml");
+    auto process = new QProcess(this);
+    job->process = process;
+    m_runningJobs.append(job);
+
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            [this, job](int, QProcess::ExitStatus exitStatus) {
+                onCompilerFinished(job, exitStatus == QProcess::CrashExit);
+            });
+    connect(process, &QProcess::errorOccurred, this, [this, job](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            onCompilerFinished(job, true);
+        }
+    });
+
+    /// Stop the compiler as soon as the caller is not interested in the result anymore
+    auto watcher = new QFutureWatcher<ParseResult>(process);
+    connect(watcher, &QFutureWatcher<ParseResult>::canceled, process, &QProcess::kill);
+    watcher->setFuture(job->result.future());
+
+    process->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
+    process->setProcessChannelMode(QProcess::MergedChannels);
+    if (shared::Trace::isEnabled()) {
+        job->traceBegin = shared::Trace::timestamp();
+    }
+    QStringList quotedFileNames;
+    for (const QString &fileName : qAsConst(job->compiledFiles)) {
+        quotedFileNames.append("\"" + fileName + "\"");
+    }
+    process->start(QString(command + "%1 %2").arg(job->tempXmlFileName, quotedFileNames.join(' ')));
+}
+
+void Asn1Reader::onCompilerFinished(const QSharedPointer<CompilerJob> &job, bool crashed)
+{
+    if (!m_runningJobs.removeOne(job)) {
+        return;
+    }
+    if (job->traceBegin >= 0) {
+        shared::Trace::addAsyncSpan("asn1", "asn1scc", job->traceBegin, shared::Trace::timestamp(), job->asn1FileName);
+    }
+
+    QProcess *process = job->process;
+    const QByteArray output = process ? process->readAll() : QByteArray();
+    if (process) {
+        if (crashed && process->error() == QProcess::FailedToStart) {
+            job->errorMessages.append(process->errorString());
+        }
+        process->deleteLater();
+    }
+
+    if (job->result.isCanceled()) {
+        QFile::remove(job->tempXmlFileName);
+        finishJob(job);
+    } else if (crashed && job->errorMessages.isEmpty()) {
+        job->errorMessages.append(tr("asn1scc compiler process crashed"));
+        QFile::remove(job->tempXmlFileName);
+        finishJob(job);
+    } else if (!output.isEmpty() || !job->errorMessages.isEmpty()) {
+        job->errorMessages.append(QString::fromUtf8(output));
+        QFile::remove(job->tempXmlFileName);
+        finishJob(job);
+    } else if (job->compiledFiles.size() > 1) {
+        /// The xml of several files is split on the thread pool
+        startParsing(job);
+    } else {
+        QDir().mkpath(QFileInfo(job->cacheFileName).absolutePath());
+        QFile::remove(cachedBinaryFileName(job->cacheFileName));
+        if (!QFile::rename(job->tempXmlFileName, job->cacheFileName)) {
+            /// Another job for the same content was faster
+            QFile::remove(job->tempXmlFileName);
+        }
+        startParsing(job);
+    }
+
+    startQueuedJobs();
+}
+
+/*!
+   Reports the result of \p job without a parsed file
+ */
+void Asn1Reader::finishJob(const QSharedPointer<CompilerJob> &job)
+{
+    job->result.reportResult(ParseResult { job->asn1FileName, {}, job->errorMessages });
+    job->result.reportFinished();
+}
+
+/*!
+   Parses the cached xml of \p job on the global thread pool.
+   If several files were compiled, their xml is split into the cached xml of each file first.
+ */
+void Asn1Reader::startParsing(const QSharedPointer<CompilerJob> &job)
+{
+    QtConcurrent::run([job]() {
+        ParseResult result { job->asn1FileName, {}, job->errorMessages };
+        if (job->compiledFiles.size() > 1 && !job->tempXmlFileName.isEmpty()) {
+            if (!job->result.isCanceled()) {
+                splitCompiledXml(job->tempXmlFileName, job->compiledFiles, job->cacheKeys, &result.errorMessages);
+            }
+            QFile::remove(job->tempXmlFileName);
+        }
+        if (!job->result.isCanceled()) {
+            const QStringList fileNames { QFileInfo(job->asn1FileName).fileName(),
+                QFileInfo(job->cacheFileName).fileName() };
+            result.file = QSharedPointer<Asn1Acn::File>(
+                    readCachedFile(job->cacheFileName, fileNames, &result.errorMessages).release());
+        }
+        job->result.reportResult(result);
+        job->result.reportFinished();
+    });
+}
+
+/*!
+   Reads the asn1scc xml from \p reader, \p sourceName is used for error messages.
+   If the xml contains several files, the first one of \p fileNames found is returned.
+ */
+std::unique_ptr<Asn1Acn::File> Asn1Reader::readXml(
+        QXmlStreamReader &reader, const QString &sourceName, const QStringList &fileNames, QStringList *errors)
+{
+    SC_TRACE_SCOPE("asn1", "Asn1Reader::readXml", sourceName);
     Asn1Acn::AstXmlParser parser(reader);
     const bool ok = parser.parse();
     if (!ok) {
-        Q_EMIT parseError(tr("Error parsing the asn1 file %1").arg(fileName));
+        errors->append(tr("Error parsing the asn1 file %1").arg(sourceName));
     }
     std::map<QString, std::unique_ptr<Asn1Acn::File>> data = parser.takeData();
     if (data.empty()) {
-        Q_EMIT parseError(tr("Invalid XML format"));
+        errors->append(tr("Invalid XML format"));
         return {};
     }
 
@@ -196,13 +593,222 @@ std::unique_ptr<File> Asn1Reader::parseAsn1XmlContent(const QString &xmlContent,
         return std::move(data.begin()->second);
     }
 
-    if (data.find(fileInfo.fileName()) != data.end()) {
-        return std::move(data[fileInfo.fileName()]);
+    for (const QString &fileName : fileNames) {
+        auto it = data.find(fileName);
+        if (it != data.end()) {
+            return std::move(it->second);
+        }
     }
 
     return {};
 }
 
+/*!
+   Returns the absolute paths of the existing files of \p fileInfos
+ */
+QStringList Asn1Reader::absoluteFilePaths(const QList<QFileInfo> &fileInfos)
+{
+    QStringList fileNames;
+    for (const QFileInfo &fileInfo : fileInfos) {
+        if (fileInfo.exists() && !fileNames.contains(fileInfo.absoluteFilePath())) {
+            fileNames.append(fileInfo.absoluteFilePath());
+        }
+    }
+    return fileNames;
+}
+
+/*!
+   Returns the cache keys of the asn.1 files \p fileNames (absolute paths). A file importing no module defined by
+   another file of the set uses the hash of its content, like a single parsed file. Otherwise the hashes of the
+   imported files are part of the key.
+   The files each file imports (directly or not) are stored in \p dependencies.
+ */
+QHash<QString, QByteArray> Asn1Reader::dependencyAwareHashes(
+        const QStringList &fileNames, QHash<QString, QStringList> *dependencies)
+{
+    static const QRegularExpression commentsRx(R"((/\*.*?\*/)|(--.*?(--|$)))",
+            QRegularExpression::DotMatchesEverythingOption | QRegularExpression::MultilineOption);
+    static const QRegularExpression definitionRx(R"(([A-Z][\w-]*)\s*(\{[^}]*\})?\s*DEFINITIONS)");
+    static const QRegularExpression importsRx(R"(\bIMPORTS\b(.*?);)", QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression fromRx(R"(\bFROM\s+([A-Z][\w-]*))");
+
+    QHash<QString, QByteArray> contentHashes;
+    QHash<QString, QString> moduleFiles;
+    QHash<QString, QStringList> importedModules;
+    for (const QString &fileName : fileNames) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const QByteArray content = file.readAll();
+        contentHashes[fileName] = QCryptographicHash::hash(content, QCryptographicHash::Md5).toHex();
+
+        const QString text = QString::fromUtf8(content).remove(commentsRx);
+        QRegularExpressionMatchIterator it = definitionRx.globalMatch(text);
+        while (it.hasNext()) {
+            moduleFiles[it.next().captured(1)] = fileName;
+        }
+        it = importsRx.globalMatch(text);
+        while (it.hasNext()) {
+            QRegularExpressionMatchIterator fromIt = fromRx.globalMatch(it.next().captured(1));
+            while (fromIt.hasNext()) {
+                importedModules[fileName].append(fromIt.next().captured(1));
+            }
+        }
+    }
+
+    QHash<QString, QByteArray> keys;
+    for (const QString &fileName : fileNames) {
+        QStringList closure;
+        QStringList toVisit { fileName };
+        while (!toVisit.isEmpty()) {
+            const QString current = toVisit.takeLast();
+            for (const QString &module : importedModules.value(current)) {
+                const QString importedFile = moduleFiles.value(module);
+                if (!importedFile.isEmpty() && importedFile != fileName && !closure.contains(importedFile)) {
+                    closure.append(importedFile);
+                    toVisit.append(importedFile);
+                }
+            }
+        }
+
+        if (closure.isEmpty()) {
+            keys[fileName] = contentHashes.value(fileName);
+        } else {
+            QStringList hashes;
+            for (const QString &importedFile : qAsConst(closure)) {
+                hashes.append(QString::fromLatin1(contentHashes.value(importedFile)));
+            }
+            hashes.sort();
+            const QByteArray combined = contentHashes.value(fileName) + hashes.join(QString()).toLatin1();
+            keys[fileName] = QCryptographicHash::hash(combined, QCryptographicHash::Md5).toHex();
+        }
+        if (dependencies) {
+            dependencies->insert(fileName, closure);
+        }
+    }
+    return keys;
+}
+
+/*!
+   Splits the asn1scc xml \p xmlFileName generated for the files \p fileNames into one xml document per asn.1 file.
+   Each document is stored as cached xml of its file, using \p cacheKeys.
+ */
+void Asn1Reader::splitCompiledXml(const QString &xmlFileName, const QStringList &fileNames,
+        const QHash<QString, QByteArray> &cacheKeys, QStringList *errors)
+{
+    QFile xmlFile(xmlFileName);
+    if (!xmlFile.open(QIODevice::ReadOnly)) {
+        errors->append(xmlFile.errorString());
+        return;
+    }
+
+    QXmlStreamReader reader(&xmlFile);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (!reader.isStartElement() || reader.name() != QLatin1String("Asn1File")) {
+            continue;
+        }
+
+        /// asn1scc writes the file name as it was passed, match it by path or by name only
+        const QString compiledName = reader.attributes().value(QLatin1String("FileName")).toString();
+        const QFileInfo compiledInfo(compiledName);
+        QString sourceFile;
+        for (const QString &fileName : fileNames) {
+            if (compiledInfo.isAbsolute() ? compiledInfo.absoluteFilePath() == fileName
+                                          : compiledInfo.fileName() == QFileInfo(fileName).fileName()) {
+                sourceFile = fileName;
+                break;
+            }
+        }
+
+        QByteArray part;
+        QXmlStreamWriter writer(&part);
+        writer.writeStartDocument();
+        writer.writeStartElement(QLatin1String("ASN1AST"));
+        int depth = 0;
+        do {
+            if (reader.isStartElement()) {
+                ++depth;
+            } else if (reader.isEndElement()) {
+                --depth;
+            }
+            writer.writeCurrentToken(reader);
+        } while (depth > 0 && !reader.atEnd() && reader.readNext() != QXmlStreamReader::Invalid);
+        writer.writeEndElement();
+        writer.writeEndDocument();
+
+        if (sourceFile.isEmpty() || !cacheKeys.contains(sourceFile)) {
+            continue;
+        }
+
+        const QString cacheFileName = cachedXmlFileName(cacheKeys.value(sourceFile));
+        QDir().mkpath(QFileInfo(cacheFileName).absolutePath());
+        const QString tempFileName = temporaryFileName("asn1", "xml");
+        QFile tempFile(tempFileName);
+        if (!tempFile.open(QIODevice::WriteOnly) || tempFile.write(part) != part.size()) {
+            errors->append(tempFile.errorString());
+            continue;
+        }
+        tempFile.close();
+        QFile::remove(cacheFileName);
+        QFile::remove(cachedBinaryFileName(cacheFileName));
+        if (!QFile::rename(tempFileName, cacheFileName)) {
+            QFile::remove(tempFileName);
+        }
+    }
+
+    if (reader.hasError()) {
+        errors->append(tr("Error parsing the asn1 file %1").arg(xmlFileName));
+    }
+}
+
+QString Asn1Reader::cachedXmlFileName(const QByteArray &hash)
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/asn/" + hash + ".xml";
+}
+
+/*!
+   Returns the name of the binary AST stored next to the cached xml \p xmlFileName
+ */
+QString Asn1Reader::cachedBinaryFileName(const QString &xmlFileName)
+{
+    const QFileInfo xmlInfo(xmlFileName);
+    return xmlInfo.absolutePath() + "/" + xmlInfo.completeBaseName() + ".ast";
+}
+
+/*!
+   Reads the cached xml \p cacheFileName, see \ref readXml.
+   The binary AST next to it is used if it's valid, otherwise it's (re)created from the xml.
+ */
+std::unique_ptr<Asn1Acn::File> Asn1Reader::readCachedFile(
+        const QString &cacheFileName, const QStringList &fileNames, QStringList *errors)
+{
+    const QString binaryFileName = cachedBinaryFileName(cacheFileName);
+    std::unique_ptr<Asn1Acn::File> data = AstBinaryCache::read(binaryFileName);
+    if (data) {
+        return data;
+    }
+
+    QFile file(cacheFileName);
+    if (!file.exists()) {
+        errors->append(tr("File not found"));
+        return {};
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        errors->append(file.errorString());
+        return {};
+    }
+
+    QXmlStreamReader reader(&file);
+    const int errorCount = errors->size();
+    data = readXml(reader, cacheFileName, fileNames, errors);
+    if (data && errors->size() == errorCount) {
+        AstBinaryCache::write(*data, binaryFileName);
+    }
+    return data;
+}
+
 /*!
    Returns the asn.1 file \p filename as HTML representation
  */
@@ -240,8 +846,11 @@ QString Asn1Reader::asn1AsHtml(const QString &filename) const
 #ifdef Q_OS_WIN
         QString cmd = QString("asn1 -customStg \"%1::%2 %3\"").arg(prettyPrintFileName, asn1HtmlFileName, filename);
 #else
+        QMutexLocker locker(&m_staticDataMutex);
+        const QString mono = m_mono;
+        locker.unlock();
         QString cmd = QString("%1 %2 -customIcdUper %3::%4 %5")
-                              .arg(m_mono, asn1Compiler, prettyPrintFileName, asn1HtmlFileName, filename);
+                              .arg(mono, asn1Compiler, prettyPrintFileName, asn1HtmlFileName, filename);
 #endif
         QProcess process;
         process.setProcessEnvironment(QProcessEnvironment::systemEnvironment());
@@ -298,9 +907,12 @@ QString Asn1Reader::checkforCompiler() const
 
     process.start(QString("which mono"));
     process.waitForFinished();
-    m_mono = process.readAll();
-    m_mono.remove('\n');
-    if (m_mono.isEmpty()) {
+    QString mono = process.readAll();
+    mono.remove('\n');
+    QMutexLocker locker(&m_staticDataMutex);
+    m_mono = mono;
+    locker.unlock();
+    if (mono.isEmpty()) {
         qWarning() << tr("Unable to find the mono framework to run the asn1scc compiler");
         return {};
     }
@@ -314,6 +926,26 @@ QString Asn1Reader::defaultParameter() const
     return Asn1Acn::defaultParameter;
 }
 
+/*!
+   Returns the command to run asn1scc. Unless set by \ref setCompilerCommand, it is built from the settings.
+   The command is kept as long as the compiler settings don't change, as finding the compiler is expensive
+ */
+QString Asn1Reader::compilerCommand()
+{
+    if (!m_compilerCommand.isEmpty()) {
+        return m_compilerCommand;
+    }
+
+    QSettings settings;
+    const QStringList compilerSettings { settings.value("SpaceCreator/asn1compiler").toString(),
+        settings.value("SpaceCreator/asn1compilerparameter").toString() };
+    if (compilerSettings != m_compilerSettings || m_settingsCompilerCommand.isEmpty()) {
+        m_compilerSettings = compilerSettings;
+        m_settingsCompilerCommand = asn1CompilerCommand();
+    }
+    return m_settingsCompilerCommand;
+}
+
 QString Asn1Reader::asn1CompilerCommand() const
 {
     QSettings settings;
@@ -331,10 +963,13 @@ QString Asn1Reader::asn1CompilerCommand() const
     if (!asn1Compiler.isEmpty()) {
         QFileInfo asnFile(asn1Compiler);
         const QString param = parameter.contains("%1") ? parameter.arg(asnFile.path()) : parameter;
-        if (m_mono.isEmpty()) {
+        QMutexLocker locker(&m_staticDataMutex);
+        const QString mono = m_mono;
+        locker.unlock();
+        if (mono.isEmpty()) {
             return QString("%1 %2").arg(asn1Compiler, param);
         } else {
-            return QString("%1 %2 %3").arg(m_mono, asn1Compiler, param);
+            return QString("%1 %2 %3").arg(mono, asn1Compiler, param);
         }
     } else {
         qWarning() << "No asn1scc compiler found";
@@ -342,13 +977,13 @@ QString Asn1Reader::asn1CompilerCommand() const
     }
 }
 
-QString Asn1Reader::temporaryFileName(const QString &basename, const QString &suffix) const
+QString Asn1Reader::temporaryFileName(const QString &basename, const QString &suffix)
 {
     quint32 value = QRandomGenerator::securelySeeded().generate();
     return QDir::tempPath() + QDir::separator() + QString("%1_%2.%3").arg(basename).arg(value).arg(suffix);
 }
 
-QByteArray Asn1Reader::fileHash(const QString &fileName) const
+QByteArray Asn1Reader::fileHash(const QString &fileName)
 {
     QFile file(fileName);
     if (file.open(QIODevice::ReadOnly)) {
@@ -361,7 +996,17 @@ QByteArray Asn1Reader::fileHash(const QString &fileName) const
 
 bool Asn1Reader::convertToXML(const QString &asn1FileName, const QString &xmlFilename, QStringList *errorMessages) const
 {
-    QString cmd = asn1CompilerCommand();
+    return convertToXML(QStringList { asn1FileName }, xmlFilename, errorMessages);
+}
+
+/*!
+   Compiles all \p asn1FileNames with one asn1scc invocation into the xml file \p xmlFilename
+ */
+bool Asn1Reader::convertToXML(
+        const QStringList &asn1FileNames, const QString &xmlFilename, QStringList *errorMessages) const
+{
+    SC_TRACE_SCOPE("asn1", "asn1scc", asn1FileNames.join(' '));
+    QString cmd = m_compilerCommand.isEmpty() ? asn1CompilerCommand() : m_compilerCommand;
     if (cmd.isEmpty()) {
         if (errorMessages)
             errorMessages->append(
@@ -370,7 +1015,11 @@ bool Asn1Reader::convertToXML(const QString &asn1FileName, const QString &xmlFil
     }
     QString asn1Command = cmd + "%1 %2";
 
-    QString asn1FileNameParameter = "\"" + asn1FileName + "\"";
+    QStringList quotedFileNames;
+    for (const QString &asn1FileName : asn1FileNames) {
+        quotedFileNames.append("\"" + asn1FileName + "\"");
+    }
+    const QString asn1FileNameParameter = quotedFileNames.join(' ');
     QString asn1XMLFileName = temporaryFileName("asn1", "xml");
 
     QProcess asn1Process;
@@ -18,11 +18,18 @@
 #pragma once
 
 #include <QCache>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
 #include <QObject>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QStringList>
+#include <map>
 #include <memory>
 
 class QFileInfo;
-class QStringList;
+class QXmlStreamReader;
 
 namespace Asn1Acn {
 class File;
@@ -30,9 +37,16 @@ class File;
 /*!
    Class to parse ASN.1 files and return the result as Asn1Acn::File object.
 
-   If the source is a file, the converted xml is cached in the the application's cache directory.
+   If the source is a file, the converted xml is cached in the the application's cache directory. A binary copy of
+   the parsed AST is stored next to it (see Asn1Acn::AstBinaryCache) and used instead of the xml when it's valid.
    If the source is a text, the converted xml is cached in memory.
 
+   The parseAsn1FileAsync functions don't block the caller: up to \ref maxConcurrentCompilers asn1scc processes run
+   at once, the resulting xml is parsed on the global thread pool and the result is delivered through a QFuture.
+
+   parseAsn1Files compiles a set of files importing each other with a single asn1scc run and caches the result
+   per file.
+
    \note uses the program asn1scc for converting to xml https://github.com/ttsiodras/asn1scc
  */
 class Asn1Reader : public QObject
@@ -40,16 +54,39 @@ class Asn1Reader : public QObject
     Q_OBJECT
 
 public:
+    /*!
+       Result of an asynchronous parse of the asn.1 file \a fileName (absolute path).
+       \a file is null if an error occurred or the job was cancelled.
+     */
+    struct ParseResult {
+        QString fileName;
+        QSharedPointer<Asn1Acn::File> file;
+        QStringList errorMessages;
+    };
+
     Asn1Reader(QObject *parent = nullptr);
+    ~Asn1Reader() override;
 
     std::unique_ptr<Asn1Acn::File> parseAsn1File(const QFileInfo &fileInfo, QStringList *errorMessages);
     std::unique_ptr<Asn1Acn::File> parseAsn1File(
             const QString &filePath, const QString &fileName, QStringList *errorMessages);
     std::unique_ptr<Asn1Acn::File> parseAsn1File(
             const QString &fileName, QStringList *errorMessages, const QString &content);
+    std::map<QString, std::unique_ptr<Asn1Acn::File>> parseAsn1Files(const QList<QFileInfo> &fileInfos,
+            QStringList *errorMessages, const QList<QFileInfo> &importCandidates = {});
     std::unique_ptr<Asn1Acn::File> parseAsn1XmlFile(const QString &fileName);
     std::unique_ptr<Asn1Acn::File> parseAsn1XmlContent(const QString &xmlContent, const QString &fileName);
 
+    QFuture<ParseResult> parseAsn1FileAsync(const QFileInfo &fileInfo, const QList<QFileInfo> &importCandidates = {});
+    QList<QFuture<ParseResult>> parseAsn1FilesAsync(const QList<QFileInfo> &fileInfos);
+
+    int maxConcurrentCompilers() const;
+    void setMaxConcurrentCompilers(int count);
+    int pendingJobsCount() const;
+    void cancelAll();
+
+    void setCompilerCommand(const QString &command);
+
     QString asn1AsHtml(const QString &filename) const;
 
     QString checkforCompiler() const;
@@ -60,15 +97,48 @@ Q_SIGNALS:
     void parseError(const QString &error);
 
 private:
+    struct CompilerJob;
+
+    void onHashFinished(const QSharedPointer<CompilerJob> &job);
+    void startQueuedJobs();
+    void startCompiler(const QSharedPointer<CompilerJob> &job);
+    void onCompilerFinished(const QSharedPointer<CompilerJob> &job, bool crashed);
+    static void finishJob(const QSharedPointer<CompilerJob> &job);
+    static void startParsing(const QSharedPointer<CompilerJob> &job);
+    static std::unique_ptr<Asn1Acn::File> readXml(
+            QXmlStreamReader &reader, const QString &sourceName, const QStringList &fileNames, QStringList *errors);
+    static QString cachedXmlFileName(const QByteArray &hash);
+    static QString cachedBinaryFileName(const QString &xmlFileName);
+    static std::unique_ptr<Asn1Acn::File> readCachedFile(
+            const QString &cacheFileName, const QStringList &fileNames, QStringList *errors);
+    static QStringList absoluteFilePaths(const QList<QFileInfo> &fileInfos);
+    static QHash<QString, QByteArray> dependencyAwareHashes(
+            const QStringList &fileNames, QHash<QString, QStringList> *dependencies);
+    static void splitCompiledXml(const QString &xmlFileName, const QStringList &fileNames,
+            const QHash<QString, QByteArray> &cacheKeys, QStringList *errors);
+
+    QString compilerCommand();
     QString asn1CompilerCommand() const;
-    QString temporaryFileName(const QString &basename, const QString &suffix) const;
+    static QString temporaryFileName(const QString &basename, const QString &suffix);
 
-    QByteArray fileHash(const QString &fileName) const;
+    static QByteArray fileHash(const QString &fileName);
     bool convertToXML(const QString &asn1FileName, const QString &xmlFilename, QStringList *errorMessages) const;
+    bool convertToXML(const QStringList &asn1FileNames, const QString &xmlFilename, QStringList *errorMessages) const;
+
+    QString m_compilerCommand;
+    /// Command built from the settings, it's valid as long as the settings equal m_compilerSettings
+    QString m_settingsCompilerCommand;
+    QStringList m_compilerSettings;
+    int m_maxConcurrentCompilers;
+    QList<QSharedPointer<CompilerJob>> m_hashingJobs;
+    QQueue<QSharedPointer<CompilerJob>> m_queuedJobs;
+    QList<QSharedPointer<CompilerJob>> m_runningJobs;
 
     static QString m_mono;
 
     static QCache<QString, QString> m_cache;
+    /// Guards m_mono and m_cache, as parseAsn1File() may run on several threads at once
+    static QMutex m_staticDataMutex;
 };
 
 }
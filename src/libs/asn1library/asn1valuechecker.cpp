@@ -0,0 +1,395 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "asn1valuechecker.h"
+
+#include "asn1const.h"
+#include "typeassignment.h"
+#include "types/type.h"
+#include "types/userdefinedtype.h"
+
+#include <QStringList>
+#include <QStringView>
+#include <QVariant>
+#include <algorithm>
+
+namespace Asn1Acn {
+
+static QStringView textView(const QString &text, int begin, int end)
+{
+    return QStringView(text.constData() + begin, end - begin);
+}
+
+static void trim(const QString &text, int &begin, int &end)
+{
+    while (begin < end && text.at(begin).isSpace()) {
+        ++begin;
+    }
+    while (end > begin && text.at(end - 1).isSpace()) {
+        --end;
+    }
+}
+
+static int indexOf(const QString &text, QChar character, int begin, int end)
+{
+    for (int idx = begin; idx < end; ++idx) {
+        if (text.at(idx) == character) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+/*!
+   Returns the end of the value starting at \p begin. Same as Asn1ValueParser::nextIndex, but the returned index is
+   absolute and never behind \p end
+ */
+static int nextIndex(const QString &text, int begin, int end)
+{
+    if (begin < end && text.at(begin) == QLatin1Char('{')) {
+        int countBracket = 0;
+        int idx = begin;
+        for (; idx < end; ++idx) {
+            if (text.at(idx) == QLatin1Char('{')) {
+                ++countBracket;
+            } else if (text.at(idx) == QLatin1Char('}')) {
+                --countBracket;
+            }
+            if (countBracket == 0) {
+                break;
+            }
+        }
+        return qMin(idx + 1, end);
+    }
+
+    const int comma = indexOf(text, QLatin1Char(','), begin, end);
+    return comma == -1 ? end : comma;
+}
+
+static bool isBraced(const QString &text, int begin, int end)
+{
+    return begin < end && text.at(begin) == QLatin1Char('{') && text.at(end - 1) == QLatin1Char('}');
+}
+
+struct Asn1ValueChecker::Node {
+    enum Kind
+    {
+        Invalid,
+        Integer,
+        Real,
+        Boolean,
+        Sequence,
+        SequenceOf,
+        Enumerated,
+        Choice,
+        AnyValue,
+        Text
+    };
+
+    void setRange(const QVariantMap &parameters)
+    {
+        hasMin = parameters.contains(ASN1_MIN);
+        min = parameters.value(ASN1_MIN).toDouble();
+        hasMax = parameters.contains(ASN1_MAX);
+        max = parameters.value(ASN1_MAX).toDouble();
+    }
+
+    bool inRange(double value) const { return !(hasMin && value < min) && !(hasMax && value > max); }
+
+    /*!
+       Returns the checker of the field \p name. The names are looked up by hash, so no string has to be created
+     */
+    const Node *member(QStringView name) const
+    {
+        const uint hash = qHash(name);
+        for (auto it = memberIndex.constFind(hash); it != memberIndex.cend() && it.key() == hash; ++it) {
+            const std::pair<QString, const Node *> &entry = members.at(it.value());
+            if (QStringView(entry.first) == name) {
+                return entry.second;
+            }
+        }
+        return nullptr;
+    }
+
+    /*!
+       Adds the field \p name, if it was not added before. Like in Asn1ValueParser::getType the first match wins
+     */
+    void addMember(const QString &name, const Node *node)
+    {
+        if (member(QStringView(name))) {
+            return;
+        }
+        memberIndex.insert(qHash(QStringView(name)), int(members.size()));
+        members.emplace_back(name, node);
+    }
+
+    Kind kind = Invalid;
+    bool hasMin = false;
+    bool hasMax = false;
+    double min = 0.;
+    double max = 0.;
+    QStringList values;
+    const Node *element = nullptr;
+    std::vector<std::pair<QString, const Node *>> members;
+    QMultiHash<uint, int> memberIndex;
+};
+
+Asn1ValueChecker::Asn1ValueChecker(const Types::Type *type)
+{
+    QHash<const Types::Type *, Node *> compiled;
+    m_root = compile(type, compiled);
+}
+
+Asn1ValueChecker::~Asn1ValueChecker() { }
+
+/*!
+   Returns if \p value is a valid value of the type this checker was created for
+ */
+bool Asn1ValueChecker::isValid(const QString &value) const
+{
+    return check(m_root, value, 0, value.size());
+}
+
+Asn1ValueChecker::Node *Asn1ValueChecker::compile(
+        const Types::Type *type, QHash<const Types::Type *, Node *> &compiled)
+{
+    auto it = compiled.constFind(type);
+    if (it != compiled.constEnd()) {
+        return it.value();
+    }
+
+    // In case of user types, use the referenced type
+    if (type && type->typeEnum() == Types::Type::USERDEFINED) {
+        auto userType = dynamic_cast<const Types::UserdefinedType *>(type);
+        if (userType && userType->referencedType()) {
+            Node *node = compile(userType->referencedType()->type(), compiled);
+            compiled.insert(type, node);
+            return node;
+        }
+    }
+
+    m_nodes.push_back(std::make_unique<Node>());
+    Node *node = m_nodes.back().get();
+    /// Registered before the children are compiled, so recursive types end up in the same node
+    compiled.insert(type, node);
+    if (!type) {
+        return node;
+    }
+
+    const QVariantMap &parameters = type->parameters();
+    node->setRange(parameters);
+
+    switch (type->typeEnum()) {
+    case Types::Type::INTEGER:
+        node->kind = Node::Integer;
+        break;
+    case Types::Type::REAL:
+        node->kind = Node::Real;
+        break;
+    case Types::Type::BOOLEAN:
+        node->kind = Node::Boolean;
+        break;
+    case Types::Type::SEQUENCE:
+        node->kind = Node::Sequence;
+        addMembers(node, type, compiled);
+        break;
+    case Types::Type::SEQUENCEOF:
+        node->kind = Node::SequenceOf;
+        node->element = type->children().empty() ? node : compile(type->children().front().get(), compiled);
+        break;
+    case Types::Type::ENUMERATED:
+        node->kind = Node::Enumerated;
+        node->values = parameters.value(ASN1_VALUES).toStringList();
+        break;
+    case Types::Type::CHOICE:
+        node->kind = Node::Choice;
+        addMembers(node, type, compiled);
+        break;
+    case Types::Type::BITSTRING:
+    case Types::Type::IA5STRING:
+    case Types::Type::NUMERICSTRING:
+    case Types::Type::OCTETSTRING:
+        node->kind = Node::AnyValue;
+        break;
+    default:
+        node->kind = Node::Text;
+        break;
+    }
+
+    return node;
+}
+
+/*!
+   Adds all types below \p type to the field lookup table of \p node, in the order Asn1ValueParser::getType searches
+ */
+void Asn1ValueChecker::addMembers(Node *node, const Types::Type *type, QHash<const Types::Type *, Node *> &compiled)
+{
+    node->addMember(type->identifier(), compile(type, compiled));
+
+    if (type->typeEnum() == Types::Type::USERDEFINED) {
+        auto userType = dynamic_cast<const Types::UserdefinedType *>(type);
+        if (userType && userType->referencedType() && userType->referencedType()->type()) {
+            const Types::Type *referencedType = userType->referencedType()->type();
+            node->addMember(referencedType->identifier(), compile(referencedType, compiled));
+        }
+    }
+
+    for (const std::unique_ptr<Types::Type> &child : type->children()) {
+        addMembers(node, child.get(), compiled);
+    }
+}
+
+bool Asn1ValueChecker::check(const Node *node, const QString &text, int begin, int end) const
+{
+    if (begin >= end) {
+        return false;
+    }
+
+    trim(text, begin, end);
+
+    switch (node->kind) {
+    case Node::Integer: {
+        bool ok;
+        const int value = text.midRef(begin, end - begin).toInt(&ok);
+        return ok && node->inRange(value);
+    }
+    case Node::Real: {
+        bool ok;
+        const double value = text.midRef(begin, end - begin).toDouble(&ok);
+        return ok && node->inRange(value);
+    }
+    case Node::Boolean: {
+        const QStringView value = textView(text, begin, end);
+        return value == QStringView(u"TRUE") || value == QStringView(u"FALSE");
+    }
+    case Node::Sequence:
+        return checkSequence(node, text, begin, end);
+    case Node::SequenceOf:
+        return checkSequenceOf(node, text, begin, end);
+    case Node::Enumerated: {
+        const QStringView value = textView(text, begin, end);
+        return std::any_of(node->values.cbegin(), node->values.cend(),
+                [&value](const QString &enumValue) { return QStringView(enumValue) == value; });
+    }
+    case Node::Choice:
+        return checkChoice(node, text, begin, end);
+    case Node::AnyValue:
+        return true;
+    case Node::Text: {
+        // take string between " "
+        if (begin < end && text.at(begin) == QLatin1Char('"')) {
+            ++begin;
+        }
+        if (begin < end && text.at(end - 1) == QLatin1Char('"')) {
+            --end;
+        }
+        return node->inRange(end - begin);
+    }
+    case Node::Invalid:
+        break;
+    }
+
+    return false;
+}
+
+/*!
+   Checks a sequence value like "{ intVal 5, seqVal { iVal 5 } }"
+ */
+bool Asn1ValueChecker::checkSequence(const Node *node, const QString &text, int begin, int end) const
+{
+    if (!isBraced(text, begin, end)) {
+        return false;
+    }
+
+    // skip '{' at the begin and '}' at the end
+    ++begin;
+    if (end > begin) {
+        --end;
+    }
+    trim(text, begin, end);
+
+    int space;
+    while ((space = indexOf(text, QLatin1Char(' '), begin, end)) != -1) {
+        const Node *field = node->member(textView(text, begin, space));
+        begin = space;
+        trim(text, begin, end);
+
+        const int fieldEnd = nextIndex(text, begin, end);
+        if (!field || !check(field, text, begin, fieldEnd)) {
+            return false;
+        }
+
+        begin = fieldEnd;
+        trim(text, begin, end);
+        const int comma = indexOf(text, QLatin1Char(','), begin, end);
+        if (comma != -1) {
+            begin = comma + 1;
+            trim(text, begin, end);
+        }
+    }
+
+    return true;
+}
+
+/*!
+   Checks a sequence of value like "{ enum1, enum3 }" or "{ { intVal 5 }, { intVal 6 } }"
+ */
+bool Asn1ValueChecker::checkSequenceOf(const Node *node, const QString &text, int begin, int end) const
+{
+    if (!isBraced(text, begin, end)) {
+        return false;
+    }
+
+    // skip '{' at the begin and '}' at the end
+    ++begin;
+    if (end > begin) {
+        --end;
+    }
+    trim(text, begin, end);
+
+    int count = 0;
+    int itemEnd;
+    while ((itemEnd = nextIndex(text, begin, end)) != begin) {
+        if (!check(node->element, text, begin, itemEnd)) {
+            return false;
+        }
+        ++count;
+
+        begin = itemEnd;
+        trim(text, begin, end);
+        const int comma = indexOf(text, QLatin1Char(','), begin, end);
+        if (comma != -1) {
+            begin = comma + 1;
+            trim(text, begin, end);
+        }
+    }
+
+    return node->inRange(count);
+}
+
+/*!
+   Checks a choice value like "choiceReal : 10.5". As in Asn1ValueParser only the name of the choice is validated
+ */
+bool Asn1ValueChecker::checkChoice(const Node *node, const QString &text, int begin, int end) const
+{
+    const int colon = indexOf(text, QLatin1Char(':'), begin, end);
+    int nameEnd = colon == -1 ? end : colon;
+    trim(text, begin, nameEnd);
+    return node->member(textView(text, begin, nameEnd)) != nullptr;
+}
+
+}
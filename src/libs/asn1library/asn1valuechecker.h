@@ -0,0 +1,61 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <memory>
+#include <vector>
+
+namespace Asn1Acn {
+namespace Types {
+class Type;
+}
+
+/*!
+   \class Asn1Acn::Asn1ValueChecker
+   Checks ASN.1 values against one type without building the value maps of the Asn1ValueParser.
+
+   The type tree is compiled once in the constructor: user defined types are resolved, ranges and enumeration
+   values are extracted from the parameters and the field names of sequences and choices are put into lookup tables.
+   \ref isValid then only scans the value text, so one checker can be used for many values and from several threads.
+   The accepted values are the same as the ones accepted by Asn1ValueParser::parseAsn1Value.
+ */
+class Asn1ValueChecker
+{
+public:
+    explicit Asn1ValueChecker(const Types::Type *type);
+    ~Asn1ValueChecker();
+
+    bool isValid(const QString &value) const;
+
+private:
+    struct Node;
+
+    Node *compile(const Types::Type *type, QHash<const Types::Type *, Node *> &compiled);
+    void addMembers(Node *node, const Types::Type *type, QHash<const Types::Type *, Node *> &compiled);
+    bool check(const Node *node, const QString &text, int begin, int end) const;
+    bool checkSequence(const Node *node, const QString &text, int begin, int end) const;
+    bool checkSequenceOf(const Node *node, const QString &text, int begin, int end) const;
+    bool checkChoice(const Node *node, const QString &text, int begin, int end) const;
+
+    std::vector<std::unique_ptr<Node>> m_nodes;
+    const Node *m_root = nullptr;
+};
+
+}
@@ -0,0 +1,570 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "astbinarycache.h"
+
+#include "file.h"
+#include "types/builtintypes.h"
+#include "types/labeltype.h"
+#include "types/userdefinedtype.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QSaveFile>
+#include <QVector>
+
+namespace Asn1Acn {
+
+static const quint32 kMagic = 0x41534e42; // "ASNB"
+static const quint32 kFormatVersion = 1;
+static const QDataStream::Version kStreamVersion = QDataStream::Qt_5_12;
+static const quint8 kNoType = 0xff;
+
+enum ParameterTag : quint8
+{
+    LongLongParameter,
+    DoubleParameter,
+    StringListParameter,
+    VariantParameter
+};
+
+/*!
+   Position of a type assignment in a file: index of the definitions and index of the assignment in them
+ */
+using AssignmentIndex = QPair<qint32, qint32>;
+
+class AstBinaryWriter
+{
+public:
+    QByteArray write(const File &file)
+    {
+        for (int defIdx = 0; defIdx < int(file.definitionsList().size()); ++defIdx) {
+            const Definitions::Types &types = file.definitionsList().at(defIdx)->types();
+            for (int typeIdx = 0; typeIdx < int(types.size()); ++typeIdx) {
+                m_assignments.insert(types.at(typeIdx).get(), { defIdx, typeIdx });
+            }
+        }
+
+        QDataStream body(&m_body, QIODevice::WriteOnly);
+        body.setVersion(kStreamVersion);
+        m_stream = &body;
+        writeFile(file);
+
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(kStreamVersion);
+        out << kMagic << kFormatVersion << quint32(m_strings.size());
+        for (const QString &string : qAsConst(m_strings)) {
+            out << string.toUtf8();
+        }
+        data.append(m_body);
+        return data;
+    }
+
+private:
+    quint32 string(const QString &text)
+    {
+        auto it = m_stringIndexes.constFind(text);
+        if (it != m_stringIndexes.constEnd()) {
+            return it.value();
+        }
+        const quint32 idx = quint32(m_strings.size());
+        m_strings.append(text);
+        m_stringIndexes.insert(text, idx);
+        return idx;
+    }
+
+    void writeLocation(const SourceLocation &location)
+    {
+        *m_stream << string(location.path()) << qint32(location.line()) << qint32(location.column());
+    }
+
+    void writeFile(const File &file)
+    {
+        *m_stream << string(file.name());
+        writeLocation(file.location());
+        *m_stream << file.isPolluted();
+
+        *m_stream << quint32(file.definitionsList().size());
+        for (const std::unique_ptr<Definitions> &definitions : file.definitionsList()) {
+            writeDefinitions(*definitions);
+        }
+
+        *m_stream << quint32(file.references().size());
+        for (const std::unique_ptr<TypeReference> &reference : file.references()) {
+            *m_stream << string(reference->name()) << string(reference->module());
+            writeLocation(reference->location());
+        }
+
+        *m_stream << quint32(file.errors().size());
+        for (const ErrorMessage &error : file.errors()) {
+            writeLocation(error.location());
+            *m_stream << string(error.message());
+        }
+    }
+
+    void writeDefinitions(const Definitions &definitions)
+    {
+        *m_stream << string(definitions.name());
+        writeLocation(definitions.location());
+
+        *m_stream << quint32(definitions.types().size());
+        for (const std::unique_ptr<TypeAssignment> &assignment : definitions.types()) {
+            *m_stream << string(assignment->name());
+            writeLocation(assignment->location());
+            writeType(assignment->type());
+        }
+
+        *m_stream << quint32(definitions.values().size());
+        for (const std::unique_ptr<ValueAssignment> &assignment : definitions.values()) {
+            *m_stream << string(assignment->name());
+            writeLocation(assignment->location());
+            writeType(assignment->type());
+        }
+
+        *m_stream << quint32(definitions.importedTypes().size());
+        for (const ImportedType &imported : definitions.importedTypes()) {
+            *m_stream << string(imported.module()) << string(imported.name());
+        }
+
+        *m_stream << quint32(definitions.importedValues().size());
+        for (const ImportedValue &imported : definitions.importedValues()) {
+            *m_stream << string(imported.module()) << string(imported.name());
+        }
+    }
+
+    void writeType(const Types::Type *type)
+    {
+        if (!type) {
+            *m_stream << kNoType;
+            return;
+        }
+
+        *m_stream << quint8(type->typeEnum()) << string(type->identifier());
+        if (type->typeEnum() == Types::Type::USERDEFINED) {
+            auto userType = static_cast<const Types::UserdefinedType *>(type);
+            const AssignmentIndex index = m_assignments.value(userType->referencedType(), { -1, -1 });
+            *m_stream << string(userType->typeName()) << string(userType->module()) << index.first << index.second;
+        } else if (type->typeEnum() == Types::Type::LABELTYPE) {
+            *m_stream << string(type->typeName());
+        }
+
+        writeParameters(type->parameters());
+
+        *m_stream << quint32(type->children().size());
+        for (const std::unique_ptr<Types::Type> &child : type->children()) {
+            writeType(child.get());
+        }
+    }
+
+    void writeParameters(const QVariantMap &parameters)
+    {
+        *m_stream << quint32(parameters.size());
+        for (auto it = parameters.cbegin(); it != parameters.cend(); ++it) {
+            *m_stream << string(it.key());
+            const QVariant &value = it.value();
+            switch (value.userType()) {
+            case QMetaType::LongLong:
+                *m_stream << quint8(LongLongParameter) << value.toLongLong();
+                break;
+            case QMetaType::Double:
+                *m_stream << quint8(DoubleParameter) << value.toDouble();
+                break;
+            case QMetaType::QStringList: {
+                const QStringList values = value.toStringList();
+                *m_stream << quint8(StringListParameter) << quint32(values.size());
+                for (const QString &text : values) {
+                    *m_stream << string(text);
+                }
+                break;
+            }
+            default:
+                *m_stream << quint8(VariantParameter) << value;
+                break;
+            }
+        }
+    }
+
+    QDataStream *m_stream = nullptr;
+    QByteArray m_body;
+    QStringList m_strings;
+    QHash<QString, quint32> m_stringIndexes;
+    QHash<const TypeAssignment *, AssignmentIndex> m_assignments;
+};
+
+class AstBinaryReader
+{
+public:
+    explicit AstBinaryReader(const QByteArray &data)
+        : m_stream(data)
+    {
+        m_stream.setVersion(kStreamVersion);
+    }
+
+    std::unique_ptr<File> read(QString *errorString)
+    {
+        std::unique_ptr<File> file;
+        if (readHeader()) {
+            file = readFile();
+        }
+        if (m_stream.status() != QDataStream::Ok) {
+            setError(QObject::tr("Truncated or corrupted data"));
+        }
+        if (!m_error.isEmpty()) {
+            if (errorString) {
+                *errorString = m_error;
+            }
+            return {};
+        }
+        return file;
+    }
+
+private:
+    bool isOk() const { return m_error.isEmpty() && m_stream.status() == QDataStream::Ok; }
+
+    void setError(const QString &error)
+    {
+        if (m_error.isEmpty()) {
+            m_error = error;
+        }
+    }
+
+    bool readHeader()
+    {
+        quint32 magic = 0;
+        quint32 version = 0;
+        m_stream >> magic >> version;
+        if (magic != kMagic) {
+            setError(QObject::tr("Not a binary ASN.1 AST"));
+            return false;
+        }
+        if (version != kFormatVersion) {
+            setError(QObject::tr("Unsupported binary ASN.1 AST version %1").arg(version));
+            return false;
+        }
+
+        const quint32 count = readCount();
+        m_strings.reserve(int(count));
+        QByteArray utf8;
+        for (quint32 idx = 0; idx < count && isOk(); ++idx) {
+            m_stream >> utf8;
+            m_strings.append(QString::fromUtf8(utf8));
+        }
+        return isOk();
+    }
+
+    quint32 readCount()
+    {
+        quint32 count = 0;
+        m_stream >> count;
+        /// Every entry takes at least one byte, larger counts can only come from corrupted data
+        if (count > quint32(m_stream.device()->bytesAvailable())) {
+            setError(QObject::tr("Truncated or corrupted data"));
+            return 0;
+        }
+        return count;
+    }
+
+    QString string()
+    {
+        quint32 idx = 0;
+        m_stream >> idx;
+        if (idx >= quint32(m_strings.size())) {
+            setError(QObject::tr("Invalid string index %1").arg(idx));
+            return {};
+        }
+        return m_strings.at(int(idx));
+    }
+
+    SourceLocation readLocation()
+    {
+        const QString path = string();
+        qint32 line = 0;
+        qint32 column = 0;
+        m_stream >> line >> column;
+        return { path, line, column };
+    }
+
+    std::unique_ptr<File> readFile()
+    {
+        auto file = std::make_unique<File>(string());
+        readLocation();
+        bool polluted = false;
+        m_stream >> polluted;
+        if (polluted) {
+            file->setPolluted();
+        }
+
+        const quint32 definitionsCount = readCount();
+        for (quint32 idx = 0; idx < definitionsCount && isOk(); ++idx) {
+            file->add(readDefinitions());
+        }
+
+        const quint32 referencesCount = readCount();
+        for (quint32 idx = 0; idx < referencesCount && isOk(); ++idx) {
+            const QString name = string();
+            const QString module = string();
+            file->addTypeReference(std::make_unique<TypeReference>(name, module, readLocation()));
+        }
+
+        const quint32 errorsCount = readCount();
+        for (quint32 idx = 0; idx < errorsCount && isOk(); ++idx) {
+            const SourceLocation location = readLocation();
+            file->addErrorMessage({ location, string() });
+        }
+        return file;
+    }
+
+    std::unique_ptr<Definitions> readDefinitions()
+    {
+        const QString name = string();
+        auto definitions = std::make_unique<Definitions>(name, readLocation());
+        m_definitions.append(definitions.get());
+
+        const quint32 typesCount = readCount();
+        for (quint32 idx = 0; idx < typesCount && isOk(); ++idx) {
+            const QString typeName = string();
+            const SourceLocation location = readLocation();
+            std::unique_ptr<Types::Type> type = readType();
+            if (!type) {
+                setError(QObject::tr("Type assignment %1 has no type").arg(typeName));
+                break;
+            }
+            definitions->addType(std::make_unique<TypeAssignment>(typeName, location, std::move(type)));
+        }
+
+        const quint32 valuesCount = readCount();
+        for (quint32 idx = 0; idx < valuesCount && isOk(); ++idx) {
+            const QString valueName = string();
+            const SourceLocation location = readLocation();
+            definitions->addValue(std::make_unique<ValueAssignment>(valueName, location, readType()));
+        }
+
+        const quint32 importedTypesCount = readCount();
+        for (quint32 idx = 0; idx < importedTypesCount && isOk(); ++idx) {
+            const QString module = string();
+            definitions->addImportedType({ module, string() });
+        }
+
+        const quint32 importedValuesCount = readCount();
+        for (quint32 idx = 0; idx < importedValuesCount && isOk(); ++idx) {
+            const QString module = string();
+            definitions->addImportedValue({ module, string() });
+        }
+        return definitions;
+    }
+
+    std::unique_ptr<Types::Type> readType()
+    {
+        quint8 typeEnum = kNoType;
+        m_stream >> typeEnum;
+        if (typeEnum == kNoType || !isOk()) {
+            return {};
+        }
+
+        const QString identifier = string();
+        std::unique_ptr<Types::Type> type;
+        switch (typeEnum) {
+        case Types::Type::INTEGER:
+            type = std::make_unique<Types::Integer>(identifier);
+            break;
+        case Types::Type::REAL:
+            type = std::make_unique<Types::Real>(identifier);
+            break;
+        case Types::Type::BOOLEAN:
+            type = std::make_unique<Types::Boolean>(identifier);
+            break;
+        case Types::Type::SEQUENCE:
+            type = std::make_unique<Types::Sequence>(identifier);
+            break;
+        case Types::Type::SEQUENCEOF:
+            type = std::make_unique<Types::SequenceOf>(identifier);
+            break;
+        case Types::Type::ENUMERATED:
+            type = std::make_unique<Types::Enumerated>(identifier);
+            break;
+        case Types::Type::CHOICE:
+            type = std::make_unique<Types::Choice>(identifier);
+            break;
+        case Types::Type::NULLTYPE:
+            type = std::make_unique<Types::Null>(identifier);
+            break;
+        case Types::Type::BITSTRING:
+            type = std::make_unique<Types::BitString>(identifier);
+            break;
+        case Types::Type::IA5STRING:
+            type = std::make_unique<Types::IA5String>(identifier);
+            break;
+        case Types::Type::NUMERICSTRING:
+            type = std::make_unique<Types::NumericString>(identifier);
+            break;
+        case Types::Type::OCTETSTRING:
+            type = std::make_unique<Types::OctetString>(identifier);
+            break;
+        case Types::Type::LABELTYPE:
+            type = std::make_unique<Types::LabelType>(string());
+            break;
+        case Types::Type::USERDEFINED: {
+            const QString name = string();
+            const QString module = string();
+            AssignmentIndex index;
+            m_stream >> index.first >> index.second;
+            type = std::make_unique<Types::UserdefinedType>(name, module, assignment(index));
+            break;
+        }
+        default:
+            setError(QObject::tr("Unknown ASN.1 type %1").arg(typeEnum));
+            return {};
+        }
+
+        /// Not all types take the identifier in the constructor
+        type->setIdentifier(identifier);
+        type->setParameters(readParameters());
+
+        const quint32 childrenCount = readCount();
+        for (quint32 idx = 0; idx < childrenCount && isOk(); ++idx) {
+            std::unique_ptr<Types::Type> child = readType();
+            if (child) {
+                type->addChild(std::move(child));
+            }
+        }
+        return type;
+    }
+
+    const TypeAssignment *assignment(const AssignmentIndex &index) const
+    {
+        if (index.first < 0 || index.first >= m_definitions.size()) {
+            return nullptr;
+        }
+        const Definitions::Types &types = m_definitions.at(index.first)->types();
+        return index.second >= 0 && index.second < int(types.size()) ? types.at(index.second).get() : nullptr;
+    }
+
+    QVariantMap readParameters()
+    {
+        QVariantMap parameters;
+        const quint32 count = readCount();
+        for (quint32 idx = 0; idx < count && isOk(); ++idx) {
+            const QString key = string();
+            quint8 tag = VariantParameter;
+            m_stream >> tag;
+            switch (tag) {
+            case LongLongParameter: {
+                qlonglong value = 0;
+                m_stream >> value;
+                parameters.insert(key, value);
+                break;
+            }
+            case DoubleParameter: {
+                double value = 0;
+                m_stream >> value;
+                parameters.insert(key, value);
+                break;
+            }
+            case StringListParameter: {
+                QStringList values;
+                const quint32 valuesCount = readCount();
+                for (quint32 valueIdx = 0; valueIdx < valuesCount && isOk(); ++valueIdx) {
+                    values.append(string());
+                }
+                parameters.insert(key, values);
+                break;
+            }
+            case VariantParameter: {
+                QVariant value;
+                m_stream >> value;
+                parameters.insert(key, value);
+                break;
+            }
+            default:
+                setError(QObject::tr("Unknown parameter kind %1").arg(tag));
+                break;
+            }
+        }
+        return parameters;
+    }
+
+    QDataStream m_stream;
+    QStringList m_strings;
+    QVector<const Definitions *> m_definitions;
+    QString m_error;
+};
+
+/*!
+   Returns the version of the binary format. It's increased whenever the layout of the data changes.
+ */
+quint32 AstBinaryCache::formatVersion()
+{
+    return kFormatVersion;
+}
+
+/*!
+   Returns the binary representation of \p file
+ */
+QByteArray AstBinaryCache::serialize(const File &file)
+{
+    return AstBinaryWriter().write(file);
+}
+
+/*!
+   Creates the file from its binary representation \p data.
+   \return An empty unique ptr if the data is invalid or has another format version, \p errorString is set then.
+ */
+std::unique_ptr<File> AstBinaryCache::deserialize(const QByteArray &data, QString *errorString)
+{
+    return AstBinaryReader(data).read(errorString);
+}
+
+/*!
+   Stores the binary representation of \p file as \p fileName. The file is replaced atomically.
+ */
+bool AstBinaryCache::write(const File &file, const QString &fileName)
+{
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile out(fileName);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const QByteArray data = serialize(file);
+    if (out.write(data) != data.size()) {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
+
+/*!
+   Reads the file \p fileName written by \ref write
+   \return An empty unique ptr if the file can't be read or is invalid
+ */
+std::unique_ptr<File> AstBinaryCache::read(const QString &fileName, QString *errorString)
+{
+    QFile in(fileName);
+    if (!in.open(QIODevice::ReadOnly)) {
+        if (errorString) {
+            *errorString = in.errorString();
+        }
+        return {};
+    }
+    return deserialize(in.readAll(), errorString);
+}
+
+}
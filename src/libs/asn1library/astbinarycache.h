@@ -0,0 +1,48 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <memory>
+
+namespace Asn1Acn {
+class File;
+
+/*!
+   \class Asn1Acn::AstBinaryCache
+   Compact binary serialization of a parsed Asn1Acn::File.
+
+   Reading the binary form skips the xml tokenizing and the lookups of the AstXmlParser. All strings are stored
+   once in a string table and referenced by index, references between type assignments are stored as indexes.
+   The data starts with a magic number and \ref formatVersion, data written by another version is rejected, so the
+   caller falls back to the xml.
+ */
+class AstBinaryCache
+{
+public:
+    static quint32 formatVersion();
+
+    static QByteArray serialize(const File &file);
+    static std::unique_ptr<File> deserialize(const QByteArray &data, QString *errorString = nullptr);
+
+    static bool write(const File &file, const QString &fileName);
+    static std::unique_ptr<File> read(const QString &fileName, QString *errorString = nullptr);
+};
+
+}
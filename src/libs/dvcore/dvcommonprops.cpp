@@ -17,6 +17,8 @@
 
 #include "dvcommonprops.h"
 
+#include "attributestore.h"
+
 namespace dvm {
 namespace meta {
 
@@ -49,7 +51,8 @@ Props::Token Props::token(const QString &fromString)
 
 QString Props::token(Props::Token tag)
 {
-    return TokensByName.key(tag);
+    static const shared::TokenNames<Props::Token> namesByToken(TokensByName);
+    return namesByToken.name(tag);
 }
 
 }
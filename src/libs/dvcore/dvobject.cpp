@@ -43,7 +43,9 @@ DVObject::~DVObject() { }
 
 QString DVObject::title() const
 {
-    return entityAttributeValue<QString>(meta::Props::token(meta::Props::Token::name));
+    static const shared::AttributeId nameId =
+            shared::AttributeNameTable::intern(meta::Props::token(meta::Props::Token::name));
+    return entityAttributeValue<QString>(nameId);
 }
 
 QString DVObject::titleUI() const
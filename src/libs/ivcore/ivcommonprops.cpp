@@ -17,6 +17,8 @@
 
 #include "ivcommonprops.h"
 
+#include "attributestore.h"
+
 namespace ivm {
 namespace meta {
 
@@ -77,7 +79,8 @@ Props::Token Props::token(const QString &fromString)
 
 QString Props::token(Props::Token tag)
 {
-    return TokensByName.key(tag);
+    static const shared::TokenNames<Props::Token> namesByToken(TokensByName);
+    return namesByToken.name(tag);
 }
 
 }
@@ -94,9 +94,13 @@ void IVInterface::CreationInfo::resetKind()
 struct IVInterfacePrivate {
     explicit IVInterfacePrivate(IVInterface::InterfaceType dir)
         : m_direction(dir)
+        , m_kind(dir == IVInterface::InterfaceType::Provided ? IVInterface::OperationKind::Sporadic
+                                                              : IVInterface::OperationKind::Any)
     {
     }
     IVInterface::InterfaceType m_direction;
+    // Decoded value of the "kind" attribute
+    IVInterface::OperationKind m_kind;
     QVector<InterfaceParameter> m_params = {};
     QPointer<IVInterface> m_cloneOf { nullptr };
     QVector<QPointer<IVInterface>> m_clones {};
@@ -142,7 +146,7 @@ bool IVInterface::postInit(QString *warning)
     }
 
     const QString prototypeName =
-            fn->entityAttributeValue(meta::Props::token(meta::Props::Token::instance_of)).toString();
+            fn->entityAttributeValue(attributeId(meta::Props::Token::instance_of)).toString();
     if (prototypeName.isEmpty()) {
         return IVObject::postInit(warning);
     }
@@ -222,7 +226,7 @@ IVInterface::OperationKind IVInterface::kindFromString(const QString &k) const
 
 IVInterface::OperationKind IVInterface::kind() const
 {
-    return kindFromString(entityAttributeValue<QString>(meta::Props::token(meta::Props::Token::kind)));
+    return d->m_kind;
 }
 
 bool IVInterface::setKind(IVInterface::OperationKind k)
@@ -235,6 +239,16 @@ bool IVInterface::setKind(IVInterface::OperationKind k)
     return false;
 }
 
+void IVInterface::attributeStoreChanged(shared::AttributeId id)
+{
+    IVObject::attributeStoreChanged(id);
+
+    static const shared::AttributeId kindId = attributeId(meta::Props::Token::kind);
+    if (id == kindId || id == shared::AttributeId::Invalid) {
+        d->m_kind = kindFromString(entityAttributeValue<QString>(kindId));
+    }
+}
+
 QVector<InterfaceParameter> IVInterface::params() const
 {
     return d->m_params;
@@ -711,7 +725,7 @@ QStringList IVInterfaceRequired::ifaceLabelList() const
 
 bool IVInterfaceRequired::isInheritPI() const
 {
-    return entityAttributeValue<bool>(meta::Props::token(meta::Props::Token::InheritPI));
+    return entityAttributeValue<bool>(attributeId(meta::Props::Token::InheritPI));
 }
 
 bool IVInterfaceRequired::hasPrototypePi() const
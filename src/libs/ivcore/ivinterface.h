@@ -147,6 +147,7 @@ protected:
     void forgetClone(IVInterface *clone);
 
     void setAttributeImpl(const QString &name, const QVariant &value, EntityAttribute::Type type) override;
+    void attributeStoreChanged(shared::AttributeId id) override;
     virtual void cloneInternals(const IVInterface *from);
     virtual void restoreInternals(const IVInterface *disconnectMe);
 
@@ -37,6 +37,17 @@ struct IVModelPrivate {
     shared::Id m_rootObjectId;
     QList<IVObject *> m_visibleObjects;
     QVector<QString> m_headerTitles;
+
+    // Name index: object type -> case folded title -> objects
+    QHash<IVObject::Type, QHash<QString, QVector<IVObject *>>> m_objectsByName;
+    // The title each object is indexed with
+    QHash<IVObject *, QString> m_indexedNames;
+    // Position of each object in the order the objects were added, the first added one wins on equal names
+    QHash<IVObject *, quint64> m_addOrder;
+    quint64 m_nextAddOrder { 0 };
+    QHash<IVObject::Type, int> m_objectsCount;
+    // Counter hints used by the IVNameValidator when generating counted names
+    QHash<QString, int> m_nameCounterHints;
 };
 
 IVModel::IVModel(PropertyTemplateConfig *dynPropConfig, QObject *parent)
@@ -58,24 +69,8 @@ bool IVModel::addObjectImpl(shared::VEObject *obj)
     if (ivm::IVObject *ivObj = obj->as<ivm::IVObject *>()) {
         if (shared::VEModel::addObjectImpl(obj)) {
             d->m_visibleObjects.append(ivObj);
-
-            for (const auto attr : d->m_dynPropConfig->propertyTemplatesForObject(ivObj)) {
-                if (attr->validate(ivObj)) {
-                    const QVariant &currentValue = obj->entityAttributeValue(attr->name());
-                    if (currentValue.isNull()) {
-                        const QVariant &defaultValue = attr->defaultValue();
-                        if (!defaultValue.isNull()) {
-                            if (attr->info() == ivm::PropertyTemplate::Info::Attribute) {
-                                obj->setEntityAttribute(attr->name(), defaultValue);
-                            } else if (attr->info() == ivm::PropertyTemplate::Info::Property) {
-                                obj->setEntityProperty(attr->name(), defaultValue);
-                            } else {
-                                qWarning() << "Unknown dynamic property info:" << attr->info();
-                            }
-                        }
-                    }
-                }
-            }
+            d->m_addOrder.insert(ivObj, d->m_nextAddOrder++);
+            indexObjectName(ivObj);
             return true;
         }
     }
@@ -83,9 +78,60 @@ bool IVModel::addObjectImpl(shared::VEObject *obj)
     return false;
 }
 
+/*!
+   Sets the default values of the dynamic properties for all newly added \p objects.
+   Objects are handled grouped by type, so the property templates (and the ones having a default value at all)
+   are looked up once per type instead of once per object.
+ */
+void IVModel::initObjects(const QVector<shared::VEObject *> &objects)
+{
+    if (!d->m_dynPropConfig) {
+        return;
+    }
+
+    QHash<int, QVector<PropertyTemplate *>> templatesWithDefaults;
+    for (shared::VEObject *obj : objects) {
+        auto ivObj = qobject_cast<ivm::IVObject *>(obj);
+        if (!ivObj) {
+            continue;
+        }
+
+        const int typeKey = static_cast<int>(ivObj->type());
+        auto it = templatesWithDefaults.find(typeKey);
+        if (it == templatesWithDefaults.end()) {
+            QVector<PropertyTemplate *> templates;
+            for (PropertyTemplate *attr : d->m_dynPropConfig->propertyTemplatesForObject(ivObj)) {
+                if (!attr->defaultValue().isNull()) {
+                    templates.append(attr);
+                }
+            }
+            it = templatesWithDefaults.insert(typeKey, templates);
+        }
+        if (it->isEmpty()) {
+            continue;
+        }
+
+        const PropertyTemplate::Scope scope = PropertyTemplate::objectScope(ivObj);
+        for (const PropertyTemplate *attr : qAsConst(*it)) {
+            if (!attr->validate(ivObj, scope) || !ivObj->entityAttributeValue(attr->attributeId()).isNull()) {
+                continue;
+            }
+            if (attr->info() == ivm::PropertyTemplate::Info::Attribute) {
+                ivObj->setEntityAttribute(attr->name(), attr->defaultValue());
+            } else if (attr->info() == ivm::PropertyTemplate::Info::Property) {
+                ivObj->setEntityProperty(attr->name(), attr->defaultValue());
+            } else {
+                qWarning() << "Unknown dynamic property info:" << attr->info();
+            }
+        }
+    }
+}
+
 bool IVModel::removeObject(shared::VEObject *obj)
 {
     if (shared::VEModel::removeObject(obj)) {
+        unindexObjectName(obj->as<ivm::IVObject *>());
+        d->m_addOrder.remove(obj->as<ivm::IVObject *>());
         if (auto parentObj = qobject_cast<ivm::IVFunctionType *>(obj->parentObject())) {
             parentObj->removeChild(obj->as<ivm::IVObject *>());
         }
@@ -121,19 +167,42 @@ IVObject *IVModel::getObject(const shared::Id &id) const
     return qobject_cast<IVObject *>(shared::VEModel::getObject(id));
 }
 
+/*!
+   Returns the object of the given \p type with the title \p name. The type Unknown matches objects of all types.
+   If several objects match, the one added to the model first is returned.
+ */
 IVObject *IVModel::getObjectByName(const QString &name, IVObject::Type type, Qt::CaseSensitivity caseSensitivity) const
 {
     if (name.isEmpty())
         return nullptr;
 
-    for (auto object : objects()) {
-        if (auto obj = qobject_cast<ivm::IVObject *>(object)) {
-            if ((type == IVObject::Type::Unknown || type == obj->type())
-                    && obj->title().compare(name, caseSensitivity) == 0)
-                return obj;
+    const QString key = name.toCaseFolded();
+    IVObject *found = nullptr;
+    auto findInBucket = [&](const QHash<QString, QVector<IVObject *>> &bucket) {
+        const auto it = bucket.constFind(key);
+        if (it == bucket.constEnd()) {
+            return;
         }
+        for (IVObject *obj : it.value()) {
+            if (obj->title().compare(name, caseSensitivity) == 0
+                    && (!found || d->m_addOrder.value(obj) < d->m_addOrder.value(found))) {
+                found = obj;
+            }
+        }
+    };
+
+    if (type != IVObject::Type::Unknown) {
+        const auto it = d->m_objectsByName.constFind(type);
+        if (it != d->m_objectsByName.constEnd()) {
+            findInBucket(it.value());
+        }
+        return found;
     }
-    return nullptr;
+
+    for (auto it = d->m_objectsByName.constBegin(); it != d->m_objectsByName.constEnd(); ++it) {
+        findInBucket(it.value());
+    }
+    return found;
 }
 
 /*!
@@ -409,6 +478,11 @@ QList<IVObject *> IVModel::visibleObjects(shared::Id rootId) const
 void IVModel::clear()
 {
     d->m_visibleObjects.clear();
+    d->m_objectsByName.clear();
+    d->m_indexedNames.clear();
+    d->m_addOrder.clear();
+    d->m_objectsCount.clear();
+    d->m_nameCounterHints.clear();
 
     d->m_rootObjectId = shared::InvalidId;
     shared::VEModel::clear();
@@ -490,4 +564,74 @@ QSet<QStringList> IVModel::nestedFunctionPaths(const IVFunctionType *fnt) const
 
     return paths;
 }
+/*!
+   Returns the number of objects of exactly the given \p type in this model
+ */
+int IVModel::objectsCount(IVObject::Type type) const
+{
+    return d->m_objectsCount.value(type, 0);
+}
+
+/*!
+   Returns the first counter to try when generating a counted name for the given \p key.
+   \sa IVNameValidator
+ */
+int IVModel::nameCounterHint(const QString &key) const
+{
+    return d->m_nameCounterHints.value(key, 0);
+}
+
+void IVModel::setNameCounterHint(const QString &key, int counter)
+{
+    d->m_nameCounterHints.insert(key, counter);
+}
+
+void IVModel::onObjectTitleChanged()
+{
+    if (auto obj = qobject_cast<IVObject *>(sender())) {
+        unindexObjectName(obj);
+        indexObjectName(obj);
+    }
+}
+
+void IVModel::indexObjectName(IVObject *obj)
+{
+    if (!obj || d->m_indexedNames.contains(obj)) {
+        return;
+    }
+
+    const QString title = obj->title();
+    d->m_indexedNames.insert(obj, title);
+    d->m_objectsByName[obj->type()][title.toCaseFolded()].append(obj);
+    ++d->m_objectsCount[obj->type()];
+    connect(obj, &IVObject::titleChanged, this, &IVModel::onObjectTitleChanged, Qt::UniqueConnection);
+}
+
+void IVModel::unindexObjectName(IVObject *obj)
+{
+    if (!obj) {
+        return;
+    }
+
+    const auto it = d->m_indexedNames.find(obj);
+    if (it == d->m_indexedNames.end()) {
+        return;
+    }
+
+    const QString key = it.value().toCaseFolded();
+    d->m_indexedNames.erase(it);
+    QHash<QString, QVector<IVObject *>> &bucket = d->m_objectsByName[obj->type()];
+    auto bucketIt = bucket.find(key);
+    if (bucketIt != bucket.end()) {
+        bucketIt->removeOne(obj);
+        if (bucketIt->isEmpty()) {
+            bucket.erase(bucketIt);
+        }
+    }
+    --d->m_objectsCount[obj->type()];
+    disconnect(obj, &IVObject::titleChanged, this, &IVModel::onObjectTitleChanged);
+    // A name might be free again, so counted names have to be searched from the start
+    d->m_nameCounterHints.clear();
+}
+
 }
@@ -83,6 +83,11 @@ public:
     QList<IVObject *> visibleObjects() const;
     QList<IVObject *> visibleObjects(shared::Id rootId) const;
 
+    int objectsCount(IVObject::Type type) const;
+
+    int nameCounterHint(const QString &key) const;
+    void setNameCounterHint(const QString &key, int counter);
+
     void clear() override;
 
     /*!
@@ -106,8 +111,15 @@ Q_SIGNALS:
 
 protected:
     bool addObjectImpl(shared::VEObject *obj) override;
+    void initObjects(const QVector<shared::VEObject *> &objects) override;
+
+private Q_SLOTS:
+    void onObjectTitleChanged();
 
 private:
+    void indexObjectName(IVObject *obj);
+    void unindexObjectName(IVObject *obj);
+
     const std::unique_ptr<IVModelPrivate> d;
 };
 
@@ -46,7 +46,7 @@ bool IVMyFunction::postInit(QString *warning)
 
     if (auto objModel = model()) {
         const QString typeName =
-                entityAttributeValue(meta::Props::token(meta::Props::Token::instance_of)).value<QString>();
+                entityAttributeValue(attributeId(meta::Props::Token::instance_of)).value<QString>();
         if (!typeName.isEmpty()) {
             const QHash<QString, IVFunctionType *> types = objModel->getAvailableFunctionTypes(this);
             if (auto typeObj = types.value(typeName)) {
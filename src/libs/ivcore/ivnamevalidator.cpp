@@ -284,7 +284,7 @@ QString IVNameValidator::nameForInstance(const IVFunction *object, const QString
     } else if (isAcceptableName(object, suggestedName)) {
         return suggestedName;
     }
-    return instance()->makeCountedName(object, suggestedName, 2);
+    return instance()->makeCountedNames(object, suggestedName, 2, 1).value(0);
 }
 
 QString IVNameValidator::nameOfType(IVObject::Type t)
@@ -318,150 +318,137 @@ QString IVNameValidator::nameOfType(IVObject::Type t)
 
 QString IVNameValidator::nextNameFor(const IVObject *object)
 {
-    return instance()->nextName(object);
+    return instance()->nextNames(object, 1).value(0);
 }
 
-QString IVNameValidator::nextName(const IVObject *object) const
+/*!
+   Returns \p count different names, that can be used for new objects like the given \p object.
+   All names are searched in one go, so this is the way to name many objects at once (e.g. on paste or import).
+   The names are not used by any object, but are not blocked in any way. So they have to be used right away.
+ */
+QStringList IVNameValidator::nextNamesFor(const IVObject *object, int count)
 {
-    if (!object) {
-        return QString();
+    return instance()->nextNames(object, count);
+}
+
+QStringList IVNameValidator::nextNames(const IVObject *object, int count) const
+{
+    if (!object || count <= 0) {
+        return {};
     }
 
     const IVObject::Type t = object->type();
     switch (t) {
     case IVObject::Type::MyFunction:
-        return nameMyFunction(object);
     case IVObject::Type::Function:
-        return nameFunction(object);
     case IVObject::Type::FunctionType:
-        return nameFunctionType(object);
     case IVObject::Type::RequiredInterface:
-        return nameRequiredInterface(object);
     case IVObject::Type::ProvidedInterface:
-        return nameProvidedInterface(object);
-    case IVObject::Type::Comment:
-        return nameComment(object);
+    case IVObject::Type::Comment: {
+        QString nameTemplate;
+        int counter = 0;
+        countedNameBase(object, &nameTemplate, &counter);
+        return makeCountedNames(object, nameTemplate, counter, count);
+    }
     case IVObject::Type::ConnectionGroup:
-    case IVObject::Type::Connection:
-        return nameConnection(object);
+    case IVObject::Type::Connection: {
+        QStringList names;
+        const QString name = nameConnection(object);
+        for (int i = 0; i < count; ++i) {
+            names.append(name);
+        }
+        return names;
+    }
     case IVObject::Type::InterfaceGroup:
     case IVObject::Type::Unknown:
-        return QString();
+        return QStringList();
     default:
         break;
     }
 
     qWarning() << "Unsupported object type:" << t;
-    return QString();
+    return QStringList();
 }
 
-QString IVNameValidator::makeCountedName(const IVObject *object, const QString &nameTemplate, int counter) const
-{
-    QString name = nameTemplate + QString::number(counter);
-    while (!isAcceptableName(object, name)) {
-        name = nameTemplate + QString::number(++counter);
-    }
-    return name;
-
-}
-
-QString IVNameValidator::nameFunctionType(const IVObject *functionType) const
+/*!
+   Returns \p count acceptable names built from \p nameTemplate and a counter starting at \p counter.
+   For objects that are named uniquely for the whole model, the model remembers the counter of the first free name.
+   So successive calls don't have to check the already used names again.
+ */
+QStringList IVNameValidator::makeCountedNames(
+        const IVObject *object, const QString &nameTemplate, int counter, int count) const
 {
-    const QString nameTemplate =
-            functionType->title().isEmpty() ? m_typePrefixes[functionType->type()] : functionType->title();
-
-
-    int counter = 0;
-    if (functionType && functionType->model()) {
-        for (const auto fn : functionType->model()->objects()) {
-            if (qobject_cast<ivm::IVFunctionType *>(fn)) {
-                ++counter;
+    IVModel *model = object->model();
+    const bool modelWideName = object->isFunctionType() || object->isFunction() || object->isMyFunction()
+            || object->isComment();
+    const QString hintKey = QString::number(static_cast<int>(object->type())) + QLatin1Char('/') + nameTemplate;
+    if (model && modelWideName) {
+        counter = qMax(counter, model->nameCounterHint(hintKey));
+    }
+
+    QStringList names;
+    names.reserve(count);
+    while (names.size() < count) {
+        const QString name = nameTemplate + QString::number(counter);
+        if (isAcceptableName(object, name)) {
+            if (names.isEmpty() && model && modelWideName) {
+                model->setNameCounterHint(hintKey, counter);
             }
+            names.append(name);
         }
-    } else {
-        counter = 0;
+        ++counter;
     }
-    ++counter;
-
-    return makeCountedName(functionType, nameTemplate, counter);
+    return names;
 }
 
-QString IVNameValidator::nameFunction(const IVObject *function) const
+/*!
+   Sets the \p nameTemplate and the first \p counter to use for generating a name for the \p object.
+   The counter is based on the number of existing objects of the same kind.
+ */
+bool IVNameValidator::countedNameBase(const IVObject *object, QString *nameTemplate, int *counter) const
 {
-    const QString nameTemplate = function->title().isEmpty() ? m_typePrefixes[function->type()] : function->title();
+    Q_ASSERT(object && nameTemplate && counter);
 
-    int counter = 0;
-    if (function && function->model()) {
-        for (const auto fn : function->model()->objects()) {
-            if (qobject_cast<ivm::IVFunction *>(fn)) {
-                ++counter;
+    const IVObject::Type t = object->type();
+    const IVModel *model = object->model();
+    int count = 0;
+    switch (t) {
+    case IVObject::Type::FunctionType:
+    case IVObject::Type::Function:
+    case IVObject::Type::MyFunction: {
+        *nameTemplate = object->title().isEmpty() ? m_typePrefixes[t] : object->title();
+        if (model) {
+            // Count like a qobject_cast would do: a function is a function type, a my-function is a function
+            count = model->objectsCount(IVObject::Type::MyFunction);
+            if (t != IVObject::Type::MyFunction) {
+                count += model->objectsCount(IVObject::Type::Function);
+            }
+            if (t == IVObject::Type::FunctionType) {
+                count += model->objectsCount(IVObject::Type::FunctionType);
             }
         }
-    } else {
-        counter = 0;
+        break;
+    }
+    case IVObject::Type::Comment: {
+        *nameTemplate = m_typePrefixes[t];
+        count = model ? model->objectsCount(t) : 0;
+        break;
+    }
+    case IVObject::Type::RequiredInterface:
+    case IVObject::Type::ProvidedInterface: {
+        *nameTemplate = m_typePrefixes[t];
+        const auto parent = object->parentObject() ? object->parentObject()->as<const IVFunctionType *>() : nullptr;
+        if (parent) {
+            count = t == IVObject::Type::RequiredInterface ? parent->ris().size() : parent->pis().size();
+        }
+        break;
+    }
+    default:
+        return false;
     }
-    ++counter;
-
-    return makeCountedName(function, nameTemplate, counter);
-}
-
-QString IVNameValidator::nameRequiredInterface(const IVObject *iface) const
-{
-    Q_ASSERT(iface);
-
-    const QString nameTemplate = m_typePrefixes[iface->type()];
-
-    const auto parent = iface->parentObject()->as<const IVFunctionType *>();
-    int counter = parent ? parent->ris().size() : 0;
-    ++counter;
-
-    return makeCountedName(iface, nameTemplate, counter);
-}
-
-QString IVNameValidator::nameProvidedInterface(const IVObject *iface) const
-{
-    Q_ASSERT(iface);
-
-    const QString nameTemplate = m_typePrefixes[iface->type()];
-
-    const auto parent = iface->parentObject()->as<const IVFunctionType *>();
-    int counter = parent ? parent->pis().size() : 0;
-    ++counter;
-
-    return makeCountedName(iface, nameTemplate, counter);
-}
-
-QString IVNameValidator::nameComment(const IVObject *comment) const
-{
-    const QString nameTemplate = m_typePrefixes[comment->type()];
-
-    int counter = 0;
-    if (comment && comment->model()) {
-        for (const auto fn : comment->model()->objects())
-            if (qobject_cast<ivm::IVComment *>(fn))
-                ++counter;
-    } else
-        counter = 0;
-    ++counter;
-
-    return makeCountedName(comment, nameTemplate, counter);
-}
-
 
-QString IVNameValidator::nameMyFunction(const IVObject *comment) const
-{
-    const QString nameTemplate = comment->title().isEmpty() ? m_typePrefixes[comment->type()] : comment->title();
-
-    int counter = 0;
-    if (comment && comment->model()) {
-        for (const auto fn : comment->model()->objects())
-            if (qobject_cast<ivm::IVMyFunction *>(fn))
-                ++counter;
-    } else
-        counter = 0;
-    ++counter;
-
-    return makeCountedName(comment, nameTemplate, counter);
+    *counter = count + 1;
+    return true;
 }
 
 QString IVNameValidator::nameConnection(const IVObject *connection) const
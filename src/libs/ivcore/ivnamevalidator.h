@@ -36,6 +36,7 @@ public:
     static QString decodeName(const IVObject::Type t, const QString &name);
 
     static QString nextNameFor(const IVObject *object);
+    static QStringList nextNamesFor(const IVObject *object, int count);
 
     static bool isValidName(const QString &name);
     static const QString &namePatternUI();
@@ -53,16 +54,10 @@ private:
 
     IVNameValidator();
 
-    QString nextName(const IVObject *object) const;
+    QStringList nextNames(const IVObject *object, int count) const;
 
-    QString makeCountedName(const IVObject *object, const QString &nameTemplate, int counter) const;
-
-    QString nameFunctionType(const IVObject *parent) const;
-    QString nameFunction(const IVObject *fn) const;
-    QString nameRequiredInterface(const IVObject *iface) const;
-    QString nameProvidedInterface(const IVObject *iface) const;
-    QString nameComment(const IVObject *comment) const;
-    QString nameMyFunction(const IVObject *comment) const;
+    QStringList makeCountedNames(const IVObject *object, const QString &nameTemplate, int counter, int count) const;
+    bool countedNameBase(const IVObject *object, QString *nameTemplate, int *counter) const;
 
     QString nameConnection(const IVObject *connection) const;
 
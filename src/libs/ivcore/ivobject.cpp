@@ -20,6 +20,7 @@
 #include "ivmodel.h"
 #include "ivnamevalidator.h"
 
+#include <QMetaEnum>
 #include <QPointer>
 #include <QVector>
 #include <QtDebug>
@@ -38,8 +39,26 @@ struct IVObjectPrivate {
     }
 
     const IVObject::Type m_type;
+    // Decoded values of the coordinate attributes (coordinates, InnerCoordinates, RootCoordinates)
+    QVector<qint32> m_coordinates[3];
 };
 
+namespace {
+int coordinatesIndex(meta::Props::Token token)
+{
+    switch (token) {
+    case meta::Props::Token::coordinates:
+        return 0;
+    case meta::Props::Token::InnerCoordinates:
+        return 1;
+    case meta::Props::Token::RootCoordinates:
+        return 2;
+    default:
+        return -1;
+    }
+}
+}
+
 IVObject::IVObject(const IVObject::Type t, const QString &title, QObject *parent, const shared::Id &id)
     : shared::VEObject(id, parent)
     , d(new IVObjectPrivate(t))
@@ -56,12 +75,13 @@ IVObject::~IVObject() { }
 
 QString IVObject::title() const
 {
-    return entityAttributeValue<QString>(meta::Props::token(meta::Props::Token::name));
+    static const shared::AttributeId nameId = attributeId(meta::Props::Token::name);
+    return entityAttributeValue<QString>(nameId);
 }
 
 QString IVObject::subscriber_name() const
 {
-    return entityAttributeValue<QString>(meta::Props::token(meta::Props::Token::subscriber_name));
+    return entityAttributeValue<QString>(attributeId(meta::Props::Token::subscriber_name));
 }
 
 QString IVObject::titleUI() const
@@ -89,6 +109,27 @@ void IVObject::sortObjectList(QList<IVObject *> &objects)
     });
 }
 
+/*!
+   Returns the interned id of the attribute \p token, to be used with the fast entityAttributeValue() overloads
+ */
+shared::AttributeId IVObject::attributeId(meta::Props::Token token)
+{
+    static const QVector<shared::AttributeId> ids = []() {
+        const QMetaEnum me = QMetaEnum::fromType<meta::Props::Token>();
+        QVector<shared::AttributeId> result(me.keyCount() + 1, shared::AttributeId::Invalid);
+        for (int i = 0; i < me.keyCount(); ++i) {
+            const int value = me.value(i);
+            if (value >= 0 && value < result.size()) {
+                result[value] = shared::AttributeNameTable::intern(meta::Props::token(meta::Props::Token(value)));
+            }
+        }
+        return result;
+    }();
+
+    const int idx = static_cast<int>(token);
+    return idx >= 0 && idx < ids.size() ? ids.at(idx) : shared::AttributeId::Invalid;
+}
+
 IVObject::Type IVObject::type() const
 {
     return d->m_type;
@@ -105,9 +146,7 @@ bool IVObject::setTitle(const QString &title)
 
 QVector<qint32> IVObject::coordinates() const
 {
-    const meta::Props::Token token = coordinatesType();
-    const QVariant varCoord = entityAttributeValue(meta::Props::token(token));
-    return coordinatesFromString(varCoord.toString());
+    return d->m_coordinates[coordinatesIndex(coordinatesType())];
 }
 
 void IVObject::setCoordinates(const QVector<qint32> &coordinates)
@@ -241,7 +280,7 @@ bool IVObject::isNested() const
 
 QString IVObject::groupName() const
 {
-    return entityAttributeValue<QString>(meta::Props::token(meta::Props::Token::group_name));
+    return entityAttributeValue<QString>(attributeId(meta::Props::Token::group_name));
 }
 
 void IVObject::setGroupName(const QString &groupName)
@@ -259,6 +298,7 @@ void IVObject::setEntityAttributes(const EntityAttributes &attributes)
         return;
     }
 
+    const QString oldTitle = title();
     clearAttributes();
     QList<EntityAttribute> attrs = attributes.values();
     std::sort(attrs.begin(), attrs.end(), [](const EntityAttribute &a1, const EntityAttribute &a2) {
@@ -268,6 +308,11 @@ void IVObject::setEntityAttributes(const EntityAttributes &attributes)
     for (const EntityAttribute &attribute : qAsConst(attrs)) {
         setEntityAttribute(attribute);
     }
+
+    // Setting the name emits titleChanged, a name that is gone has to be signalled here
+    if (!oldTitle.isEmpty() && !attributeStore().contains(attributeId(meta::Props::Token::name))) {
+        Q_EMIT titleChanged(title());
+    }
 }
 
 void IVObject::setAttributeImpl(const QString &attributeName, const QVariant &value, EntityAttribute::Type type)
@@ -308,6 +353,27 @@ void IVObject::setAttributeImpl(const QString &attributeName, const QVariant &va
     }
 }
 
+void IVObject::attributeStoreChanged(shared::AttributeId id)
+{
+    // Setting the name emits titleChanged in setAttributeImpl, removing it only passes here
+    static const shared::AttributeId nameId = attributeId(meta::Props::Token::name);
+    if (id == nameId && !attributeStore().contains(nameId)) {
+        Q_EMIT titleChanged(title());
+    }
+
+    static const shared::AttributeId coordinateIds[] = { attributeId(meta::Props::Token::coordinates),
+        attributeId(meta::Props::Token::InnerCoordinates), attributeId(meta::Props::Token::RootCoordinates) };
+
+    for (int i = 0; i < 3; ++i) {
+        if (id == shared::AttributeId::Invalid) {
+            d->m_coordinates[i].clear();
+        } else if (id == coordinateIds[i]) {
+            d->m_coordinates[i] = coordinatesFromString(entityAttributeValue(id).toString());
+            break;
+        }
+    }
+}
+
 IVModel *IVObject::model() const
 {
     return qobject_cast<IVModel *>(shared::VEObject::model());
@@ -334,7 +400,7 @@ void IVObject::setVisible(bool isVisible)
  */
 bool IVObject::isVisible() const
 {
-    return entityAttributeValue(meta::Props::token(meta::Props::Token::is_visible), true);
+    return entityAttributeValue(attributeId(meta::Props::Token::is_visible), true);
 }
 
 }
@@ -105,6 +105,8 @@ public:
 
     static void sortObjectList(QList<ivm::IVObject *> &objects);
 
+    static shared::AttributeId attributeId(meta::Props::Token token);
+
 Q_SIGNALS:
     void titleChanged(const QString &title);
     void coordinatesChanged(const QVector<qint32> &coordinates);
@@ -116,6 +118,7 @@ public Q_SLOTS:
 
 protected:
     void setAttributeImpl(const QString &name, const QVariant &value, EntityAttribute::Type type) override;
+    void attributeStoreChanged(shared::AttributeId id) override;
 
 private:
     const std::unique_ptr<IVObjectPrivate> d;
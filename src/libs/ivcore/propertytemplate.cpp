@@ -20,7 +20,9 @@
 #include "ivobject.h"
 
 #include <QDomElement>
+#include <QHash>
 #include <QMetaEnum>
+#include <QRegularExpression>
 #include <QRegularExpressionMatch>
 
 namespace ivm {
@@ -28,7 +30,13 @@ namespace ivm {
 const QString kTagName = QLatin1String("Attr");
 
 struct PropertyTemplate::PropertyTemplatePrivate {
+    struct AttrValidator {
+        shared::AttributeId m_attrId;
+        QRegularExpression m_rx;
+    };
+
     QString m_name;
+    shared::AttributeId m_attrId { shared::AttributeId::Invalid };
     QString m_label;
     PropertyTemplate::Info m_info;
     PropertyTemplate::Type m_type;
@@ -37,6 +45,8 @@ struct PropertyTemplate::PropertyTemplatePrivate {
     QVariant m_defaultValue;
     QString m_rxValueValidatorPattern;
     QMap<PropertyTemplate::Scope, QPair<QString, QString>> m_rxAttrValidatorPattern;
+    // Compiled once from m_rxAttrValidatorPattern, so validate() does not build regular expressions
+    QHash<int, AttrValidator> m_attrValidators;
     bool m_isVisible = true;
     bool m_isSystem = false;
 };
@@ -56,6 +66,15 @@ QString PropertyTemplate::name() const
 void PropertyTemplate::setName(const QString &name)
 {
     d->m_name = name;
+    d->m_attrId = shared::AttributeNameTable::intern(name);
+}
+
+/*!
+   Returns the interned id of the attribute name
+ */
+shared::AttributeId PropertyTemplate::attributeId() const
+{
+    return d->m_attrId;
 }
 
 QString PropertyTemplate::label() const
@@ -156,6 +175,14 @@ QMap<PropertyTemplate::Scope, QPair<QString, QString>> PropertyTemplate::attrVal
 void PropertyTemplate::setAttrValidatorPattern(const QMap<Scope, QPair<QString, QString>> &pattern)
 {
     d->m_rxAttrValidatorPattern = pattern;
+
+    d->m_attrValidators.clear();
+    for (auto it = pattern.constBegin(); it != pattern.constEnd(); ++it) {
+        QRegularExpression rx(it.value().second);
+        rx.optimize();
+        d->m_attrValidators.insert(static_cast<int>(it.key()),
+                { shared::AttributeNameTable::intern(it.value().first), rx });
+    }
 }
 
 QDomElement PropertyTemplate::toXml(QDomDocument *doc) const
@@ -410,6 +437,14 @@ static inline PropertyTemplate::Scope typeToScope(const IVObject::Type &type)
     return scope;
 }
 
+/*!
+   Returns the property template scope the given \p object belongs to
+ */
+PropertyTemplate::Scope PropertyTemplate::objectScope(const IVObject *object)
+{
+    return typeToScope(object->type());
+}
+
 /*!
  * \brief PropertyTemplate::validate
  * \param object which attributes to be checked
@@ -417,28 +452,31 @@ static inline PropertyTemplate::Scope typeToScope(const IVObject::Type &type)
  */
 bool PropertyTemplate::validate(const IVObject *object) const
 {
-    const PropertyTemplate::Scope objectScope = typeToScope(object->type());
+    return validate(object, objectScope(object));
+}
+
+/*!
+   Same as validate(const IVObject *), for callers that already know the scope of the \p object
+ */
+bool PropertyTemplate::validate(const IVObject *object, PropertyTemplate::Scope objectScope) const
+{
     if (!d->m_scope.testFlag(objectScope)) {
         return false;
     }
 
-    if (d->m_rxAttrValidatorPattern.isEmpty()) {
+    if (d->m_attrValidators.isEmpty()) {
         return true;
     }
 
-    const auto it = d->m_rxAttrValidatorPattern.constFind(objectScope);
-    if (it != d->m_rxAttrValidatorPattern.constEnd()) {
-        auto checkPattern = [](const EntityAttributes &data, const QString &name, const QString &pattern) {
-            auto objAttrIter = data.constFind(name);
-            if (objAttrIter != data.constEnd()) {
-                const QRegularExpression rx(pattern);
-                const QString value = objAttrIter.value().value<QString>();
-                const QRegularExpressionMatch match = rx.match(value);
-                return match.capturedLength() == value.length();
-            }
-            return true;
-        };
-        return checkPattern(object->entityAttributes(), it->first, it->second);
+    const auto it = d->m_attrValidators.constFind(static_cast<int>(objectScope));
+    if (it != d->m_attrValidators.constEnd()) {
+        const shared::AttributeStore::Entry *entry = object->attributeStore().find(it->m_attrId);
+        if (entry) {
+            const QString value = entry->value.value<QString>();
+            const QRegularExpressionMatch match = it->m_rx.match(value);
+            return match.capturedLength() == value.length();
+        }
+        return true;
     }
     return false;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "attributestore.h"
+
 #include <QObject>
 #include <QVariant>
 #include <QVector>
@@ -59,6 +61,7 @@ public:
 
     QString name() const;
     void setName(const QString &name);
+    shared::AttributeId attributeId() const;
 
     QString label() const;
     void setLabel(const QString &name);
@@ -96,6 +99,8 @@ public:
     static QVariant convertData(const QVariant &value, PropertyTemplate::Type type);
 
     bool validate(const IVObject *object) const;
+    bool validate(const IVObject *object, PropertyTemplate::Scope objectScope) const;
+    static PropertyTemplate::Scope objectScope(const IVObject *object);
 
 private:
     struct PropertyTemplatePrivate;
@@ -88,6 +88,37 @@ struct PropertyTemplateConfig::PropertyTemplateConfigPrivate {
                 m_provIface.append(attr);
         }
 
+        buildIndex(m_function, m_functionByName);
+        buildIndex(m_myFunction, m_myFunctionByName);
+        buildIndex(m_reqIface, m_reqIfaceByName);
+        buildIndex(m_provIface, m_provIfaceByName);
+    }
+
+    static void buildIndex(const QList<PropertyTemplate *> &attrs, QHash<QString, PropertyTemplate *> &index)
+    {
+        index.clear();
+        index.reserve(attrs.size());
+        // Iterate backwards, so the first template of a name wins - same as a linear search would
+        for (auto it = attrs.crbegin(); it != attrs.crend(); ++it) {
+            index.insert((*it)->name(), *it);
+        }
+    }
+
+    const QHash<QString, PropertyTemplate *> *indexForObject(const ivm::IVObject *obj) const
+    {
+        switch (obj->type()) {
+        case ivm::IVObject::Type::FunctionType:
+        case ivm::IVObject::Type::Function:
+            return &m_functionByName;
+        case ivm::IVObject::Type::RequiredInterface:
+            return &m_reqIfaceByName;
+        case ivm::IVObject::Type::ProvidedInterface:
+            return &m_provIfaceByName;
+        case ivm::IVObject::Type::MyFunction:
+            return &m_myFunctionByName;
+        default:
+            return nullptr;
+        }
     }
 
     QString m_configPath;
@@ -95,6 +126,11 @@ struct PropertyTemplateConfig::PropertyTemplateConfigPrivate {
     QList<PropertyTemplate *> m_myFunction;
     QList<PropertyTemplate *> m_reqIface;
     QList<PropertyTemplate *> m_provIface;
+
+    QHash<QString, PropertyTemplate *> m_functionByName;
+    QHash<QString, PropertyTemplate *> m_myFunctionByName;
+    QHash<QString, PropertyTemplate *> m_reqIfaceByName;
+    QHash<QString, PropertyTemplate *> m_provIfaceByName;
 };
 
 PropertyTemplateConfig::PropertyTemplateConfig()
@@ -178,12 +214,8 @@ bool PropertyTemplateConfig::hasPropertyTemplateForObject(const IVObject *obj, c
 
 PropertyTemplate *PropertyTemplateConfig::propertyTemplateForObject(const IVObject *obj, const QString &name) const
 {
-    const QList<PropertyTemplate *> templates = propertyTemplatesForObject(obj);
-    auto it = std::find_if(templates.constBegin(), templates.constEnd(), [name](PropertyTemplate *propTemplate) {
-        return propTemplate->name() == name;
-        ;
-    });
-    return it == templates.constEnd() ? nullptr : *it;
+    const QHash<QString, PropertyTemplate *> *index = d->indexForObject(obj);
+    return index ? index->value(name, nullptr) : nullptr;
 }
 
 QList<PropertyTemplate *> PropertyTemplateConfig::parseAttributesList(
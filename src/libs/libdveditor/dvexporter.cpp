@@ -34,6 +34,8 @@
 #include "templating/exportabledvpartition.h"
 #include "templating/exportabledvprocessor.h"
 
+#include <QBuffer>
+
 namespace dve {
 
 QString DVExporter::defaultTemplatePath() const
@@ -46,6 +48,12 @@ DVExporter::DVExporter(QObject *parent)
 {
 }
 
+bool DVExporter::exportObjects(const QList<dvm::DVObject *> &objects, QBuffer *outBuffer, const QString &templatePath)
+{
+    const QHash<QString, QVariant> dvObjects = collectObjects(objects);
+    return exportData(dvObjects, templatePath, outBuffer);
+}
+
 QVariant DVExporter::createFrom(const shared::VEObject *object) const
 {
     return ExportableDVObject::createFrom(object->as<const dvm::DVObject *>());
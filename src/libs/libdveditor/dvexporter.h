@@ -19,6 +19,8 @@
 
 #include "objectsexporter.h"
 
+class QBuffer;
+
 namespace dvm {
 class DVObject;
 }
@@ -32,6 +34,9 @@ public:
     explicit DVExporter(QObject *parent = nullptr);
     QString defaultTemplatePath() const override;
 
+    bool exportObjects(
+            const QList<dvm::DVObject *> &objects, QBuffer *outBuffer, const QString &templatePath = QString());
+
 private:
     /**
      * @brief DVExporter::createFrom creates appropriate exported class and casts to QVariant
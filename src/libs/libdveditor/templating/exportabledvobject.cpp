@@ -17,6 +17,7 @@
 
 #include "exportabledvobject.h"
 
+#include "attributestore.h"
 #include "dvbinding.h"
 #include "dvbus.h"
 #include "dvconnection.h"
@@ -52,7 +53,7 @@ QString ExportableDVObject::name() const
  */
 QVariantList ExportableDVObject::attributes() const
 {
-    return generateProperties(exportedObject<dvm::DVObject>()->entityAttributes(), false);
+    return generateProperties(exportedObject<dvm::DVObject>()->attributeStore(), false);
 }
 
 /**
@@ -61,7 +62,7 @@ QVariantList ExportableDVObject::attributes() const
  */
 QVariantList ExportableDVObject::properties() const
 {
-    return generateProperties(exportedObject<dvm::DVObject>()->entityAttributes(), true);
+    return generateProperties(exportedObject<dvm::DVObject>()->attributeStore(), true);
 }
 
 QVariant ExportableDVObject::createFrom(const dvm::DVObject *dvObject)
@@ -91,15 +92,16 @@ QVariant ExportableDVObject::createFrom(const dvm::DVObject *dvObject)
 
 /**
  * @brief ExportableDVObject::generateProperties generates a variant list sorted by meta::Props::Token.
- * @param props can be hash of attributes or properties of DVObject.
+ * @param attributes the attributes of the DVObject, only the properties or only the other attributes are used.
  * @return sorted QVariantList which can be used in string templates
  */
-QVariantList ExportableDVObject::generateProperties(const EntityAttributes &attributes, bool isProperty)
+QVariantList ExportableDVObject::generateProperties(const shared::AttributeStore &attributes, bool isProperty)
 {
     QVariantList result;
-    for (auto it = attributes.cbegin(); it != attributes.cend(); ++it) {
-        if (it.value().isProperty() == isProperty) {
-            result << QVariant::fromValue(templating::ExportableProperty(it.key(), it.value().value()));
+    for (const shared::AttributeStore::Entry &entry : attributes) {
+        if ((entry.type == EntityAttribute::Type::Property) == isProperty) {
+            result << QVariant::fromValue(templating::ExportableProperty(
+                    shared::AttributeNameTable::name(entry.id), entry.value));
         }
     }
 
@@ -18,10 +18,13 @@
 #pragma once
 
 #include "abstractexportableobject.h"
-#include "entityattribute.h"
 
 #include <QVariant>
 
+namespace shared {
+class AttributeStore;
+}
+
 namespace dvm {
 class DVObject;
 }
@@ -49,7 +52,7 @@ public:
     static QVariant createFrom(const dvm::DVObject *dvObject);
 
 protected:
-    static QVariantList generateProperties(const EntityAttributes &attributes, bool isProperty);
+    static QVariantList generateProperties(const shared::AttributeStore &attributes, bool isProperty);
 };
 
 }
@@ -28,6 +28,7 @@
 
 #include <QBuffer>
 #include <QDir>
+#include <QHash>
 #include <QPointF>
 #include <QStandardPaths>
 #include <QTemporaryDir>
@@ -49,6 +50,7 @@ CmdEntitiesImport::CmdEntitiesImport(const QByteArray &data, ivm::IVFunctionType
         static const QPointF outOfScene { std::numeric_limits<qreal>::max(), std::numeric_limits<qreal>::max() };
         QPointF basePoint { outOfScene };
         const QSet<QString> functionNames = m_model->nestedFunctionNames();
+        QHash<ivm::IVObject::Type, QVector<ivm::IVObject *>> objectsToRename;
         for (ivm::IVObject *obj : objects) {
             obj->setModel(m_model);
             if (obj->parentObject()) {
@@ -56,7 +58,7 @@ CmdEntitiesImport::CmdEntitiesImport(const QByteArray &data, ivm::IVFunctionType
             }
             if (functionNames.contains(obj->title())) {
                 obj->removeEntityAttribute(ivm::meta::Props::token(ivm::meta::Props::Token::name));
-                obj->setTitle(ivm::IVNameValidator::nextNameFor(obj));
+                objectsToRename[obj->type()].append(obj);
             }
             QVector<QPointF> coordinates = shared::graphicsviewutils::polygon(obj->coordinates());
             std::for_each(coordinates.cbegin(), coordinates.cend(), [&basePoint](const QPointF &point) {
@@ -67,6 +69,14 @@ CmdEntitiesImport::CmdEntitiesImport(const QByteArray &data, ivm::IVFunctionType
             });
             m_rootEntities.append(obj);
         }
+        // Name all clashing objects in one go, so they get distinct names
+        for (const QVector<ivm::IVObject *> &sameTypeObjects : qAsConst(objectsToRename)) {
+            const QStringList names =
+                    ivm::IVNameValidator::nextNamesFor(sameTypeObjects.first(), sameTypeObjects.size());
+            for (int idx = 0; idx < sameTypeObjects.size() && idx < names.size(); ++idx) {
+                sameTypeObjects[idx]->setTitle(names[idx]);
+            }
+        }
         const QPointF offset = basePoint == outOfScene ? QPointF() : pos - basePoint;
         for (ivm::IVObject *obj : objects) {
             QVector<QPointF> coordinates = shared::graphicsviewutils::polygon(obj->coordinates());
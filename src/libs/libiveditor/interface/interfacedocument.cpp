@@ -46,15 +46,18 @@
 #include "ivvisualizationmodelbase.h"
 #include "ivxmlreader.h"
 #include "propertytemplateconfig.h"
+#include "trace.h"
 
 #include <QAction>
 #include <QApplication>
 #include <QBuffer>
 #include <QClipboard>
+#include <QDateTime>
 #include <QDebug>
 #include <QDialogButtonBox>
 #include <QDir>
 #include <QDirIterator>
+#include <QFutureWatcher>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMenu>
@@ -65,10 +68,74 @@
 #include <QToolBar>
 #include <QUndoStack>
 #include <QVBoxLayout>
+#include <QtConcurrent>
 #include <algorithm>
 
 namespace ive {
 
+/*!
+   One component of the libraries, parsed on the thread pool. The parsed objects belong to no model until they are
+   published to \a model
+ */
+struct ComponentLoad {
+    QString path;
+    QDateTime lastModified;
+    ivm::IVModel *model { nullptr };
+    QThread *modelThread { nullptr };
+    QVector<ivm::IVObject *> objects;
+    QString error;
+};
+
+/*!
+   A component published to \a model, with the modification time of its file at the time of parsing
+ */
+struct LoadedComponent {
+    QDateTime lastModified;
+    ivm::IVModel *model { nullptr };
+    QVector<shared::Id> objectIds;
+};
+
+/*!
+   Parses the component of \p job. Runs on the thread pool, so the parsed objects are moved to the thread of the model
+   they will be published to. Children follow their parents
+ */
+static ComponentLoad parseComponent(const ComponentLoad &job)
+{
+    ComponentLoad result = job;
+    ivm::IVXMLReader parser;
+    if (!parser.readFile(result.path)) {
+        result.error = parser.errorString();
+        return result;
+    }
+
+    result.objects = parser.parsedObjects();
+    for (ivm::IVObject *object : qAsConst(result.objects)) {
+        if (!object->parent()) {
+            object->moveToThread(result.modelThread);
+        }
+    }
+    return result;
+}
+
+/*!
+   Adds the parsed objects of \p result to its model and returns what was published
+ */
+static LoadedComponent publishToModel(const ComponentLoad &result)
+{
+    result.model->addObjects(result.objects);
+
+    LoadedComponent component;
+    component.lastModified = result.lastModified;
+    component.model = result.model;
+    for (ivm::IVObject *object : result.objects) {
+        /// Objects failing their post initialization are dropped by the model
+        if (result.model->getObject(object->id()) == object) {
+            component.objectIds.append(object->id());
+        }
+    }
+    return component;
+}
+
 struct InterfaceDocument::InterfaceDocumentPrivate {
     cmd::CommandsStack *commandsStack { nullptr };
 
@@ -101,6 +168,10 @@ struct InterfaceDocument::InterfaceDocumentPrivate {
     Asn1Acn::Asn1ModelStorage *asnModelStorage { nullptr };
     QString mscFileName;
     QString asnFileName;
+
+    QHash<QString, LoadedComponent> loadedComponents;
+    QFutureWatcher<ComponentLoad> componentsWatcher;
+    QSet<int> publishedComponents;
 };
 
 /*!
@@ -126,10 +197,16 @@ InterfaceDocument::InterfaceDocument(QObject *parent)
     d->sharedModel = new ivm::IVModel(d->dynPropConfig, this);
     d->objectsModel = new ivm::IVModel(d->dynPropConfig, this);
     d->objectsModel->setSharedTypesModel(d->sharedModel);
+
+    connect(&d->componentsWatcher, &QFutureWatcher<ComponentLoad>::resultReadyAt, this,
+            &InterfaceDocument::publishComponent);
+    connect(&d->componentsWatcher, &QFutureWatcher<ComponentLoad>::finished, this,
+            &InterfaceDocument::availableComponentsLoaded);
 }
 
 InterfaceDocument::~InterfaceDocument()
 {
+    cancelComponentsLoading();
     delete d->view;
     delete d;
 }
@@ -249,6 +326,7 @@ bool InterfaceDocument::create(const QString &path)
 
 bool InterfaceDocument::load(const QString &path, QStringList *warnings)
 {
+    SC_TRACE_SCOPE("load", "InterfaceDocument::load", path);
     const QString oldPath = d->filePath;
     setPath(path);
 
@@ -263,25 +341,121 @@ bool InterfaceDocument::load(const QString &path, QStringList *warnings)
     return loaded;
 }
 
+/*!
+   Loads the shared types and the components library. The components are parsed concurrently on the thread pool and
+   published to the shared and import models one by one as they are ready. Components loaded before whose file did
+   not change since are not parsed again. Emits availableComponentsLoaded() when all components are published.
+   Always returns true, components failing to parse are reported as warnings
+ */
 bool InterfaceDocument::loadAvailableComponents()
 {
-    bool result = true;
+    SC_TRACE_SCOPE("io", "InterfaceDocument::loadAvailableComponents");
+    cancelComponentsLoading();
+
+    QSet<QString> foundPaths;
+    QVector<ComponentLoad> jobs;
+    auto collectComponents = [&](const QString &libraryPath, ivm::IVModel *model) {
+        QDirIterator libraryIt(libraryPath, QDir::Dirs | QDir::NoDotAndDotDot);
+        while (libraryIt.hasNext()) {
+            const QFileInfo fileInfo(libraryIt.next() + QDir::separator() + kDefaultInterfaceViewFileName);
+            if (!fileInfo.exists()) {
+                continue;
+            }
 
-    d->sharedModel->clear();
-    QDirIterator instantiatableIt(ive::sharedTypesPath(), QDir::Dirs | QDir::NoDotAndDotDot);
-    while (instantiatableIt.hasNext()) {
-        result |= loadComponentModel(
-                d->sharedModel, instantiatableIt.next() + QDir::separator() + kDefaultInterfaceViewFileName);
+            const QString path = fileInfo.absoluteFilePath();
+            foundPaths.insert(path);
+            const auto loaded = d->loadedComponents.constFind(path);
+            if (loaded != d->loadedComponents.constEnd() && loaded->model == model
+                    && loaded->lastModified == fileInfo.lastModified()) {
+                continue;
+            }
+
+            ComponentLoad job;
+            job.path = path;
+            job.lastModified = fileInfo.lastModified();
+            job.model = model;
+            job.modelThread = model->thread();
+            jobs.append(job);
+        }
+    };
+    collectComponents(ive::sharedTypesPath(), d->sharedModel);
+    collectComponents(ive::componentsLibraryPath(), d->importModel);
+
+    QStringList outdatedPaths;
+    for (auto it = d->loadedComponents.cbegin(); it != d->loadedComponents.cend(); ++it) {
+        const bool reloaded = std::any_of(
+                jobs.cbegin(), jobs.cend(), [&it](const ComponentLoad &job) { return job.path == it.key(); });
+        if (reloaded || !foundPaths.contains(it.key())) {
+            outdatedPaths.append(it.key());
+        }
+    }
+    for (const QString &path : qAsConst(outdatedPaths)) {
+        unloadComponent(path);
     }
 
-    d->importModel->clear();
-    QDirIterator importableIt(ive::componentsLibraryPath(), QDir::Dirs | QDir::NoDotAndDotDot);
-    while (importableIt.hasNext()) {
-        result |= loadComponentModel(
-                d->importModel, importableIt.next() + QDir::separator() + kDefaultInterfaceViewFileName);
+    d->componentsWatcher.setFuture(QtConcurrent::mapped(jobs, &parseComponent));
+    return true;
+}
+
+/*!
+   Publishes the component parsed at \p index of the running load to its model
+ */
+void InterfaceDocument::publishComponent(int index)
+{
+    if (d->publishedComponents.contains(index)) {
+        return;
     }
+    d->publishedComponents.insert(index);
 
-    return result;
+    const ComponentLoad result = d->componentsWatcher.resultAt(index);
+    if (!result.error.isEmpty()) {
+        qWarning() << result.error;
+        return;
+    }
+
+    unloadComponent(result.path);
+    d->loadedComponents.insert(result.path, publishToModel(result));
+}
+
+/*!
+   Removes the objects of the component loaded from \p path from its model and deletes them
+ */
+void InterfaceDocument::unloadComponent(const QString &path)
+{
+    const LoadedComponent component = d->loadedComponents.take(path);
+    if (!component.model) {
+        return;
+    }
+
+    for (auto it = component.objectIds.crbegin(); it != component.objectIds.crend(); ++it) {
+        if (ivm::IVObject *object = component.model->getObject(*it)) {
+            component.model->removeObject(object);
+            if (!object->parent() || object->parent() == component.model) {
+                delete object;
+            }
+        }
+    }
+}
+
+/*!
+   Waits for a running load and deletes the parsed, but not yet published, objects. The load is not canceled, as
+   QtConcurrent drops the results of canceled jobs, and with them the ownership of their objects
+ */
+void InterfaceDocument::cancelComponentsLoading()
+{
+    QFuture<ComponentLoad> future = d->componentsWatcher.future();
+    future.waitForFinished();
+    for (int idx = 0; idx < future.resultCount(); ++idx) {
+        if (!d->publishedComponents.contains(idx) && future.isResultReadyAt(idx)) {
+            const ComponentLoad result = future.resultAt(idx);
+            for (ivm::IVObject *object : result.objects) {
+                if (!object->parent()) {
+                    delete object;
+                }
+            }
+        }
+    }
+    d->publishedComponents.clear();
 }
 
 QString InterfaceDocument::getComponentName(const QStringList &exportNames)
@@ -376,6 +550,9 @@ bool InterfaceDocument::exportSelectedType()
     return false;
 }
 
+/*!
+   Loads the component at \p path into \p model right away, replacing the previously loaded version of it
+ */
 bool InterfaceDocument::loadComponentModel(ivm::IVModel *model, const QString &path)
 {
     if (path.isEmpty() || !QFileInfo::exists(path)) {
@@ -383,13 +560,20 @@ bool InterfaceDocument::loadComponentModel(ivm::IVModel *model, const QString &p
         return false;
     }
 
-    ivm::IVXMLReader parser;
-    if (!parser.readFile(path)) {
-        qWarning() << parser.errorString();
+    const QFileInfo fileInfo(path);
+    ComponentLoad job;
+    job.path = fileInfo.absoluteFilePath();
+    job.lastModified = fileInfo.lastModified();
+    job.model = model;
+    job.modelThread = model->thread();
+    const ComponentLoad result = parseComponent(job);
+    if (!result.error.isEmpty()) {
+        qWarning() << result.error;
         return false;
     }
 
-    model->addObjects(parser.parsedObjects());
+    unloadComponent(result.path);
+    d->loadedComponents.insert(result.path, publishToModel(result));
     return true;
 }
 
@@ -430,8 +614,8 @@ void InterfaceDocument::setAsn1FileName(const QString &asnfile)
         if (d->asnModelStorage->contains(asn1FilePath())) {
             checkAllInterfacesForAsn1Compliance();
         } else {
-            // does load the data
-            d->asnModelStorage->asn1DataTypes(asn1FilePath());
+            // loads the data in the background, the interfaces are checked once it's loaded
+            d->asnModelStorage->asn1DataTypesAsync(asn1FilePath());
         }
     }
 }
@@ -565,8 +749,8 @@ void InterfaceDocument::setAsn1ModelStorage(Asn1Acn::Asn1ModelStorage *asn1Stora
     }
 
     d->asnModelStorage = asn1Storage;
-    connect(d->asnModelStorage, &Asn1Acn::Asn1ModelStorage::dataTypesChanged, this, [&](const QString &fileName) {
-        if (fileName == asn1FilePath()) {
+    connect(d->asnModelStorage, &Asn1Acn::Asn1ModelStorage::dataTypesChanged, this, [&](const QStringList &fileNames) {
+        if (fileNames.contains(asn1FilePath())) {
             checkAllInterfacesForAsn1Compliance();
         }
     });
@@ -127,6 +127,8 @@ Q_SIGNALS:
 
     void asn1ParameterErrorDetected(const QStringList &faultyInterfaces);
 
+    void availableComponentsLoaded();
+
 public Q_SLOTS:
     void onSavedExternally(const QString &filePath, bool saved);
     void setObjects(const QVector<ivm::IVObject *> &objects, QStringList *warnings = nullptr);
@@ -159,6 +161,9 @@ private:
     QString getComponentName(const QStringList &exportNames);
     QList<ivm::IVObject *> prepareSelectedObjectsForExport(QString &name, bool silent = false);
     bool loadComponentModel(ivm::IVModel *model, const QString &path);
+    void publishComponent(int index);
+    void unloadComponent(const QString &path);
+    void cancelComponentsLoading();
 
     QWidget *createGraphicsView();
     QTreeView *createModelView();
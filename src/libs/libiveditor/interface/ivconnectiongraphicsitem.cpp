@@ -19,10 +19,12 @@
 
 #include "baseitems/common/ivutils.h"
 #include "colors/colormanager.h"
+#include "connectionrouter.h"
 #include "graphicsviewutils.h"
 #include "interface/graphicsitemhelpers.h"
 #include "ivcommentgraphicsitem.h"
 #include "ivconnection.h"
+#include "ivconnectionlayoutmanager.h"
 #include "ivfunction.h"
 #include "ivmyfunction.h"
 #include "ivfunctiongraphicsitem.h"
@@ -52,24 +54,12 @@ namespace ive {
  */
 static inline QVector<QPointF> generateConnectionPath(IVConnectionGraphicsItem *connection)
 {
-    if (!connection || !connection->scene())
+    ConnectionRoute route;
+    if (!connection || !connection->routeEnds(&route))
         return {};
 
-    const IVInterfaceGraphicsItem *startItem = connection->startItem();
-    const IVInterfaceGraphicsItem *endItem = connection->endItem();
-    if (!startItem || !endItem)
-        return {};
-
-    const QGraphicsScene *scene = connection->scene();
-    Q_ASSERT(startItem->scene() == endItem->scene() && scene);
-
-    const bool isStartEndpointNested = startItem->targetItem()->isAncestorOf(endItem);
-    const bool isEndEndpointNested = endItem->targetItem()->isAncestorOf(startItem);
-
-
     return shared::graphicsviewutils::createConnectionPath(shared::graphicsviewutils::siblingItemsRects(connection),
-            startItem->connectionEndPoint(isStartEndpointNested), startItem->targetItem()->sceneBoundingRect(),
-            endItem->connectionEndPoint(isEndEndpointNested), endItem->targetItem()->sceneBoundingRect());
+            route.startPos, route.sourceRect, route.endPos, route.targetRect);
 }
 
 IVConnectionGraphicsItem::GraphicsPathItem::GraphicsPathItem(QGraphicsItem *parent)
@@ -210,8 +200,13 @@ void IVConnectionGraphicsItem::rebuildLayout()
     }
 
     if (pathObsolete) {
-        layout();
-        mergeGeometry();
+        /// The current path stays until the new route is computed in the background
+        if (auto manager = IVConnectionLayoutManager::instance(scene())) {
+            manager->scheduleLayout(this);
+        } else {
+            layout();
+            mergeGeometry();
+        }
         return;
     }
 
@@ -245,8 +240,54 @@ void IVConnectionGraphicsItem::layout()
         return;
     }
 
-    m_points = generateConnectionPath(this);
+    if (auto manager = IVConnectionLayoutManager::instance(scene())) {
+        manager->layoutNow({ this });
+    } else {
+        m_points.clear();
+        updateBoundingRect();
+    }
+}
+
+/*!
+   Gets the end points of the connection and the geometries of the items they belong to.
+   Returns false if the connection can't be routed.
+ */
+bool IVConnectionGraphicsItem::routeEnds(ConnectionRoute *route) const
+{
+    if (!route || !scene() || !m_startItem || !m_endItem)
+        return false;
+
+    Q_ASSERT(m_startItem->scene() == m_endItem->scene());
+
+    const bool isStartEndpointNested = m_startItem->targetItem()->isAncestorOf(m_endItem);
+    const bool isEndEndpointNested = m_endItem->targetItem()->isAncestorOf(m_startItem);
+
+    route->startPos = m_startItem->connectionEndPoint(isStartEndpointNested);
+    route->sourceRect = m_startItem->targetItem()->sceneBoundingRect();
+    route->endPos = m_endItem->connectionEndPoint(isEndEndpointNested);
+    route->targetRect = m_endItem->targetItem()->sceneBoundingRect();
+    return true;
+}
+
+const ConnectionRoute &IVConnectionGraphicsItem::lastRoute() const
+{
+    return m_lastRoute;
+}
+
+/*!
+   Sets the path found by IVConnectionLayoutManager.
+   If \a updateEntity is set the new coordinates are stored in the entity and merged into the geometry change command
+   with the serial \a geometryCommandSerial, if that command is still the last one on the undo stack.
+ */
+void IVConnectionGraphicsItem::applyRoute(
+        const ConnectionRoute &route, bool updateEntity, quint64 geometryCommandSerial)
+{
+    m_lastRoute = route;
+    m_points = route.points;
     updateBoundingRect();
+    if (updateEntity) {
+        mergeGeometryInto(geometryCommandSerial);
+    }
 }
 
 bool IVConnectionGraphicsItem::replaceInterface(
@@ -275,13 +316,53 @@ void IVConnectionGraphicsItem::layoutInterfaceConnections(IVInterfaceGraphicsIte
         IVConnectionGraphicsItem::LayoutPolicy layoutPolicy,
         IVConnectionGraphicsItem::CollisionsPolicy collisionsPolicy, bool includingNested)
 {
-    for (IVConnectionGraphicsItem *connection : ifaceItem->connectionItems()) {
-        Q_ASSERT(connection && connection->startItem() && connection->endItem());
-        if (!connection) {
-            continue;
+    layoutInterfaceConnections(QList<IVInterfaceGraphicsItem *> { ifaceItem }, layoutPolicy, collisionsPolicy,
+            includingNested);
+}
+
+//! Updates all connections linked to \a ifaceItems the same way as for a single interface,
+//! the connections needing a new route are routed in one batch together with \a otherConnections
+void IVConnectionGraphicsItem::layoutInterfaceConnections(const QList<IVInterfaceGraphicsItem *> &ifaceItems,
+        IVConnectionGraphicsItem::LayoutPolicy layoutPolicy,
+        IVConnectionGraphicsItem::CollisionsPolicy collisionsPolicy, bool includingNested,
+        const QList<IVConnectionGraphicsItem *> &otherConnections)
+{
+    QList<IVConnectionGraphicsItem *> candidates = otherConnections;
+    QGraphicsScene *scene = nullptr;
+    for (IVInterfaceGraphicsItem *ifaceItem : ifaceItems) {
+        for (IVConnectionGraphicsItem *connection : ifaceItem->connectionItems()) {
+            Q_ASSERT(connection && connection->startItem() && connection->endItem());
+            if (!connection) {
+                continue;
+            }
+            if (includingNested || connection->parentItem() != ifaceItem->parentItem()) {
+                if (connection->updateConnectionLayout(ifaceItem, layoutPolicy, collisionsPolicy)) {
+                    candidates.append(connection);
+                }
+            }
         }
-        if (includingNested || connection->parentItem() != ifaceItem->parentItem()) {
-            connection->layoutConnection(ifaceItem, layoutPolicy, collisionsPolicy);
+        if (!scene) {
+            scene = ifaceItem->scene();
+        }
+    }
+
+    QList<IVConnectionGraphicsItem *> rerouted;
+    for (IVConnectionGraphicsItem *connection : qAsConst(candidates)) {
+        if (connection->m_startItem && connection->m_startItem->isVisible() && connection->m_endItem
+                && connection->m_endItem->isVisible()) {
+            rerouted.append(connection);
+        } else {
+            connection->setVisible(false);
+        }
+    }
+    if (rerouted.isEmpty()) {
+        return;
+    }
+    if (auto manager = IVConnectionLayoutManager::instance(scene ? scene : rerouted.first()->scene())) {
+        manager->layoutNow(rerouted);
+    } else {
+        for (IVConnectionGraphicsItem *connection : qAsConst(rerouted)) {
+            connection->layout();
         }
     }
 }
@@ -355,9 +436,9 @@ static inline QVector<QPointF> replaceIntersectedSegments(
         }
     }
     sections.erase(std::unique(sections.begin(), sections.end()), sections.end());
-    const QList<QRectF> existingRects = shared::graphicsviewutils::siblingItemsRects(connection);
+    const shared::graphicsviewutils::ObstacleIndex obstacles(shared::graphicsviewutils::siblingItemsRects(connection));
     for (auto chunk : sections) {
-        const QVector<QPointF> subPath = shared::graphicsviewutils::path(existingRects, chunk.first, chunk.second);
+        const QVector<QPointF> subPath = shared::graphicsviewutils::routePath(obstacles, chunk.first, chunk.second);
         if (!points.isEmpty()) {
             /// Remove overlapped chunk
             const int idxStart = points.indexOf(chunk.first);
@@ -388,9 +469,18 @@ static inline QVector<QPointF> replaceIntersectedSegments(
 void IVConnectionGraphicsItem::layoutConnection(
         IVInterfaceGraphicsItem *ifaceItem, LayoutPolicy layoutPolicy, CollisionsPolicy collisionsPolicy)
 {
-    if (layoutPolicy == LayoutPolicy::Default) {
+    if (updateConnectionLayout(ifaceItem, layoutPolicy, collisionsPolicy)) {
         layout();
-        return;
+    }
+}
+
+//! Applies \a layoutPolicy and \a collisionsPolicy except generating a new path,
+//! returns true if the connection has to be routed again
+bool IVConnectionGraphicsItem::updateConnectionLayout(
+        IVInterfaceGraphicsItem *ifaceItem, LayoutPolicy layoutPolicy, CollisionsPolicy collisionsPolicy)
+{
+    if (layoutPolicy == LayoutPolicy::Default) {
+        return true;
     } else if (layoutPolicy == LayoutPolicy::LastSegment) {
         updateEndPoint(ifaceItem);
     } else if (layoutPolicy == LayoutPolicy::Scaling) {
@@ -398,16 +488,16 @@ void IVConnectionGraphicsItem::layoutConnection(
     }
 
     if (CollisionsPolicy::Ignore == collisionsPolicy) {
-        return;
+        return false;
     } else if (CollisionsPolicy::PartialRebuild == collisionsPolicy) {
         updateOverlappedSections();
     } else if (CollisionsPolicy::Rebuild == collisionsPolicy) {
         const QList<QGraphicsItem *> overlappedItems = intersectedItems(this, kNestedTypes);
         if (!overlappedItems.isEmpty()) {
-            layout();
-            return;
+            return true;
         }
     }
+    return false;
 }
 
 //! Replaces intersected segments of connection path with newly generated subpaths if any
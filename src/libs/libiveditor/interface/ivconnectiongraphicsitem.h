@@ -18,6 +18,7 @@
 #pragma once
 
 #include "ivconnection.h"
+#include "ivconnectionlayoutmanager.h"
 #include "ivobject.h"
 #include "ui/veinteractiveobject.h"
 
@@ -88,10 +89,17 @@ public:
 
     void layout();
 
+    bool routeEnds(ConnectionRoute *route) const;
+    const ConnectionRoute &lastRoute() const;
+    void applyRoute(const ConnectionRoute &route, bool updateEntity = false, quint64 geometryCommandSerial = 0);
+
     bool replaceInterface(IVInterfaceGraphicsItem *ifaceToBeReplaced, IVInterfaceGraphicsItem *newIface);
 
     static void layoutInterfaceConnections(IVInterfaceGraphicsItem *ifaceItem, LayoutPolicy layoutPolicy,
             CollisionsPolicy collisionsPolicy, bool includingNested);
+    static void layoutInterfaceConnections(const QList<IVInterfaceGraphicsItem *> &ifaceItems,
+            LayoutPolicy layoutPolicy, CollisionsPolicy collisionsPolicy, bool includingNested,
+            const QList<IVConnectionGraphicsItem *> &otherConnections = {});
     void layoutConnection(
             IVInterfaceGraphicsItem *ifaceItem, LayoutPolicy layoutPolicy, CollisionsPolicy collisionsPolicy);
 
@@ -119,6 +127,8 @@ private:
     void transformToEndPoint(const IVInterfaceGraphicsItem *iface);
     void updateLastSegment(const IVInterfaceGraphicsItem *iface);
     void updateEndPoint(const IVInterfaceGraphicsItem *iface);
+    bool updateConnectionLayout(
+            IVInterfaceGraphicsItem *ifaceItem, LayoutPolicy layoutPolicy, CollisionsPolicy collisionsPolicy);
 
     enum class IfaceConnectionReference
     {
@@ -142,6 +152,9 @@ private:
     GraphicsPathItem *m_item = nullptr;
     QVector<QPointF> m_points;
     bool m_firstUpdate { true };
+
+    /// Last generated route, reused while the end points didn't move and no obstacle overlaps it
+    ConnectionRoute m_lastRoute;
 };
 
 }
@@ -0,0 +1,264 @@
+/*
+  Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "ivconnectionlayoutmanager.h"
+
+#include "connectionrouter.h"
+#include "graphicsviewutils.h"
+#include "ivconnectiongraphicsitem.h"
+
+#include <QGraphicsScene>
+#include <QTimer>
+#include <QtConcurrentMap>
+
+namespace ive {
+
+bool ConnectionRoute::hasSameEnds(const ConnectionRoute &other) const
+{
+    return startPos == other.startPos && sourceRect == other.sourceRect && endPos == other.endPos
+            && targetRect == other.targetRect;
+}
+
+IVConnectionLayoutManager::IVConnectionLayoutManager(QGraphicsScene *scene)
+    : QObject(scene)
+{
+    connect(&m_watcher, &QFutureWatcher<ConnectionRoute>::finished, this, &IVConnectionLayoutManager::applyResults);
+}
+
+IVConnectionLayoutManager::~IVConnectionLayoutManager()
+{
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
+/*!
+   Returns the manager of \p scene, it's created on the first request and owned by the scene
+ */
+IVConnectionLayoutManager *IVConnectionLayoutManager::instance(QGraphicsScene *scene)
+{
+    if (!scene) {
+        return nullptr;
+    }
+
+    auto manager = scene->findChild<IVConnectionLayoutManager *>(QString(), Qt::FindDirectChildrenOnly);
+    return manager ? manager : new IVConnectionLayoutManager(scene);
+}
+
+/*!
+   Routes all \p connections and applies the new paths before returning.
+   Results of earlier scheduled layouts of these connections are dropped.
+ */
+void IVConnectionLayoutManager::layoutNow(const QList<IVConnectionGraphicsItem *> &connections)
+{
+    const QVector<Job> jobs = prepareJobs(connections, false);
+    if (jobs.isEmpty()) {
+        return;
+    }
+
+    QVector<ConnectionRoute> results;
+    if (jobs.size() == 1) {
+        results.append(computeRoute(jobs.first()));
+    } else {
+        results = QtConcurrent::blockingMapped<QVector<ConnectionRoute>>(jobs, &IVConnectionLayoutManager::computeRoute);
+    }
+
+    for (int idx = 0; idx < jobs.size(); ++idx) {
+        if (IVConnectionGraphicsItem *connection = jobs.at(idx).connection) {
+            connection->applyRoute(results.at(idx));
+        }
+    }
+}
+
+/*!
+   Queues \p connection to be routed in the background.
+   All connections scheduled during the same event loop iteration are routed as one batch.
+ */
+void IVConnectionLayoutManager::scheduleLayout(IVConnectionGraphicsItem *connection)
+{
+    if (connection) {
+        queueLayout(connection, connection->topGeometryCommandSerial());
+    }
+}
+
+/*!
+   Queues \p connection, its route gets recorded in the geometry change with the serial \p geometryCommand
+ */
+void IVConnectionLayoutManager::queueLayout(IVConnectionGraphicsItem *connection, quint64 geometryCommand)
+{
+    nextGeneration(connection);
+    if (geometryCommand != 0) {
+        m_geometryCommands.insert(connection, geometryCommand);
+    }
+    if (!m_pending.contains(connection)) {
+        m_pending.append(connection);
+    }
+    if (!m_startScheduled) {
+        m_startScheduled = true;
+        QTimer::singleShot(0, this, &IVConnectionLayoutManager::startPending);
+    }
+}
+
+bool IVConnectionLayoutManager::hasPendingLayouts() const
+{
+    return !m_pending.isEmpty() || !m_runningJobs.isEmpty();
+}
+
+/*!
+   Blocks until all scheduled layouts are computed and applied
+ */
+void IVConnectionLayoutManager::waitForDone()
+{
+    while (hasPendingLayouts()) {
+        if (m_runningJobs.isEmpty()) {
+            startPending();
+        }
+        m_watcher.waitForFinished();
+        applyResults();
+    }
+}
+
+QVector<IVConnectionLayoutManager::Job> IVConnectionLayoutManager::prepareJobs(
+        const QList<IVConnectionGraphicsItem *> &connections, bool updateEntities)
+{
+    QVector<Job> jobs;
+    QHash<const QGraphicsItem *, QSharedPointer<shared::graphicsviewutils::ObstacleIndex>> obstacles;
+    for (IVConnectionGraphicsItem *connection : connections) {
+        if (!connection || std::any_of(jobs.cbegin(), jobs.cend(), [connection](const Job &job) {
+                return job.connection == connection;
+            })) {
+            continue;
+        }
+
+        Job job;
+        job.connection = connection;
+        job.generation = nextGeneration(connection);
+        job.geometryCommand = m_geometryCommands.take(connection);
+        if (!connection->routeEnds(&job.route)) {
+            connection->applyRoute(job.route, updateEntities, job.geometryCommand);
+            continue;
+        }
+
+        /// All connections of one nesting level avoid the same rectangles
+        auto &index = obstacles[connection->parentItem()];
+        if (!index) {
+            index = QSharedPointer<shared::graphicsviewutils::ObstacleIndex>::create(
+                    shared::graphicsviewutils::siblingItemsRects(connection));
+        }
+        job.obstacles = index;
+
+        const ConnectionRoute &lastRoute = connection->lastRoute();
+        if (job.route.hasSameEnds(lastRoute)
+                && shared::graphicsviewutils::ConnectionRouter(*index).isRouteValid(lastRoute.points)) {
+            /// Nothing relevant for this connection has changed, keep the route found before
+            connection->applyRoute(lastRoute, updateEntities, job.geometryCommand);
+            continue;
+        }
+        jobs.append(job);
+    }
+    return jobs;
+}
+
+quint64 IVConnectionLayoutManager::nextGeneration(IVConnectionGraphicsItem *connection)
+{
+    auto it = m_generations.find(connection);
+    if (it == m_generations.end()) {
+        connect(connection, &QObject::destroyed, this, [this, connection]() {
+            m_generations.remove(connection);
+            m_geometryCommands.remove(connection);
+        });
+        it = m_generations.insert(connection, 0);
+    }
+    return ++it.value();
+}
+
+void IVConnectionLayoutManager::startPending()
+{
+    m_startScheduled = false;
+    if (!m_runningJobs.isEmpty()) {
+        /// Restarted from applyResults once the running batch is done
+        return;
+    }
+
+    QList<IVConnectionGraphicsItem *> connections;
+    for (const QPointer<IVConnectionGraphicsItem> &connection : qAsConst(m_pending)) {
+        if (connection) {
+            connections.append(connection);
+        }
+    }
+    m_pending.clear();
+
+    const QVector<Job> jobs = prepareJobs(connections, true);
+    if (jobs.isEmpty()) {
+        Q_EMIT layoutsApplied();
+        return;
+    }
+
+    m_runningJobs = jobs;
+    m_watcher.setFuture(QtConcurrent::mapped(m_runningJobs, &IVConnectionLayoutManager::computeRoute));
+}
+
+void IVConnectionLayoutManager::applyResults()
+{
+    /// The watcher itself only reports being finished once its finished event was delivered
+    if (m_runningJobs.isEmpty() || !m_watcher.future().isFinished()) {
+        return;
+    }
+
+    const QVector<Job> jobs = m_runningJobs;
+    m_runningJobs.clear();
+    if (m_watcher.isCanceled()) {
+        return;
+    }
+
+    const QList<ConnectionRoute> results = m_watcher.future().results();
+    for (int idx = 0; idx < jobs.size() && idx < results.size(); ++idx) {
+        const Job &job = jobs.at(idx);
+        IVConnectionGraphicsItem *connection = job.connection;
+        if (!connection || m_generations.value(connection) != job.generation) {
+            /// The connection is gone or was scheduled again
+            continue;
+        }
+
+        ConnectionRoute current;
+        if (!connection->routeEnds(&current) || !current.hasSameEnds(job.route)) {
+            /// Geometry changed while the route was computed without a new request,
+            /// so the new layout still belongs to the command of this job
+            queueLayout(connection, job.geometryCommand);
+            continue;
+        }
+        connection->applyRoute(results.at(idx), true, job.geometryCommand);
+    }
+
+    if (!m_pending.isEmpty() && !m_startScheduled) {
+        m_startScheduled = true;
+        QTimer::singleShot(0, this, &IVConnectionLayoutManager::startPending);
+    }
+    Q_EMIT layoutsApplied();
+}
+
+/*!
+   Computes the route of \p job. Runs on a worker thread, so it must only touch the immutable job data.
+ */
+ConnectionRoute IVConnectionLayoutManager::computeRoute(const Job &job)
+{
+    ConnectionRoute route = job.route;
+    route.points = shared::graphicsviewutils::createConnectionPath(
+            *job.obstacles, route.startPos, route.sourceRect, route.endPos, route.targetRect);
+    return route;
+}
+
+}
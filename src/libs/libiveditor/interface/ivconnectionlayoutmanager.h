@@ -0,0 +1,107 @@
+/*
+  Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QRectF>
+#include <QSharedPointer>
+#include <QVector>
+
+class QGraphicsScene;
+
+namespace shared {
+namespace graphicsviewutils {
+class ObstacleIndex;
+}
+}
+
+namespace ive {
+class IVConnectionGraphicsItem;
+
+/*!
+   End points of a connection, the geometries of the items they belong to and the route found between them
+ */
+struct ConnectionRoute {
+    QPointF startPos;
+    QRectF sourceRect;
+    QPointF endPos;
+    QRectF targetRect;
+    QVector<QPointF> points;
+
+    bool hasSameEnds(const ConnectionRoute &other) const;
+};
+
+/*!
+   \class ive::IVConnectionLayoutManager
+   Computes the routes of a batch of connections of one scene.
+
+   The obstacle rectangles are snapshot once per nesting level on the UI thread, the routes are then computed in
+   parallel on the global thread pool and all results are applied to the graphics items at once.
+   \ref layoutNow waits for the results, \ref scheduleLayout returns immediately: the connection keeps showing its
+   old path until the new route is applied. A result is dropped if its connection was scheduled again or its end
+   points moved in the meantime.
+   A scheduled route is recorded in the geometry change that was the last command when the layout was requested.
+   If other commands were done in the meantime, the route is applied without being recorded.
+ */
+class IVConnectionLayoutManager : public QObject
+{
+    Q_OBJECT
+public:
+    explicit IVConnectionLayoutManager(QGraphicsScene *scene);
+    ~IVConnectionLayoutManager() override;
+
+    static IVConnectionLayoutManager *instance(QGraphicsScene *scene);
+
+    void layoutNow(const QList<IVConnectionGraphicsItem *> &connections);
+    void scheduleLayout(IVConnectionGraphicsItem *connection);
+
+    bool hasPendingLayouts() const;
+    void waitForDone();
+
+Q_SIGNALS:
+    void layoutsApplied();
+
+private:
+    struct Job {
+        QPointer<IVConnectionGraphicsItem> connection;
+        quint64 generation = 0;
+        quint64 geometryCommand = 0; ///< Serial of the geometry change that requested the layout
+        ConnectionRoute route;
+        QSharedPointer<shared::graphicsviewutils::ObstacleIndex> obstacles;
+    };
+
+    QVector<Job> prepareJobs(const QList<IVConnectionGraphicsItem *> &connections, bool updateEntities);
+    void queueLayout(IVConnectionGraphicsItem *connection, quint64 geometryCommand);
+    quint64 nextGeneration(IVConnectionGraphicsItem *connection);
+    void startPending();
+    void applyResults();
+
+    static ConnectionRoute computeRoute(const Job &job);
+
+    QHash<IVConnectionGraphicsItem *, quint64> m_generations;
+    QHash<IVConnectionGraphicsItem *, quint64> m_geometryCommands;
+    QList<QPointer<IVConnectionGraphicsItem>> m_pending;
+    QVector<Job> m_runningJobs;
+    QFutureWatcher<ConnectionRoute> m_watcher;
+    bool m_startScheduled = false;
+};
+
+}
@@ -207,9 +207,9 @@ static inline QPointF mapPositionFromOrigin(ivm::IVInterface *iface, ivm::meta::
     const auto parentFn = iface->parentObject()->as<ivm::IVFunctionType *>();
     const QRectF fnRect = shared::graphicsviewutils::rect(
             ivm::IVObject::coordinatesFromString(
-                    parentFn->entityAttributeValue<QString>(ivm::meta::Props::token(coordinateToken))))
+                    parentFn->entityAttributeValue<QString>(ivm::IVObject::attributeId(coordinateToken))))
                                   .normalized();
-    const QString strCoordinates = iface->entityAttributeValue<QString>(ivm::meta::Props::token(coordinateToken));
+    const QString strCoordinates = iface->entityAttributeValue<QString>(ivm::IVObject::attributeId(coordinateToken));
     QPointF pos = shared::graphicsviewutils::pos(ivm::IVObject::coordinatesFromString(strCoordinates));
 
     *side = shared::graphicsviewutils::getNearestSide(fnRect, pos);
@@ -328,7 +328,7 @@ void IVInterfaceGraphicsItem::layout()
     ivm::meta::Props::Token token = entity()->coordinatesType();
     while (pos.isNull() && idx < types.size()) {
         token = types.at(idx);
-        const QString strCoordinates = entity()->entityAttributeValue<QString>(ivm::meta::Props::token(token));
+        const QString strCoordinates = entity()->entityAttributeValue<QString>(ivm::IVObject::attributeId(token));
         pos = shared::graphicsviewutils::pos(ivm::IVObject::coordinatesFromString(strCoordinates));
         ++idx;
     }
@@ -39,6 +39,7 @@
 #include "ivinterface.h"
 #include "ivinterfacegroup.h"
 #include "ivmyfunction.h"
+#include "trace.h"
 
 #include <QGraphicsView>
 #include <QGuiApplication>
@@ -176,6 +177,7 @@ void IVItemModel::onIVObjectAdded(ivm::IVObject *object)
 
 void IVItemModel::onObjectsAdded(const QVector<shared::Id> &objectsIds)
 {
+    SC_TRACE_SCOPE("scene", "IVItemModel::onObjectsAdded");
     QList<ivm::IVObject *> objectsToAdd;
     for (auto id : objectsIds) {
         objectsToAdd.append(m_model->getObject(id));
@@ -365,7 +367,8 @@ void IVItemModel::setupInnerGeometry(ivm::IVObject *obj) const
         return;
     }
 
-    QVariant innerCoord = obj->entityAttributeValue(ivm::meta::Props::token(ivm::meta::Props::Token::InnerCoordinates));
+    QVariant innerCoord =
+            obj->entityAttributeValue(ivm::IVObject::attributeId(ivm::meta::Props::Token::InnerCoordinates));
     if (innerCoord.isValid()) {
         return;
     }
@@ -375,7 +378,7 @@ void IVItemModel::setupInnerGeometry(ivm::IVObject *obj) const
     }
     QRectF rootGeometry;
     const QVariant rootCoord =
-            parentObj->entityAttributeValue(ivm::meta::Props::token(ivm::meta::Props::Token::RootCoordinates));
+            parentObj->entityAttributeValue(ivm::IVObject::attributeId(ivm::meta::Props::Token::RootCoordinates));
     if (rootCoord.isValid()) {
         rootGeometry = shared::graphicsviewutils::rect(ivm::IVObject::coordinatesFromString(rootCoord.toString()));
     }
@@ -384,7 +387,7 @@ void IVItemModel::setupInnerGeometry(ivm::IVObject *obj) const
     for (const ivm::IVObject *child : parentObj->children()) {
         if (kTypes.contains(child->type())) {
             innerCoord =
-                    child->entityAttributeValue(ivm::meta::Props::token(ivm::meta::Props::Token::InnerCoordinates));
+                    child->entityAttributeValue(ivm::IVObject::attributeId(ivm::meta::Props::Token::InnerCoordinates));
             if (!innerCoord.isValid()) {
                 continue;
             }
@@ -281,7 +281,7 @@ void IVMyFunctionGraphicsItem::drawNestedView(QPainter *painter)
     };
     QList<ConnectionData> parentConnections;
     for (const ivm::IVObject *child : qAsConst(childEntities)) {
-        const QString strCoordinates = child->entityAttributeValue<QString>(ivm::meta::Props::token(token));
+        const QString strCoordinates = child->entityAttributeValue<QString>(ivm::IVObject::attributeId(token));
         if (child->type() == ivm::IVObject::Type::MyFunction || child->type() == ivm::IVObject::Type::FunctionType
                 || child->type() == ivm::IVObject::Type::Comment) {
             const QRectF itemSceneRect =
@@ -332,7 +332,7 @@ void IVMyFunctionGraphicsItem::drawNestedView(QPainter *painter)
                 QPointF innerIfacePos;
                 if (innerIface->hasEntityAttribute(ivm::meta::Props::token(token))) {
                     const QString ifaceStrCoordinates =
-                            innerIface->entityAttributeValue<QString>(ivm::meta::Props::token(token));
+                            innerIface->entityAttributeValue<QString>(ivm::IVObject::attributeId(token));
                     innerIfacePos =
                             shared::graphicsviewutils::pos(ivm::IVObject::coordinatesFromString(ifaceStrCoordinates));
                 }
@@ -419,26 +419,31 @@ void IVMyFunctionGraphicsItem::drawNestedView(QPainter *painter)
 void IVMyFunctionGraphicsItem::layoutConnectionsOnResize(IVConnectionGraphicsItem::CollisionsPolicy collisionsPolicy)
 {
     /// Changing inner and outer connections bound to current function item
+    QList<IVInterfaceGraphicsItem *> ifaces;
+    QList<IVConnectionGraphicsItem *> nestedConnections;
     for (const auto item : childItems()) {
         if (auto iface = qgraphicsitem_cast<IVInterfaceGraphicsItem *>(item)) {
-            IVConnectionGraphicsItem::layoutInterfaceConnections(
-                    iface, IVConnectionGraphicsItem::LayoutPolicy::Scaling, collisionsPolicy, true);
+            ifaces.append(iface);
         } else if (auto connection = qgraphicsitem_cast<IVConnectionGraphicsItem *>(item)) {
             if (connection->mySourceItem() != this && connection->myTargetItem() != this)
-                connection->layout();
+                nestedConnections.append(connection);
         }
     }
+    IVConnectionGraphicsItem::layoutInterfaceConnections(
+            ifaces, IVConnectionGraphicsItem::LayoutPolicy::Scaling, collisionsPolicy, true, nestedConnections);
 }
 
 void IVMyFunctionGraphicsItem::layoutConnectionsOnMove(IVConnectionGraphicsItem::CollisionsPolicy collisionsPolicy)
 {
     /// Changing outer connections only cause inner stay unchanged as children of current item
+    QList<IVInterfaceGraphicsItem *> ifaces;
     for (const auto item : childItems()) {
         if (auto iface = qgraphicsitem_cast<IVInterfaceGraphicsItem *>(item)) {
-            IVConnectionGraphicsItem::layoutInterfaceConnections(
-                    iface, IVConnectionGraphicsItem::LayoutPolicy::Scaling, collisionsPolicy, false);
+            ifaces.append(iface);
         }
     }
+    IVConnectionGraphicsItem::layoutInterfaceConnections(
+            ifaces, IVConnectionGraphicsItem::LayoutPolicy::Scaling, collisionsPolicy, false);
 }
 
 void IVMyFunctionGraphicsItem::prepareTextRect(QRectF &textRect, const QRectF &targetTextRect) const
@@ -17,6 +17,7 @@
 
 #include "iveditorcore.h"
 
+#include "asn1modelstorage.h"
 #include "baseitems/common/ivutils.h"
 #include "commandlineparser.h"
 #include "commandsstack.h"
@@ -36,6 +37,7 @@
 #include "ivfunction.h"
 #include "ivinterface.h"
 #include "ivmodel.h"
+#include "memoryreport.h"
 
 #include <QDateTime>
 #include <QDebug>
@@ -69,8 +71,8 @@ IVEditorCore::IVEditorCore(QObject *parent)
     m_docToolBar->setMovable(true);
 
     if (ivm::IVModel *model = document()->objectsModel()) {
-        connect(model, &ivm::IVModel::objectsAdded, this, &ive::IVEditorCore::updateIVItems);
-        connect(model, &ivm::IVModel::objectRemoved, this, &ive::IVEditorCore::updateIVItems);
+        connect(model, &ivm::IVModel::objectsAdded, this, &ive::IVEditorCore::onObjectsAdded);
+        connect(model, &ivm::IVModel::objectRemoved, this, &ive::IVEditorCore::onObjectRemoved);
         connect(model, &ivm::IVModel::rootObjectChanged, this, &ive::IVEditorCore::updateIVItems);
     }
 }
@@ -113,6 +115,8 @@ void IVEditorCore::populateCommandLineArguments(shared::CommandLineParser *parse
     parser->handlePositional(shared::CommandLineParser::Positional::ExportToFile);
     parser->handlePositional(shared::CommandLineParser::Positional::ListScriptableActions);
     parser->handlePositional(shared::CommandLineParser::Positional::DropUnsavedChangesSilently);
+    parser->handlePositional(shared::CommandLineParser::Positional::TraceFile);
+    parser->handlePositional(shared::CommandLineParser::Positional::MemoryReportFile);
 }
 
 QAction *IVEditorCore::actionExportFunctions()
@@ -366,6 +370,20 @@ QUndoStack *IVEditorCore::undoStack() const
     return m_document->undoStack();
 }
 
+/*!
+   Adds the IV models, the scene and the ASN.1 types to \p report
+ */
+void IVEditorCore::addToMemoryReport(shared::MemoryReport *report) const
+{
+    shared::EditorCore::addToMemoryReport(report);
+    report->addModel(m_document->objectsModel());
+    report->addModel(m_document->importModel());
+    report->addScene(m_document->scene());
+    if (Asn1Acn::Asn1ModelStorage *storage = m_document->asn1ModelStorage()) {
+        storage->addToMemoryReport(report);
+    }
+}
+
 cmd::CommandsStack *IVEditorCore::commandsStack() const
 {
     Q_ASSERT(m_document && m_document->commandsStack());
@@ -402,41 +420,50 @@ bool IVEditorCore::save()
 
 QVector<ivm::IVFunction *> IVEditorCore::allIVFunctions() const
 {
+    updateLists();
     return m_ivFunctions;
 }
 
 QVector<ivm::IVConnection *> IVEditorCore::allIVConnections() const
 {
+    updateLists();
     return m_ivConnections;
 }
 
 /*!
-   Returns a list of the names of all functions in the iv model
+   Returns a list of the names of all functions in the iv model, in the order of the model
+   \sa hasFunctionName
  */
 QStringList IVEditorCore::ivFunctionsNames() const
 {
-    QStringList functionNames;
-    for (const ivm::IVFunction *ivFunction : m_ivFunctions) {
-        if (ivFunction && !ivFunction->title().isEmpty()) {
-            functionNames << ivFunction->title();
-        }
-    }
-    return functionNames;
+    updateLists();
+    return m_functionNamesList;
 }
 
 /*!
-   Returns a list of the names of all connections in the iv model
+   Returns a list of the names of all connections in the iv model, in the order of the model
+   \sa hasConnectionName
  */
 QStringList IVEditorCore::ivConnectionNames() const
 {
-    QStringList connectionNames;
-    for (const ivm::IVConnection *ivConnection : m_ivConnections) {
-        if (ivConnection && !ivConnection->name().isEmpty()) {
-            connectionNames << ivConnection->name();
-        }
-    }
-    connectionNames.removeDuplicates();
-    return connectionNames;
+    updateLists();
+    return m_connectionNamesList;
+}
+
+/*!
+   Returns if the iv model contains a function called \p name. The case is ignored like in all iv/msc name checks
+ */
+bool IVEditorCore::hasFunctionName(const QString &name) const
+{
+    return !name.isEmpty() && m_functionNameCounts.contains(nameKey(name));
+}
+
+/*!
+   Returns if the iv model contains a connection called \p name. The case is ignored like in all iv/msc name checks
+ */
+bool IVEditorCore::hasConnectionName(const QString &name) const
+{
+    return !name.isEmpty() && m_connectionNameCounts.contains(nameKey(name));
 }
 
 /*!
@@ -519,20 +546,217 @@ ivm::IVInterface *IVEditorCore::getInterface(
 }
 
 /*!
-   Updates the list of functions and connections from the iv model
+   Rebuilds the list of functions and connections and their names from the iv model
  */
 void IVEditorCore::updateIVItems()
 {
-    m_ivFunctions.clear();
-    m_ivConnections.clear();
+    for (const IndexedObject &function : qAsConst(m_functions)) {
+        disconnect(function.object, &ivm::IVObject::titleChanged, this, &IVEditorCore::onFunctionTitleChanged);
+    }
+    m_functions.clear();
+    m_connections.clear();
+    m_functionNameCounts.clear();
+    m_connectionNameCounts.clear();
+    m_listsValid = false;
+
+    ivm::IVModel *ivModel = m_document->objectsModel();
+    if (!ivModel) {
+        return;
+    }
 
+    for (shared::VEObject *obj : ivModel->objects()) {
+        indexObject(qobject_cast<ivm::IVObject *>(obj));
+    }
+}
+
+void IVEditorCore::onObjectsAdded(const QVector<shared::Id> &objectsIds)
+{
     ivm::IVModel *ivModel = m_document->objectsModel();
     if (!ivModel) {
         return;
     }
 
-    m_ivFunctions = ivModel->allObjectsByType<ivm::IVFunction>();
-    m_ivConnections = ivModel->allObjectsByType<ivm::IVConnection>();
+    for (const shared::Id &id : objectsIds) {
+        indexObject(ivModel->getObject(id));
+    }
+}
+
+/*!
+   The object is not part of the model anymore, but still exists
+ */
+void IVEditorCore::onObjectRemoved(shared::Id objectId)
+{
+    auto function = m_functions.constFind(objectId);
+    if (function != m_functions.constEnd()) {
+        unindexObject(function->object);
+        return;
+    }
+
+    auto connection = m_connections.constFind(objectId);
+    if (connection != m_connections.constEnd()) {
+        unindexObject(connection->object);
+    }
+}
+
+void IVEditorCore::onFunctionTitleChanged()
+{
+    if (auto function = qobject_cast<ivm::IVFunction *>(sender())) {
+        unindexObject(function);
+        indexObject(function);
+    }
+}
+
+/*!
+   The name of a connection is the name of one of its interfaces, so the connections of the interface are re-indexed
+ */
+void IVEditorCore::onInterfaceTitleChanged()
+{
+    auto interface = qobject_cast<ivm::IVInterface *>(sender());
+    ivm::IVModel *ivModel = m_document->objectsModel();
+    if (!interface || !ivModel) {
+        return;
+    }
+
+    for (ivm::IVConnection *connection : ivModel->getConnectionsForIface(interface->id())) {
+        if (m_connections.contains(connection->id())) {
+            indexConnectionName(connection);
+        }
+    }
+}
+
+/*!
+   Returns the key \p name is stored with in the name sets. Names are compared with \ref m_caseCheck
+ */
+QString IVEditorCore::nameKey(const QString &name) const
+{
+    return m_caseCheck == Qt::CaseInsensitive ? name.toCaseFolded() : name;
+}
+
+static void addNameKey(QHash<QString, int> &counts, const QString &key)
+{
+    ++counts[key];
+}
+
+static void removeNameKey(QHash<QString, int> &counts, const QString &key)
+{
+    auto it = counts.find(key);
+    if (it != counts.end() && --it.value() <= 0) {
+        counts.erase(it);
+    }
+}
+
+/*!
+   Adds the function or connection \p obj to the lists and its name to the name sets. Other objects are ignored
+ */
+void IVEditorCore::indexObject(ivm::IVObject *obj)
+{
+    if (auto function = qobject_cast<ivm::IVFunction *>(obj)) {
+        if (m_functions.contains(function->id())) {
+            return;
+        }
+        m_functions.insert(function->id(), { function, function->title() });
+        addNameKey(m_functionNameCounts, nameKey(function->title()));
+        m_listsValid = false;
+        connect(function, &ivm::IVObject::titleChanged, this, &IVEditorCore::onFunctionTitleChanged,
+                Qt::UniqueConnection);
+        return;
+    }
+
+    if (auto connection = qobject_cast<ivm::IVConnection *>(obj)) {
+        if (m_connections.contains(connection->id())) {
+            return;
+        }
+        indexConnectionName(connection);
+        for (ivm::IVInterface *interface : { connection->sourceInterface(), connection->targetInterface() }) {
+            if (interface) {
+                connect(interface, &ivm::IVObject::titleChanged, this, &IVEditorCore::onInterfaceTitleChanged,
+                        Qt::UniqueConnection);
+            }
+        }
+    }
+}
+
+/*!
+   Removes the function or connection \p obj from the lists and its name from the name sets
+ */
+void IVEditorCore::unindexObject(ivm::IVObject *obj)
+{
+    if (auto function = qobject_cast<ivm::IVFunction *>(obj)) {
+        auto it = m_functions.find(function->id());
+        if (it == m_functions.end()) {
+            return;
+        }
+        removeNameKey(m_functionNameCounts, nameKey(it->name));
+        m_functions.erase(it);
+        m_listsValid = false;
+        disconnect(function, &ivm::IVObject::titleChanged, this, &IVEditorCore::onFunctionTitleChanged);
+        return;
+    }
+
+    if (auto connection = qobject_cast<ivm::IVConnection *>(obj)) {
+        auto it = m_connections.find(connection->id());
+        if (it == m_connections.end()) {
+            return;
+        }
+        /// The interfaces stay connected, as they might be used by other connections
+        removeNameKey(m_connectionNameCounts, nameKey(it->name));
+        m_connections.erase(it);
+        m_listsValid = false;
+    }
+}
+
+/*!
+   Stores the current name of \p connection, replacing the name stored before
+ */
+void IVEditorCore::indexConnectionName(ivm::IVConnection *connection)
+{
+    const QString name = connection->name();
+    auto it = m_connections.find(connection->id());
+    if (it != m_connections.end()) {
+        if (it->name == name) {
+            return;
+        }
+        removeNameKey(m_connectionNameCounts, nameKey(it->name));
+    }
+    m_connections.insert(connection->id(), { connection, name });
+    addNameKey(m_connectionNameCounts, nameKey(name));
+    m_listsValid = false;
+}
+
+/*!
+   Rebuilds the lists of functions and connections and of their names in the order of the iv model, if they changed
+ */
+void IVEditorCore::updateLists() const
+{
+    if (m_listsValid) {
+        return;
+    }
+
+    m_ivFunctions.clear();
+    m_ivConnections.clear();
+    m_functionNamesList.clear();
+    m_connectionNamesList.clear();
+    if (ivm::IVModel *ivModel = m_document->objectsModel()) {
+        for (const shared::Id &id : ivModel->objectsOrder()) {
+            auto function = m_functions.constFind(id);
+            if (function != m_functions.constEnd()) {
+                m_ivFunctions.append(static_cast<ivm::IVFunction *>(function->object));
+                if (!function->name.isEmpty()) {
+                    m_functionNamesList.append(function->name);
+                }
+                continue;
+            }
+            auto connection = m_connections.constFind(id);
+            if (connection != m_connections.constEnd()) {
+                m_ivConnections.append(static_cast<ivm::IVConnection *>(connection->object));
+                if (!connection->name.isEmpty()) {
+                    m_connectionNamesList.append(connection->name);
+                }
+            }
+        }
+    }
+    m_connectionNamesList.removeDuplicates();
+    m_listsValid = true;
 }
 
 QUrl IVEditorCore::helpPage() const
@@ -21,6 +21,8 @@
 #include "editorcore.h"
 #include "ui/graphicsviewbase.h"
 
+#include <QHash>
+#include <QStringList>
 #include <QVector>
 
 namespace ivm {
@@ -67,6 +69,7 @@ public:
     bool renameCyclicInterface(const QString &oldName, const QString &newName, const QString &functionName);
 
     QUndoStack *undoStack() const override;
+    void addToMemoryReport(shared::MemoryReport *report) const override;
     cmd::CommandsStack *commandsStack() const;
 
     bool renameAsnFile(const QString &oldName, const QString &newName) override;
@@ -79,18 +82,29 @@ public:
 
     QStringList ivFunctionsNames() const;
     QStringList ivConnectionNames() const;
+    bool hasFunctionName(const QString &name) const;
+    bool hasConnectionName(const QString &name) const;
 
 public Q_SLOTS:
     void onSaveRenderRequested();
 
 private Q_SLOTS:
     void updateIVItems();
+    void onObjectsAdded(const QVector<shared::Id> &objectsIds);
+    void onObjectRemoved(shared::Id objectId);
+    void onFunctionTitleChanged();
+    void onInterfaceTitleChanged();
 
 private:
     void saveSceneRender(const QString &filePath) const;
     ivm::IVInterface *getInterface(
             const QString &ifName, ivm::IVInterface::InterfaceType ifType, ivm::IVFunction *parentFunction);
     QUrl helpPage() const override;
+    QString nameKey(const QString &name) const;
+    void indexObject(ivm::IVObject *obj);
+    void unindexObject(ivm::IVObject *obj);
+    void indexConnectionName(ivm::IVConnection *connection);
+    void updateLists() const;
 
     ive::InterfaceDocument *m_document { nullptr };
 
@@ -100,8 +114,22 @@ private:
     QAction *m_actionExportType { nullptr };
     QAction *m_actionToggleE2EView { nullptr };
 
-    QVector<ivm::IVFunction *> m_ivFunctions;
-    QVector<ivm::IVConnection *> m_ivConnections;
+    /// A function or connection of the iv model with its current name, to update the counts on remove and rename
+    struct IndexedObject {
+        ivm::IVObject *object { nullptr };
+        QString name;
+    };
+    QHash<shared::Id, IndexedObject> m_functions;
+    QHash<shared::Id, IndexedObject> m_connections;
+    /// Number of functions/connections per name key (see \ref nameKey)
+    QHash<QString, int> m_functionNameCounts;
+    QHash<QString, int> m_connectionNameCounts;
+    /// Lists in the order of the iv model, rebuilt on the first call after a change (see \ref updateLists)
+    mutable QVector<ivm::IVFunction *> m_ivFunctions;
+    mutable QVector<ivm::IVConnection *> m_ivConnections;
+    mutable QStringList m_functionNamesList;
+    mutable QStringList m_connectionNamesList;
+    mutable bool m_listsValid = false;
 
     Qt::CaseSensitivity m_caseCheck = Qt::CaseInsensitive;
 };
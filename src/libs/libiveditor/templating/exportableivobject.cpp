@@ -19,6 +19,7 @@
 
 #include "exportableivobject.h"
 
+#include "attributestore.h"
 #include "exportableivconnection.h"
 #include "exportableivconnectiongroup.h"
 #include "exportableivfunction.h"
@@ -83,7 +84,7 @@ QVariant ExportableIVObject::createFrom(const ivm::IVObject *ivObject)
  */
 QVariantList ExportableIVObject::attributes() const
 {
-    return generateProperties(exportedObject<ivm::IVObject>()->entityAttributes(), false);
+    return generateProperties(exportedObject<ivm::IVObject>()->attributeStore(), false);
 }
 
 /**
@@ -92,7 +93,7 @@ QVariantList ExportableIVObject::attributes() const
  */
 QVariantList ExportableIVObject::properties() const
 {
-    return generateProperties(exportedObject<ivm::IVObject>()->entityAttributes(), true);
+    return generateProperties(exportedObject<ivm::IVObject>()->attributeStore(), true);
 }
 
 QStringList ExportableIVObject::path() const
@@ -102,15 +103,16 @@ QStringList ExportableIVObject::path() const
 
 /**
  * @brief ExportableIVObject::generateProperties generates a variant list sorted by meta::Props::Token.
- * @param props can be hash of attributes or properties of IVObject.
+ * @param attributes the attributes of the IVObject, only the properties or only the other attributes are used.
  * @return sorted QVariantList which can be used in string templates
  */
-QVariantList ExportableIVObject::generateProperties(const EntityAttributes &attributes, bool isProperty)
+QVariantList ExportableIVObject::generateProperties(const shared::AttributeStore &attributes, bool isProperty)
 {
     QVariantList result;
-    for (auto it = attributes.cbegin(); it != attributes.cend(); ++it) {
-        if (it.value().isProperty() == isProperty) {
-            result << QVariant::fromValue(templating::ExportableProperty(it.key(), it.value().value()));
+    for (const shared::AttributeStore::Entry &entry : attributes) {
+        if ((entry.type == EntityAttribute::Type::Property) == isProperty) {
+            result << QVariant::fromValue(templating::ExportableProperty(
+                    shared::AttributeNameTable::name(entry.id), entry.value));
         }
     }
 
@@ -18,10 +18,13 @@
 #pragma once
 
 #include "abstractexportableobject.h"
-#include "entityattribute.h"
 
 #include <QVariant>
 
+namespace shared {
+class AttributeStore;
+}
+
 namespace ivm {
 class IVObject;
 }
@@ -53,7 +56,7 @@ public:
     QStringList path() const;
 
 protected:
-    static QVariantList generateProperties(const EntityAttributes &attributes, bool isProperty);
+    static QVariantList generateProperties(const shared::AttributeStore &attributes, bool isProperty);
 };
 
 }
@@ -31,6 +31,7 @@
 #include "commentitem.h"
 #include "conditionitem.h"
 #include "coregionitem.h"
+#include "messageconformance.h"
 #include "messageitem.h"
 #include "mscaction.h"
 #include "mscchart.h"
@@ -43,6 +44,7 @@
 #include "msctimer.h"
 #include "systemchecks.h"
 #include "timeritem.h"
+#include "trace.h"
 #include "ui/graphicsscenebase.h"
 
 #include <QDebug>
@@ -104,6 +106,7 @@ struct ChartLayoutManagerPrivate {
     QHash<QUuid, msc::InteractiveObject *> m_instanceEventItems;
     QVector<msc::InteractiveObject *> m_instanceEventItemsSorted;
     QPointer<msc::SystemChecks> m_systemChecker;
+    msc::MessageConformance m_messageConformance;
     QPointer<MscCommandsStack> m_undoStack;
 
     QPointer<msc::MscChart> m_currentChart = nullptr;
@@ -176,6 +179,8 @@ ChartLayoutManager::ChartLayoutManager(MscCommandsStack *undoStack, QObject *par
     d->m_layoutUpdateTimer.setInterval(1);
     d->m_layoutUpdateTimer.setSingleShot(true);
     connect(&d->m_layoutUpdateTimer, &QTimer::timeout, this, &msc::ChartLayoutManager::doLayout);
+    connect(&d->m_messageConformance, &msc::MessageConformance::statusChanged, this,
+            &msc::ChartLayoutManager::onMessageConformanceChanged);
 
     Q_ASSERT(undoStack != nullptr);
     d->m_undoStack = undoStack;
@@ -205,6 +210,7 @@ void ChartLayoutManager::setCurrentChart(MscChart *chart)
     }
 
     d->m_currentChart = chart;
+    d->m_messageConformance.setChart(chart);
 
     clearScene();
 
@@ -344,6 +350,7 @@ void ChartLayoutManager::updateLayout()
  */
 void ChartLayoutManager::doLayout()
 {
+    SC_TRACE_SCOPE("layout", "ChartLayoutManager::doLayout");
     d->m_layoutUpdateTimer.stop();
 
     d->m_layoutInfo.m_dynamicInstanceMarkers.clear();
@@ -1983,6 +1990,7 @@ void insertEntity(QMap<int, msc::MscInstanceEvent *> &events, int key, msc::MscI
 void ChartLayoutManager::setSystemChecker(SystemChecks *checker)
 {
     d->m_systemChecker = checker;
+    d->m_messageConformance.setSystemChecker(checker);
 }
 
 /*!
@@ -1993,6 +2001,26 @@ SystemChecks *ChartLayoutManager::systemChecker() const
     return d->m_systemChecker.data();
 }
 
+/*!
+   Returns the cache of the IV conformance of the messages of the current chart
+ */
+MessageConformance *ChartLayoutManager::messageConformance() const
+{
+    return &(d->m_messageConformance);
+}
+
+/*!
+   Updates the items of all \p messages, for which the IV conformance changed
+ */
+void ChartLayoutManager::onMessageConformanceChanged(const QVector<MscMessage *> &messages)
+{
+    for (MscMessage *message : messages) {
+        if (MessageItem *item = itemForMessage(message)) {
+            item->checkIVConnection();
+        }
+    }
+}
+
 /*!
    Returns if a layout update is still pending
  */
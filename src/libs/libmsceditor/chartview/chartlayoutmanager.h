@@ -42,6 +42,7 @@ class ConditionItem;
 class CoregionItem;
 class InstanceItem;
 class InteractiveObject;
+class MessageConformance;
 class MessageItem;
 class SystemChecks;
 class TimerItem;
@@ -119,6 +120,7 @@ public:
 
     void setSystemChecker(msc::SystemChecks *checker);
     msc::SystemChecks *systemChecker() const;
+    msc::MessageConformance *messageConformance() const;
 
     bool layoutUpdatePending() const;
 
@@ -145,6 +147,7 @@ private Q_SLOTS:
     void onInstanceEventItemMoved(shared::ui::InteractiveObjectBase *item);
     void onMessageRetargeted(msc::MessageItem *item, const QPointF &pos, msc::MscMessage::EndType endType);
     void onInstanceCreatorChanged(msc::MscInstance *newCreator);
+    void onMessageConformanceChanged(const QVector<msc::MscMessage *> &messages);
 
 private:
     std::unique_ptr<ChartLayoutManagerPrivate> const d;
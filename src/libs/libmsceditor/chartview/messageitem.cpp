@@ -33,6 +33,7 @@
 #include "commands/cmdmessagepointsedit.h"
 #include "commands/cmdsetparameterlist.h"
 #include "commentitem.h"
+#include "messageconformance.h"
 #include "messagedialog.h"
 #include "mscchart.h"
 #include "msccommandsstack.h"
@@ -47,7 +48,6 @@
 #include <QGraphicsScene>
 #include <QPainter>
 #include <QPolygonF>
-#include <QTimer>
 #include <cmath>
 
 namespace msc {
@@ -77,7 +77,6 @@ MessageItem::MessageItem(MscMessage *message, ChartLayoutManager *chartLayoutMan
 
     setFlags(ItemSendsGeometryChanges | ItemSendsScenePositionChanges | ItemIsSelectable);
 
-    connect(m_message, &msc::MscMessage::dataChanged, this, &msc::MessageItem::checkIVConnection, Qt::QueuedConnection);
     connect(m_message, &msc::MscMessage::dataChanged, this, &msc::MessageItem::updateDisplayText);
     updateDisplayText();
 
@@ -117,11 +116,6 @@ MessageItem::MessageItem(MscMessage *message, ChartLayoutManager *chartLayoutMan
         }
     });
 
-    if (m_chartLayoutManager && m_chartLayoutManager->systemChecker()) {
-        connect(m_chartLayoutManager->systemChecker(), &msc::SystemChecks::ivDataReset, this,
-                &msc::MessageItem::checkIVConnection);
-    }
-
     if (!isCreator()) {
         m_arrowItem->setEditable(false);
     }
@@ -136,7 +130,6 @@ void MessageItem::onTextChanged()
         gph->updateLayout();
     }
 
-    QTimer::singleShot(1, this, &msc::MessageItem::checkIVConnection);
     update();
 }
 
@@ -827,7 +820,8 @@ void MessageItem::updateDisplayText()
 }
 
 /*!
-   Checks in the iv model, if there is a corresponding connection
+   Updates the color of the message, depending on a corresponding connection in the iv model.
+   Called by the ChartLayoutManager, when the conformance of the message changed
  */
 void MessageItem::checkIVConnection()
 {
@@ -1100,8 +1094,8 @@ bool MessageItem::wannabeGlobal() const
  */
 bool MessageItem::ivConnectionOk() const
 {
-    if (m_chartLayoutManager && m_chartLayoutManager->systemChecker()) {
-        return m_chartLayoutManager->systemChecker()->checkMessage(m_message);
+    if (m_chartLayoutManager) {
+        return m_chartLayoutManager->messageConformance()->isConform(m_message);
     }
     return true;
 }
@@ -107,6 +107,7 @@ Q_SIGNALS:
 public Q_SLOTS:
     void setPositionChangeIgnored(bool ignored);
     void onChartBoxChanged();
+    void checkIVConnection();
 
 protected:
     void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event) override;
@@ -128,7 +129,6 @@ private Q_SLOTS:
     void onRenamed(const QString &title);
     void onManualGeometryChangeFinished(shared::ui::GripPoint *gp, const QPointF &from, const QPointF &to);
     void updateDisplayText();
-    void checkIVConnection();
 
 private:
     QString displayTextFromModel() const;
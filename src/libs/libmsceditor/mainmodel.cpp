@@ -35,6 +35,7 @@
 #include "mscmodel.h"
 #include "mscreader.h"
 #include "mscwriter.h"
+#include "trace.h"
 
 #include <QApplication>
 #include <QClipboard>
@@ -304,6 +305,7 @@ void MainModel::showFirstChart()
  */
 bool MainModel::loadFile(const QString &filename)
 {
+    SC_TRACE_SCOPE("load", "MainModel::loadFile", filename);
     msc::MscReader reader;
     msc::MscModel *model = nullptr;
 
@@ -497,10 +499,8 @@ void MainModel::setNewModel(MscModel *model)
     showFirstChart();
     d->m_hierarchyModel.setModel(d->m_mscModel);
 
-    d->m_mscModel->setAsn1TypesData(d->m_asnDataStore->asn1DataTypes(asn1File().absoluteFilePath()));
-    connect(d->m_mscModel, &msc::MscModel::dataDefinitionStringChanged, this, [this](const QString &) {
-        d->m_mscModel->setAsn1TypesData(d->m_asnDataStore->asn1DataTypes(asn1File().absoluteFilePath()));
-    });
+    updateAsn1TypesData();
+    connect(d->m_mscModel, &msc::MscModel::dataDefinitionStringChanged, this, &msc::MainModel::updateAsn1TypesData);
     connect(d->m_mscModel, &msc::MscModel::dataDefinitionStringChanged, this, &msc::MainModel::asn1FileNameChanged);
 
     Q_EMIT modelUpdated(d->m_mscModel);
@@ -516,6 +516,17 @@ QFileInfo MainModel::asn1File() const
     return QFileInfo(QFileInfo(d->m_currentFilePath).absolutePath() + "/" + d->m_mscModel->dataDefinitionString());
 }
 
+/*!
+   Passes the asn1 types of the current asn1 file to the model.
+   Types not loaded yet are loaded in the background and passed once the storage signals them.
+ */
+void MainModel::updateAsn1TypesData()
+{
+    const QFuture<QSharedPointer<Asn1Acn::File>> dataTypes =
+            d->m_asnDataStore->asn1DataTypesAsync(asn1File().absoluteFilePath());
+    d->m_mscModel->setAsn1TypesData(dataTypes.isFinished() ? dataTypes.result() : QSharedPointer<Asn1Acn::File>());
+}
+
 Asn1Acn::Asn1ModelStorage *MainModel::asn1ModelStorage() const
 {
     return d->m_asnDataStore;
@@ -535,8 +546,9 @@ void MainModel::setAsn1ModelStorage(Asn1Acn::Asn1ModelStorage *asn1Storage)
     }
 
     d->m_asnDataStore = asn1Storage;
-    connect(d->m_asnDataStore, &Asn1Acn::Asn1ModelStorage::dataTypesChanged, this, [&](const QString &fileName) {
-        if (fileName == asn1File().absoluteFilePath()) {
+    connect(d->m_asnDataStore, &Asn1Acn::Asn1ModelStorage::dataTypesChanged, this, [&](const QStringList &fileNames) {
+        const QString fileName = asn1File().absoluteFilePath();
+        if (fileNames.contains(fileName)) {
             d->m_mscModel->setAsn1TypesData(d->m_asnDataStore->asn1DataTypes(fileName));
         }
     });
@@ -111,6 +111,7 @@ private:
     msc::MscChart *firstChart(const QVector<msc::MscDocument *> &docs) const;
     void clearMscModel();
     void setNewModel(msc::MscModel *model);
+    void updateAsn1TypesData();
 
     std::unique_ptr<MainModelPrivate> const d;
 };
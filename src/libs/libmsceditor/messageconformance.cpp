@@ -0,0 +1,265 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "messageconformance.h"
+
+#include "mscchart.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
+#include "systemchecks.h"
+
+namespace msc {
+
+MessageConformance::MessageConformance(QObject *parent)
+    : QObject(parent)
+{
+    /// Collects all changes of one event loop cycle into one check
+    m_updateTimer.setInterval(0);
+    m_updateTimer.setSingleShot(true);
+    connect(&m_updateTimer, &QTimer::timeout, this, &MessageConformance::update);
+}
+
+MessageConformance::~MessageConformance() { }
+
+/*!
+   Sets the object to check the messages with. All messages are checked again
+ */
+void MessageConformance::setSystemChecker(SystemChecks *checker)
+{
+    if (checker == m_checker) {
+        return;
+    }
+
+    if (m_checker) {
+        disconnect(m_checker, nullptr, this, nullptr);
+    }
+    m_checker = checker;
+    if (m_checker) {
+        connect(m_checker, &SystemChecks::ivDataReset, this, &MessageConformance::invalidateAll);
+        connect(m_checker, &SystemChecks::ivDataChanged, this, &MessageConformance::invalidateNames);
+    }
+    invalidateAll();
+}
+
+/*!
+   Sets the chart, whose messages are tracked. The status of the messages of the previous chart is dropped
+ */
+void MessageConformance::setChart(MscChart *chart)
+{
+    if (chart == m_chart) {
+        return;
+    }
+
+    if (m_chart) {
+        disconnect(m_chart, nullptr, this, nullptr);
+        for (MscInstance *instance : m_chart->instances()) {
+            disconnect(instance, nullptr, this, nullptr);
+        }
+        for (MscMessage *message : m_chart->messages()) {
+            disconnect(message, nullptr, this, nullptr);
+        }
+    }
+    m_status.clear();
+    m_dirty.clear();
+    m_updateTimer.stop();
+
+    m_chart = chart;
+    if (!m_chart) {
+        return;
+    }
+
+    connect(m_chart, &MscChart::instanceAdded, this, [this](MscInstance *instance) { addInstance(instance); });
+    connect(m_chart, &MscChart::instanceRemoved, this,
+            [this](MscInstance *instance) { disconnect(instance, nullptr, this, nullptr); });
+    connect(m_chart, &MscChart::instanceEventAdded, this, &MessageConformance::addEvent);
+    connect(m_chart, &MscChart::instanceEventRemoved, this, &MessageConformance::removeEvent);
+    for (MscInstance *instance : m_chart->instances()) {
+        addInstance(instance);
+    }
+    for (MscMessage *message : m_chart->messages()) {
+        addEvent(message);
+    }
+}
+
+/*!
+   Returns if \p message has a corresponding IV connection. If the status of the message is not known, all messages
+   with an unknown status are checked at once.
+   Messages that are not part of the chart are checked directly, without caching the result.
+ */
+bool MessageConformance::isConform(MscMessage *message)
+{
+    if (!m_checker || !message) {
+        return true;
+    }
+
+    const bool dirty = m_dirty.contains(message);
+    const auto it = m_status.constFind(message);
+    if (it == m_status.constEnd() && !dirty) {
+        return m_checker->checkMessage(message);
+    }
+    if (!dirty) {
+        return it.value();
+    }
+
+    update();
+    return m_status.value(message, true);
+}
+
+/*!
+   Marks \p message to be checked again. The check is done on the next event loop cycle or on the next query
+ */
+void MessageConformance::invalidate(MscMessage *message)
+{
+    if (!message) {
+        return;
+    }
+
+    m_dirty.insert(message);
+    m_updateTimer.start();
+}
+
+/*!
+   Marks all messages to be checked again, which have one of the \p names, or whose source or target instance has one
+   of them. All messages are marked, if \p names is empty
+ */
+void MessageConformance::invalidateNames(const QStringList &names)
+{
+    if (names.isEmpty()) {
+        invalidateAll();
+        return;
+    }
+    if (!m_chart) {
+        return;
+    }
+
+    const Qt::CaseSensitivity caseSensitivity = m_checker ? m_checker->stringSensitivity() : Qt::CaseInsensitive;
+    auto matches = [&](const QString &name) { return names.contains(name, caseSensitivity); };
+    for (MscMessage *message : m_chart->messages()) {
+        const MscInstance *source = message->sourceInstance();
+        const MscInstance *target = message->targetInstance();
+        if (matches(message->name()) || (source && matches(source->name())) || (target && matches(target->name()))) {
+            invalidate(message);
+        }
+    }
+}
+
+/*!
+   Marks all messages of the chart to be checked again
+ */
+void MessageConformance::invalidateAll()
+{
+    if (!m_chart) {
+        return;
+    }
+
+    for (MscMessage *message : m_chart->messages()) {
+        m_dirty.insert(message);
+    }
+    m_updateTimer.start();
+}
+
+/*!
+   Checks all messages marked as changed and notifies about the ones which status changed
+ */
+void MessageConformance::update()
+{
+    m_updateTimer.stop();
+    const QVector<MscMessage *> changed = checkDirtyMessages();
+    if (!changed.isEmpty()) {
+        Q_EMIT statusChanged(changed);
+    }
+}
+
+void MessageConformance::addEvent(MscInstanceEvent *event)
+{
+    auto message = qobject_cast<MscMessage *>(event);
+    if (!message) {
+        return;
+    }
+
+    connect(message, &MscEntity::nameChanged, this, [this, message]() { invalidate(message); });
+    connect(message, &MscMessage::sourceChanged, this, [this, message]() { invalidate(message); });
+    connect(message, &MscMessage::targetChanged, this, [this, message]() { invalidate(message); });
+    invalidate(message);
+}
+
+void MessageConformance::removeEvent(MscInstanceEvent *event)
+{
+    auto message = qobject_cast<MscMessage *>(event);
+    if (!message) {
+        return;
+    }
+
+    disconnect(message, nullptr, this, nullptr);
+    m_status.remove(message);
+    m_dirty.remove(message);
+}
+
+void MessageConformance::addInstance(MscInstance *instance)
+{
+    connect(instance, &MscEntity::nameChanged, this, [this, instance]() { invalidateInstance(instance); });
+}
+
+/*!
+   Marks all messages from or to \p instance to be checked again
+ */
+void MessageConformance::invalidateInstance(MscInstance *instance)
+{
+    if (!m_chart) {
+        return;
+    }
+
+    for (MscMessage *message : m_chart->messages()) {
+        if (message->sourceInstance() == instance || message->targetInstance() == instance) {
+            invalidate(message);
+        }
+    }
+}
+
+/*!
+   Checks all messages marked as changed in one pass and returns the ones which status changed
+ */
+QVector<MscMessage *> MessageConformance::checkDirtyMessages()
+{
+    QVector<MscMessage *> changed;
+    if (m_dirty.isEmpty()) {
+        return changed;
+    }
+
+    QVector<MscMessage *> messages;
+    QVector<const MscMessage *> checkedMessages;
+    messages.reserve(m_dirty.size());
+    checkedMessages.reserve(m_dirty.size());
+    for (MscMessage *message : qAsConst(m_dirty)) {
+        messages.append(message);
+        checkedMessages.append(message);
+    }
+    m_dirty.clear();
+
+    const QVector<bool> results = m_checker ? m_checker->checkMessageList(checkedMessages)
+                                            : QVector<bool>(checkedMessages.size(), true);
+    for (int idx = 0; idx < messages.size(); ++idx) {
+        auto it = m_status.find(messages.at(idx));
+        if (it == m_status.end() || it.value() != results.at(idx)) {
+            m_status.insert(messages.at(idx), results.at(idx));
+            changed.append(messages.at(idx));
+        }
+    }
+    return changed;
+}
+
+} // namespace msc
@@ -0,0 +1,79 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+namespace msc {
+class MscChart;
+class MscInstance;
+class MscInstanceEvent;
+class MscMessage;
+class SystemChecks;
+
+/*!
+   \class msc::MessageConformance
+   Caches for all messages of a chart, if they have a corresponding connection in the IV model.
+
+   All messages with an unknown status are checked in one pass by \ref SystemChecks::checkMessageList. A message is
+   only checked again, when its name or one of its instances changed, or when IV objects with the name of the message
+   or of its instances changed. All messages are checked again, when the IV data of the system checks is reset.
+   Changes of the status are reported in bulk by \ref statusChanged.
+ */
+class MessageConformance : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MessageConformance(QObject *parent = nullptr);
+    ~MessageConformance() override;
+
+    void setSystemChecker(msc::SystemChecks *checker);
+    void setChart(msc::MscChart *chart);
+
+    bool isConform(msc::MscMessage *message);
+
+public Q_SLOTS:
+    void invalidate(msc::MscMessage *message);
+    void invalidateNames(const QStringList &names);
+    void invalidateAll();
+    void update();
+
+Q_SIGNALS:
+    void statusChanged(const QVector<msc::MscMessage *> &messages);
+
+private:
+    void addEvent(msc::MscInstanceEvent *event);
+    void removeEvent(msc::MscInstanceEvent *event);
+    void addInstance(msc::MscInstance *instance);
+    void invalidateInstance(msc::MscInstance *instance);
+    QVector<msc::MscMessage *> checkDirtyMessages();
+
+    QPointer<msc::SystemChecks> m_checker;
+    QPointer<msc::MscChart> m_chart;
+    QHash<const msc::MscMessage *, bool> m_status;
+    QSet<msc::MscMessage *> m_dirty;
+    QTimer m_updateTimer;
+};
+
+} // namespace msc
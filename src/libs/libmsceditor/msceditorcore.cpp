@@ -17,6 +17,7 @@
 
 #include "msceditorcore.h"
 
+#include "asn1modelstorage.h"
 #include "commandlineparser.h"
 #include "commands/cmddeleteentity.h"
 #include "commands/cmddocumentcreate.h"
@@ -27,6 +28,7 @@
 #include "ivconnection.h"
 #include "ivfunction.h"
 #include "mainmodel.h"
+#include "memoryreport.h"
 #include "messagedeclarationsdialog.h"
 #include "mscchart.h"
 #include "msccommandsstack.h"
@@ -327,6 +329,8 @@ void MSCEditorCore::populateCommandLineArguments(shared::CommandLineParser *pars
     parser->handlePositional(shared::CommandLineParser::Positional::OpenFileMsc);
     parser->handlePositional(shared::CommandLineParser::Positional::DbgOpenMscExamplesChain);
     parser->handlePositional(shared::CommandLineParser::Positional::DropUnsavedChangesSilently);
+    parser->handlePositional(shared::CommandLineParser::Positional::TraceFile);
+    parser->handlePositional(shared::CommandLineParser::Positional::MemoryReportFile);
 }
 
 BaseTool *MSCEditorCore::activeTool() const
@@ -440,6 +444,20 @@ QUndoStack *MSCEditorCore::undoStack() const
     return m_model->undoStack();
 }
 
+/*!
+   Adds the MSC model, the chart and hierarchy scenes and the ASN.1 types to \p report
+ */
+void MSCEditorCore::addToMemoryReport(shared::MemoryReport *report) const
+{
+    shared::EditorCore::addToMemoryReport(report);
+    m_model->mscModel()->addToMemoryReport(report);
+    report->addScene(m_model->graphicsScene());
+    report->addScene(m_model->hierarchyScene());
+    if (Asn1Acn::Asn1ModelStorage *storage = m_model->asn1ModelStorage()) {
+        storage->addToMemoryReport(report);
+    }
+}
+
 msc::MscCommandsStack *MSCEditorCore::commandsStack() const
 {
     return m_model->commandsStack();
@@ -469,9 +487,18 @@ bool MSCEditorCore::renameAsnFile(const QString &oldName, const QString &newName
    Changes all instances that have the name \p oldName to have the new name \p name
  */
 void MSCEditorCore::changeMscInstanceName(const QString &oldName, const QString &name)
+{
+    changeMscInstanceName(oldName, name, m_model->mscModel()->allCharts());
+}
+
+/*!
+   Changes the instances of \p charts that have the name \p oldName to have the new name \p name
+ */
+void MSCEditorCore::changeMscInstanceName(
+        const QString &oldName, const QString &name, const QVector<msc::MscChart *> &charts)
 {
     bool updated = false;
-    for (msc::MscChart *chart : m_model->mscModel()->allCharts()) {
+    for (msc::MscChart *chart : charts) {
         for (msc::MscInstance *instance : chart->instances()) {
             if (instance->name() == oldName) {
                 msc::MscCommandsStack *undo = commandsStack();
@@ -492,9 +519,19 @@ void MSCEditorCore::changeMscInstanceName(const QString &oldName, const QString
  */
 void MSCEditorCore::changeMscMessageName(
         const QString &oldName, const QString &newName, const QString &sourceName, const QString &targetName)
+{
+    changeMscMessageName(oldName, newName, sourceName, targetName, m_model->mscModel()->allCharts());
+}
+
+/*!
+   Changes the messages of \p charts that have the name \p oldName to have the new name \p newName, if the source and
+   target have the names \p sourceName and \p targetName
+ */
+void MSCEditorCore::changeMscMessageName(const QString &oldName, const QString &newName, const QString &sourceName,
+        const QString &targetName, const QVector<msc::MscChart *> &charts)
 {
     bool updated = false;
-    for (msc::MscChart *chart : m_model->mscModel()->allCharts()) {
+    for (msc::MscChart *chart : charts) {
         for (msc::MscMessage *message : chart->messages()) {
             if (message->name() == oldName) {
                 const QString messageSource = message->sourceInstance() ? message->sourceInstance()->name() : "";
@@ -561,9 +598,18 @@ void MSCEditorCore::removeMscMessages(ivm::IVConnection *ivConnection)
    Returns a list of all corresponding instances for iv function \p IVFunction.
  */
 QList<MscInstance *> MSCEditorCore::correspondingInstances(ivm::IVFunction *ivFunction) const
+{
+    return correspondingInstances(ivFunction, m_model->mscModel()->allCharts());
+}
+
+/*!
+   Returns a list of the corresponding instances of \p charts for iv function \p ivFunction.
+ */
+QList<MscInstance *> MSCEditorCore::correspondingInstances(
+        ivm::IVFunction *ivFunction, const QVector<msc::MscChart *> &charts) const
 {
     QList<MscInstance *> corresponds;
-    for (msc::MscChart *chart : m_model->mscModel()->allCharts()) {
+    for (msc::MscChart *chart : charts) {
         for (msc::MscInstance *instance : chart->instances()) {
             if (m_systemChecks->correspond(ivFunction, instance)) {
                 corresponds.append(instance);
@@ -578,9 +624,18 @@ QList<MscInstance *> MSCEditorCore::correspondingInstances(ivm::IVFunction *ivFu
    Returns a list of all corresponding messages for iv connection \p ivConnection.
  */
 QList<MscMessage *> MSCEditorCore::correspondingMessages(ivm::IVConnection *ivConnection) const
+{
+    return correspondingMessages(ivConnection, m_model->mscModel()->allCharts());
+}
+
+/*!
+   Returns a list of the corresponding messages of \p charts for iv connection \p ivConnection.
+ */
+QList<MscMessage *> MSCEditorCore::correspondingMessages(
+        ivm::IVConnection *ivConnection, const QVector<msc::MscChart *> &charts) const
 {
     QList<MscMessage *> corresponds;
-    for (msc::MscChart *chart : m_model->mscModel()->allCharts()) {
+    for (msc::MscChart *chart : charts) {
         for (msc::MscMessage *message : chart->messages()) {
             if (m_systemChecks->correspond(ivConnection, message)) {
                 corresponds.append(message);
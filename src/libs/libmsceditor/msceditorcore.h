@@ -111,16 +111,24 @@ public:
     ViewMode viewMode();
 
     QUndoStack *undoStack() const override;
+    void addToMemoryReport(shared::MemoryReport *report) const override;
     msc::MscCommandsStack *commandsStack() const;
 
     bool renameAsnFile(const QString &oldName, const QString &newName) override;
     void changeMscInstanceName(const QString &oldName, const QString &name);
+    void changeMscInstanceName(const QString &oldName, const QString &name, const QVector<msc::MscChart *> &charts);
     void changeMscMessageName(
             const QString &oldName, const QString &newName, const QString &sourceName, const QString &targetName);
+    void changeMscMessageName(const QString &oldName, const QString &newName, const QString &sourceName,
+            const QString &targetName, const QVector<msc::MscChart *> &charts);
     void removeMscInstances(ivm::IVFunction *ivFunction);
     void removeMscMessages(ivm::IVConnection *ivConnection);
     QList<msc::MscInstance *> correspondingInstances(ivm::IVFunction *ivFunction) const;
+    QList<msc::MscInstance *> correspondingInstances(
+            ivm::IVFunction *ivFunction, const QVector<msc::MscChart *> &charts) const;
     QList<msc::MscMessage *> correspondingMessages(ivm::IVConnection *ivConnection) const;
+    QList<msc::MscMessage *> correspondingMessages(
+            ivm::IVConnection *ivConnection, const QVector<msc::MscChart *> &charts) const;
 
     QString filePath() const override;
     bool save() override;
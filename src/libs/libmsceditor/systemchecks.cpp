@@ -48,6 +48,20 @@ bool SystemChecks::checkMessage(const MscMessage *message) const
     return true;
 }
 
+/*!
+   Checks all \p messages like \ref checkMessage and returns the results in the same order.
+   Derived classes can do that in one pass, sharing the data needed for the checks
+ */
+QVector<bool> SystemChecks::checkMessageList(const QVector<const MscMessage *> &messages) const
+{
+    QVector<bool> results;
+    results.reserve(messages.size());
+    for (const MscMessage *message : messages) {
+        results.append(checkMessage(message));
+    }
+    return results;
+}
+
 QVector<QPair<MscChart *, MscInstance *>> SystemChecks::checkInstanceNames() const
 {
     return {};
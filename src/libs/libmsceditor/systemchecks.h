@@ -50,6 +50,7 @@ public:
 
     virtual bool checkInstance(const msc::MscInstance *instance) const;
     virtual bool checkMessage(const msc::MscMessage *message) const;
+    virtual QVector<bool> checkMessageList(const QVector<const msc::MscMessage *> &messages) const;
 
     virtual QVector<QPair<msc::MscChart *, msc::MscInstance *>> checkInstanceNames() const;
     virtual QVector<QPair<msc::MscChart *, msc::MscInstance *>> checkInstanceRelations() const;
@@ -70,6 +71,8 @@ public:
 
 Q_SIGNALS:
     void ivDataReset();
+    /// IV objects with the given names were added, removed or renamed. An empty list means any name might be affected
+    void ivDataChanged(const QStringList &names);
 };
 
 } // namespace msc
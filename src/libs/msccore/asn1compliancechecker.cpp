@@ -0,0 +1,176 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "asn1compliancechecker.h"
+
+#include "asn1valuechecker.h"
+#include "file.h"
+#include "mscchart.h"
+#include "mscmessage.h"
+#include "mscmessagedeclaration.h"
+#include "mscmessagedeclarationlist.h"
+#include "trace.h"
+
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace msc {
+
+/// Number of messages checked by one job of the thread pool
+static const int kBatchSize = 256;
+
+using MessageRef = QPair<const MscChart *, const MscMessage *>;
+
+/*!
+   Checks one batch of messages. A function object with result_type, as QtConcurrent::blockingMapped expects it
+ */
+struct CheckBatch {
+    using result_type = Asn1ComplianceChecker::Failures;
+
+    CheckBatch(const Asn1ComplianceChecker *checker, const QVector<MessageRef> *messages)
+        : m_checker(checker)
+        , m_messages(messages)
+    {
+    }
+
+    Asn1ComplianceChecker::Failures operator()(const QPair<int, int> &range) const
+    {
+        Asn1ComplianceChecker::Failures failures;
+        for (int idx = range.first; idx < range.second; ++idx) {
+            Asn1ComplianceChecker::Failure failure;
+            const MessageRef &ref = m_messages->at(idx);
+            if (!m_checker->checkMessage(ref.first, ref.second, &failure)) {
+                failures.append(failure);
+            }
+        }
+        return failures;
+    }
+
+    const Asn1ComplianceChecker *m_checker;
+    const QVector<MessageRef> *m_messages;
+};
+
+/*!
+   Collects the declarations of \p declarations and the value checkers of \p asn1Data for all declared types.
+   Without \p declarations all messages fail, without \p asn1Data only the number of parameters is checked
+ */
+Asn1ComplianceChecker::Asn1ComplianceChecker(
+        const QSharedPointer<Asn1Acn::File> &asn1Data, const MscMessageDeclarationList *declarations)
+    : m_asn1Data(asn1Data)
+    , m_hasDeclarations(declarations != nullptr)
+{
+    if (!declarations) {
+        return;
+    }
+
+    for (MscMessageDeclaration *declaration : *declarations) {
+        if (!declaration) {
+            continue;
+        }
+
+        Declaration entry;
+        entry.typeNames = declaration->typeRefList();
+        if (m_asn1Data) {
+            for (const QString &typeName : entry.typeNames) {
+                entry.checkers.append(m_asn1Data->valueCheckers(typeName));
+            }
+        }
+        /// Like in MscModel::checkMessageAsn1Compliance the last declaration of a message is used
+        for (const QString &name : declaration->names()) {
+            m_declarations.insert(name, entry);
+        }
+    }
+}
+
+/*!
+   Checks all messages of \p charts and returns the failing ones, in the order of the charts and messages
+ */
+Asn1ComplianceChecker::Failures Asn1ComplianceChecker::check(const QVector<MscChart *> &charts) const
+{
+    SC_TRACE_SCOPE("checks", "Asn1ComplianceChecker::check");
+    QVector<MessageRef> messages;
+    for (const MscChart *chart : charts) {
+        for (const MscMessage *message : chart->messages()) {
+            messages.append({ chart, message });
+        }
+    }
+
+    QVector<QPair<int, int>> batches;
+    for (int begin = 0; begin < messages.size(); begin += kBatchSize) {
+        batches.append({ begin, std::min(begin + kBatchSize, messages.size()) });
+    }
+
+    const QVector<Failures> results =
+            QtConcurrent::blockingMapped<QVector<Failures>>(batches, CheckBatch(this, &messages));
+
+    Failures failures;
+    for (const Failures &batchFailures : results) {
+        failures += batchFailures;
+    }
+    return failures;
+}
+
+/*!
+   Returns if the parameters of \p message comply to its declaration. If not, \p failure is filled with the reason
+ */
+bool Asn1ComplianceChecker::checkMessage(const MscChart *chart, const MscMessage *message, Failure *failure) const
+{
+    auto fail = [&](Failure::Reason reason, int parameterIndex) {
+        if (failure) {
+            failure->reason = reason;
+            failure->chart = chart;
+            failure->message = message;
+            failure->parameterIndex = parameterIndex;
+            if (parameterIndex >= 0) {
+                failure->parameter = message->parameters().at(parameterIndex).parameter();
+                failure->typeName = m_declarations.value(message->name()).typeNames.at(parameterIndex);
+            }
+        }
+        return false;
+    };
+
+    if (!m_hasDeclarations) {
+        return fail(Failure::Reason::NoDeclarations, -1);
+    }
+
+    const auto it = m_declarations.constFind(message->name());
+    if (it == m_declarations.constEnd()) {
+        // no matching declaration available
+        return true;
+    }
+
+    const MscParameterList &parameters = message->parameters();
+    if (parameters.size() != it->typeNames.size()) {
+        return fail(Failure::Reason::ParameterCount, -1);
+    }
+    if (!m_asn1Data) {
+        return true;
+    }
+
+    for (int idx = 0; idx < parameters.size(); ++idx) {
+        const QString &parameter = parameters.at(idx).parameter();
+        const QVector<const Asn1Acn::Asn1ValueChecker *> &checkers = it->checkers.at(idx);
+        if (std::none_of(checkers.cbegin(), checkers.cend(),
+                    [&parameter](const Asn1Acn::Asn1ValueChecker *checker) { return checker->isValid(parameter); })) {
+            return fail(Failure::Reason::InvalidParameter, idx);
+        }
+    }
+
+    return true;
+}
+
+}
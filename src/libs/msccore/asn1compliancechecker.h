@@ -0,0 +1,80 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+namespace Asn1Acn {
+class Asn1ValueChecker;
+class File;
+}
+
+namespace msc {
+class MscChart;
+class MscMessage;
+class MscMessageDeclarationList;
+
+/*!
+   \class msc::Asn1ComplianceChecker
+   Checks the parameters of many messages against their message declarations and the ASN.1 types.
+
+   The declarations and the value checkers of the used types are collected once in the constructor. That snapshot is
+   only read afterwards, so the messages are checked in parallel on the global thread pool.
+   The model must not be changed while \ref check is running.
+ */
+class Asn1ComplianceChecker
+{
+public:
+    struct Failure {
+        enum class Reason
+        {
+            NoDeclarations, ///< No message declarations are available at all
+            ParameterCount, ///< The number of parameters does not match the declaration
+            InvalidParameter ///< The parameter is no valid value of the declared type
+        };
+
+        Reason reason = Reason::InvalidParameter;
+        const MscChart *chart = nullptr;
+        const MscMessage *message = nullptr;
+        int parameterIndex = -1; ///< Index of the invalid parameter, -1 if the message as a whole fails
+        QString parameter;
+        QString typeName;
+    };
+    using Failures = QVector<Failure>;
+
+    Asn1ComplianceChecker(
+            const QSharedPointer<Asn1Acn::File> &asn1Data, const MscMessageDeclarationList *declarations);
+
+    Failures check(const QVector<MscChart *> &charts) const;
+    bool checkMessage(const MscChart *chart, const MscMessage *message, Failure *failure = nullptr) const;
+
+private:
+    struct Declaration {
+        QStringList typeNames;
+        QVector<QVector<const Asn1Acn::Asn1ValueChecker *>> checkers;
+    };
+
+    QSharedPointer<Asn1Acn::File> m_asn1Data;
+    bool m_hasDeclarations = false;
+    QHash<QString, Declaration> m_declarations;
+};
+
+}
@@ -20,11 +20,15 @@
 #include "asn1valueparser.h"
 #include "file.h"
 #include "mscchart.h"
+#include "memoryreport.h"
 #include "mscdocument.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
 #include "mscmessagedeclaration.h"
 #include "mscmessagedeclarationlist.h"
 
 #include <QDebug>
+#include <QSet>
 
 namespace msc {
 
@@ -276,37 +280,98 @@ bool MscModel::checkMessageAsn1Compliance(const msc::MscMessage &message) const
  */
 bool MscModel::checkAllMessagesForAsn1Compliance(QStringList *faultyMessages) const
 {
-    QVector<msc::MscMessage *> messages;
+    const Asn1ComplianceChecker::Failures failures = asn1ComplianceFailures();
+    if (faultyMessages) {
+        for (const Asn1ComplianceChecker::Failure &failure : failures) {
+            *faultyMessages << QString("%1(%2)").arg(failure.message->name(), failure.message->paramString());
+        }
+    }
+
+    return failures.isEmpty();
+}
 
+/*!
+   Checks the parameters of all messages in this model against the asn1 definition on the global thread pool.
+   Returns one entry for each message that does not comply
+ */
+Asn1ComplianceChecker::Failures MscModel::asn1ComplianceFailures() const
+{
+    QVector<msc::MscChart *> charts;
     for (msc::MscDocument *childDoc : m_documents) {
-        appendMessages(childDoc, messages);
+        appendCharts(childDoc, charts);
     }
-    for (msc::MscChart *childChart : m_charts) {
-        messages.append(childChart->messages());
+    charts += m_charts;
+
+    const msc::MscMessageDeclarationList *messageDeclarations =
+            m_documents.isEmpty() ? nullptr : m_documents.at(0)->messageDeclarations();
+    const Asn1ComplianceChecker checker(m_asn1Data, messageDeclarations);
+    return checker.check(charts);
+}
+
+/*!
+   Estimated size of an entity of type \p T, with the private data of QObject and the name
+ */
+template<typename T>
+static qint64 entityBytes(const MscEntity *entity)
+{
+    return qint64(sizeof(T) - sizeof(QObject)) + shared::MemoryReport::ObjectBytes
+            + shared::MemoryReport::stringBytes(entity->name());
+}
+
+/*!
+   Adds the documents, charts, instances and events of this model to \p report.
+   Events are reported per type, like "msc.events.Message". The per instance event lists of the charts are
+   reported as "msc.eventVectors"
+ */
+void MscModel::addToMemoryReport(shared::MemoryReport *report) const
+{
+    for (const MscDocument *document : allDocuments()) {
+        report->add(QLatin1String("msc.documents"), 1, entityBytes<MscDocument>(document));
     }
 
-    bool ok = true;
+    for (const MscChart *chart : allCharts()) {
+        report->add(QLatin1String("msc.charts"), 1, entityBytes<MscChart>(chart));
+        for (const MscInstance *instance : chart->instances()) {
+            report->add(QLatin1String("msc.instances"), 1, entityBytes<MscInstance>(instance));
+        }
 
-    for (msc::MscMessage *message : messages) {
-        if (!checkMessageAsn1Compliance(*message)) {
-            ok = false;
-            if (faultyMessages) {
-                *faultyMessages << QString("%1(%2)").arg(message->name(), message->paramString());
+        /// Events shared by several instances, like messages, are in several lists but counted once
+        QSet<const MscInstanceEvent *> counted;
+        auto addEvents = [&](const QVector<MscInstanceEvent *> &eventVector) {
+            report->add(QLatin1String("msc.eventVectors"), 1,
+                    qint64(sizeof(QVector<MscInstanceEvent *>)) + shared::MemoryReport::ArrayHeaderBytes
+                            + eventVector.capacity() * qint64(sizeof(MscInstanceEvent *)));
+            for (const MscInstanceEvent *event : eventVector) {
+                if (!event || counted.contains(event)) {
+                    continue;
+                }
+                counted.insert(event);
+
+                qint64 bytes = entityBytes<MscInstanceEvent>(event);
+                if (auto message = qobject_cast<const MscMessage *>(event)) {
+                    bytes = entityBytes<MscMessage>(message);
+                    for (const MscParameter &parameter : message->parameters()) {
+                        bytes += sizeof(MscParameter) + shared::MemoryReport::stringBytes(parameter.parameter());
+                    }
+                }
+                report->add(QLatin1String("msc.events.") + event->entityTypeName(), 1, bytes);
             }
+        };
+
+        const QHash<MscInstance *, QVector<MscInstanceEvent *>> events = chart->rawEvents();
+        for (const QVector<MscInstanceEvent *> &eventVector : events) {
+            addEvents(eventVector);
         }
+        addEvents(chart->orphanEvents());
     }
-
-    return ok;
 }
 
-void MscModel::appendMessages(msc::MscDocument *doc, QVector<msc::MscMessage *> &messages) const
+void MscModel::appendCharts(msc::MscDocument *doc, QVector<msc::MscChart *> &charts) const
 {
     for (msc::MscDocument *childDoc : doc->documents()) {
-        appendMessages(childDoc, messages);
-    }
-    for (msc::MscChart *childChart : doc->charts()) {
-        messages.append(childChart->messages());
+        appendCharts(childDoc, charts);
     }
+    charts += doc->charts();
 }
 
 } // namespace msc
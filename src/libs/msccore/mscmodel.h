@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "asn1compliancechecker.h"
+
 #include <QObject>
 #include <QSharedPointer>
 #include <QStringList>
@@ -27,6 +29,10 @@ namespace Asn1Acn {
 class File;
 }
 
+namespace shared {
+class MemoryReport;
+}
+
 namespace msc {
 class MscChart;
 class MscDocument;
@@ -70,6 +76,9 @@ public:
 
     bool checkMessageAsn1Compliance(const msc::MscMessage &message) const;
     bool checkAllMessagesForAsn1Compliance(QStringList *faultyMessages = nullptr) const;
+    Asn1ComplianceChecker::Failures asn1ComplianceFailures() const;
+
+    void addToMemoryReport(shared::MemoryReport *report) const;
 
 Q_SIGNALS:
     void dataChanged();
@@ -85,7 +94,7 @@ Q_SIGNALS:
     void documentRemovedFrom(msc::MscDocument *document, QObject *parentObject);
 
 private:
-    void appendMessages(msc::MscDocument *doc, QVector<msc::MscMessage *> &messages) const;
+    void appendCharts(msc::MscDocument *doc, QVector<msc::MscChart *> &charts) const;
 
     QVector<MscDocument *> m_documents;
     QVector<MscChart *> m_charts;
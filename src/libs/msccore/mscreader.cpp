@@ -25,6 +25,7 @@
 #include "mscerrorlistener.h"
 #include "mscmodel.h"
 #include "mscparservisitor.h"
+#include "trace.h"
 
 #include <QFileInfo>
 #include <QObject>
@@ -53,6 +54,7 @@ MscReader::MscReader() { }
 */
 MscModel *MscReader::parseFile(const QString &filename, QStringList *errorMessages)
 {
+    SC_TRACE_SCOPE("io", "MscReader::parseFile", filename);
     if (!QFileInfo::exists(filename)) {
         throw FileNotFoundException();
     }
@@ -71,6 +73,7 @@ MscModel *MscReader::parseFile(const QString &filename, QStringList *errorMessag
 
 MscModel *MscReader::parseText(const QString &text, QStringList *errorMessages)
 {
+    SC_TRACE_SCOPE("io", "MscReader::parseText");
     ANTLRInputStream input(text.toStdString());
     return parse(input, errorMessages);
 }
@@ -0,0 +1,262 @@
+/*
+  Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "attributestore.h"
+
+#include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+#include <atomic>
+
+namespace shared {
+
+namespace {
+/// The table only ever grows, so readers never take a lock. A name is fully written before it is published with a
+/// release store (into its bucket and into the name count), and nothing is moved or freed while the process runs.
+constexpr int kBucketCount = 1024;
+constexpr int kChunkSize = 256;
+constexpr int kMaxChunks = 256;
+/// Most objects carry up to eight attributes, so a few exact reallocations beat doubling the capacity
+constexpr int kEntriesGrowStep = 2;
+
+struct NameNode {
+    QString name;
+    AttributeId id;
+    const NameNode *next;
+};
+
+struct NameTableData {
+    ~NameTableData()
+    {
+        for (std::atomic<const NameNode *> &bucket : buckets) {
+            const NameNode *node = bucket.load(std::memory_order_relaxed);
+            while (node) {
+                const NameNode *next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+        for (const NameNode **chunk : chunks) {
+            delete[] chunk;
+        }
+    }
+
+    QMutex writeMutex;
+    std::atomic<const NameNode *> buckets[kBucketCount] = {};
+    const NameNode **chunks[kMaxChunks] = {};
+    std::atomic<int> count { 0 };
+};
+
+NameTableData &nameTable()
+{
+    static NameTableData table;
+    return table;
+}
+
+const NameNode *findNode(const NameTableData &table, const QString &name, size_t hash)
+{
+    const NameNode *node = table.buckets[hash % kBucketCount].load(std::memory_order_acquire);
+    while (node && node->name != name) {
+        node = node->next;
+    }
+    return node;
+}
+}
+
+/*!
+   Returns the id of the attribute \p name. The name is added to the table if it was not known yet.
+   An empty name results in AttributeId::Invalid.
+ */
+AttributeId AttributeNameTable::intern(const QString &name)
+{
+    if (name.isEmpty()) {
+        return AttributeId::Invalid;
+    }
+
+    NameTableData &table = nameTable();
+    const size_t hash = qHash(name);
+    if (const NameNode *node = findNode(table, name, hash)) {
+        return node->id;
+    }
+
+    QMutexLocker locker(&table.writeMutex);
+    if (const NameNode *node = findNode(table, name, hash)) {
+        return node->id;
+    }
+    const int idx = table.count.load(std::memory_order_relaxed);
+    if (idx >= kChunkSize * kMaxChunks) {
+        qWarning() << "Too many attribute names, ignoring" << name;
+        return AttributeId::Invalid;
+    }
+
+    std::atomic<const NameNode *> &bucket = table.buckets[hash % kBucketCount];
+    const auto node = new NameNode { name, static_cast<AttributeId>(idx), bucket.load(std::memory_order_relaxed) };
+    const NameNode **&chunk = table.chunks[idx / kChunkSize];
+    if (!chunk) {
+        chunk = new const NameNode *[kChunkSize];
+    }
+    chunk[idx % kChunkSize] = node;
+    /// Publish the id before the name, so whoever finds the name can also resolve the id
+    table.count.store(idx + 1, std::memory_order_release);
+    bucket.store(node, std::memory_order_release);
+    return node->id;
+}
+
+/*!
+   Returns the id of the attribute \p name, or AttributeId::Invalid if that name was never interned.
+   Unlike \ref intern, this never grows the table.
+ */
+AttributeId AttributeNameTable::find(const QString &name)
+{
+    if (name.isEmpty()) {
+        return AttributeId::Invalid;
+    }
+
+    const NameNode *node = findNode(nameTable(), name, qHash(name));
+    return node ? node->id : AttributeId::Invalid;
+}
+
+/*!
+   Returns the attribute name for the given \p id. The returned string shares its data with the table.
+ */
+QString AttributeNameTable::name(AttributeId id)
+{
+    const int idx = static_cast<int>(id);
+    const NameTableData &table = nameTable();
+    if (idx < 0 || idx >= table.count.load(std::memory_order_acquire)) {
+        return QString();
+    }
+    return table.chunks[idx / kChunkSize][idx % kChunkSize]->name;
+}
+
+/*!
+   Returns the number of interned attribute names
+ */
+int AttributeNameTable::count()
+{
+    return nameTable().count.load(std::memory_order_acquire);
+}
+
+const AttributeStore::Entry *AttributeStore::find(AttributeId id) const
+{
+    const int idx = indexOf(id);
+    return idx < 0 ? nullptr : &m_entries[idx];
+}
+
+bool AttributeStore::contains(AttributeId id) const
+{
+    return indexOf(id) >= 0;
+}
+
+QVariant AttributeStore::value(AttributeId id, const QVariant &defaultValue) const
+{
+    const Entry *entry = find(id);
+    return entry ? entry->value : defaultValue;
+}
+
+EntityAttribute AttributeStore::attribute(AttributeId id) const
+{
+    const Entry *entry = find(id);
+    return entry ? EntityAttribute { AttributeNameTable::name(entry->id), entry->value, entry->type } : EntityAttribute();
+}
+
+void AttributeStore::set(AttributeId id, const QVariant &value, EntityAttribute::Type type)
+{
+    if (id == AttributeId::Invalid) {
+        return;
+    }
+
+    const int idx = indexOf(id);
+    if (idx >= 0) {
+        Entry &entry = m_entries[idx];
+        entry.value = value;
+        entry.type = type;
+    } else {
+        Entry entry;
+        entry.id = id;
+        entry.type = type;
+        entry.value = value;
+        if (m_entries.size() == m_entries.capacity()) {
+            m_entries.reserve(m_entries.size() + kEntriesGrowStep);
+        }
+        m_entries.append(entry);
+    }
+}
+
+bool AttributeStore::remove(AttributeId id)
+{
+    const int idx = indexOf(id);
+    if (idx < 0) {
+        return false;
+    }
+    m_entries.remove(idx);
+    return true;
+}
+
+void AttributeStore::clear()
+{
+    m_entries.clear();
+}
+
+int AttributeStore::size() const
+{
+    return m_entries.size();
+}
+
+bool AttributeStore::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+const AttributeStore::Entry *AttributeStore::begin() const
+{
+    return m_entries.constData();
+}
+
+const AttributeStore::Entry *AttributeStore::end() const
+{
+    return m_entries.constData() + m_entries.size();
+}
+
+/*!
+   Returns the stored attributes as a name keyed hash, as used by the EntityAttributes based API
+ */
+EntityAttributes AttributeStore::toHash() const
+{
+    EntityAttributes attrs;
+    attrs.reserve(m_entries.size());
+    for (const Entry &entry : m_entries) {
+        const QString name = AttributeNameTable::name(entry.id);
+        attrs.insert(name, EntityAttribute { name, entry.value, entry.type });
+    }
+    return attrs;
+}
+
+int AttributeStore::indexOf(AttributeId id) const
+{
+    if (id == AttributeId::Invalid) {
+        return -1;
+    }
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+}
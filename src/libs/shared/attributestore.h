@@ -0,0 +1,121 @@
+/*
+  Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include "entityattribute.h"
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+namespace shared {
+
+/*!
+   Identifier of an interned attribute name. Use \ref AttributeNameTable to convert from/to the name.
+ */
+enum class AttributeId : int
+{
+    Invalid = -1
+};
+
+/*!
+   \class shared::AttributeNameTable
+   Process wide, thread safe table of attribute names.
+   All objects share one copy of each attribute name and look attributes up by their integer id.
+   Names are never removed, so lookups don't take any lock. Only adding a new name is serialized.
+ */
+class AttributeNameTable
+{
+public:
+    static AttributeId intern(const QString &name);
+    static AttributeId find(const QString &name);
+    static QString name(AttributeId id);
+    static int count();
+};
+
+/*!
+   \class shared::AttributeStore
+   Compact storage of the attributes of one entity. The entries are kept in a vector keyed by the interned name id,
+   which is much lighter than a hash of name strings for the few attributes an object usually carries.
+   Interface view connections and comments carry one or two attributes, functions and interfaces five to eight.
+   So the vector grows in small exact steps instead of reserving a fixed inline buffer for every object.
+ */
+class AttributeStore
+{
+public:
+    struct Entry {
+        AttributeId id = AttributeId::Invalid;
+        EntityAttribute::Type type = EntityAttribute::Type::Attribute;
+        QVariant value;
+    };
+
+    const Entry *find(AttributeId id) const;
+    bool contains(AttributeId id) const;
+    QVariant value(AttributeId id, const QVariant &defaultValue = QVariant()) const;
+    EntityAttribute attribute(AttributeId id) const;
+
+    void set(AttributeId id, const QVariant &value, EntityAttribute::Type type);
+    bool remove(AttributeId id);
+    void clear();
+
+    int size() const;
+    bool isEmpty() const;
+    const Entry *begin() const;
+    const Entry *end() const;
+
+    EntityAttributes toHash() const;
+
+private:
+    int indexOf(AttributeId id) const;
+
+    QVector<Entry> m_entries;
+};
+
+/*!
+   \class shared::TokenNames
+   Reverse lookup of a name to token hash, like the ones of the Props classes of the models.
+   The names are kept in a vector indexed by the token value, so the (hot) token to name conversion used while saving
+   and exporting does not scan the hash.
+ */
+template<typename Token>
+class TokenNames
+{
+public:
+    explicit TokenNames(const QHash<QString, Token> &tokensByName)
+    {
+        for (auto it = tokensByName.cbegin(); it != tokensByName.cend(); ++it) {
+            const int idx = static_cast<int>(it.value());
+            if (idx >= m_names.size()) {
+                m_names.resize(idx + 1);
+            }
+            m_names[idx] = it.key();
+        }
+    }
+
+    QString name(Token token) const
+    {
+        const int idx = static_cast<int>(token);
+        return idx >= 0 && idx < m_names.size() ? m_names.at(idx) : QString();
+    }
+
+private:
+    QVector<QString> m_names;
+};
+
+}
@@ -47,6 +47,10 @@ namespace shared {
            Save the file opened by OpenIVFile using the template passed with OpenStringTemplateFile.
     \var shared::CommandLineParser::DropUnsavedChangesSilently
            Do not warn about unsaved changes on the document closing.
+    \var shared::CommandLineParser::TraceFile
+           Record a Chrome trace of the application and write it to the given file on exit.
+    \var shared::CommandLineParser::MemoryReportFile
+           Write the estimated memory usage of the models, scenes and undo stacks to the given file on exit.
 */
 
 CommandLineParser::CommandLineParser()
@@ -162,6 +166,18 @@ QCommandLineOption CommandLineParser::positionalArg(CommandLineParser::Positiona
                 "Export the doc to the <file> using the template set by -t or the default template.");
         valueName = QCoreApplication::translate("CommandLineParser", "file");
         break;
+    case CommandLineParser::Positional::TraceFile:
+        names << "trace";
+        description = QCoreApplication::translate(
+                "CommandLineParser", "Write a Chrome trace of the loading, layout and export steps to <file>");
+        valueName = QCoreApplication::translate("CommandLineParser", "file");
+        break;
+    case CommandLineParser::Positional::MemoryReportFile:
+        names << "memory-report";
+        description = QCoreApplication::translate(
+                "CommandLineParser", "Write the estimated memory usage per object category as JSON to <file> on exit");
+        valueName = QCoreApplication::translate("CommandLineParser", "file");
+        break;
     case CommandLineParser::Positional::ListScriptableActions:
         names << "l"
               << "list-actions";
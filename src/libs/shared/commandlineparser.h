@@ -48,6 +48,8 @@ public:
         OpenStringTemplateFile,
         ExportToFile,
         DropUnsavedChangesSilently,
+        TraceFile,
+        MemoryReportFile,
 
         Unknown
     };
@@ -25,11 +25,14 @@
 namespace shared {
 namespace cmd {
 
+static quint64 lastSerial = 0;
+
 CmdEntityGeometryChange::CmdEntityGeometryChange(
         const QList<QPair<shared::VEObject *, QVector<QPointF>>> &objectsData, const QString &title)
     : QUndoCommand(title.isEmpty() ? QObject::tr("Change item(s) geometry/position") : title)
     , m_internalData(objectsData)
     , m_data(convertData(m_internalData))
+    , m_serial(++lastSerial)
 {
 }
 
@@ -69,6 +72,14 @@ int CmdEntityGeometryChange::id() const
     return ChangeEntityGeometry;
 }
 
+/*!
+   Returns the number identifying this command. Unlike the pointer, it's never reused by a later command
+ */
+quint64 CmdEntityGeometryChange::serial() const
+{
+    return m_serial;
+}
+
 void CmdEntityGeometryChange::mergeCommand(QUndoCommand *command)
 {
     if (command->id() != AutoLayoutEntity)
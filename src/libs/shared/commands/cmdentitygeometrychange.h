@@ -40,6 +40,7 @@ public:
     void redo() override;
     void undo() override;
     int id() const override;
+    quint64 serial() const;
 
     void mergeCommand(QUndoCommand *command);
 
@@ -59,6 +60,7 @@ private:
     QList<QPair<shared::VEObject *, QVector<QPointF>>> m_internalData;
     QList<ObjectData> m_data;
     QList<QUndoCommand *> m_mergedCmds;
+    const quint64 m_serial;
 };
 
 }
@@ -0,0 +1,457 @@
+/*
+  Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "connectionrouter.h"
+
+#include "graphicsviewutils.h"
+
+#include <QHash>
+#include <QtMath>
+#include <algorithm>
+#include <queue>
+
+namespace shared {
+namespace graphicsviewutils {
+
+static const qreal kConnectionMargin = 16.0;
+static const qreal kDefaultBendPenalty = 2 * kConnectionMargin;
+static const int kMaxGridCells = 64;
+/// Upper bound of the states one search may expand before giving up
+static const int kMaxRouterStates = 1000000;
+/// Distance the first searched area extends beyond the end points
+static const qreal kInitialSearchMargin = 8 * kConnectionMargin;
+
+namespace {
+enum Direction
+{
+    Right = 0,
+    Down,
+    Left,
+    Up,
+    NoDirection,
+};
+
+static const int kDx[] = { 1, 0, -1, 0 };
+static const int kDy[] = { 0, 1, 0, -1 };
+
+Direction direction(const QPointF &from, const QPointF &to)
+{
+    const qreal dx = to.x() - from.x();
+    const qreal dy = to.y() - from.y();
+    if (qFuzzyIsNull(dy) && !qFuzzyIsNull(dx)) {
+        return dx > 0 ? Right : Left;
+    }
+    if (qFuzzyIsNull(dx) && !qFuzzyIsNull(dy)) {
+        return dy > 0 ? Down : Up;
+    }
+    return NoDirection;
+}
+
+/// Coordinates produced by rotated direction vectors carry rounding noise, snap them to merge grid lines
+qreal snapped(qreal value)
+{
+    return qRound64(value * 1024) / 1024.;
+}
+
+QVector<qreal> uniqueSorted(QVector<qreal> values)
+{
+    std::transform(values.begin(), values.end(), values.begin(), snapped);
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+int indexOf(const QVector<qreal> &values, qreal value)
+{
+    const auto it = std::lower_bound(values.cbegin(), values.cend(), snapped(value));
+    return it != values.cend() && *it == snapped(value) ? int(std::distance(values.cbegin(), it)) : -1;
+}
+
+struct OpenState {
+    qreal f;
+    qreal g;
+    qint64 state;
+    bool operator>(const OpenState &other) const { return f > other.f; }
+};
+
+struct Visit {
+    qreal g;
+    qint64 parent;
+};
+}
+
+ObstacleIndex::ObstacleIndex(const QList<QRectF> &rects)
+{
+    reset(rects);
+}
+
+/*!
+   Rebuilds the index for \p rects
+ */
+void ObstacleIndex::reset(const QList<QRectF> &rects)
+{
+    m_rects = rects;
+    m_bounds = QRectF();
+    m_cells.clear();
+    m_columns = m_rows = 0;
+    m_cellSize = 0;
+
+    for (const QRectF &rect : m_rects) {
+        if (rect.isValid()) {
+            m_bounds = m_bounds.isNull() ? rect : m_bounds.united(rect);
+        }
+    }
+    if (m_bounds.isNull()) {
+        return;
+    }
+
+    /// Aim for roughly one rectangle per cell, but keep the grid reasonably small
+    const qreal area = qMax(m_bounds.width() * m_bounds.height(), qreal(1));
+    m_cellSize = qMax(qSqrt(area / m_rects.size()), qreal(1));
+    m_cellSize = qMax(m_cellSize, qMax(m_bounds.width(), m_bounds.height()) / kMaxGridCells);
+    m_columns = qBound(1, qCeil(m_bounds.width() / m_cellSize) + 1, kMaxGridCells + 1);
+    m_rows = qBound(1, qCeil(m_bounds.height() / m_cellSize) + 1, kMaxGridCells + 1);
+    m_cells.resize(m_columns * m_rows);
+
+    for (int idx = 0; idx < m_rects.size(); ++idx) {
+        const QRectF &rect = m_rects.at(idx);
+        if (!rect.isValid()) {
+            continue;
+        }
+        for (int r = row(rect.top()); r <= row(rect.bottom()); ++r) {
+            for (int c = column(rect.left()); c <= column(rect.right()); ++c) {
+                m_cells[r * m_columns + c].append(idx);
+            }
+        }
+    }
+}
+
+const QList<QRectF> &ObstacleIndex::rects() const
+{
+    return m_rects;
+}
+
+QRectF ObstacleIndex::boundingRect() const
+{
+    return m_bounds;
+}
+
+bool ObstacleIndex::isEmpty() const
+{
+    return m_cells.isEmpty();
+}
+
+/*!
+   Returns the indexes in \ref rects of the rectangles that might overlap \p area.
+   Unlike QRectF::intersects this also handles degenerated areas like horizontal or vertical lines.
+ */
+QVector<int> ObstacleIndex::query(const QRectF &area) const
+{
+    const QRectF normalized = area.normalized();
+    if (isEmpty() || normalized.right() < m_bounds.left() || normalized.left() > m_bounds.right()
+            || normalized.bottom() < m_bounds.top() || normalized.top() > m_bounds.bottom()) {
+        return {};
+    }
+
+    QVector<int> result;
+    for (int r = row(normalized.top()); r <= row(normalized.bottom()); ++r) {
+        for (int c = column(normalized.left()); c <= column(normalized.right()); ++c) {
+            result += m_cells.at(r * m_columns + c);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+/*!
+   Returns true if the segment from \p p1 to \p p2 crosses the interior of any obstacle.
+   Touching an obstacle edge is not considered as crossing it.
+ */
+bool ObstacleIndex::intersects(const QPointF &p1, const QPointF &p2) const
+{
+    if (isEmpty()) {
+        return false;
+    }
+
+    const qreal left = qMin(p1.x(), p2.x());
+    const qreal right = qMax(p1.x(), p2.x());
+    const qreal top = qMin(p1.y(), p2.y());
+    const qreal bottom = qMax(p1.y(), p2.y());
+    if (right < m_bounds.left() || left > m_bounds.right() || bottom < m_bounds.top() || top > m_bounds.bottom()) {
+        return false;
+    }
+
+    const bool horizontal = qFuzzyCompare(p1.y(), p2.y());
+    const bool vertical = qFuzzyCompare(p1.x(), p2.x());
+    auto crosses = [&](const QRectF &rect) {
+        if (horizontal) {
+            return rect.top() < p1.y() && p1.y() < rect.bottom() && left < rect.right() && right > rect.left();
+        }
+        if (vertical) {
+            return rect.left() < p1.x() && p1.x() < rect.right() && top < rect.bottom() && bottom > rect.top();
+        }
+        return rectContainsPoint(rect, p1) || rectContainsPoint(rect, p2)
+                || shared::graphicsviewutils::intersects(rect, QLineF(p1, p2));
+    };
+
+    /// Duplicates are not filtered here, checking a rectangle twice is cheaper than sorting the candidates
+    for (int r = row(top); r <= row(bottom); ++r) {
+        for (int c = column(left); c <= column(right); ++c) {
+            for (int idx : m_cells.at(r * m_columns + c)) {
+                if (crosses(m_rects.at(idx))) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/*!
+   Returns true if any segment of \p polyline crosses the interior of an obstacle
+ */
+bool ObstacleIndex::intersects(const QVector<QPointF> &polyline) const
+{
+    for (int idx = 1; idx < polyline.size(); ++idx) {
+        if (intersects(polyline.at(idx - 1), polyline.at(idx))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int ObstacleIndex::column(qreal x) const
+{
+    return qBound(0, int((x - m_bounds.left()) / m_cellSize), m_columns - 1);
+}
+
+int ObstacleIndex::row(qreal y) const
+{
+    return qBound(0, int((y - m_bounds.top()) / m_cellSize), m_rows - 1);
+}
+
+/*!
+   Creates a router avoiding the rectangles of \p obstacles. The index has to outlive the router.
+ */
+ConnectionRouter::ConnectionRouter(const ObstacleIndex &obstacles)
+    : m_obstacles(obstacles)
+    , m_bendPenalty(kDefaultBendPenalty)
+{
+}
+
+qreal ConnectionRouter::bendPenalty() const
+{
+    return m_bendPenalty;
+}
+
+void ConnectionRouter::setBendPenalty(qreal penalty)
+{
+    m_bendPenalty = qMax(penalty, qreal(0));
+}
+
+/*!
+   Returns the route leaving the source along \p startDirection and entering the target along \p endDirection.
+   The first and last points are the \c p1 of the directions. Returns an empty vector if there is no route.
+ */
+QVector<QPointF> ConnectionRouter::route(const QLineF &startDirection, const QLineF &endDirection) const
+{
+    const Direction startDir = direction(startDirection.p1(), startDirection.p2());
+    const Direction endDir = direction(endDirection.p2(), endDirection.p1());
+    const QVector<QPointF> points = findRoute(startDirection.p2(), startDir, endDirection.p2(), endDir);
+    if (points.isEmpty()) {
+        return {};
+    }
+
+    QVector<QPointF> result;
+    result.reserve(points.size() + 2);
+    result.append(startDirection.p1());
+    result += points;
+    result.append(endDirection.p1());
+    return result;
+}
+
+/*!
+   Returns the route from \p startPoint to \p endPoint without constraints on the first and last segment directions.
+ */
+QVector<QPointF> ConnectionRouter::route(const QPointF &startPoint, const QPointF &endPoint) const
+{
+    return findRoute(startPoint, NoDirection, endPoint, NoDirection);
+}
+
+/*!
+   Returns true if the previously computed route \p points can be reused as it doesn't cross any obstacle
+ */
+bool ConnectionRouter::isRouteValid(const QVector<QPointF> &points) const
+{
+    return points.size() >= 2 && !m_obstacles.intersects(points);
+}
+
+QVector<QPointF> ConnectionRouter::findRoute(
+        const QPointF &startPoint, int startDirection, const QPointF &endPoint, int endDirection) const
+{
+    if (startPoint == endPoint) {
+        return { startPoint, endPoint };
+    }
+
+    const QRectF endPoints = QRectF(startPoint, endPoint).normalized();
+    const QRectF obstaclesArea = m_obstacles.boundingRect().adjusted(
+            -2 * kConnectionMargin, -2 * kConnectionMargin, 2 * kConnectionMargin, 2 * kConnectionMargin);
+    qreal margin = kInitialSearchMargin;
+    while (true) {
+        const QRectF area = endPoints.adjusted(-margin, -margin, margin, margin);
+        const QVector<QPointF> points = findRouteInArea(area, startPoint, startDirection, endPoint, endDirection);
+        if (!points.isEmpty() || m_obstacles.isEmpty() || area.contains(obstaclesArea)) {
+            return points;
+        }
+        margin *= 4;
+    }
+}
+
+/*!
+   Searches a route that stays within \p area. The graph lines are the borders of \p area, the end points and the
+   shifted edges of the obstacles the index returns for \p area. Segments are checked against all obstacles.
+ */
+QVector<QPointF> ConnectionRouter::findRouteInArea(const QRectF &area, const QPointF &startPoint,
+        int startDirection, const QPointF &endPoint, int endDirection) const
+{
+    QVector<qreal> xs { startPoint.x(), endPoint.x(), area.left(), area.right() };
+    QVector<qreal> ys { startPoint.y(), endPoint.y(), area.top(), area.bottom() };
+    const QVector<int> candidates = m_obstacles.query(area);
+    xs.reserve(candidates.size() * 2 + 4);
+    ys.reserve(candidates.size() * 2 + 4);
+    auto addLine = [](QVector<qreal> &lines, qreal value, qreal min, qreal max) {
+        if (value > min && value < max) {
+            lines.append(value);
+        }
+    };
+    for (int idx : candidates) {
+        const QRectF &rect = m_obstacles.rects().at(idx);
+        if (!rect.isValid()) {
+            continue;
+        }
+        addLine(xs, rect.left() - kConnectionMargin, area.left(), area.right());
+        addLine(xs, rect.right() + kConnectionMargin, area.left(), area.right());
+        addLine(ys, rect.top() - kConnectionMargin, area.top(), area.bottom());
+        addLine(ys, rect.bottom() + kConnectionMargin, area.top(), area.bottom());
+    }
+    xs = uniqueSorted(xs);
+    ys = uniqueSorted(ys);
+    const qint64 columns = xs.size();
+    const qint64 rows = ys.size();
+
+    const qint64 startNode = indexOf(ys, startPoint.y()) * columns + indexOf(xs, startPoint.x());
+    const qint64 endNode = indexOf(ys, endPoint.y()) * columns + indexOf(xs, endPoint.x());
+
+    auto nodePoint = [&](qint64 node) { return QPointF(xs.at(int(node % columns)), ys.at(int(node / columns))); };
+    auto heuristic = [&](qint64 node) {
+        const QPointF point = nodePoint(node);
+        return qAbs(point.x() - endPoint.x()) + qAbs(point.y() - endPoint.y());
+    };
+
+    /// A state is a node together with the direction it was entered from, so bends can be priced
+    auto stateOf = [](qint64 node, int dir) { return node * (NoDirection + 1) + dir; };
+
+    QHash<qint64, Visit> visited;
+    std::priority_queue<OpenState, std::vector<OpenState>, std::greater<OpenState>> open;
+    const qint64 initialState = stateOf(startNode, startDirection);
+    visited.insert(initialState, { 0, -1 });
+    open.push({ heuristic(startNode), 0, initialState });
+
+    qint64 goalState = -1;
+    int expandedStates = 0;
+    while (!open.empty()) {
+        const OpenState current = open.top();
+        open.pop();
+        if (current.g > visited.value(current.state).g) {
+            continue;
+        }
+        if (++expandedStates > kMaxRouterStates) {
+            return {};
+        }
+
+        const qint64 node = current.state / (NoDirection + 1);
+        const int dir = int(current.state % (NoDirection + 1));
+        if (node == endNode) {
+            goalState = current.state;
+            break;
+        }
+
+        const qint64 column = node % columns;
+        const qint64 row = node / columns;
+        for (int nextDir = Right; nextDir < NoDirection; ++nextDir) {
+            if (dir != NoDirection && (dir + 2) % 4 == nextDir) {
+                continue;
+            }
+            const qint64 nextColumn = column + kDx[nextDir];
+            const qint64 nextRow = row + kDy[nextDir];
+            if (nextColumn < 0 || nextColumn >= columns || nextRow < 0 || nextRow >= rows) {
+                continue;
+            }
+            const qint64 nextNode = nextRow * columns + nextColumn;
+            const QPointF from = nodePoint(node);
+            const QPointF to = nodePoint(nextNode);
+            if (m_obstacles.intersects(from, to)) {
+                continue;
+            }
+
+            qreal g = current.g + QLineF(from, to).length();
+            if (dir != NoDirection && dir != nextDir) {
+                g += m_bendPenalty;
+            }
+            if (nextNode == endNode && endDirection != NoDirection && endDirection != nextDir) {
+                g += m_bendPenalty;
+            }
+
+            const qint64 nextState = stateOf(nextNode, nextDir);
+            const auto it = visited.constFind(nextState);
+            if (it != visited.constEnd() && it->g <= g) {
+                continue;
+            }
+            visited.insert(nextState, { g, current.state });
+            open.push({ g + heuristic(nextNode), g, nextState });
+        }
+    }
+
+    if (goalState < 0) {
+        return {};
+    }
+
+    QVector<QPointF> nodes;
+    for (qint64 state = goalState; state >= 0; state = visited.value(state).parent) {
+        nodes.prepend(nodePoint(state / (NoDirection + 1)));
+    }
+
+    /// Keep only the points where the route changes its direction
+    QVector<QPointF> points { nodes.first() };
+    for (int idx = 1; idx < nodes.size(); ++idx) {
+        if (idx + 1 < nodes.size()
+                && direction(nodes.at(idx - 1), nodes.at(idx)) == direction(nodes.at(idx), nodes.at(idx + 1))) {
+            continue;
+        }
+        points.append(nodes.at(idx));
+    }
+    if (points.size() == 1) {
+        points.append(endPoint);
+    }
+    points.first() = startPoint;
+    points.last() = endPoint;
+    return points;
+}
+
+}
+}
@@ -0,0 +1,95 @@
+/*
+  Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QLineF>
+#include <QList>
+#include <QRectF>
+#include <QVector>
+
+namespace shared {
+namespace graphicsviewutils {
+
+/*!
+   \class shared::graphicsviewutils::ObstacleIndex
+   Uniform grid index over the rectangles a connection must not cross.
+   The index is immutable once built, so a single instance can be queried from several threads.
+ */
+class ObstacleIndex
+{
+public:
+    ObstacleIndex() = default;
+    explicit ObstacleIndex(const QList<QRectF> &rects);
+
+    void reset(const QList<QRectF> &rects);
+
+    const QList<QRectF> &rects() const;
+    QRectF boundingRect() const;
+    bool isEmpty() const;
+
+    QVector<int> query(const QRectF &area) const;
+    bool intersects(const QPointF &p1, const QPointF &p2) const;
+    bool intersects(const QVector<QPointF> &polyline) const;
+
+private:
+    int column(qreal x) const;
+    int row(qreal y) const;
+
+    QList<QRectF> m_rects;
+    QRectF m_bounds;
+    qreal m_cellSize = 0;
+    int m_columns = 0;
+    int m_rows = 0;
+    QVector<QVector<int>> m_cells;
+};
+
+/*!
+   \class shared::graphicsviewutils::ConnectionRouter
+   Orthogonal connection router.
+
+   The router builds an orthogonal visibility graph whose lines run along the obstacle edges (shifted by the
+   connection margin) and through the connection end points, then searches it with A*. Only the obstacles around the
+   end points contribute lines, the searched area is widened until a route is found or it covers all obstacles.
+   Every change of direction costs \ref bendPenalty in addition to the segment length, so routes with fewer bends
+   are preferred.
+ */
+class ConnectionRouter
+{
+public:
+    explicit ConnectionRouter(const ObstacleIndex &obstacles);
+
+    qreal bendPenalty() const;
+    void setBendPenalty(qreal penalty);
+
+    QVector<QPointF> route(const QLineF &startDirection, const QLineF &endDirection) const;
+    QVector<QPointF> route(const QPointF &startPoint, const QPointF &endPoint) const;
+
+    bool isRouteValid(const QVector<QPointF> &points) const;
+
+private:
+    QVector<QPointF> findRoute(const QPointF &startPoint, int startDirection, const QPointF &endPoint,
+            int endDirection) const;
+    QVector<QPointF> findRouteInArea(const QRectF &area, const QPointF &startPoint, int startDirection,
+            const QPointF &endPoint, int endDirection) const;
+
+    const ObstacleIndex &m_obstacles;
+    qreal m_bendPenalty;
+};
+
+}
+}
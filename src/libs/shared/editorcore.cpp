@@ -17,12 +17,14 @@
 
 #include "editorcore.h"
 
+#include "memoryreport.h"
 #include "ui/graphicsviewbase.h"
 
 #include <QAction>
 #include <QApplication>
 #include <QDebug>
 #include <QDesktopServices>
+#include <QFileDialog>
 #include <QKeySequence>
 #include <QMainWindow>
 #include <QMenuBar>
@@ -143,6 +145,50 @@ QAction *EditorCore::actionToggleMinimap()
     return m_actionToggleMinimap;
 }
 
+QAction *EditorCore::actionMemoryReport()
+{
+    if (m_actionMemoryReport == nullptr) {
+        m_actionMemoryReport = new QAction(tr("Save memory report..."), this);
+        connect(m_actionMemoryReport, &QAction::triggered, this, &EditorCore::showMemoryReport);
+    }
+    return m_actionMemoryReport;
+}
+
+/*!
+   Adds the undo stack. Subclasses add their models and scenes and call this implementation
+ */
+void EditorCore::addToMemoryReport(MemoryReport *report) const
+{
+    report->addUndoStack(undoStack());
+}
+
+/*!
+   Writes the estimated memory usage of this core as JSON to \p fileName
+ */
+bool EditorCore::saveMemoryReport(const QString &fileName) const
+{
+    MemoryReport report;
+    addToMemoryReport(&report);
+    return report.save(fileName);
+}
+
+/*!
+   Asks for a file name and saves the memory report to it
+ */
+void EditorCore::showMemoryReport()
+{
+    QWidget *parent = QApplication::activeWindow();
+    const QString fileName =
+            QFileDialog::getSaveFileName(parent, tr("Save memory report"), QString(), tr("JSON files (*.json)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (!saveMemoryReport(fileName)) {
+        QMessageBox::warning(parent, tr("Memory report"), tr("Unable to write the file %1").arg(fileName));
+    }
+}
+
 /*!
    Pops upd the about dialog with basic information about the application
  */
@@ -32,6 +32,7 @@ class QUrl;
 namespace shared {
 
 class CommandLineParser;
+class MemoryReport;
 
 namespace ui {
 class GraphicsViewBase;
@@ -58,6 +59,7 @@ public:
     QAction *actionUndo();
     QAction *actionRedo();
     QAction *actionToggleMinimap();
+    QAction *actionMemoryReport();
 
     // Populate a CommandLineParser with the arguments this application can handle
     virtual void populateCommandLineArguments(CommandLineParser *parser) const = 0;
@@ -73,9 +75,14 @@ public:
     /// Saves the file
     virtual bool save() = 0;
 
+    /// Adds the models, scenes and undo stack of this core to \p report
+    virtual void addToMemoryReport(MemoryReport *report) const;
+    bool saveMemoryReport(const QString &fileName) const;
+
 public Q_SLOTS:
     void showHelp();
     void showAboutDialog();
+    void showMemoryReport();
 
 Q_SIGNALS:
     void editedExternally(shared::EditorCore *);
@@ -96,6 +103,7 @@ private:
     QAction *m_actionUndo { nullptr };
     QAction *m_actionRedo { nullptr };
     QAction *m_actionToggleMinimap { nullptr };
+    QAction *m_actionMemoryReport { nullptr };
 };
 
 }
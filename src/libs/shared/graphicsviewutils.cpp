@@ -1,5 +1,7 @@
 #include "graphicsviewutils.h"
 
+#include "connectionrouter.h"
+#include "trace.h"
 #include "ui/veinteractiveobject.h"
 #include "ui/verectgraphicsitem.h"
 #include "veobject.h"
@@ -826,6 +828,7 @@ QVector<QPointF> findPath(const QList<QRectF> &existingRects, const QLineF &star
  */
 QVector<QPointF> path(const QList<QRectF> &existingRects, const QLineF &startDirection, const QLineF &endDirection)
 {
+    SC_TRACE_SCOPE("routing", "graphicsviewutils::path");
     QRectF intersectedRect;
     QList<QVector<QPointF>> paths { { startDirection.p1(), startDirection.p2() } };
     while (true) {
@@ -885,6 +888,18 @@ QVector<QPointF> path(const QList<QRectF> &existingRects, const QLineF &startDir
 QVector<QPointF> createConnectionPath(const QList<QRectF> &existingRects, const QPointF &startIfacePos,
         const QRectF &sourceRect, const QPointF &endIfacePos, const QRectF &targetRect)
 {
+    return createConnectionPath(ObstacleIndex(existingRects), startIfacePos, sourceRect, endIfacePos, targetRect);
+}
+
+/*!
+ * Generates the whole path for \a IVConnectionGraphicsItem avoiding the rectangles of \a obstacles.
+ * The path is found by the A* based \a ConnectionRouter, the corner based search of \a path
+ * is used only if the router doesn't find any route.
+ */
+QVector<QPointF> createConnectionPath(const ObstacleIndex &obstacles, const QPointF &startIfacePos,
+        const QRectF &sourceRect, const QPointF &endIfacePos, const QRectF &targetRect)
+{
+    SC_TRACE_SCOPE("routing", "graphicsviewutils::createConnectionPath");
     const QLineF startDirection = ifaceSegment(sourceRect, startIfacePos, endIfacePos);
     if (startDirection.isNull())
         return {};
@@ -893,10 +908,23 @@ QVector<QPointF> createConnectionPath(const QList<QRectF> &existingRects, const
     if (endDirection.isNull())
         return {};
 
-    const auto points = path(existingRects, startDirection, endDirection);
+    QVector<QPointF> points = ConnectionRouter(obstacles).route(startDirection, endDirection);
+    if (points.isEmpty())
+        points = path(obstacles.rects(), startDirection, endDirection);
     return simplifyPoints(points);
 }
 
+/*!
+ * Generates the path from \a startPoint to \a endPoint avoiding the rectangles of \a obstacles.
+ * Falls back to the corner based search of \a path if the router doesn't find any route.
+ */
+QVector<QPointF> routePath(const ObstacleIndex &obstacles, const QPointF &startPoint, const QPointF &endPoint)
+{
+    SC_TRACE_SCOPE("routing", "graphicsviewutils::routePath");
+    const QVector<QPointF> points = ConnectionRouter(obstacles).route(startPoint, endPoint);
+    return points.isEmpty() ? path(obstacles.rects(), startPoint, endPoint) : points;
+}
+
 QVector<QPointF> simplifyPoints(const QVector<QPointF> &points)
 {
     if (points.size() <= 2)
@@ -7,6 +7,7 @@ class QPainterPath;
 
 namespace shared {
 namespace graphicsviewutils {
+class ObstacleIndex;
 
 static const QMarginsF kTextMargins = { 20, 20, 20, 20 };
 static const QMarginsF kRootMargins = { 50, 50, 50, 50 };
@@ -88,6 +89,9 @@ QVector<QPointF> path(const QList<QRectF> &existingRects, const QLineF &startDir
 
 QVector<QPointF> createConnectionPath(const QList<QRectF> &existingRects, const QPointF &startIfacePos,
         const QRectF &sourceRect, const QPointF &endIfacePos, const QRectF &targetRect);
+QVector<QPointF> createConnectionPath(const ObstacleIndex &obstacles, const QPointF &startIfacePos,
+        const QRectF &sourceRect, const QPointF &endIfacePos, const QRectF &targetRect);
+QVector<QPointF> routePath(const ObstacleIndex &obstacles, const QPointF &startPoint, const QPointF &endPoint);
 
 QVector<QPointF> simplifyPoints(const QVector<QPointF> &points);
 
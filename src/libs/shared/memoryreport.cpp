@@ -0,0 +1,245 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "memoryreport.h"
+
+#include "attributestore.h"
+#include "vemodel.h"
+#include "veobject.h"
+
+#include <QFile>
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QGraphicsTextItem>
+#include <QJsonDocument>
+#include <QSet>
+#include <QTextDocument>
+#include <QUndoCommand>
+#include <QUndoStack>
+#include <QVariant>
+#include <functional>
+
+namespace shared {
+
+/// Assumed size of QGraphicsItem including its private data
+static const qint64 kGraphicsItemBytes = 320;
+/// Assumed size of the layout and format data of a QTextDocument without any text
+static const qint64 kTextDocumentBytes = 1024;
+/// Assumed size of the layout data of one text block
+static const qint64 kTextBlockBytes = 128;
+/// Assumed size of QUndoCommand including its private data, without the texts
+static const qint64 kUndoCommandBytes = 96;
+
+const qint64 MemoryReport::ObjectBytes = sizeof(QObject) + 112;
+const qint64 MemoryReport::ArrayHeaderBytes = 24;
+
+/*!
+   Adds \p count objects with \p bytes in total to \p category
+ */
+void MemoryReport::add(const QString &category, qint64 count, qint64 bytes)
+{
+    Entry &entry = m_entries[category];
+    entry.count += count;
+    entry.bytes += bytes;
+}
+
+MemoryReport::Entry MemoryReport::entry(const QString &category) const
+{
+    return m_entries.value(category);
+}
+
+/*!
+   Returns all categories, sorted by name
+ */
+QStringList MemoryReport::categories() const
+{
+    return m_entries.keys();
+}
+
+qint64 MemoryReport::totalBytes() const
+{
+    qint64 bytes = 0;
+    for (const Entry &entry : m_entries) {
+        bytes += entry.bytes;
+    }
+    return bytes;
+}
+
+/*!
+   Adds all objects of \p model, one category per class like "ve.IVFunction", and their attributes as
+   "ve.attributes"
+ */
+void MemoryReport::addModel(const VEModel *model)
+{
+    if (!model) {
+        return;
+    }
+
+    const QHash<Id, VEObject *> objects = model->objects();
+    for (const VEObject *object : objects) {
+        if (!object) {
+            continue;
+        }
+
+        const QString className = QString::fromLatin1(object->metaObject()->className()).section("::", -1);
+        add(QLatin1String("ve.") + className, 1, ObjectBytes);
+
+        const AttributeStore &store = object->attributeStore();
+        qint64 attributeBytes = 0;
+        for (const AttributeStore::Entry &attribute : store) {
+            attributeBytes += sizeof(AttributeStore::Entry) + variantBytes(attribute.value);
+        }
+        add(QLatin1String("ve.attributes"), store.size(), attributeBytes);
+    }
+}
+
+/*!
+   Adds all items of \p scene as "scene.items" and the documents of their text labels as "scene.textDocuments"
+ */
+void MemoryReport::addScene(const QGraphicsScene *scene)
+{
+    if (!scene) {
+        return;
+    }
+
+    QSet<const QTextDocument *> documents;
+    const QList<QGraphicsItem *> items = scene->items();
+    for (const QGraphicsItem *item : items) {
+        add(QLatin1String("scene.items"), 1,
+                kGraphicsItemBytes + (item->toGraphicsObject() ? ObjectBytes : 0));
+
+        if (auto textItem = dynamic_cast<const QGraphicsTextItem *>(item)) {
+            const QTextDocument *document = textItem->document();
+            if (document && !documents.contains(document)) {
+                documents.insert(document);
+                add(QLatin1String("scene.textDocuments"), 1, textDocumentBytes(document));
+            }
+        }
+    }
+}
+
+/*!
+   Adds all commands of \p stack, including their child commands, as "undo.commands"
+ */
+void MemoryReport::addUndoStack(const QUndoStack *stack)
+{
+    if (!stack) {
+        return;
+    }
+
+    std::function<void(const QUndoCommand *)> addCommand = [&](const QUndoCommand *command) {
+        add(QLatin1String("undo.commands"), 1,
+                kUndoCommandBytes + stringBytes(command->text()) + stringBytes(command->actionText()));
+        for (int idx = 0; idx < command->childCount(); ++idx) {
+            addCommand(command->child(idx));
+        }
+    };
+
+    for (int idx = 0; idx < stack->count(); ++idx) {
+        addCommand(stack->command(idx));
+    }
+}
+
+/*!
+   Returns the report as JSON object, like
+   { "totalBytes": 1200, "categories": { "undo.commands": { "count": 10, "bytes": 1200 } } }
+ */
+QJsonObject MemoryReport::toJson() const
+{
+    QJsonObject categories;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        categories.insert(it.key(),
+                QJsonObject { { "count", double(it.value().count) }, { "bytes", double(it.value().bytes) } });
+    }
+    return QJsonObject { { "totalBytes", double(totalBytes()) }, { "categories", categories } };
+}
+
+/*!
+   Writes the report as JSON to \p fileName
+ */
+bool MemoryReport::save(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Unable to write the memory report %s", qPrintable(fileName));
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+/*!
+   Returns the heap size of the data of \p text
+ */
+qint64 MemoryReport::stringBytes(const QString &text)
+{
+    return text.capacity() > 0 ? ArrayHeaderBytes + (text.capacity() + 1) * qint64(sizeof(QChar)) : 0;
+}
+
+/*!
+   Returns the heap size of the data of \p value, without the QVariant itself.
+   Values stored inline in the variant, like numbers, count as 0
+ */
+qint64 MemoryReport::variantBytes(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::QString:
+        return stringBytes(value.toString());
+    case QMetaType::QByteArray:
+        return ArrayHeaderBytes + value.toByteArray().capacity();
+    case QMetaType::QStringList: {
+        const QStringList list = value.toStringList();
+        qint64 bytes = ArrayHeaderBytes + list.size() * qint64(sizeof(QString));
+        for (const QString &text : list) {
+            bytes += stringBytes(text);
+        }
+        return bytes;
+    }
+    case QMetaType::QVariantList: {
+        const QVariantList list = value.toList();
+        qint64 bytes = ArrayHeaderBytes + list.size() * qint64(sizeof(QVariant));
+        for (const QVariant &item : list) {
+            bytes += variantBytes(item);
+        }
+        return bytes;
+    }
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        qint64 bytes = ArrayHeaderBytes;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            bytes += sizeof(QString) + sizeof(QVariant) + stringBytes(it.key()) + variantBytes(it.value());
+        }
+        return bytes;
+    }
+    default:
+        return 0;
+    }
+}
+
+/*!
+   Returns the estimated size of \p document with its text and layout
+ */
+qint64 MemoryReport::textDocumentBytes(const QTextDocument *document)
+{
+    if (!document) {
+        return 0;
+    }
+    return ObjectBytes + kTextDocumentBytes + document->characterCount() * qint64(sizeof(QChar))
+            + document->blockCount() * kTextBlockBytes;
+}
+
+}
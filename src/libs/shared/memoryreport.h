@@ -0,0 +1,77 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+class QGraphicsScene;
+class QTextDocument;
+class QUndoStack;
+class QVariant;
+
+namespace shared {
+
+class VEModel;
+
+/*!
+   \class shared::MemoryReport
+   Collects the estimated memory usage of models, scenes and undo stacks as object count and bytes per category.
+
+   The bytes are estimates: the private data of Qt classes is not accessible, so a fixed size is assumed for it,
+   and implicitly shared data like strings is counted for every object using it. The numbers are meant to compare
+   categories and sessions, not to match the heap usage of the process.
+   Categories are dot separated names like "ve.attributes" or "scene.items". Other libraries add their own
+   categories by \ref add, like Asn1ModelStorage or MscModel do.
+ */
+class MemoryReport
+{
+public:
+    struct Entry {
+        qint64 count = 0;
+        qint64 bytes = 0;
+    };
+
+    void add(const QString &category, qint64 count, qint64 bytes);
+    Entry entry(const QString &category) const;
+    QStringList categories() const;
+    qint64 totalBytes() const;
+
+    void addModel(const VEModel *model);
+    void addScene(const QGraphicsScene *scene);
+    void addUndoStack(const QUndoStack *stack);
+
+    QJsonObject toJson() const;
+    bool save(const QString &fileName) const;
+
+    static qint64 stringBytes(const QString &text);
+    static qint64 variantBytes(const QVariant &value);
+    static qint64 textDocumentBytes(const QTextDocument *document);
+
+    /// Assumed size of a QObject including its private data
+    static const qint64 ObjectBytes;
+    /// Size of the header of the heap block of implicitly shared containers like QString or QVector
+    static const qint64 ArrayHeaderBytes;
+
+private:
+    QMap<QString, Entry> m_entries;
+};
+
+}
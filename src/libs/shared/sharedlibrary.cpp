@@ -1,5 +1,7 @@
 #include "sharedlibrary.h"
 
+#include "trace.h"
+
 #include <qglobal.h>
 
 static void init_shared_library()
@@ -11,10 +13,12 @@ namespace shared {
 
 /**
    Initializes the library resources and Qt meta types.
+   Starts tracing if the environment variable SC_TRACE_FILE is set.
  */
 void initSharedLibrary()
 {
     init_shared_library();
+    Trace::startFromEnvironment();
 }
 
 }
@@ -0,0 +1,236 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "trace.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+namespace shared {
+
+std::atomic<bool> Trace::m_enabled { false };
+
+namespace {
+
+struct TraceEvent {
+    const char *category;
+    const char *name;
+    char phase;
+    qint64 timestamp;
+    qint64 duration;
+    int threadId;
+    quint64 asyncId;
+    QString detail;
+};
+
+struct TraceData {
+    QMutex mutex;
+    QElapsedTimer timer;
+    QString fileName;
+    QVector<TraceEvent> events;
+    QVector<QString> threadNames; ///< Name of each thread, by trace thread id
+    quint64 nextAsyncId = 1;
+    bool postRoutineAdded = false;
+};
+
+Q_GLOBAL_STATIC(TraceData, traceData)
+
+/*!
+   Returns the small id of the current thread in the trace. Has to be called with the mutex locked
+ */
+int currentThreadId(TraceData *data)
+{
+    thread_local int threadId = -1;
+    if (threadId < 0) {
+        threadId = data->threadNames.size();
+        QThread *thread = QThread::currentThread();
+        QString name = thread ? thread->objectName() : QString();
+        if (name.isEmpty()) {
+            const bool isMain = QCoreApplication::instance() && thread == QCoreApplication::instance()->thread();
+            name = isMain ? QString("Main thread") : QString("Thread %1").arg(threadId);
+        }
+        data->threadNames.append(name);
+    }
+    return threadId;
+}
+
+QJsonObject eventJson(const TraceEvent &event, qint64 processId)
+{
+    QJsonObject json;
+    json["cat"] = QString::fromLatin1(event.category);
+    json["name"] = QString::fromLatin1(event.name);
+    json["ph"] = QString(QLatin1Char(event.phase));
+    json["ts"] = event.timestamp;
+    json["pid"] = processId;
+    json["tid"] = event.threadId;
+    if (event.phase == 'X') {
+        json["dur"] = event.duration;
+    } else {
+        json["id"] = QString::number(event.asyncId);
+    }
+    if (!event.detail.isEmpty()) {
+        json["args"] = QJsonObject { { "detail", event.detail } };
+    }
+    return json;
+}
+
+void writeOnQuit()
+{
+    Trace::stop();
+}
+
+}
+
+/*!
+   Starts recording. All spans recorded before are dropped. If \p fileName is set, the trace is written there
+   by \ref stop.
+   Returns false if tracing is running already
+ */
+bool Trace::start(const QString &fileName)
+{
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->mutex);
+    if (isEnabled()) {
+        return false;
+    }
+
+    data->fileName = fileName;
+    data->events.clear();
+    data->nextAsyncId = 1;
+    data->timer.start();
+    if (!data->postRoutineAdded) {
+        qAddPostRoutine(writeOnQuit);
+        data->postRoutineAdded = true;
+    }
+    m_enabled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+/*!
+   Starts recording into the file set by the environment variable SC_TRACE_FILE, if it is set
+ */
+bool Trace::startFromEnvironment()
+{
+    const QString fileName = qEnvironmentVariable("SC_TRACE_FILE");
+    return !fileName.isEmpty() && start(fileName);
+}
+
+/*!
+   Stops recording and writes the trace file, if one was set in \ref start. The recorded spans are kept for
+   \ref toJson.
+   Returns false if the file could not be written
+ */
+bool Trace::stop()
+{
+    if (!isEnabled()) {
+        return true;
+    }
+    m_enabled.store(false, std::memory_order_relaxed);
+
+    const QString traceFile = fileName();
+    if (traceFile.isEmpty()) {
+        return true;
+    }
+
+    QFile file(traceFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Unable to write the trace file %s", qPrintable(traceFile));
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+QString Trace::fileName()
+{
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->mutex);
+    return data->fileName;
+}
+
+/*!
+   Returns the microseconds since tracing was started
+ */
+qint64 Trace::timestamp()
+{
+    return traceData()->timer.nsecsElapsed() / 1000;
+}
+
+/*!
+   Adds a span of the current thread, from \p begin to \p end as returned by \ref timestamp
+ */
+void Trace::addSpan(const char *category, const char *name, qint64 begin, qint64 end, const QString &detail)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->mutex);
+    data->events.append({ category, name, 'X', begin, end - begin, currentThreadId(data), 0, detail });
+}
+
+/*!
+   Adds a span that is not bound to a thread, like an external process that ran from \p begin to \p end.
+   Async spans are shown in their own track, so they may overlap any other span
+ */
+void Trace::addAsyncSpan(const char *category, const char *name, qint64 begin, qint64 end, const QString &detail)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->mutex);
+    const int threadId = currentThreadId(data);
+    const quint64 asyncId = data->nextAsyncId++;
+    data->events.append({ category, name, 'b', begin, 0, threadId, asyncId, detail });
+    data->events.append({ category, name, 'e', end, 0, threadId, asyncId, QString() });
+}
+
+/*!
+   Returns the recorded spans as Chrome trace event JSON object, including the names of the threads
+ */
+QJsonObject Trace::toJson()
+{
+    TraceData *data = traceData();
+    QMutexLocker locker(&data->mutex);
+
+    const qint64 processId = QCoreApplication::applicationPid();
+    QJsonArray events;
+    for (int threadId = 0; threadId < data->threadNames.size(); ++threadId) {
+        events.append(QJsonObject { { "name", "thread_name" }, { "ph", "M" }, { "pid", processId },
+                { "tid", threadId }, { "args", QJsonObject { { "name", data->threadNames.at(threadId) } } } });
+    }
+    for (const TraceEvent &event : qAsConst(data->events)) {
+        events.append(eventJson(event, processId));
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = QString("ms");
+    return root;
+}
+
+}
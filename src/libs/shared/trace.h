@@ -0,0 +1,98 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <atomic>
+
+namespace shared {
+
+/*!
+   \class shared::Trace
+   Records timed spans and writes them as Chrome trace event JSON, to be viewed with chrome://tracing or Perfetto.
+
+   Tracing is off by default. It is started by \ref start, or by \ref initSharedLibrary when the environment variable
+   SC_TRACE_FILE is set. While it is off, a \ref TraceScope only costs the check of one atomic flag.
+   The trace file is written by \ref stop, which is called automatically when the application quits.
+ */
+class Trace
+{
+public:
+    static bool isEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    static bool start(const QString &fileName = QString());
+    static bool startFromEnvironment();
+    static bool stop();
+    static QString fileName();
+
+    static qint64 timestamp();
+    static void addSpan(const char *category, const char *name, qint64 begin, qint64 end, const QString &detail);
+    static void addAsyncSpan(const char *category, const char *name, qint64 begin, qint64 end, const QString &detail);
+
+    static QJsonObject toJson();
+
+private:
+    static std::atomic<bool> m_enabled;
+};
+
+/*!
+   \class shared::TraceScope
+   Records the time from its construction to its destruction as one span of the current thread.
+   Scopes nested in the same thread are shown nested in the trace
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name)
+        : m_category(category)
+        , m_name(name)
+        , m_begin(Trace::isEnabled() ? Trace::timestamp() : -1)
+    {
+    }
+    TraceScope(const char *category, const char *name, const QString &detail)
+        : TraceScope(category, name)
+    {
+        if (m_begin >= 0) {
+            m_detail = detail;
+        }
+    }
+    ~TraceScope()
+    {
+        if (m_begin >= 0) {
+            Trace::addSpan(m_category, m_name, m_begin, Trace::timestamp(), m_detail);
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+
+    const char *m_category;
+    const char *m_name;
+    qint64 m_begin;
+    QString m_detail;
+};
+
+}
+
+#define SC_TRACE_CONCAT_IMPL(a, b) a##b
+#define SC_TRACE_CONCAT(a, b) SC_TRACE_CONCAT_IMPL(a, b)
+
+/// Traces the rest of the current scope. Use as SC_TRACE_SCOPE("category", "name") or with a detail string as
+/// third argument, like a file name
+#define SC_TRACE_SCOPE(...) shared::TraceScope SC_TRACE_CONCAT(scTraceScope, __LINE__)(__VA_ARGS__)
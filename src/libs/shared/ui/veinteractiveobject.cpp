@@ -60,9 +60,26 @@ void VEInteractiveObject::onSelectionChanged(bool isSelected)
     }
 }
 
+/*!
+   Applies the current geometry to the entity and records it in the geometry change on top of the undo stack
+ */
 void VEInteractiveObject::mergeGeometry()
 {
-    QTimer::singleShot(0, this, [this]() {
+    mergeGeometry(true, 0);
+}
+
+/*!
+   Applies the current geometry to the entity. It's only recorded in the geometry change with the serial
+   \a commandSerial, if that one is still on top of the undo stack
+ */
+void VEInteractiveObject::mergeGeometryInto(quint64 commandSerial)
+{
+    mergeGeometry(false, commandSerial);
+}
+
+void VEInteractiveObject::mergeGeometry(bool intoTopCommand, quint64 commandSerial)
+{
+    QTimer::singleShot(0, this, [this, intoTopCommand, commandSerial]() {
         if (!m_commandsStack) {
             qWarning() << Q_FUNC_INFO << "No command stack set in shared::ui::VEInteractiveObject";
             return;
@@ -70,7 +87,7 @@ void VEInteractiveObject::mergeGeometry()
 
         for (auto child : childItems()) {
             if (auto io = qobject_cast<VEInteractiveObject *>(child->toGraphicsObject())) {
-                io->mergeGeometry();
+                io->mergeGeometry(intoTopCommand, commandSerial);
             }
         }
 
@@ -78,7 +95,8 @@ void VEInteractiveObject::mergeGeometry()
         autolayoutCmd->redo();
 
         const QUndoCommand *cmd = m_commandsStack->command(m_commandsStack->index() - 1);
-        if (auto prevGeometryBasedCmd = dynamic_cast<const cmd::CmdEntityGeometryChange *>(cmd))
+        auto prevGeometryBasedCmd = dynamic_cast<const cmd::CmdEntityGeometryChange *>(cmd);
+        if (prevGeometryBasedCmd && (intoTopCommand || prevGeometryBasedCmd->serial() == commandSerial))
             const_cast<cmd::CmdEntityGeometryChange *>(prevGeometryBasedCmd)->mergeCommand(autolayoutCmd);
         else
             delete autolayoutCmd;
@@ -111,6 +129,19 @@ void VEInteractiveObject::updateEntity()
     m_commandsStack->push(changeGeometryCmd);
 }
 
+/*!
+   Returns the serial of the geometry change on top of the undo stack, 0 if the last command changed no geometry
+ */
+quint64 VEInteractiveObject::topGeometryCommandSerial() const
+{
+    if (!m_commandsStack) {
+        return 0;
+    }
+    const QUndoCommand *cmd = m_commandsStack->command(m_commandsStack->index() - 1);
+    auto geometryCmd = dynamic_cast<const cmd::CmdEntityGeometryChange *>(cmd);
+    return geometryCmd ? geometryCmd->serial() : 0;
+}
+
 QList<QPair<shared::VEObject *, QVector<QPointF>>> VEInteractiveObject::prepareChangeCoordinatesCommandParams() const
 {
     QList<QPair<shared::VEObject *, QVector<QPointF>>> params;
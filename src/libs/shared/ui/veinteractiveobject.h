@@ -55,6 +55,7 @@ public:
     virtual void updateEntity();
     virtual void updateFromEntity() = 0;
     virtual QList<QPair<VEObject *, QVector<QPointF>>> prepareChangeCoordinatesCommandParams() const;
+    quint64 topGeometryCommandSerial() const;
 
     virtual QString prepareTooltip() const;
     virtual void enableEditMode() {};
@@ -76,10 +77,14 @@ protected:
     void onSelectionChanged(bool isSelected) override;
 
     void mergeGeometry();
+    void mergeGeometryInto(quint64 commandSerial);
 
     virtual ColorManager::HandledColors handledColorType() const = 0;
     virtual ColorHandler colorHandler() const;
 
+private:
+    void mergeGeometry(bool intoTopCommand, quint64 commandSerial);
+
 protected:
     const QPointer<VEObject> m_dataObject;
     QPointer<cmd::CommandsStackBase> m_commandsStack;
@@ -37,6 +37,7 @@ VEModel::~VEModel() { }
 bool VEModel::addObject(VEObject *obj)
 {
     if (addObjectImpl(obj)) {
+        initObjects({ obj });
         if (!obj->postInit()) {
             removeObject(obj);
         } else {
@@ -127,4 +128,13 @@ bool VEModel::addObjectImpl(VEObject *obj)
     return true;
 }
 
+/*!
+   Called with all \p objects that were just added by addObject() or addObjects(), before their postInit().
+   Subclasses can use it to initialize all new objects in one pass (e.g. setting default attributes).
+ */
+void VEModel::initObjects(const QVector<VEObject *> &objects)
+{
+    Q_UNUSED(objects)
+}
+
 } // namespace shared
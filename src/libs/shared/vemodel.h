@@ -54,11 +54,16 @@ public:
     void addObjects(const QVector<T> &objects, QStringList *warnings = nullptr)
     {
         QVector<T> addedObjects;
+        QVector<VEObject *> addedVEObjects;
+        addedObjects.reserve(objects.size());
+        addedVEObjects.reserve(objects.size());
         for (auto obj : objects) {
             if (addObjectImpl(obj)) {
                 addedObjects.append(obj);
+                addedVEObjects.append(obj);
             }
         }
+        initObjects(addedVEObjects);
 
         QVector<shared::Id> ids;
         auto it = addedObjects.begin();
@@ -93,6 +98,7 @@ Q_SIGNALS:
 
 protected:
     virtual bool addObjectImpl(VEObject *obj);
+    virtual void initObjects(const QVector<VEObject *> &objects);
 
 private:
     const std::unique_ptr<VEModelPrivate> d;
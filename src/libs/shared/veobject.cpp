@@ -32,7 +32,7 @@ struct VEObjectPrivate {
     }
 
     const shared::Id m_id;
-    EntityAttributes m_attrs;
+    AttributeStore m_attrs;
     VEModel *m_model;
 };
 
@@ -53,7 +53,19 @@ shared::Id VEObject::id() const
     return d->m_id;
 }
 
+/*!
+   Returns a copy of all attributes, keyed by the attribute name.
+   Prefer entityAttributeValue() or attributeStore() for single lookups, as this builds a new hash.
+ */
 EntityAttributes VEObject::entityAttributes() const
+{
+    return d->m_attrs.toHash();
+}
+
+/*!
+   Returns the compact storage of the attributes
+ */
+const AttributeStore &VEObject::attributeStore() const
 {
     return d->m_attrs;
 }
@@ -75,28 +87,40 @@ void VEObject::setEntityAttribute(const QString &name, const QVariant &value)
 
 EntityAttribute VEObject::entityAttribute(const QString &name) const
 {
-    return d->m_attrs.value(name);
+    return d->m_attrs.attribute(AttributeNameTable::find(name));
 }
 
 QVariant VEObject::entityAttributeValue(const QString &name, const QVariant &defaultValue) const
 {
-    const EntityAttribute attr = entityAttribute(name);
-    return attr.isNull() ? defaultValue : attr.value();
+    return entityAttributeValue(AttributeNameTable::find(name), defaultValue);
+}
+
+/*!
+   Returns the value of the attribute with the interned name \p id.
+   This is the fast path for attributes that are read often, as no string hashing is involved.
+ */
+QVariant VEObject::entityAttributeValue(AttributeId id, const QVariant &defaultValue) const
+{
+    const AttributeStore::Entry *entry = d->m_attrs.find(id);
+    return !entry || entry->value.isNull() ? defaultValue : entry->value;
 }
 
 void VEObject::removeEntityAttribute(const QString &attributeName)
 {
-    if (!attributeName.isEmpty() && d->m_attrs.remove(attributeName))
+    const AttributeId id = AttributeNameTable::find(attributeName);
+    if (d->m_attrs.remove(id)) {
+        attributeStoreChanged(id);
         Q_EMIT attributeChanged(attributeName);
+    }
 }
 
 bool VEObject::hasEntityAttribute(const QString &attributeName, const QVariant &value) const
 {
-    const auto it = d->m_attrs.constFind(attributeName);
-    if (it == d->m_attrs.cend()) {
+    const AttributeStore::Entry *entry = d->m_attrs.find(AttributeNameTable::find(attributeName));
+    if (!entry) {
         return false;
     }
-    return !value.isValid() || it->value() == value;
+    return !value.isValid() || entry->value == value;
 }
 
 /*!
@@ -104,11 +128,11 @@ bool VEObject::hasEntityAttribute(const QString &attributeName, const QVariant &
  */
 bool VEObject::hasEntityAttribute(const EntityAttribute &attribute) const
 {
-    const auto it = d->m_attrs.constFind(attribute.name());
-    if (it == d->m_attrs.cend()) {
+    const AttributeStore::Entry *entry = d->m_attrs.find(AttributeNameTable::find(attribute.name()));
+    if (!entry) {
         return false;
     }
-    return it.value().value() == attribute.value();
+    return entry->value == attribute.value();
 }
 
 /*!
@@ -131,12 +155,23 @@ bool VEObject::setParentObject(VEObject *parentObject)
 
 void VEObject::setAttributeImpl(const QString &name, const QVariant &value, EntityAttribute::Type type)
 {
-    d->m_attrs[name] = EntityAttribute { name, value, type };
+    const AttributeId id = AttributeNameTable::intern(name);
+    if (id == AttributeId::Invalid) {
+        return;
+    }
+    d->m_attrs.set(id, value, type);
+    attributeStoreChanged(id);
 }
 
 void VEObject::clearAttributes()
 {
     d->m_attrs.clear();
+    attributeStoreChanged(AttributeId::Invalid);
+}
+
+void VEObject::attributeStoreChanged(AttributeId id)
+{
+    Q_UNUSED(id)
 }
 
 QVector<qint32> VEObject::coordinatesFromString(const QString &strCoordinates)
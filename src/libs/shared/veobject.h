@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "attributestore.h"
 #include "common.h"
 #include "entityattribute.h"
 
@@ -54,16 +55,24 @@ public:
     // like "name" and "kind" below:
     // <Required_Interface name="run_forrest" kind="Sporadic">
     EntityAttributes entityAttributes() const;
+    const AttributeStore &attributeStore() const;
     EntityAttribute entityAttribute(const QString &name) const;
     /// TODO: template
     template<typename T>
     T entityAttributeValue(const QString &name, const T &defaultValue = T()) const
     {
-        const EntityAttribute attr = entityAttribute(name);
-        return attr.isNull() ? defaultValue : attr.value<T>();
+        return entityAttributeValue<T>(AttributeNameTable::find(name), defaultValue);
+    }
+
+    template<typename T>
+    T entityAttributeValue(AttributeId id, const T &defaultValue = T()) const
+    {
+        const AttributeStore::Entry *entry = attributeStore().find(id);
+        return !entry || entry->value.isNull() ? defaultValue : entry->value.value<T>();
     }
 
     QVariant entityAttributeValue(const QString &name, const QVariant &defaultValue = QVariant()) const;
+    QVariant entityAttributeValue(AttributeId id, const QVariant &defaultValue = QVariant()) const;
 
     void removeEntityAttribute(const QString &attributeName);
     bool hasEntityAttribute(const QString &attributeName, const QVariant &value = QVariant()) const;
@@ -100,6 +109,11 @@ protected:
     virtual void setAttributeImpl(const QString &name, const QVariant &value, EntityAttribute::Type type);
     void clearAttributes();
 
+    /// Called after the stored value of the attribute \p id was set or removed.
+    /// On clearAttributes() it is called with AttributeId::Invalid.
+    /// Subclasses use it to keep decoded values of hot attributes up to date.
+    virtual void attributeStoreChanged(AttributeId id);
+
 private:
     const std::unique_ptr<VEObjectPrivate> d;
 };
@@ -17,6 +17,8 @@
 
 #include "xmlreader.h"
 
+#include "trace.h"
+
 #include <QFile>
 #include <QXmlStreamAttribute>
 #include <QtDebug>
@@ -45,6 +47,7 @@ void XmlReader::setMetaData(const QXmlStreamAttributes &attributes)
 
 bool XmlReader::readFile(const QString &file)
 {
+    SC_TRACE_SCOPE("io", "XmlReader::readFile", file);
     QFile in(file);
     if (in.exists(file) && in.open(QFile::ReadOnly | QFile::Text))
         return read(&in);
@@ -19,9 +19,11 @@
 
 #include "interface/interfacedocument.h"
 #include "ivconnection.h"
+#include "ivcommonprops.h"
 #include "ivconnectionchain.h"
 #include "iveditorcore.h"
 #include "ivfunction.h"
+#include "ivinterface.h"
 #include "ivmodel.h"
 #include "mainmodel.h"
 #include "mscchart.h"
@@ -30,6 +32,7 @@
 #include "mscmessage.h"
 #include "mscmessagedeclaration.h"
 #include "mscmodel.h"
+#include "trace.h"
 
 #include <QDebug>
 #include <algorithm>
@@ -54,14 +57,126 @@ void IvSystemChecks::setIvCore(QSharedPointer<ive::IVEditorCore> ivCore)
         return;
     }
 
-    if (ivm::IVModel *model = ivModel()) {
-        disconnect(model, nullptr, this, nullptr);
+    m_ivCore = ivCore;
+    updateIvModelConnection();
+    Q_EMIT ivDataReset();
+}
+
+/*!
+   Sets the IV model to check against, without an IV editor core. Used for checks of loaded models only.
+   The model must not change while it is set, as the functions and connections are collected once here
+ */
+void IvSystemChecks::setIvModel(ivm::IVModel *model)
+{
+    if (model == m_ivModel) {
+        return;
     }
 
-    m_ivCore = ivCore;
+    m_ivModel = model;
+    m_ivFunctions.clear();
+    m_ivConnections.clear();
+    if (model) {
+        for (const shared::Id &id : model->objectsOrder()) {
+            ivm::IVObject *obj = model->getObject(id);
+            if (auto function = qobject_cast<ivm::IVFunction *>(obj)) {
+                m_ivFunctions.append(function);
+            } else if (auto connection = qobject_cast<ivm::IVConnection *>(obj)) {
+                m_ivConnections.append(connection);
+            }
+        }
+    }
+    updateIvModelConnection();
     Q_EMIT ivDataReset();
 }
 
+/*!
+   Follows the changes of the currently checked IV model, to report them by ivDataChanged()
+ */
+void IvSystemChecks::updateIvModelConnection()
+{
+    ivm::IVModel *model = ivModel();
+    if (model == m_connectedModel) {
+        return;
+    }
+
+    if (m_connectedModel) {
+        disconnect(m_connectedModel, nullptr, this, nullptr);
+        for (shared::VEObject *obj : m_connectedModel->objects()) {
+            disconnect(obj, nullptr, this, nullptr);
+        }
+    }
+    m_connectedModel = model;
+    if (!m_connectedModel) {
+        return;
+    }
+
+    connect(m_connectedModel, &ivm::IVModel::objectsAdded, this, &IvSystemChecks::onIvObjectsAdded);
+    /// Removed objects can't be looked up anymore, so any name might be affected
+    connect(m_connectedModel, &ivm::IVModel::objectRemoved, this, [this]() { Q_EMIT ivDataChanged({}); });
+    connect(m_connectedModel, &ivm::IVModel::modelReset, this, [this]() { Q_EMIT ivDataChanged({}); });
+    for (shared::VEObject *obj : m_connectedModel->objects()) {
+        connectIvObject(qobject_cast<ivm::IVObject *>(obj));
+    }
+}
+
+/*!
+   Reports renames of functions and interfaces and kind changes of interfaces. The previous name is unknown then, so
+   they are reported as affecting any name
+ */
+void IvSystemChecks::connectIvObject(ivm::IVObject *obj)
+{
+    if (!obj || !(obj->isFunction() || obj->isInterface())) {
+        return;
+    }
+
+    connect(obj, &ivm::IVObject::titleChanged, this, [this]() { Q_EMIT ivDataChanged({}); });
+    if (obj->isInterface()) {
+        static const QString kindToken = ivm::meta::Props::token(ivm::meta::Props::Token::kind);
+        connect(obj, &ivm::IVObject::attributeChanged, this, [this](const QString &name) {
+            if (name == kindToken) {
+                Q_EMIT ivDataChanged({});
+            }
+        });
+    }
+}
+
+void IvSystemChecks::onIvObjectsAdded(const QVector<shared::Id> &objectsIds)
+{
+    if (!m_connectedModel) {
+        return;
+    }
+
+    QStringList names;
+    for (const shared::Id &id : objectsIds) {
+        ivm::IVObject *obj = m_connectedModel->getObject(id);
+        if (!obj) {
+            continue;
+        }
+        connectIvObject(obj);
+        if (auto connection = qobject_cast<ivm::IVConnection *>(obj)) {
+            names << connection->name() << connection->sourceName() << connection->targetName();
+        } else {
+            names << obj->title();
+            if (obj->isInterface() && obj->parentObject()) {
+                names << obj->parentObject()->title();
+            }
+        }
+    }
+    names.removeAll(QString());
+    if (!names.isEmpty()) {
+        names.removeDuplicates();
+        Q_EMIT ivDataChanged(names);
+    }
+}
+
+/*!
+   Sets the MSC model to check, without an MSC editor core. Used for checks of loaded models only
+ */
+void IvSystemChecks::setMscModel(msc::MscModel *model)
+{
+    m_mscModel = model;
+}
+
 /*!
    Returns a pointer to the IV editor model
  */
@@ -75,12 +190,13 @@ const QSharedPointer<ive::IVEditorCore> &IvSystemChecks::ivCore() const
  */
 QVector<QPair<msc::MscChart *, msc::MscInstance *>> IvSystemChecks::checkInstanceNames() const
 {
+    SC_TRACE_SCOPE("checks", "IvSystemChecks::checkInstanceNames");
     QVector<QPair<msc::MscChart *, msc::MscInstance *>> result;
-    if (!m_ivCore || !m_mscCore) {
+    if (!hasValidSystem() || !hasMscData()) {
         return result;
     }
 
-    QVector<msc::MscChart *> charts = m_mscCore->mainModel()->mscModel()->allCharts();
+    QVector<msc::MscChart *> charts = mscCharts();
     for (msc::MscChart *chart : charts) {
         for (msc::MscInstance *instance : chart->instances()) {
             ivm::IVFunction *ivFunction = correspondingFunction(instance);
@@ -98,12 +214,13 @@ QVector<QPair<msc::MscChart *, msc::MscInstance *>> IvSystemChecks::checkInstanc
  */
 QVector<QPair<msc::MscChart *, msc::MscInstance *>> IvSystemChecks::checkInstanceRelations() const
 {
+    SC_TRACE_SCOPE("checks", "IvSystemChecks::checkInstanceRelations");
     QVector<QPair<msc::MscChart *, msc::MscInstance *>> result;
-    if (!m_ivCore || !m_mscCore) {
+    if (!hasValidSystem() || !hasMscData()) {
         return result;
     }
 
-    QVector<msc::MscChart *> charts = m_mscCore->mainModel()->mscModel()->allCharts();
+    QVector<msc::MscChart *> charts = mscCharts();
     for (msc::MscChart *chart : charts) {
         QVector<QPair<msc::MscInstance *, ivm::IVFunction *>> pairs;
         for (msc::MscInstance *instance : chart->instances()) {
@@ -132,10 +249,14 @@ QVector<QPair<msc::MscChart *, msc::MscInstance *>> IvSystemChecks::checkInstanc
  */
 bool IvSystemChecks::checkInstance(const msc::MscInstance *instance) const
 {
-    if (!m_ivCore) {
+    if (!hasValidSystem()) {
         return true;
     }
 
+    if (!m_ivModel) {
+        /// Same as searching the corresponding function, as the core compares the names with the same sensitivity
+        return instance && m_ivCore->hasFunctionName(instance->name());
+    }
     ivm::IVFunction *ivFunction = correspondingFunction(instance);
     return ivFunction != nullptr;
 }
@@ -145,11 +266,17 @@ bool IvSystemChecks::checkInstance(const msc::MscInstance *instance) const
  */
 QStringList IvSystemChecks::functionsNames() const
 {
-    if (!m_ivCore) {
-        return {};
+    if (!m_ivModel) {
+        return m_ivCore ? m_ivCore->ivFunctionsNames() : QStringList();
     }
 
-    return m_ivCore->ivFunctionsNames();
+    QStringList names;
+    for (const ivm::IVFunction *function : m_ivFunctions) {
+        if (!function->title().isEmpty()) {
+            names.append(function->title());
+        }
+    }
+    return names;
 }
 
 /*!
@@ -158,17 +285,26 @@ QStringList IvSystemChecks::functionsNames() const
  */
 QVector<QPair<msc::MscChart *, msc::MscMessage *>> IvSystemChecks::checkMessages() const
 {
+    SC_TRACE_SCOPE("checks", "IvSystemChecks::checkMessages");
     QVector<QPair<msc::MscChart *, msc::MscMessage *>> result;
-    if (!m_ivCore || !m_mscCore) {
+    if (!hasValidSystem() || !hasMscData()) {
         return result;
     }
 
-    QVector<msc::MscChart *> charts = m_mscCore->mainModel()->mscModel()->allCharts();
-    for (msc::MscChart *chart : qAsConst(charts)) {
+    QVector<QPair<msc::MscChart *, msc::MscMessage *>> messages;
+    QVector<const msc::MscMessage *> messageList;
+    const QVector<msc::MscChart *> charts = mscCharts();
+    for (msc::MscChart *chart : charts) {
         for (msc::MscMessage *message : chart->messages()) {
-            if (!checkMessage(message)) {
-                result << QPair<msc::MscChart *, msc::MscMessage *>(chart, message);
-            }
+            messages << QPair<msc::MscChart *, msc::MscMessage *>(chart, message);
+            messageList.append(message);
+        }
+    }
+
+    const QVector<bool> checks = checkMessageList(messageList);
+    for (int idx = 0; idx < messages.size(); ++idx) {
+        if (!checks.at(idx)) {
+            result << messages.at(idx);
         }
     }
 
@@ -181,15 +317,47 @@ QVector<QPair<msc::MscChart *, msc::MscMessage *>> IvSystemChecks::checkMessages
  */
 bool IvSystemChecks::checkMessage(const msc::MscMessage *message) const
 {
-    if (!m_ivCore || !message) {
+    return checkMessageList({ message }).first();
+}
+
+/*!
+   Checks all \p messages like \ref checkMessage, but builds the connection chains of the IV model only once
+ */
+QVector<bool> IvSystemChecks::checkMessageList(const QVector<const msc::MscMessage *> &messages) const
+{
+    SC_TRACE_SCOPE("checks", "IvSystemChecks::checkMessageList");
+    if (!hasValidSystem() || !ivModel()) {
+        return QVector<bool>(messages.size(), true);
+    }
+
+    const QList<ivm::IVConnectionChain *> chains = ivm::IVConnectionChain::build(*ivModel());
+    const ChainsByName chainsIndex = chainsByName(chains);
+
+    QVector<bool> results;
+    results.reserve(messages.size());
+    for (const msc::MscMessage *message : messages) {
+        results.append(checkMessage(message, chainsIndex));
+    }
+
+    qDeleteAll(chains);
+    return results;
+}
+
+/*!
+   Checks if the given MSC message has a corresponding iv connection in one of the \p chains
+ */
+bool IvSystemChecks::checkMessage(const msc::MscMessage *message, const ChainsByName &chains) const
+{
+    if (!message) {
         return true;
     }
 
     const QString sourceName = message->sourceInstance() ? message->sourceInstance()->name() : "";
     const QString targetName = message->targetInstance() ? message->targetInstance()->name() : "";
     if (!sourceName.isEmpty() && !targetName.isEmpty()) {
-        QList<ivm::IVConnectionChain *> chains = ivm::IVConnectionChain::build(*ivModel());
-        for (const ivm::IVConnectionChain *chain : qAsConst(chains)) {
+        /// A chain can only contain the message, if one of its connections has the name of the message
+        const QVector<const ivm::IVConnectionChain *> candidates = chains.value(message->name().trimmed().toLower());
+        for (const ivm::IVConnectionChain *chain : candidates) {
             if (chain->contains(message->name(), sourceName, targetName)) {
                 return true;
             }
@@ -225,17 +393,41 @@ bool IvSystemChecks::checkMessage(const msc::MscMessage *message) const
     return false;
 }
 
+/*!
+   Returns the \p chains by the names of their connections, the names are compared like IVConnectionChain::contains
+ */
+IvSystemChecks::ChainsByName IvSystemChecks::chainsByName(const QList<ivm::IVConnectionChain *> &chains)
+{
+    ChainsByName index;
+    for (const ivm::IVConnectionChain *chain : chains) {
+        for (const ivm::IVConnection *connection : chain->connections()) {
+            QVector<const ivm::IVConnectionChain *> &entry = index[connection->name().trimmed().toLower()];
+            if (!entry.contains(chain)) {
+                entry.append(chain);
+            }
+        }
+    }
+    return index;
+}
+
 /*!
    Returns a list of the names of all connections in the iv model
    \sa connectionNamesFromTo
  */
 QStringList IvSystemChecks::connectionNames() const
 {
-    if (!m_ivCore) {
-        return {};
+    if (!m_ivModel) {
+        return m_ivCore ? m_ivCore->ivConnectionNames() : QStringList();
     }
 
-    return m_ivCore->ivConnectionNames();
+    QStringList names;
+    for (const ivm::IVConnection *connection : m_ivConnections) {
+        if (!connection->name().isEmpty()) {
+            names.append(connection->name());
+        }
+    }
+    names.removeDuplicates();
+    return names;
 }
 
 /*!
@@ -245,7 +437,7 @@ QStringList IvSystemChecks::connectionNames() const
  */
 QStringList IvSystemChecks::connectionNamesFromTo(const QString &sourceName, const QString &targetName) const
 {
-    if (!m_ivCore) {
+    if (!hasValidSystem()) {
         return {};
     }
 
@@ -264,6 +456,9 @@ QStringList IvSystemChecks::connectionNamesFromTo(const QString &sourceName, con
  */
 ivm::IVModel *IvSystemChecks::ivModel() const
 {
+    if (m_ivModel) {
+        return m_ivModel;
+    }
     if (!m_ivCore) {
         return {};
     }
@@ -276,6 +471,47 @@ ivm::IVModel *IvSystemChecks::ivModel() const
     return m_ivCore->document()->objectsModel();
 }
 
+/*!
+   Returns all functions of the IV model, preferring the set model over the one of the in-core
+ */
+QVector<ivm::IVFunction *> IvSystemChecks::allFunctions() const
+{
+    if (m_ivModel) {
+        return m_ivFunctions;
+    }
+    return m_ivCore ? m_ivCore->allIVFunctions() : QVector<ivm::IVFunction *>();
+}
+
+/*!
+   Returns all connections of the IV model, preferring the set model over the one of the in-core
+ */
+QVector<ivm::IVConnection *> IvSystemChecks::allConnections() const
+{
+    if (m_ivModel) {
+        return m_ivConnections;
+    }
+    return m_ivCore ? m_ivCore->allIVConnections() : QVector<ivm::IVConnection *>();
+}
+
+/*!
+   Returns all charts of the MSC model, preferring the set model over the one of the msc-core
+ */
+QVector<msc::MscChart *> IvSystemChecks::mscCharts() const
+{
+    if (m_mscModel) {
+        return m_mscModel->allCharts();
+    }
+    return m_mscCore ? m_mscCore->mainModel()->mscModel()->allCharts() : QVector<msc::MscChart *>();
+}
+
+/*!
+   Returns if an MSC model or an MSC editor core is set
+ */
+bool IvSystemChecks::hasMscData() const
+{
+    return m_mscModel || m_mscCore;
+}
+
 /*!
    Returns the iv functions that corresponds to the given msc instance
  */
@@ -285,7 +521,7 @@ ivm::IVFunction *IvSystemChecks::correspondingFunction(const msc::MscInstance *i
         return nullptr;
     }
 
-    const QVector<ivm::IVFunction *> functions = m_ivCore->allIVFunctions();
+    const QVector<ivm::IVFunction *> functions = allFunctions();
     auto it = std::find_if(functions.cbegin(), functions.cend(),
             [this, &instance](ivm::IVFunction *func) { return correspond(func, instance); });
 
@@ -400,7 +636,7 @@ QVector<msc::MscMessageDeclaration *> IvSystemChecks::allConnectionsAsDeclaratio
 {
     QVector<msc::MscMessageDeclaration *> result;
 
-    for (ivm::IVConnection *connection : m_ivCore->allIVConnections()) {
+    for (ivm::IVConnection *connection : allConnections()) {
         auto declaration = new msc::MscMessageDeclaration();
         declaration->setNames({ connection->name() });
         QStringList params;
@@ -427,7 +663,7 @@ Qt::CaseSensitivity IvSystemChecks::stringSensitivity() const
  */
 bool IvSystemChecks::hasValidSystem() const
 {
-    return !m_ivCore.isNull();
+    return !m_ivCore.isNull() || !m_ivModel.isNull();
 }
 
 }
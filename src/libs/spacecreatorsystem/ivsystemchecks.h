@@ -17,8 +17,10 @@
 
 #pragma once
 
+#include "common.h"
 #include "systemchecks.h"
 
+#include <QHash>
 #include <QObject>
 #include <QPair>
 #include <QPointer>
@@ -30,6 +32,7 @@
 namespace ivm {
 class IVObject;
 class IVConnection;
+class IVConnectionChain;
 class IVFunction;
 class IVModel;
 }
@@ -63,6 +66,9 @@ public:
     void setIvCore(QSharedPointer<ive::IVEditorCore> ivCore);
     const QSharedPointer<ive::IVEditorCore> &ivCore() const;
 
+    void setIvModel(ivm::IVModel *model);
+    void setMscModel(msc::MscModel *model);
+
     QVector<QPair<msc::MscChart *, msc::MscInstance *>> checkInstanceNames() const override;
     QVector<QPair<msc::MscChart *, msc::MscInstance *>> checkInstanceRelations() const override;
     bool checkInstance(const msc::MscInstance *instance) const override;
@@ -70,6 +76,7 @@ public:
 
     QVector<QPair<msc::MscChart *, msc::MscMessage *>> checkMessages() const override;
     bool checkMessage(const msc::MscMessage *message) const override;
+    QVector<bool> checkMessageList(const QVector<const msc::MscMessage *> &messages) const override;
     QStringList connectionNames() const override;
     QStringList connectionNamesFromTo(const QString &sourceName, const QString &targetName) const override;
 
@@ -88,13 +95,33 @@ Q_SIGNALS:
     void mscCoreChanged();
 
 private:
+    /// Connection chains by the (lower case) names of the connections they contain
+    using ChainsByName = QHash<QString, QVector<const ivm::IVConnectionChain *>>;
+
+    bool checkMessage(const msc::MscMessage *message, const ChainsByName &chains) const;
+    static ChainsByName chainsByName(const QList<ivm::IVConnectionChain *> &chains);
+
+    void updateIvModelConnection();
+    void connectIvObject(ivm::IVObject *obj);
+    void onIvObjectsAdded(const QVector<shared::Id> &objectsIds);
+
     ivm::IVModel *ivModel() const;
+    QVector<ivm::IVFunction *> allFunctions() const;
+    QVector<ivm::IVConnection *> allConnections() const;
+    QVector<msc::MscChart *> mscCharts() const;
+    bool hasMscData() const;
     bool hasAncestor(ivm::IVFunction *func, const QVector<ivm::IVFunction *> allFunctions) const;
     bool hasDescendant(ivm::IVFunction *func, const QVector<ivm::IVFunction *> allFunctions) const;
     bool isAncestor(ivm::IVFunction *func, ivm::IVFunction *otherFunc) const;
 
     QPointer<msc::MSCEditorCore> m_mscCore;
     QSharedPointer<ive::IVEditorCore> m_ivCore;
+    QPointer<ivm::IVModel> m_ivModel;
+    /// The model whose changes are reported by ivDataChanged()
+    QPointer<ivm::IVModel> m_connectedModel;
+    QVector<ivm::IVFunction *> m_ivFunctions;
+    QVector<ivm::IVConnection *> m_ivConnections;
+    QPointer<msc::MscModel> m_mscModel;
     Qt::CaseSensitivity m_caseCheck = Qt::CaseInsensitive;
 };
 
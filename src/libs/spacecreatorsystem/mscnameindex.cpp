@@ -0,0 +1,298 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "mscnameindex.h"
+
+#include "mainmodel.h"
+#include "mscchart.h"
+#include "msceditorcore.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
+#include "mscmodel.h"
+#include "spacecreatorproject.h"
+
+namespace scs {
+
+MscNameIndex::MscNameIndex(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void MscNameIndex::setStorage(SpaceCreatorProject *storage)
+{
+    if (m_storage == storage) {
+        return;
+    }
+
+    if (m_storage) {
+        disconnect(m_storage, nullptr, this, nullptr);
+    }
+    const QList<msc::MSCEditorCore *> indexedCores = m_cores.keys();
+    for (msc::MSCEditorCore *core : indexedCores) {
+        removeCore(core);
+    }
+
+    m_storage = storage;
+    m_filesChanged = true;
+    if (m_storage) {
+        connect(m_storage, &SpaceCreatorProject::mscCoreAdded, this,
+                [this](QSharedPointer<msc::MSCEditorCore> core) { addCore(core.data()); });
+        connect(m_storage, &SpaceCreatorProject::mscCoreRemoved, this,
+                [this](QSharedPointer<msc::MSCEditorCore> core) { removeCore(core.data()); });
+        connect(m_storage, &SpaceCreatorProject::projectFilesChanged, this, [this]() { m_filesChanged = true; });
+    }
+}
+
+/*!
+   Returns the charts having at least one instance called \p name, case insensitive
+ */
+MscNameIndex::ChartsByCore MscNameIndex::instanceCharts(const QString &name)
+{
+    update();
+    return chartsByCore(m_instanceCharts.value(name.toLower()));
+}
+
+/*!
+   Returns the charts having at least one message called \p name, case insensitive
+ */
+MscNameIndex::ChartsByCore MscNameIndex::messageCharts(const QString &name)
+{
+    update();
+    return chartsByCore(m_messageCharts.value(name.toLower()));
+}
+
+/*!
+   Syncs the index with the MSC files of the project and indexes all charts changed since the last update
+ */
+void MscNameIndex::update()
+{
+    if (m_storage && m_filesChanged) {
+        syncCores();
+    }
+
+    for (auto it = m_cores.begin(); it != m_cores.end(); ++it) {
+        if (it->dirty || it->model != it.key()->mainModel()->mscModel()) {
+            updateCharts(it.key(), it.value());
+        }
+    }
+
+    for (msc::MscChart *chart : qAsConst(m_dirtyCharts)) {
+        auto it = m_charts.find(chart);
+        if (it != m_charts.end()) {
+            unindexChart(chart, it.value());
+            indexChart(chart, it.value());
+        }
+    }
+    m_dirtyCharts.clear();
+}
+
+/*!
+   Syncs the indexed cores with all MSC files of the project. Loading the cores of new files already adds them through
+   the mscCoreAdded signal of the storage, syncing catches the cores the storage dropped or never announced
+ */
+void MscNameIndex::syncCores()
+{
+    m_filesChanged = false;
+
+    QSet<msc::MSCEditorCore *> cores;
+    for (const QSharedPointer<msc::MSCEditorCore> &core : m_storage->allMscCores()) {
+        cores.insert(core.data());
+        addCore(core.data());
+    }
+    const QList<msc::MSCEditorCore *> indexedCores = m_cores.keys();
+    for (msc::MSCEditorCore *core : indexedCores) {
+        if (!cores.contains(core)) {
+            removeCore(core);
+        }
+    }
+}
+
+void MscNameIndex::addCore(msc::MSCEditorCore *core)
+{
+    if (!core || m_cores.contains(core)) {
+        return;
+    }
+
+    CoreEntry &entry = m_cores[core];
+    entry.mainModel = core->mainModel();
+
+    auto markDirty = [this, core]() {
+        auto it = m_cores.find(core);
+        if (it != m_cores.end()) {
+            it->dirty = true;
+        }
+    };
+    connect(core->mainModel(), &msc::MainModel::modelUpdated, this, markDirty);
+    connect(core, &QObject::destroyed, this, [this, core]() { removeCore(core); });
+}
+
+void MscNameIndex::removeCore(msc::MSCEditorCore *core)
+{
+    auto it = m_cores.find(core);
+    if (it == m_cores.end()) {
+        return;
+    }
+
+    /// Called from the destroyed signal as well, so the core must not be accessed beyond QObject
+    disconnect(core, nullptr, this, nullptr);
+    if (it->mainModel) {
+        disconnect(it->mainModel, nullptr, this, nullptr);
+    }
+    if (it->model) {
+        disconnect(it->model, nullptr, this, nullptr);
+    }
+    const QSet<msc::MscChart *> charts = it->charts;
+    for (msc::MscChart *chart : charts) {
+        removeChart(chart);
+    }
+    m_cores.remove(core);
+}
+
+/*!
+   Adds the charts new in the model of \p core and removes the ones no longer in the model.
+   The charts that are still there are not indexed again
+ */
+void MscNameIndex::updateCharts(msc::MSCEditorCore *core, CoreEntry &entry)
+{
+    msc::MscModel *model = core->mainModel()->mscModel();
+    if (entry.model != model) {
+        if (entry.model) {
+            disconnect(entry.model, nullptr, this, nullptr);
+        }
+        entry.model = model;
+        if (model) {
+            /// Any structural change of the documents of the model is propagated to this signal
+            connect(model, &msc::MscModel::dataChanged, this, [this, core]() {
+                auto it = m_cores.find(core);
+                if (it != m_cores.end()) {
+                    it->dirty = true;
+                }
+            });
+        }
+    }
+    entry.dirty = false;
+
+    QSet<msc::MscChart *> charts;
+    if (model) {
+        for (msc::MscChart *chart : model->allCharts()) {
+            charts.insert(chart);
+        }
+    }
+
+    const QSet<msc::MscChart *> removedCharts = entry.charts - charts;
+    for (msc::MscChart *chart : removedCharts) {
+        removeChart(chart);
+    }
+    const QSet<msc::MscChart *> addedCharts = charts - entry.charts;
+    for (msc::MscChart *chart : addedCharts) {
+        addChart(core, chart);
+    }
+}
+
+void MscNameIndex::addChart(msc::MSCEditorCore *core, msc::MscChart *chart)
+{
+    ChartEntry &entry = m_charts[chart];
+    entry.core = core;
+    m_cores[core].charts.insert(chart);
+
+    auto markDirty = [this, chart]() { m_dirtyCharts.insert(chart); };
+    connect(chart, &msc::MscChart::instanceAdded, this, markDirty);
+    connect(chart, &msc::MscChart::instanceRemoved, this, markDirty);
+    connect(chart, &msc::MscChart::instanceEventAdded, this, markDirty);
+    connect(chart, &msc::MscChart::instanceEventRemoved, this, markDirty);
+    connect(chart, &QObject::destroyed, this, [this, chart]() { removeChart(chart); });
+
+    indexChart(chart, entry);
+}
+
+void MscNameIndex::removeChart(msc::MscChart *chart)
+{
+    auto it = m_charts.find(chart);
+    if (it == m_charts.end()) {
+        return;
+    }
+
+    unindexChart(chart, it.value());
+    auto coreIt = m_cores.find(it->core);
+    if (coreIt != m_cores.end()) {
+        coreIt->charts.remove(chart);
+    }
+    m_charts.erase(it);
+    m_dirtyCharts.remove(chart);
+    disconnect(chart, nullptr, this, nullptr);
+}
+
+void MscNameIndex::indexChart(msc::MscChart *chart, ChartEntry &entry)
+{
+    auto markDirty = [this, chart]() { m_dirtyCharts.insert(chart); };
+
+    for (msc::MscInstance *instance : chart->instances()) {
+        const QString name = instance->name().toLower();
+        entry.instanceNames.append(name);
+        m_instanceCharts[name].insert(chart);
+        entry.entities.append(instance);
+        connect(instance, &msc::MscEntity::nameChanged, this, markDirty);
+    }
+
+    for (msc::MscMessage *message : chart->messages()) {
+        const QString name = message->name().toLower();
+        entry.messageNames.append(name);
+        m_messageCharts[name].insert(chart);
+        entry.entities.append(message);
+        connect(message, &msc::MscEntity::nameChanged, this, markDirty);
+    }
+}
+
+void MscNameIndex::unindexChart(msc::MscChart *chart, ChartEntry &entry)
+{
+    auto unindexName = [chart](QHash<QString, QSet<msc::MscChart *>> &index, const QString &name) {
+        auto it = index.find(name);
+        if (it != index.end()) {
+            it->remove(chart);
+            if (it->isEmpty()) {
+                index.erase(it);
+            }
+        }
+    };
+
+    for (const QString &name : qAsConst(entry.instanceNames)) {
+        unindexName(m_instanceCharts, name);
+    }
+    for (const QString &name : qAsConst(entry.messageNames)) {
+        unindexName(m_messageCharts, name);
+    }
+    for (const QPointer<QObject> &entity : qAsConst(entry.entities)) {
+        if (entity) {
+            disconnect(entity, nullptr, this, nullptr);
+        }
+    }
+
+    entry.instanceNames.clear();
+    entry.messageNames.clear();
+    entry.entities.clear();
+}
+
+MscNameIndex::ChartsByCore MscNameIndex::chartsByCore(const QSet<msc::MscChart *> &charts) const
+{
+    ChartsByCore result;
+    for (msc::MscChart *chart : charts) {
+        result[m_charts.value(chart).core].append(chart);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+namespace msc {
+class MainModel;
+class MSCEditorCore;
+class MscChart;
+class MscModel;
+}
+
+namespace scs {
+class SpaceCreatorProject;
+
+/*!
+   \class scs::MscNameIndex
+   Index of the instance and message names of all MSC files of a project.
+
+   The names are mapped to the charts using them, case insensitive. The index is kept up to date from the change
+   signals of the MSC models: a changed chart is only marked dirty and indexed again at the next lookup, so a lookup
+   costs the number of changed charts instead of all charts of the project.
+   The MSC files are followed by the core added/removed signals of the storage. The storage is only asked for all its
+   cores again after the files of the project changed, to load the cores of new files.
+ */
+class MscNameIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    using ChartsByCore = QHash<msc::MSCEditorCore *, QVector<msc::MscChart *>>;
+
+    explicit MscNameIndex(QObject *parent = nullptr);
+
+    void setStorage(scs::SpaceCreatorProject *storage);
+
+    ChartsByCore instanceCharts(const QString &name);
+    ChartsByCore messageCharts(const QString &name);
+
+private:
+    struct CoreEntry {
+        QPointer<msc::MainModel> mainModel;
+        QPointer<msc::MscModel> model;
+        QSet<msc::MscChart *> charts;
+        bool dirty = true;
+    };
+    struct ChartEntry {
+        msc::MSCEditorCore *core = nullptr;
+        QStringList instanceNames;
+        QStringList messageNames;
+        QVector<QPointer<QObject>> entities;
+    };
+
+    void update();
+    void syncCores();
+    void addCore(msc::MSCEditorCore *core);
+    void removeCore(msc::MSCEditorCore *core);
+    void updateCharts(msc::MSCEditorCore *core, CoreEntry &entry);
+    void addChart(msc::MSCEditorCore *core, msc::MscChart *chart);
+    void removeChart(msc::MscChart *chart);
+    void indexChart(msc::MscChart *chart, ChartEntry &entry);
+    void unindexChart(msc::MscChart *chart, ChartEntry &entry);
+    ChartsByCore chartsByCore(const QSet<msc::MscChart *> &charts) const;
+
+    QPointer<SpaceCreatorProject> m_storage;
+    bool m_filesChanged = true;
+    QHash<msc::MSCEditorCore *, CoreEntry> m_cores;
+    QHash<msc::MscChart *, ChartEntry> m_charts;
+    QSet<msc::MscChart *> m_dirtyCharts;
+    QHash<QString, QSet<msc::MscChart *>> m_instanceCharts;
+    QHash<QString, QSet<msc::MscChart *>> m_messageCharts;
+};
+
+}
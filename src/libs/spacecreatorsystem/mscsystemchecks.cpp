@@ -35,6 +35,7 @@
 #include "mscinstance.h"
 #include "mscmessage.h"
 #include "mscmodel.h"
+#include "mscnameindex.h"
 #include "spacecreatorproject.h"
 #include "undocommand.h"
 
@@ -47,12 +48,14 @@ namespace scs {
 
 MscSystemChecks::MscSystemChecks(QObject *parent)
     : QObject(parent)
+    , m_nameIndex(new MscNameIndex(this))
 {
 }
 
 void MscSystemChecks::setStorage(SpaceCreatorProject *storage)
 {
     m_storage = storage;
+    m_nameIndex->setStorage(storage);
 
     connect(m_storage, &scs::SpaceCreatorProject::mscCoreAdded, this, [=](QSharedPointer<msc::MSCEditorCore> core) {
         connect(core.data(), &msc::MSCEditorCore::nameChanged, this, &scs::MscSystemChecks::onMscEntityNameChanged);
@@ -71,8 +74,9 @@ void MscSystemChecks::setStorage(SpaceCreatorProject *storage)
  */
 bool MscSystemChecks::mscInstancesExist(const QString &name)
 {
-    for (QSharedPointer<msc::MSCEditorCore> &mscCore : m_storage->allMscCores()) {
-        for (msc::MscChart *chart : mscCore->mainModel()->mscModel()->allCharts()) {
+    const MscNameIndex::ChartsByCore charts = m_nameIndex->instanceCharts(name);
+    for (const QVector<msc::MscChart *> &coreCharts : charts) {
+        for (msc::MscChart *chart : coreCharts) {
             for (msc::MscInstance *instance : chart->instances()) {
                 if (instance->name() == name) {
                     return true;
@@ -88,8 +92,9 @@ bool MscSystemChecks::mscInstancesExist(const QString &name)
  */
 void MscSystemChecks::changeMscInstanceName(const QString &oldName, const QString &name)
 {
-    for (QSharedPointer<msc::MSCEditorCore> &mscCore : m_storage->allMscCores()) {
-        mscCore->changeMscInstanceName(oldName, name);
+    const MscNameIndex::ChartsByCore charts = m_nameIndex->instanceCharts(oldName);
+    for (auto it = charts.cbegin(); it != charts.cend(); ++it) {
+        it.key()->changeMscInstanceName(oldName, name, it.value());
     }
 }
 
@@ -108,8 +113,9 @@ void MscSystemChecks::removeMscInstances(ivm::IVFunction *ivFunction)
  */
 bool MscSystemChecks::hasCorrespondingInstances(ivm::IVFunction *ivFunction) const
 {
-    for (QSharedPointer<msc::MSCEditorCore> &mscCore : m_storage->allMscCores()) {
-        if (!mscCore->correspondingInstances(ivFunction).isEmpty()) {
+    const MscNameIndex::ChartsByCore charts = m_nameIndex->instanceCharts(ivFunction->title());
+    for (auto it = charts.cbegin(); it != charts.cend(); ++it) {
+        if (!it.key()->correspondingInstances(ivFunction, it.value()).isEmpty()) {
             return true;
         }
     }
@@ -121,8 +127,9 @@ bool MscSystemChecks::hasCorrespondingInstances(ivm::IVFunction *ivFunction) con
  */
 bool MscSystemChecks::mscMessagesExist(const QString &messageName, const QString &sourceName, const QString &targetName)
 {
-    for (QSharedPointer<msc::MSCEditorCore> &mscCore : m_storage->allMscCores()) {
-        for (msc::MscChart *chart : mscCore->mainModel()->mscModel()->allCharts()) {
+    const MscNameIndex::ChartsByCore charts = m_nameIndex->messageCharts(messageName);
+    for (const QVector<msc::MscChart *> &coreCharts : charts) {
+        for (msc::MscChart *chart : coreCharts) {
             for (msc::MscMessage *message : chart->messages()) {
                 if (message->name() == messageName) {
                     const QString messageSource = message->sourceInstance() ? message->sourceInstance()->name() : "";
@@ -144,8 +151,9 @@ bool MscSystemChecks::mscMessagesExist(const QString &messageName, const QString
 void MscSystemChecks::changeMscMessageName(
         const QString &oldName, const QString &newName, const QString &sourceName, const QString &targetName)
 {
-    for (QSharedPointer<msc::MSCEditorCore> &mscCore : m_storage->allMscCores()) {
-        mscCore->changeMscMessageName(oldName, newName, sourceName, targetName);
+    const MscNameIndex::ChartsByCore charts = m_nameIndex->messageCharts(oldName);
+    for (auto it = charts.cbegin(); it != charts.cend(); ++it) {
+        it.key()->changeMscMessageName(oldName, newName, sourceName, targetName, it.value());
     }
 }
 
@@ -164,6 +172,17 @@ void MscSystemChecks::removeMscMessages(ivm::IVConnection *ivConnection)
  */
 bool MscSystemChecks::hasCorrespondingMessages(ivm::IVConnection *ivConnection) const
 {
+    if (!ivConnection->name().isEmpty()) {
+        const MscNameIndex::ChartsByCore charts = m_nameIndex->messageCharts(ivConnection->name());
+        for (auto it = charts.cbegin(); it != charts.cend(); ++it) {
+            if (!it.key()->correspondingMessages(ivConnection, it.value()).isEmpty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Connections without a name correspond to messages of any name
     for (QSharedPointer<msc::MSCEditorCore> &mscCore : m_storage->allMscCores()) {
         if (!mscCore->correspondingMessages(ivConnection).isEmpty()) {
             return true;
@@ -333,8 +352,8 @@ void MscSystemChecks::onMscEntityNameChanged(QObject *entity, const QString &old
 
     auto instance = dynamic_cast<msc::MscInstance *>(entity);
     if (instance) {
-        const bool hasOldName = ivCore->ivFunctionsNames().contains(oldName, m_caseCheck);
-        const bool hasNewName = ivCore->ivFunctionsNames().contains(instance->name(), m_caseCheck);
+        const bool hasOldName = ivCore->hasFunctionName(oldName);
+        const bool hasNewName = ivCore->hasFunctionName(instance->name());
 
         if (!hasOldName && !hasNewName) {
             const int result = QMessageBox::question(nullptr, tr("No IV function"),
@@ -40,6 +40,7 @@ class UndoCommand;
 }
 
 namespace scs {
+class MscNameIndex;
 class SpaceCreatorProject;
 
 /*!
@@ -77,6 +78,7 @@ public Q_SLOTS:
 
 private:
     QPointer<SpaceCreatorProject> m_storage;
+    MscNameIndex *m_nameIndex = nullptr;
     Qt::CaseSensitivity m_caseCheck = Qt::CaseInsensitive;
     bool m_nameUpdateRunning = false;
 };
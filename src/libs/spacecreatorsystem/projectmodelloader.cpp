@@ -0,0 +1,259 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "projectmodelloader.h"
+
+#include "baseitems/common/ivutils.h"
+#include "dvmodel.h"
+#include "dvxmlreader.h"
+#include "exceptions.h"
+#include "ivmodel.h"
+#include "ivxmlreader.h"
+#include "mscmodel.h"
+#include "mscreader.h"
+#include "propertytemplateconfig.h"
+
+#include <QDirIterator>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+namespace scs {
+
+ProjectModelLoader::ProjectModelLoader(QObject *parent)
+    : QObject(parent)
+    , m_pool(QThreadPool::globalInstance())
+    , m_dynPropConfig(ivm::PropertyTemplateConfig::instance())
+{
+}
+
+ProjectModelLoader::~ProjectModelLoader() { }
+
+/*!
+   Sets the pool the files are loaded on. Default is the global thread pool
+ */
+void ProjectModelLoader::setThreadPool(QThreadPool *pool)
+{
+    m_pool = pool ? pool : QThreadPool::globalInstance();
+}
+
+/*!
+   Loads all \p fileNames in parallel and blocks until all are loaded. Models of files loaded before are replaced.
+   Returns false if at least one file could not be loaded, the reasons are available in \ref errorMessages
+ */
+bool ProjectModelLoader::load(const QStringList &fileNames)
+{
+    QVector<QFuture<LoadedFile>> futures;
+    for (const QString &fileName : fileNames) {
+        if (fileType(fileName) == FileType::Unknown) {
+            m_errorMessages.append(tr("Unknown file type of %1").arg(fileName));
+            continue;
+        }
+        futures.append(
+                QtConcurrent::run(m_pool, &ProjectModelLoader::loadFile, fileName, m_dynPropConfig, thread()));
+    }
+
+    bool ok = futures.size() == fileNames.size();
+    for (QFuture<LoadedFile> &future : futures) {
+        const LoadedFile loaded = future.result();
+        m_errorMessages += loaded.errorMessages;
+        if (!loaded.model) {
+            ok = false;
+            continue;
+        }
+
+        loaded.model->setParent(this);
+        switch (loaded.type) {
+        case FileType::IV:
+            delete m_ivModels.value(loaded.fileName);
+            m_ivModels.insert(loaded.fileName, static_cast<ivm::IVModel *>(loaded.model));
+            break;
+        case FileType::DV:
+            delete m_dvModels.value(loaded.fileName);
+            m_dvModels.insert(loaded.fileName, static_cast<dvm::DVModel *>(loaded.model));
+            break;
+        case FileType::MSC:
+            delete m_mscModels.value(loaded.fileName);
+            m_mscModels.insert(loaded.fileName, static_cast<msc::MscModel *>(loaded.model));
+            break;
+        case FileType::Unknown:
+            break;
+        }
+    }
+    return ok;
+}
+
+/*!
+   Loads all IV, DV and MSC files in \p directory and its sub directories
+ */
+bool ProjectModelLoader::loadDirectory(const QString &directory)
+{
+    return load(projectFiles(directory));
+}
+
+/*!
+   Deletes all loaded models and clears the error messages
+ */
+void ProjectModelLoader::clear()
+{
+    qDeleteAll(m_ivModels);
+    m_ivModels.clear();
+    qDeleteAll(m_dvModels);
+    m_dvModels.clear();
+    qDeleteAll(m_mscModels);
+    m_mscModels.clear();
+    m_errorMessages.clear();
+}
+
+/*!
+   Returns all IV, DV and MSC files in \p directory and its sub directories, sorted by name
+ */
+QStringList ProjectModelLoader::projectFiles(const QString &directory)
+{
+    QStringList files;
+    QDirIterator it(directory, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString fileName = it.next();
+        if (fileType(fileName) != FileType::Unknown) {
+            files.append(fileName);
+        }
+    }
+    files.sort();
+    return files;
+}
+
+ivm::IVModel *ProjectModelLoader::ivModel(const QString &fileName) const
+{
+    return m_ivModels.value(fileName, nullptr);
+}
+
+dvm::DVModel *ProjectModelLoader::dvModel(const QString &fileName) const
+{
+    return m_dvModels.value(fileName, nullptr);
+}
+
+msc::MscModel *ProjectModelLoader::mscModel(const QString &fileName) const
+{
+    return m_mscModels.value(fileName, nullptr);
+}
+
+QStringList ProjectModelLoader::ivFiles() const
+{
+    QStringList files = m_ivModels.keys();
+    files.sort();
+    return files;
+}
+
+QStringList ProjectModelLoader::dvFiles() const
+{
+    QStringList files = m_dvModels.keys();
+    files.sort();
+    return files;
+}
+
+QStringList ProjectModelLoader::mscFiles() const
+{
+    QStringList files = m_mscModels.keys();
+    files.sort();
+    return files;
+}
+
+/*!
+   Returns the models of all loaded MSC files, in the order of their file names
+ */
+QVector<msc::MscModel *> ProjectModelLoader::allMscModels() const
+{
+    QVector<msc::MscModel *> models;
+    for (const QString &fileName : mscFiles()) {
+        models.append(m_mscModels.value(fileName));
+    }
+    return models;
+}
+
+QStringList ProjectModelLoader::errorMessages() const
+{
+    return m_errorMessages;
+}
+
+ProjectModelLoader::FileType ProjectModelLoader::fileType(const QString &fileName)
+{
+    if (fileName.endsWith(ive::kDefaultInterfaceViewFileName)) {
+        return FileType::IV;
+    }
+    if (fileName.endsWith(".dv.xml")) {
+        return FileType::DV;
+    }
+    if (fileName.endsWith(".msc")) {
+        return FileType::MSC;
+    }
+    return FileType::Unknown;
+}
+
+/*!
+   Loads \p fileName into a new model. Runs in a thread of the pool, the model is moved to \p targetThread when done
+ */
+ProjectModelLoader::LoadedFile ProjectModelLoader::loadFile(
+        const QString &fileName, ivm::PropertyTemplateConfig *dynPropConfig, QThread *targetThread)
+{
+    LoadedFile loaded;
+    loaded.fileName = fileName;
+    loaded.type = fileType(fileName);
+
+    switch (loaded.type) {
+    case FileType::IV: {
+        ivm::IVXMLReader parser;
+        if (!parser.readFile(fileName)) {
+            loaded.errorMessages.append(QString("%1: %2").arg(fileName, parser.errorString()));
+            break;
+        }
+        auto model = new ivm::IVModel(dynPropConfig);
+        model->initFromObjects(parser.parsedObjects(), &loaded.errorMessages);
+        loaded.model = model;
+        break;
+    }
+    case FileType::DV: {
+        dvm::DVXMLReader parser;
+        if (!parser.readFile(fileName)) {
+            loaded.errorMessages.append(QString("%1: %2").arg(fileName, parser.errorString()));
+            break;
+        }
+        auto model = new dvm::DVModel;
+        model->initFromObjects(parser.parsedObjects());
+        loaded.model = model;
+        break;
+    }
+    case FileType::MSC: {
+        msc::MscReader reader;
+        try {
+            loaded.model = reader.parseFile(fileName, &loaded.errorMessages);
+        } catch (const msc::ParserException &e) {
+            loaded.errorMessages.append(QString("%1: %2").arg(fileName, e.errorMessage()));
+        } catch (...) {
+            loaded.errorMessages.append(QString("%1: unable to parse the file").arg(fileName));
+        }
+        break;
+    }
+    case FileType::Unknown:
+        break;
+    }
+
+    if (loaded.model) {
+        loaded.model->moveToThread(targetThread);
+    }
+    return loaded;
+}
+
+}
@@ -0,0 +1,109 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+class QThread;
+class QThreadPool;
+
+namespace dvm {
+class DVModel;
+}
+namespace ivm {
+class IVModel;
+class PropertyTemplateConfig;
+}
+namespace msc {
+class MscModel;
+}
+
+namespace scs {
+
+/*!
+   \class scs::ProjectModelLoader
+   Loads the IV, DV and MSC files of a project into plain models, without creating any editor or GUI objects.
+
+   The files are read in parallel on a thread pool. The models are created in the worker threads and moved to the
+   thread of the loader afterwards, so they can be used like models loaded by the editors. The loader owns all models.
+
+   The loader only reads the global ivm::PropertyTemplateConfig. The application has to initialize it once, before any
+   loader is created:
+   \code
+   ivm::PropertyTemplateConfig::instance()->init(ive::dynamicPropertiesFilePath());
+   \endcode
+ */
+class ProjectModelLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ProjectModelLoader(QObject *parent = nullptr);
+    ~ProjectModelLoader() override;
+
+    void setThreadPool(QThreadPool *pool);
+
+    bool load(const QStringList &fileNames);
+    bool loadDirectory(const QString &directory);
+    void clear();
+
+    static QStringList projectFiles(const QString &directory);
+
+    ivm::IVModel *ivModel(const QString &fileName) const;
+    dvm::DVModel *dvModel(const QString &fileName) const;
+    msc::MscModel *mscModel(const QString &fileName) const;
+
+    QStringList ivFiles() const;
+    QStringList dvFiles() const;
+    QStringList mscFiles() const;
+    QVector<msc::MscModel *> allMscModels() const;
+
+    QStringList errorMessages() const;
+
+private:
+    enum class FileType
+    {
+        Unknown,
+        IV,
+        DV,
+        MSC
+    };
+
+    struct LoadedFile {
+        QString fileName;
+        FileType type = FileType::Unknown;
+        QObject *model = nullptr;
+        QStringList errorMessages;
+    };
+
+    static FileType fileType(const QString &fileName);
+    static LoadedFile loadFile(
+            const QString &fileName, ivm::PropertyTemplateConfig *dynPropConfig, QThread *targetThread);
+
+    QThreadPool *m_pool = nullptr;
+    ivm::PropertyTemplateConfig *m_dynPropConfig = nullptr;
+    QHash<QString, ivm::IVModel *> m_ivModels;
+    QHash<QString, dvm::DVModel *> m_dvModels;
+    QHash<QString, msc::MscModel *> m_mscModels;
+    QStringList m_errorMessages;
+};
+
+}
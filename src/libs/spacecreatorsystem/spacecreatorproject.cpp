@@ -239,7 +239,8 @@ QVector<IvSystemChecks *> SpaceCreatorProject::ivChecks() const
 }
 
 /*!
-   Removes all data that is stored here, but is not part of the project
+   Removes all data that is stored here, but is not part of the project.
+   To be called whenever the files of the project changed, so \ref projectFilesChanged is emitted afterwards
  */
 void SpaceCreatorProject::purgeNonProjectData()
 {
@@ -254,14 +255,21 @@ void SpaceCreatorProject::purgeNonProjectData()
     }
 
     const QStringList mscFiles = allMscFiles();
+    QVector<QSharedPointer<msc::MSCEditorCore>> removedMscCores;
     auto mscIt = m_mscStore.begin();
     while (mscIt != m_mscStore.end()) {
         if (!mscFiles.contains(mscIt.key())) {
+            removedMscCores.append(mscIt.value());
             mscIt = m_mscStore.erase(mscIt);
         } else {
             ++mscIt;
         }
     }
+    for (const QSharedPointer<msc::MSCEditorCore> &mscCore : qAsConst(removedMscCores)) {
+        Q_EMIT mscCoreRemoved(mscCore);
+    }
+
+    Q_EMIT projectFilesChanged();
 }
 
 /*!
@@ -319,6 +327,11 @@ void SpaceCreatorProject::setMscData(const QString &fileName, QSharedPointer<msc
         disconnect(oldData.data(), nullptr, this, nullptr);
     }
 
+    const QSharedPointer<msc::MSCEditorCore> replacedData = m_mscStore.value(fileName);
+    if (replacedData) {
+        disconnect(replacedData.data(), nullptr, this, nullptr);
+        Q_EMIT mscCoreRemoved(replacedData);
+    }
     m_mscStore[fileName] = mscData;
     connect(mscData.data(), &shared::EditorCore::editedExternally, this, &scs::SpaceCreatorProject::editedExternally);
     auto checker = new scs::IvSystemChecks(mscData.data());
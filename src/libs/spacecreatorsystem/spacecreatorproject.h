@@ -86,6 +86,8 @@ Q_SIGNALS:
     void dvCoreAdded(QSharedPointer<dve::DVEditorCore> dvCore);
     void ivCoreAdded(QSharedPointer<ive::IVEditorCore> ivCore);
     void mscCoreAdded(QSharedPointer<msc::MSCEditorCore> mscCore);
+    void mscCoreRemoved(QSharedPointer<msc::MSCEditorCore> mscCore);
+    void projectFilesChanged();
 
 protected Q_SLOTS:
     void purgeNonProjectData();
@@ -72,20 +72,19 @@ protected:
     template<typename T>
     QHash<QString, QVariant> collectObjects(const QList<T *> &objects)
     {
-        QHash<QString, QVariant> grouppedObjects;
-
+        // The lists are filled first and wrapped in variants at the end. Appending to a list stored in a
+        // QVariant copies the whole list each time
+        QHash<QString, QVariantList> groups;
         for (const auto &object : objects) {
             if (object->parentObject() != nullptr)
                 continue;
 
-            const QVariant &exportedObject = createFrom(object);
-            const QString objectGroupName = groupName(object);
-            if (!grouppedObjects.contains(objectGroupName)) {
-                grouppedObjects[objectGroupName] = QVariant::fromValue(QList<QVariant>());
-            }
-            QVariantList objects = grouppedObjects[objectGroupName].toList();
-            objects << exportedObject;
-            grouppedObjects[objectGroupName] = objects;
+            groups[groupName(object)].append(createFrom(object));
+        }
+
+        QHash<QString, QVariant> grouppedObjects;
+        for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
+            grouppedObjects.insert(it.key(), QVariant::fromValue(it.value()));
         }
         return grouppedObjects;
     }
@@ -17,6 +17,8 @@
 
 #include "stringtemplate.h"
 
+#include "trace.h"
+
 #include <QApplication>
 #include <QDebug>
 #include <QFileInfo>
@@ -103,6 +105,7 @@ void StringTemplate::init()
 bool StringTemplate::parseFile(
         const QHash<QString, QVariant> &grouppedObjects, const QString &templateFileName, QIODevice *out)
 {
+    SC_TRACE_SCOPE("export", "StringTemplate::parseFile", templateFileName);
     if (!out || templateFileName.isEmpty()) {
         return false;
     }
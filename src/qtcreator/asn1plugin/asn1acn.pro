@@ -48,6 +48,7 @@ include($$IDE_SOURCE_TREE/src/qtcreatorplugin.pri)
 ### Plugin ###
 
 CONFIG += object_parallel_to_source
+QT += concurrent
 
 DEFINES += ASN1ACN_LIBRARY
 INCLUDEPATH += $$PWD/src
@@ -169,6 +170,7 @@ SOURCES += \
     editor.cpp \
     asn1sccdocumentprocessor.cpp \
     parseddatastorage.cpp \
+    parsedfileindex.cpp \
     astxmlparser.cpp \
     projectwatcher.cpp \
     document.cpp \
@@ -328,6 +330,7 @@ HEADERS += \
     editor.h \
     asn1sccdocumentprocessor.h \
     parseddatastorage.h \
+    parsedfileindex.h \
     astxmlparser.h \
     projectwatcher.h \
     document.h \
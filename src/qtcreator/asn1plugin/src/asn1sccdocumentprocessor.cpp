@@ -61,6 +61,17 @@ void Asn1SccDocumentProcessor::run()
 {
     m_docBuilder.reset(m_docBuilderCreator(m_documents));
 
+    ParsedDataStorage *storage = m_storage;
+    const QString projectName = m_projectName;
+    const int index = m_index;
+    m_docBuilder->setOutdatedCheck([storage, projectName, index]() {
+        return index < storage->getProjectBuildersCount(projectName);
+    });
+
+    connect(m_docBuilder.get(),
+            &ParsedDocumentBuilder::documentsAvailable,
+            this,
+            &Asn1SccDocumentProcessor::onBuilderDocumentsAvailable);
     connect(m_docBuilder.get(),
             &ParsedDocumentBuilder::finished,
             this,
@@ -84,7 +95,23 @@ Asn1SccDocumentProcessor::State Asn1SccDocumentProcessor::state()
 
 std::vector<std::unique_ptr<Asn1Acn::File>> Asn1SccDocumentProcessor::takeResults()
 {
-    return std::move(m_results);
+    std::vector<std::unique_ptr<Asn1Acn::File>> results;
+    results.swap(m_results);
+    return results;
+}
+
+/*!
+   Passes on the documents parsed so far, while the builder still works on the other ones
+ */
+void Asn1SccDocumentProcessor::onBuilderDocumentsAvailable()
+{
+    if (m_index < m_storage->getProjectBuildersCount(m_projectName))
+        return;
+
+    for (auto &document : m_docBuilder->takeDocuments())
+        m_results.push_back(std::move(document));
+
+    Q_EMIT documentsAvailable(m_projectName);
 }
 
 void Asn1SccDocumentProcessor::onBuilderFinished()
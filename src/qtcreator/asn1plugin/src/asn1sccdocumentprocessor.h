@@ -62,6 +62,7 @@ public:
     State state() override;
 
 private Q_SLOTS:
+    void onBuilderDocumentsAvailable();
     void onBuilderFinished();
     void onBuilderFailed();
     void onBuilderErrored();
@@ -29,6 +29,12 @@
 #include "asn1reader.h"
 #include "errormessageparser.h"
 
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <algorithm>
+
 namespace Asn1Acn {
 namespace Internal {
 
@@ -40,98 +46,174 @@ ParsedDocumentBuilder *Asn1SccParsedDocumentBuilder::create(const QHash<QString,
     return new Asn1SccParsedDocumentBuilder(documents);
 }
 
-Asn1SccParsedDocumentBuilder::Asn1SccParsedDocumentBuilder(const QHash<QString, QString> &documents)
+Asn1SccParsedDocumentBuilder::Asn1SccParsedDocumentBuilder(const QHash<QString, QString> &documents,
+                                                           ParseFunction parse,
+                                                           QThreadPool *pool)
     : m_documentSources(documents)
-{}
-
-Asn1SccParsedDocumentBuilder::~Asn1SccParsedDocumentBuilder()
+    , m_parse(std::move(parse))
+    , m_pool(pool)
+    , m_cancelled(QSharedPointer<QAtomicInt>::create(0))
 {
-    m_workerThread.quit();
-    m_workerThread.wait();
+    m_publishTimer.setSingleShot(true);
+    m_publishTimer.setInterval(publishInterval);
+    connect(&m_publishTimer, &QTimer::timeout, this, &Asn1SccParsedDocumentBuilder::publish);
 }
 
-void Asn1SccParsedDocumentBuilder::run()
+/*!
+   Skips the tasks not started yet and waits for the running ones
+ */
+Asn1SccParsedDocumentBuilder::~Asn1SccParsedDocumentBuilder()
 {
-    m_worker = new Asn1ReadWorker(this);
-    m_worker->moveToThread(&m_workerThread);
-    connect(&m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
-    connect(m_worker,
-            &Asn1ReadWorker::resultReady,
-            this,
-            &Asn1SccParsedDocumentBuilder::handleResults);
-    m_workerThread.start();
-    QMetaObject::invokeMethod(m_worker, "doWork");
+    m_cancelled->fetchAndStoreOrdered(1);
+    for (DocumentWatcher *watcher : qAsConst(m_watchers))
+        watcher->waitForFinished();
 }
 
-void Asn1SccParsedDocumentBuilder::handleResults()
+void Asn1SccParsedDocumentBuilder::run()
 {
-    Q_ASSERT(m_worker != nullptr);
-    if (m_worker->hadError()) {
-        Q_EMIT errored();
+    if (m_documentSources.isEmpty()) {
+        QTimer::singleShot(0, this, &Asn1SccParsedDocumentBuilder::finish);
         return;
     }
-    Q_EMIT finished();
+
+    QStringList fileNames = m_documentSources.keys();
+    std::sort(fileNames.begin(), fileNames.end());
+
+    const ParseFunction parse = m_parse;
+    const std::function<bool()> isOutdated = outdatedCheck();
+    const QSharedPointer<QAtomicInt> cancelled = m_cancelled;
+
+    m_pendingDocuments = fileNames.size();
+    for (const QString &fileName : qAsConst(fileNames)) {
+        const QString content = m_documentSources.value(fileName);
+        auto watcher = new DocumentWatcher(this);
+        connect(watcher, &DocumentWatcher::finished, this, [this, watcher]() { mergeDocument(watcher); });
+        m_watchers.insert(watcher);
+        watcher->setFuture(QtConcurrent::run(m_pool, [fileName, content, parse, isOutdated, cancelled]() {
+            return parseDocument(fileName, content, parse, isOutdated, cancelled);
+        }));
+    }
 }
 
 std::vector<std::unique_ptr<Asn1Acn::File>> Asn1SccParsedDocumentBuilder::takeDocuments()
 {
-    return std::move(m_parsedDocuments);
+    std::vector<std::unique_ptr<Asn1Acn::File>> documents;
+    documents.swap(m_parsedDocuments);
+    return documents;
 }
 
 /*!
-   \brief Asn1ReadWorker::Asn1ReadWorker
-   \param builder
+   Parses \p content of \p fileName with the asn1scc compiler
  */
-Asn1ReadWorker::Asn1ReadWorker(Asn1SccParsedDocumentBuilder *builder)
-    : QObject()
-    , m_builder(builder)
-{}
+std::unique_ptr<Asn1Acn::File> Asn1SccParsedDocumentBuilder::parseWithAsn1Scc(const QString &fileName,
+                                                                            const QString &content,
+                                                                            QStringList *errorMessages)
+{
+    Asn1Reader reader;
+    return reader.parseAsn1File(fileName, errorMessages, content);
+}
 
 /*!
-   Reports if the ASN parsing returned an error
+   The pool all builders parse on. It is separate from the global pool, so slow compiler runs can't starve other
+   concurrent work
  */
-bool Asn1ReadWorker::hadError() const
+QThreadPool *Asn1SccParsedDocumentBuilder::parsingThreadPool()
 {
-    return !m_builder->m_errorMessages.empty();
+    static QThreadPool pool;
+    return &pool;
 }
 
 /*!
-   Does the parsing for all the files
+   Parses \p content of \p fileName. Runs in a thread of the pool, so only the passed values are used
  */
-void Asn1ReadWorker::doWork()
+QSharedPointer<Asn1SccParsedDocumentBuilder::DocumentResult> Asn1SccParsedDocumentBuilder::parseDocument(
+    const QString &fileName,
+    const QString &content,
+    const ParseFunction &parse,
+    const std::function<bool()> &isOutdated,
+    const QSharedPointer<QAtomicInt> &cancelled)
 {
-    Asn1Reader reader;
-    m_builder->m_errorMessages.clear();
-    for (auto it = m_builder->m_documentSources.begin(); it != m_builder->m_documentSources.end();
-         ++it) {
-        const QString &fileName = it.key();
-        const QString &asnContent = it.value();
-        QStringList errorMessages;
-        std::unique_ptr<Asn1Acn::File> data = reader.parseAsn1File(fileName,
-                                                                   &errorMessages,
-                                                                   asnContent);
-        if (!errorMessages.isEmpty() || data.get() == nullptr) {
-            if (errorMessages.isEmpty()) {
-                m_builder->m_errorMessages.push_back(
-                    {{}, QString("Error reading file %1").arg(fileName)});
-            } else {
-                const ErrorMessageParser errorParser;
-                for (const QString &error : qAsConst(errorMessages)) {
-                    Asn1Acn::ErrorMessage msg = errorParser.parse(error);
-                    if (msg.isValid()) {
-                        Asn1Acn::ErrorMessage msgFixed(SourceLocation(fileName,
-                                                                      msg.location().line(),
-                                                                      msg.location().column()),
-                                                       msg.message());
-                        m_builder->m_errorMessages.push_back(msgFixed);
-                    }
-                }
-            }
-        } else {
-            m_builder->m_parsedDocuments.push_back(std::move(data));
+    auto result = QSharedPointer<DocumentResult>::create();
+    if (cancelled->loadAcquire() != 0 || (isOutdated && isOutdated()))
+        return result;
+
+    QStringList errorMessages;
+    std::unique_ptr<Asn1Acn::File> data = parse(fileName, content, &errorMessages);
+    if (errorMessages.isEmpty() && data.get() != nullptr) {
+        result->document = std::move(data);
+        return result;
+    }
+
+    if (errorMessages.isEmpty()) {
+        result->errorMessages.push_back({{}, QString("Error reading file %1").arg(fileName)});
+        return result;
+    }
+
+    const ErrorMessageParser errorParser;
+    for (const QString &error : qAsConst(errorMessages)) {
+        Asn1Acn::ErrorMessage msg = errorParser.parse(error);
+        if (msg.isValid()) {
+            Asn1Acn::ErrorMessage msgFixed(SourceLocation(fileName,
+                                                          msg.location().line(),
+                                                          msg.location().column()),
+                                           msg.message());
+            result->errorMessages.push_back(msgFixed);
         }
     }
-    Q_EMIT resultReady();
+
+    return result;
+}
+
+/*!
+   Collects the result of the task of \p watcher. A parsed document is published with the ones arriving in the next
+   \ref publishInterval
+ */
+void Asn1SccParsedDocumentBuilder::mergeDocument(DocumentWatcher *watcher)
+{
+    const QSharedPointer<DocumentResult> result = watcher->result();
+    m_watchers.remove(watcher);
+    watcher->deleteLater();
+
+    if (result->document)
+        m_parsedDocuments.push_back(std::move(result->document));
+    m_errorMessages.insert(m_errorMessages.end(),
+                           result->errorMessages.begin(),
+                           result->errorMessages.end());
+
+    if (--m_pendingDocuments == 0) {
+        finish();
+        return;
+    }
+
+    if (!m_parsedDocuments.empty() && !m_publishTimer.isActive())
+        m_publishTimer.start();
+}
+
+void Asn1SccParsedDocumentBuilder::publish()
+{
+    if (m_parsedDocuments.empty() || isOutdated())
+        return;
+
+    Q_EMIT documentsAvailable();
+}
+
+void Asn1SccParsedDocumentBuilder::finish()
+{
+    m_publishTimer.stop();
+
+    if (isOutdated()) {
+        // The results of a superseded revision are never used
+        m_parsedDocuments.clear();
+        m_errorMessages.clear();
+        Q_EMIT finished();
+        return;
+    }
+
+    if (!m_errorMessages.empty()) {
+        Q_EMIT errored();
+        return;
+    }
+    Q_EMIT finished();
 }
 
 } // namespace Internal
@@ -25,31 +25,47 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
-#include <QByteArray>
+#include <QAtomicInt>
+#include <QFutureWatcher>
 #include <QHash>
+#include <QSet>
+#include <QSharedPointer>
 #include <QString>
-#include <QThread>
+#include <QStringList>
+#include <QTimer>
 
 #include "parseddocumentbuilder.h"
 
+class QThreadPool;
+
 namespace Asn1Acn {
 namespace Internal {
 
-class Asn1ReadWorker;
-
 /*!
    Build ASN data structure from ASN files/content
+
+   Each document is parsed in its own task on a thread pool bounded to the number of cores, so a free thread takes the
+   next document and one slow document doesn't hold back others. The results are merged in the thread of the builder
+   as they arrive and published by documentsAvailable() without waiting for the slowest document. The documents
+   arriving within \ref publishInterval are published together, so the storage isn't updated for each document. Once
+   the documents are outdated, the tasks not started yet are skipped and the results are dropped.
  */
 class Asn1SccParsedDocumentBuilder : public ParsedDocumentBuilder
 {
     Q_OBJECT
 
 public:
+    using ParseFunction = std::function<std::unique_ptr<Asn1Acn::File>(
+        const QString &fileName, const QString &content, QStringList *errorMessages)>;
+
     static ParsedDocumentBuilder *create(const QHash<QString, QString> &documents);
 
-    Asn1SccParsedDocumentBuilder(const QHash<QString, QString> &documents);
+    Asn1SccParsedDocumentBuilder(const QHash<QString, QString> &documents,
+                                 ParseFunction parse = parseWithAsn1Scc,
+                                 QThreadPool *pool = parsingThreadPool());
     ~Asn1SccParsedDocumentBuilder();
     void run() override;
 
@@ -59,39 +75,41 @@ public:
         return m_errorMessages;
     }
 
-private Q_SLOTS:
-    void handleResults();
+    static std::unique_ptr<Asn1Acn::File> parseWithAsn1Scc(const QString &fileName,
+                                                           const QString &content,
+                                                           QStringList *errorMessages);
+    static QThreadPool *parsingThreadPool();
+
+    static const int publishInterval = 100; ///< Milliseconds a parsed document may wait for others to be published
 
 private:
+    struct DocumentResult
+    {
+        std::unique_ptr<Asn1Acn::File> document;
+        std::vector<Asn1Acn::ErrorMessage> errorMessages;
+    };
+    using DocumentWatcher = QFutureWatcher<QSharedPointer<DocumentResult>>;
+
+    static QSharedPointer<DocumentResult> parseDocument(const QString &fileName,
+                                                        const QString &content,
+                                                        const ParseFunction &parse,
+                                                        const std::function<bool()> &isOutdated,
+                                                        const QSharedPointer<QAtomicInt> &cancelled);
+    void mergeDocument(DocumentWatcher *watcher);
+    void publish();
+    void finish();
+
     const QHash<QString, QString> m_documentSources;
+    const ParseFunction m_parse;
+    QThreadPool *m_pool;
 
     std::vector<std::unique_ptr<Asn1Acn::File>> m_parsedDocuments;
     std::vector<Asn1Acn::ErrorMessage> m_errorMessages;
 
-    QThread m_workerThread;
-    Asn1ReadWorker *m_worker = nullptr;
-
-    friend class Asn1ReadWorker;
-};
-
-/*!
-   Worker class for parsing asn.1 files in a thread
- */
-class Asn1ReadWorker : public QObject
-{
-    Q_OBJECT
-public:
-    Asn1ReadWorker(Asn1SccParsedDocumentBuilder *builder);
-    bool hadError() const;
-
-public Q_SLOTS:
-    void doWork();
-
-Q_SIGNALS:
-    void resultReady();
-
-private:
-    Asn1SccParsedDocumentBuilder *m_builder = nullptr;
+    QSet<DocumentWatcher *> m_watchers;
+    QSharedPointer<QAtomicInt> m_cancelled;
+    int m_pendingDocuments = 0;
+    QTimer m_publishTimer;
 };
 
 } /* namespace Internal */
@@ -52,6 +52,7 @@ public:
     virtual State state() = 0;
 
 Q_SIGNALS:
+    void documentsAvailable(const QString &projectName) const;
     void processingFinished(const QString &projectName) const;
 };
 
@@ -30,10 +30,153 @@
 #include "asn1/file.h"
 #include "asn1/project.h"
 
+#include <QSet>
+
+#include <algorithm>
+
 using namespace Asn1Acn::Internal;
 
+/*!
+   Removes all files with one of \a paths in a single pass
+ */
+static void removeFilesFromSnapshot(ParsedDataStorage::ProjectSnapshot &project,
+                                    const QSet<QString> &paths)
+{
+    size_t kept = 0;
+    for (size_t idx = 0; idx < project.files.size(); idx++) {
+        const QString path = project.files[idx]->name();
+        if (paths.contains(path)) {
+            project.filesByPath.remove(path);
+            continue;
+        }
+        if (kept != idx) {
+            project.files[kept] = std::move(project.files[idx]);
+            project.indexes[kept] = std::move(project.indexes[idx]);
+        }
+        kept++;
+    }
+
+    project.files.resize(kept);
+    project.indexes.resize(kept);
+}
+
+static void removeFileFromSnapshot(ParsedDataStorage::ProjectSnapshot &project, const QString &path)
+{
+    project.filesByPath.remove(path);
+
+    const auto it = std::find_if(project.files.begin(),
+                                 project.files.end(),
+                                 [&path](const std::shared_ptr<Asn1Acn::File> &file) {
+                                     return file->name() == path;
+                                 });
+    if (it == project.files.end())
+        return;
+
+    project.indexes.erase(project.indexes.begin() + std::distance(project.files.begin(), it));
+    project.files.erase(it);
+}
+
+static void addReferences(ParsedFileIndex::ReferencesByType &references, const ParsedFileIndex &index)
+{
+    const auto &fileReferences = index.referencesByType();
+    for (auto it = fileReferences.cbegin(); it != fileReferences.cend(); it++)
+        references[it.key()] += it.value();
+}
+
+static void removeReferences(ParsedFileIndex::ReferencesByType &references, const ParsedFileIndex &index)
+{
+    const auto &fileReferences = index.referencesByType();
+    for (auto it = fileReferences.cbegin(); it != fileReferences.cend(); it++) {
+        const auto found = references.find(it.key());
+        if (found == references.end() || it.value().isEmpty())
+            continue;
+
+        // addReferences appended all references of the file at once
+        const int first = found.value().indexOf(it.value().first());
+        if (first < 0)
+            continue;
+        found.value().remove(first, it.value().size());
+        if (found.value().isEmpty())
+            references.erase(found);
+    }
+}
+
+/*!
+   Updates the references of \a snapshot for the files that are only in \a before or only in \a after
+ */
+static void updateReferences(ParsedDataStorage::Snapshot &snapshot,
+                             const ParsedDataStorage::ProjectSnapshot &before,
+                             const ParsedDataStorage::ProjectSnapshot &after)
+{
+    QSet<const ParsedFileIndex *> beforeIndexes;
+    for (const auto &index : before.indexes)
+        beforeIndexes.insert(index.get());
+    QSet<const ParsedFileIndex *> afterIndexes;
+    for (const auto &index : after.indexes)
+        afterIndexes.insert(index.get());
+
+    for (const auto &index : before.indexes)
+        if (!afterIndexes.contains(index.get()))
+            removeReferences(snapshot.referencesByType, *index);
+    for (const auto &index : after.indexes)
+        if (!beforeIndexes.contains(index.get()))
+            addReferences(snapshot.referencesByType, *index);
+}
+
+const ParsedDataStorage::ProjectSnapshot *ParsedDataStorage::Snapshot::project(
+    const QString &name) const
+{
+    // Same as Root::project, the project added last wins
+    for (auto it = projects.rbegin(); it != projects.rend(); it++)
+        if ((*it)->name == name)
+            return it->get();
+
+    return nullptr;
+}
+
+Asn1Acn::File *ParsedDataStorage::Snapshot::anyFile(const QString &path) const
+{
+    for (const auto &project : projects)
+        if (const auto file = project->file(path))
+            return file;
+
+    return nullptr;
+}
+
+QStringList ParsedDataStorage::Snapshot::projectsForFile(const QString &path) const
+{
+    QStringList res;
+
+    for (const auto &project : projects) {
+        if (project->file(path) != nullptr)
+            res.append(project->name);
+    }
+
+    return res;
+}
+
+int ParsedDataStorage::Snapshot::documentsCount() const
+{
+    int cnt = 0;
+
+    for (const auto &project : projects)
+        cnt += static_cast<int>(project->files.size());
+
+    return cnt;
+}
+
+/*!
+   Returns all references to \a type of \a module, in the order the files were added
+ */
+QVector<const Asn1Acn::TypeReference *> ParsedDataStorage::Snapshot::references(
+    const QString &module, const QString &type) const
+{
+    return referencesByType.value(qMakePair(module, type));
+}
+
 ParsedDataStorage::ParsedDataStorage()
     : m_root(std::make_unique<Asn1Acn::Root>())
+    , m_snapshot(std::make_shared<Snapshot>())
 {}
 
 ParsedDataStorage *ParsedDataStorage::instance()
@@ -42,19 +185,25 @@ ParsedDataStorage *ParsedDataStorage::instance()
     return &instance_;
 }
 
-Asn1Acn::File *ParsedDataStorage::getAnyFileForPath(const Utils::FileName &filePath) const
+/*!
+   Returns the latest published version of the parsed data. No lock is taken
+ */
+ParsedDataStorage::SnapshotPtr ParsedDataStorage::snapshot() const
 {
-    QMutexLocker locker(&m_documentsMutex);
+    return std::atomic_load(&m_snapshot);
+}
 
-    return getFileForPathInternal(filePath);
+Asn1Acn::File *ParsedDataStorage::getAnyFileForPath(const Utils::FileName &filePath) const
+{
+    return snapshot()->anyFile(filePath.toString());
 }
 
 Asn1Acn::File *ParsedDataStorage::getFileForPathFromProject(const QString &projectName,
                                                             const Utils::FileName &filePath)
 {
-    QMutexLocker locker(&m_documentsMutex);
+    const auto current = snapshot();
 
-    const auto &project = m_root->project(projectName);
+    const auto project = current->project(projectName);
     if (project == nullptr)
         return nullptr;
 
@@ -63,30 +212,57 @@ Asn1Acn::File *ParsedDataStorage::getFileForPathFromProject(const QString &proje
 
 void ParsedDataStorage::addProject(const QString &projectName)
 {
-    QMutexLocker locker(&m_documentsMutex);
+    QMutexLocker locker(&m_writeMutex);
 
     m_root->add(std::make_unique<Asn1Acn::Project>(projectName));
+
+    auto project = std::make_shared<ProjectSnapshot>();
+    project->name = projectName;
+
+    auto next = std::make_shared<Snapshot>(*snapshot());
+    next->projects.push_back(std::move(project));
+    publish(std::move(next));
 }
 
 void ParsedDataStorage::removeProject(const QString &projectName)
 {
-    QMutexLocker locker(&m_documentsMutex);
+    QMutexLocker locker(&m_writeMutex);
 
     m_root->remove(projectName);
+
+    auto next = std::make_shared<Snapshot>(*snapshot());
+    const auto it = std::find_if(next->projects.begin(),
+                                 next->projects.end(),
+                                 [&projectName](const ProjectSnapshotPtr &project) {
+                                     return project->name == projectName;
+                                 });
+    if (it == next->projects.end())
+        return;
+
+    for (const auto &index : (*it)->indexes)
+        removeReferences(next->referencesByType, *index);
+    next->projects.erase(it);
+    publish(std::move(next));
 }
 
 const QStringList ParsedDataStorage::getProjectsForFile(const Utils::FileName &filePath) const
 {
-    QMutexLocker locker(&m_documentsMutex);
-
-    return getProjectsForFileInternal(filePath);
+    return snapshot()->projectsForFile(filePath.toString());
 }
 
-const Utils::FileNameList ParsedDataStorage::getFilesPathsFromProject(const QString &project) const
+const Utils::FileNameList ParsedDataStorage::getFilesPathsFromProject(const QString &projectName) const
 {
-    QMutexLocker locker(&m_documentsMutex);
+    const auto current = snapshot();
+
+    const auto project = current->project(projectName);
+    if (project == nullptr)
+        return {};
+
+    Utils::FileNameList ret;
+    for (const auto &file : project->files)
+        ret.append(Utils::FileName::fromString(file->name()));
 
-    return getFilesPathsFromProjectInternal(project);
+    return ret;
 }
 
 Asn1Acn::SourceLocation ParsedDataStorage::getDefinitionLocation(const Utils::FileName &path,
@@ -102,9 +278,9 @@ const Asn1Acn::TypeAssignment *ParsedDataStorage::getTypeAssignment(
     const QString &typeAssignmentName,
     const QString &definitionsName) const
 {
-    QMutexLocker locker(&m_documentsMutex);
+    const auto current = snapshot();
 
-    const auto file = getFileForPathInternal(path);
+    const auto file = current->anyFile(path.toString());
     if (file == nullptr)
         return nullptr;
 
@@ -117,7 +293,7 @@ const Asn1Acn::TypeAssignment *ParsedDataStorage::getTypeAssignment(
 
 int ParsedDataStorage::getProjectBuildersCount(const QString &projectName) const
 {
-    QMutexLocker locker(&m_documentsMutex);
+    QMutexLocker locker(&m_writeMutex);
 
     const auto project = m_root->project(projectName);
     if (project == nullptr)
@@ -128,7 +304,7 @@ int ParsedDataStorage::getProjectBuildersCount(const QString &projectName) const
 
 void ParsedDataStorage::setProjectBuildersCount(const QString &projectName, const int version) const
 {
-    QMutexLocker locker(&m_documentsMutex);
+    QMutexLocker locker(&m_writeMutex);
 
     auto project = m_root->project(projectName);
     if (project == nullptr)
@@ -139,7 +315,7 @@ void ParsedDataStorage::setProjectBuildersCount(const QString &projectName, cons
 
 void ParsedDataStorage::resetProjectBuildersCount()
 {
-    QMutexLocker locker(&m_documentsMutex);
+    QMutexLocker locker(&m_writeMutex);
 
     const auto &projects = m_root->projects();
     for (const auto &project : projects)
@@ -149,86 +325,119 @@ void ParsedDataStorage::resetProjectBuildersCount()
 void ParsedDataStorage::addFileToProject(const QString &projectName,
                                          std::unique_ptr<Asn1Acn::File> file)
 {
-    QMutexLocker locker(&m_documentsMutex);
+    std::vector<std::unique_ptr<Asn1Acn::File>> files;
+    files.push_back(std::move(file));
+    addFilesToProject(projectName, std::move(files));
+}
+
+/*!
+   Adds \a files to \a projectName, replacing the files with the same paths, and publishes them in one new version.
+   If \a files contains a path several times, the last file wins
+ */
+void ParsedDataStorage::addFilesToProject(const QString &projectName,
+                                          std::vector<std::unique_ptr<Asn1Acn::File>> files)
+{
+    if (files.empty())
+        return;
+
+    // The indexes are built before locking, so other writers are not blocked by them
+    std::vector<std::shared_ptr<Asn1Acn::File>> sharedFiles;
+    std::vector<std::shared_ptr<const ParsedFileIndex>> indexes;
+    sharedFiles.reserve(files.size());
+    indexes.reserve(files.size());
+    QSet<QString> paths;
+    for (auto &file : files) {
+        paths.insert(file->name());
+        sharedFiles.push_back(std::move(file));
+        indexes.push_back(std::make_shared<const ParsedFileIndex>(*sharedFiles.back()));
+    }
+
+    QMutexLocker locker(&m_writeMutex);
 
     auto project = m_root->project(projectName);
     if (project == nullptr)
         return;
 
-    project->add(std::move(file));
+    for (const auto &file : sharedFiles)
+        project->add(file);
+
+    updateProject(projectName, [&](ProjectSnapshot &snapshot) {
+        removeFilesFromSnapshot(snapshot, paths);
+
+        snapshot.files.reserve(snapshot.files.size() + sharedFiles.size());
+        snapshot.indexes.reserve(snapshot.indexes.size() + indexes.size());
+        QHash<QString, size_t> added;
+        for (size_t idx = 0; idx < sharedFiles.size(); idx++) {
+            const auto &file = sharedFiles[idx];
+            snapshot.filesByPath.insert(file->name(), file.get());
+
+            const auto duplicate = added.constFind(file->name());
+            if (duplicate != added.constEnd()) {
+                snapshot.files[duplicate.value()] = file;
+                snapshot.indexes[duplicate.value()] = indexes[idx];
+                continue;
+            }
+            added.insert(file->name(), snapshot.files.size());
+            snapshot.files.push_back(file);
+            snapshot.indexes.push_back(indexes[idx]);
+        }
+    });
 }
 
 void ParsedDataStorage::removeFileFromProject(const QString &projectName,
                                               const Utils::FileName &filePath)
 {
-    QMutexLocker locker(&m_documentsMutex);
+    QMutexLocker locker(&m_writeMutex);
 
-    removeFileFromProjectInternal(projectName, filePath);
+    auto project = m_root->project(projectName);
+    if (project == nullptr)
+        return;
+
+    project->remove(filePath.toString());
+
+    updateProject(projectName, [&filePath](ProjectSnapshot &snapshot) {
+        removeFileFromSnapshot(snapshot, filePath.toString());
+    });
 }
 
 int ParsedDataStorage::getProjectsCount()
 {
-    QMutexLocker locker(&m_documentsMutex);
-
-    return static_cast<int>(m_root->projects().size());
+    return static_cast<int>(snapshot()->projects.size());
 }
 
 int ParsedDataStorage::getDocumentsCount()
 {
-    int cnt = 0;
-
-    QMutexLocker locker(&m_documentsMutex);
-
-    for (auto it = m_root->projects().begin(); it != m_root->projects().end(); it++)
-        cnt += static_cast<int>((*it)->files().size());
-
-    return cnt;
+    return snapshot()->documentsCount();
 }
 
-void ParsedDataStorage::removeFileFromProjectInternal(const QString &projectName,
-                                                      const Utils::FileName &filePath)
+/*!
+   Publishes a new version, in which only the snapshot of \a projectName is copied and changed by \a update.
+   Has to be called with the write mutex locked
+ */
+void ParsedDataStorage::updateProject(const QString &projectName, const ProjectUpdate &update)
 {
-    auto prj = m_root->project(projectName);
-    if (prj == nullptr)
-        return;
+    const auto current = snapshot();
 
-    prj->remove(filePath.toString());
-}
+    for (auto idx = current->projects.size(); idx > 0; idx--) {
+        const auto &project = current->projects.at(idx - 1);
+        if (project->name != projectName)
+            continue;
 
-const QStringList ParsedDataStorage::getProjectsForFileInternal(const Utils::FileName &filePath) const
-{
-    QStringList res;
+        auto changedProject = std::make_shared<ProjectSnapshot>(*project);
+        update(*changedProject);
 
-    const auto &projects = m_root->projects();
-    for (const auto &project : projects) {
-        if (project->file(filePath.toString()) != nullptr)
-            res.append(project->name());
+        auto next = std::make_shared<Snapshot>(*current);
+        updateReferences(*next, *project, *changedProject);
+        next->projects[idx - 1] = std::move(changedProject);
+        publish(std::move(next));
+        return;
     }
-
-    return res;
 }
 
-const Utils::FileNameList ParsedDataStorage::getFilesPathsFromProjectInternal(
-    const QString &projectName) const
+void ParsedDataStorage::publish(std::shared_ptr<Snapshot> next)
 {
-    const auto project = m_root->project(projectName);
-    if (project == nullptr)
-        return {};
-
-    Utils::FileNameList ret;
-    for (const auto &file : project->files())
-        ret.append(Utils::FileName::fromString(file->name()));
-
-    return ret;
-}
-
-Asn1Acn::File *ParsedDataStorage::getFileForPathInternal(const Utils::FileName &filePath) const
-{
-    for (auto it = m_root->projects().begin(); it != m_root->projects().end(); it++)
-        if ((*it)->file(filePath.toString()) != nullptr)
-            return (*it)->file(filePath.toString());
-
-    return nullptr;
+    next->version = snapshot()->version + 1;
+    std::atomic_store(&m_snapshot, SnapshotPtr(std::move(next)));
 }
 
 Asn1Acn::SourceLocation ParsedDataStorage::getLocationFromModule(
@@ -29,32 +29,79 @@
 #include <QObject>
 #include <QString>
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include <utils/fileutils.h>
 
 #include "asn1/file.h"
 #include "asn1/root.h"
 
+#include "parsedfileindex.h"
+
 namespace Asn1Acn {
 namespace Internal {
 
+/*!
+   Stores the parsed files of all projects.
+
+   Readers work on immutable snapshots: snapshot() returns the latest published version without taking any lock,
+   and the files stay alive as long as the snapshot is referenced, even if they are removed from the storage
+   meanwhile. Writers are serialized, copy only the snapshot of the project they change and publish a new version.
+   The snapshots of all other projects are shared between the versions. As each change copies the snapshot of its
+   project, many files are added with one addFilesToProject() call instead of one addFileToProject() per file.
+   The references of all projects are kept in one index of the snapshot, which is updated for the added and removed
+   files only, so finding usages doesn't depend on the number of files.
+
+   root() gives the tree of projects for the views. It is only modified and read in the GUI thread.
+ */
 class ParsedDataStorage : public QObject
 {
     Q_OBJECT
 
 public:
+    struct ProjectSnapshot
+    {
+        QString name;
+        std::vector<std::shared_ptr<Asn1Acn::File>> files;
+        std::vector<std::shared_ptr<const ParsedFileIndex>> indexes; ///< Same order as files
+        QHash<QString, Asn1Acn::File *> filesByPath;
+
+        Asn1Acn::File *file(const QString &path) const { return filesByPath.value(path, nullptr); }
+    };
+    using ProjectSnapshotPtr = std::shared_ptr<const ProjectSnapshot>;
+
+    struct Snapshot
+    {
+        quint64 version = 0;
+        std::vector<ProjectSnapshotPtr> projects;
+        /// References of all files by the referenced type. The references of one file are stored in one block
+        ParsedFileIndex::ReferencesByType referencesByType;
+
+        const ProjectSnapshot *project(const QString &name) const;
+        Asn1Acn::File *anyFile(const QString &path) const;
+        QStringList projectsForFile(const QString &path) const;
+        int documentsCount() const;
+        QVector<const Asn1Acn::TypeReference *> references(const QString &module,
+                                                           const QString &type) const;
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
     ParsedDataStorage();
     ~ParsedDataStorage() = default;
 
     static ParsedDataStorage *instance();
 
     const Asn1Acn::Root *root() const { return m_root.get(); }
+    SnapshotPtr snapshot() const;
 
     void addProject(const QString &projectName);
     void removeProject(const QString &projectName);
 
     void addFileToProject(const QString &projectName, std::unique_ptr<Asn1Acn::File> file);
+    void addFilesToProject(const QString &projectName,
+                           std::vector<std::unique_ptr<Asn1Acn::File>> files);
     void removeFileFromProject(const QString &projectName, const Utils::FileName &filePath);
 
     Asn1Acn::File *getAnyFileForPath(const Utils::FileName &filePath) const;
@@ -78,17 +125,17 @@ public:
     int getDocumentsCount();
 
 private:
-    const QStringList getProjectsForFileInternal(const Utils::FileName &filePath) const;
-    const Utils::FileNameList getFilesPathsFromProjectInternal(const QString &projectName) const;
-    void removeFileFromProjectInternal(const QString &projectName, const Utils::FileName &filePath);
+    using ProjectUpdate = std::function<void(ProjectSnapshot &)>;
 
-    Asn1Acn::File *getFileForPathInternal(const Utils::FileName &filePath) const;
+    void updateProject(const QString &projectName, const ProjectUpdate &update);
+    void publish(std::shared_ptr<Snapshot> next);
 
     Asn1Acn::SourceLocation getLocationFromModule(const Asn1Acn::Definitions &moduleDefinition,
                                                   const QString &typeAssignmentName) const;
 
     std::unique_ptr<Asn1Acn::Root> m_root;
-    mutable QMutex m_documentsMutex;
+    SnapshotPtr m_snapshot;
+    mutable QMutex m_writeMutex;
 };
 
 } // namespace Internal
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -49,10 +50,28 @@ public:
     virtual std::vector<std::unique_ptr<Asn1Acn::File>> takeDocuments() = 0;
     virtual const std::vector<Asn1Acn::ErrorMessage> &errorMessages() const = 0;
 
+    /*!
+       Sets the check if a newer revision of the documents is being built. It may be called from worker threads,
+       builders use it to skip work whose result would be dropped anyway
+     */
+    void setOutdatedCheck(std::function<bool()> isOutdated) { m_isOutdated = std::move(isOutdated); }
+
+protected:
+    bool isOutdated() const { return m_isOutdated && m_isOutdated(); }
+    std::function<bool()> outdatedCheck() const { return m_isOutdated; }
+
 Q_SIGNALS:
+    /*!
+       Emitted when a part of the documents is parsed, before the builder is finished. takeDocuments() returns the
+       documents parsed so far
+     */
+    void documentsAvailable();
     void finished();
     void errored();
     void failed();
+
+private:
+    std::function<bool()> m_isOutdated;
 };
 
 } /* namespace Internal */
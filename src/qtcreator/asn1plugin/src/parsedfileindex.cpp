@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 N7 Space sp. z o. o.
+** Contact: http://n7space.com
+**
+** This file is part of ASN.1/ACN Plugin for QtCreator.
+**
+** Plugin was developed under a program and funded by
+** European Space Agency.
+**
+** This Plugin is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**
+****************************************************************************/
+
+#include "parsedfileindex.h"
+
+#include <asn1/definitions.h>
+#include <asn1/file.h>
+#include <asn1/typereference.h>
+
+using namespace Asn1Acn::Internal;
+
+ParsedFileIndex::ParsedFileIndex(const Asn1Acn::File &file)
+{
+    for (const auto &ref : file.references())
+        m_references[qMakePair(ref->module(), ref->name())].append(ref.get());
+
+    m_modules.reserve(file.definitionsList().size());
+    for (const auto &defs : file.definitionsList()) {
+        Module module{defs.get(), characterMask(defs->name()), {}};
+        module.names.reserve(defs->types().size() + defs->values().size());
+        defs->forAllNodes([&module](const Asn1Acn::Node *node) {
+            module.names.push_back({node, characterMask(node->name())});
+        });
+        m_modules.push_back(std::move(module));
+    }
+}
+
+QVector<const Asn1Acn::TypeReference *> ParsedFileIndex::references(const QString &module,
+                                                                    const QString &type) const
+{
+    return m_references.value(qMakePair(module, type));
+}
+
+/*!
+   Returns a bit for each letter (case insensitive) and digit in \a text. Other characters are ignored
+ */
+quint64 ParsedFileIndex::characterMask(const QString &text)
+{
+    quint64 mask = 0;
+    for (const QChar character : text) {
+        const ushort code = character.toLower().unicode();
+        if (code >= 'a' && code <= 'z')
+            mask |= quint64(1) << (code - 'a');
+        else if (code >= '0' && code <= '9')
+            mask |= quint64(1) << (26 + code - '0');
+    }
+    return mask;
+}
@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 N7 Space sp. z o. o.
+** Contact: http://n7space.com
+**
+** This file is part of ASN.1/ACN Plugin for QtCreator.
+**
+** Plugin was developed under a program and funded by
+** European Space Agency.
+**
+** This Plugin is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**
+****************************************************************************/
+#pragma once
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+namespace Asn1Acn {
+class Definitions;
+class File;
+class Node;
+class TypeReference;
+
+namespace Internal {
+
+/*!
+   Lookup tables of one parsed file, built once when the file is added to the ParsedDataStorage.
+
+   References are grouped by the module and name of the referenced type, so finding usages only touches the results.
+   Every type and value name has a mask of the letters and digits it contains. A locator pattern can only match a
+   name, if the name contains all letters and digits of the pattern, so most names are skipped without running the
+   regular expression.
+ */
+class ParsedFileIndex
+{
+public:
+    struct Name
+    {
+        const Asn1Acn::Node *node;
+        quint64 mask;
+    };
+
+    struct Module
+    {
+        const Asn1Acn::Definitions *definitions;
+        quint64 mask;
+        std::vector<Name> names;
+    };
+
+    using ReferenceKey = QPair<QString, QString>; ///< Module and name of the referenced type
+    using ReferencesByType = QHash<ReferenceKey, QVector<const Asn1Acn::TypeReference *>>;
+
+    explicit ParsedFileIndex(const Asn1Acn::File &file);
+
+    QVector<const Asn1Acn::TypeReference *> references(const QString &module,
+                                                       const QString &type) const;
+    const ReferencesByType &referencesByType() const { return m_references; }
+    const std::vector<Module> &modules() const { return m_modules; }
+
+    static quint64 characterMask(const QString &text);
+    static bool mayMatch(quint64 nameMask, quint64 patternMask)
+    {
+        return (nameMask & patternMask) == patternMask;
+    }
+
+private:
+    ReferencesByType m_references;
+    std::vector<Module> m_modules;
+};
+
+} // namespace Internal
+} // namespace Asn1Acn
@@ -30,12 +30,39 @@
 
 #include <utils/qtcassert.h>
 
+#include <algorithm>
+
 #include "asn1sccdocumentprocessor.h"
+#include "astbinarycache.h"
 #include "filesourcereader.h"
 
 using namespace Asn1Acn::Internal;
 using FileNameList = Utils::FileNameList;
 
+static std::vector<Asn1Acn::ErrorMessage> fileErrorMessages(
+    const QString &path, const std::vector<Asn1Acn::ErrorMessage> &errorMessages)
+{
+    std::vector<Asn1Acn::ErrorMessage> res;
+
+    for (const auto &message : errorMessages)
+        if (message.location().path() == path)
+            res.push_back(message);
+
+    return res;
+}
+
+static bool sameErrorMessages(const std::vector<Asn1Acn::ErrorMessage> &first,
+                              const std::vector<Asn1Acn::ErrorMessage> &second)
+{
+    return std::equal(first.begin(),
+                      first.end(),
+                      second.begin(),
+                      second.end(),
+                      [](const Asn1Acn::ErrorMessage &a, const Asn1Acn::ErrorMessage &b) {
+                          return a.location() == b.location() && a.message() == b.message();
+                      });
+}
+
 ProjectContentHandler *ProjectContentHandler::create()
 {
     return new ProjectContentHandler([](const QString &project)
@@ -135,6 +162,10 @@ DocumentProcessor *ProjectContentHandler::createDocumentProcessor(
 
 void ProjectContentHandler::startProcessing(DocumentProcessor *dp)
 {
+    connect(dp,
+            &DocumentProcessor::documentsAvailable,
+            this,
+            &ProjectContentHandler::onFilesAvailable);
     connect(dp,
             &DocumentProcessor::processingFinished,
             this,
@@ -145,6 +176,15 @@ void ProjectContentHandler::startProcessing(DocumentProcessor *dp)
     dp->run();
 }
 
+/*!
+   Stores the files a processor has parsed already. They have no errors, as the files with errors aren't parsed
+ */
+void ProjectContentHandler::onFilesAvailable(const QString &projectName)
+{
+    DocumentProcessor *dp = qobject_cast<DocumentProcessor *>(sender());
+    handleFilesProcesedWithSuccess(projectName, dp->takeResults());
+}
+
 void ProjectContentHandler::onFilesProcessingFinished(const QString &projectName)
 {
     DocumentProcessor *dp = qobject_cast<DocumentProcessor *>(sender());
@@ -173,35 +213,43 @@ void ProjectContentHandler::onFilesProcessingFinished(const QString &projectName
 void ProjectContentHandler::handleFilesProcesedWithSuccess(
     const QString &projectName, std::vector<std::unique_ptr<Asn1Acn::File>> parsedDocuments)
 {
-    for (size_t i = 0; i < parsedDocuments.size(); i++)
-        m_storage->addFileToProject(projectName, std::move(parsedDocuments[i]));
+    m_storage->addFilesToProject(projectName, std::move(parsedDocuments));
 }
 
+/*!
+   Sets the error messages of a failed run. Files stay unchanged once they are stored, as other threads may read them.
+   A stored file with other errors is replaced by a copy with the new errors, so it keeps its last parsed content
+ */
 void ProjectContentHandler::handleFilesProcesedWithFailure(
     const QString &projectName,
     std::vector<std::unique_ptr<Asn1Acn::File>> parsedDocuments,
     const std::vector<Asn1Acn::ErrorMessage> &errorMessages)
 {
-    for (size_t i = 0; i < parsedDocuments.size(); i++) {
-        const auto path = Utils::FileName::fromString(parsedDocuments[i]->location().path());
-        auto file = m_storage->getFileForPathFromProject(projectName, path);
-        if (file == nullptr) {
-            file = parsedDocuments[i].get();
-            m_storage->addFileToProject(projectName, std::move(parsedDocuments[i]));
-        }
-
-        refreshErrorMessages(file, errorMessages);
+    std::vector<std::unique_ptr<Asn1Acn::File>> changedFiles;
+
+    for (auto &document : parsedDocuments) {
+        const QString path = document->location().path();
+        const auto fileErrors = fileErrorMessages(path, errorMessages);
+
+        const auto stored = m_storage->getFileForPathFromProject(projectName,
+                                                                 Utils::FileName::fromString(path));
+        if (stored != nullptr && sameErrorMessages(stored->errors(), fileErrors))
+            continue;
+
+        // A stored file may be read through a snapshot meanwhile, so the errors are set on a copy
+        std::unique_ptr<Asn1Acn::File> file = stored ? AstBinaryCache::deserialize(
+                                                           AstBinaryCache::serialize(*stored))
+                                                     : nullptr;
+        if (file == nullptr)
+            file = std::move(document);
+
+        file->clearErrors();
+        for (const auto &message : fileErrors)
+            file->addErrorMessage(message);
+        changedFiles.push_back(std::move(file));
     }
-}
-
-void ProjectContentHandler::refreshErrorMessages(
-    Asn1Acn::File *file, const std::vector<Asn1Acn::ErrorMessage> &errorMessages)
-{
-    file->clearErrors();
 
-    for (const auto &message : errorMessages)
-        if (message.location().path() == file->location().path())
-            file->addErrorMessage(message);
+    m_storage->addFilesToProject(projectName, std::move(changedFiles));
 }
 
 void ProjectContentHandler::allProcessingFinished()
@@ -59,6 +59,7 @@ public:
     void handleFileContentChanged(const Utils::FileName &path);
 
 private Q_SLOTS:
+    void onFilesAvailable(const QString &projectName);
     void onFilesProcessingFinished(const QString &projectName);
 
 private:
@@ -81,9 +82,6 @@ private:
                                         std::vector<std::unique_ptr<Asn1Acn::File>> parsedDocuments,
                                         const std::vector<Asn1Acn::ErrorMessage> &errorMessages);
 
-    void refreshErrorMessages(Asn1Acn::File *file,
-                              const std::vector<Asn1Acn::ErrorMessage> &errorMessages);
-
     ParsedDataStorage *m_storage;
     ModelValidityGuard *m_guard;
 
@@ -46,7 +46,7 @@ int ChildrenCountingVisitor::valueFor(const Asn1Acn::Project &project) const
     return std::accumulate(project.files().begin(),
                            project.files().end(),
                            0,
-                           [](int n, const std::unique_ptr<Asn1Acn::File> &file) {
+                           [](int n, const std::shared_ptr<Asn1Acn::File> &file) {
                                return n
                                       + file->valueFor<OutlineVisitors::ChildrenCountingVisitor>();
                            });
@@ -125,19 +125,29 @@ QList<TypesLocator::Entry> TypesLocator::matchesFor(QFutureInterface<Entry> &fut
                                                     const QString &entry)
 {
     const auto regExp = createRegExp(entry);
+    const auto patternMask = ParsedFileIndex::characterMask(entry);
     EntriesCollector collector(this);
 
-    for (const auto &project : ParsedDataStorage::instance()->root()->projects())
-        for (const auto &file : project->files())
-            for (const auto &defs : file->definitionsList()) {
+    const auto snapshot = ParsedDataStorage::instance()->snapshot();
+    for (const auto &project : snapshot->projects)
+        for (const auto &index : project->indexes)
+            for (const auto &module : index->modules()) {
                 if (future.isCanceled())
                     return collector.entries();
-                const auto defsMatch = regExp.match(defs->name());
-                defs->forAllNodes([&](const Asn1Acn::Node *node) {
+                const auto defsMatch = ParsedFileIndex::mayMatch(module.mask, patternMask)
+                                           ? regExp.match(module.definitions->name())
+                                           : QRegularExpressionMatch();
+                for (const auto &name : module.names) {
                     if (future.isCanceled())
-                        return;
-                    collector.append(node, regExp.match(node->name()), defsMatch);
-                });
+                        return collector.entries();
+                    const bool nameMayMatch = ParsedFileIndex::mayMatch(name.mask, patternMask);
+                    if (!nameMayMatch && !defsMatch.hasMatch())
+                        continue;
+                    collector.append(name.node,
+                                     nameMayMatch ? regExp.match(name.node->name())
+                                                  : QRegularExpressionMatch(),
+                                     defsMatch);
+                }
             }
     return collector.entries();
 }
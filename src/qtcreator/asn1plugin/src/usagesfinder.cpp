@@ -85,15 +85,14 @@ static void performSearch(QFutureInterface<Asn1Acn::TypeReference> &future,
                           ParsedDataStorage *storage,
                           const UsagesFinderParameters &params)
 {
-    future.setProgressRange(0, storage->getDocumentsCount());
-
-    for (const auto &project : storage->root()->projects())
-        for (const auto &file : project->files()) {
-            for (const auto &ref : file->references())
-                if (ref->module() == params.module && ref->name() == params.type)
-                    future.reportResult(*ref);
-            future.setProgressValue(future.progressValue() + 1);
-        }
+    const auto snapshot = storage->snapshot();
+    const auto references = snapshot->references(params.module, params.type);
+    future.setProgressRange(0, references.size());
+
+    for (const auto ref : references) {
+        future.reportResult(*ref);
+        future.setProgressValue(future.progressValue() + 1);
+    }
 
     future.setProgressValue(future.progressMaximum());
 }
@@ -52,6 +52,7 @@ SpaceCreatorProjectImpl::SpaceCreatorProjectImpl(ProjectExplorer::Project *proje
     connect(m_asn1Storage.get(), &Asn1Acn::Asn1ModelStorage::error, this, &SpaceCreatorProjectImpl::reportAsn1Error);
     connect(m_asn1Storage.get(), &Asn1Acn::Asn1ModelStorage::success, this,
             &SpaceCreatorProjectImpl::clearTasksForFile);
+    m_asn1Storage->prefetch(m_asnFiles);
 
     static bool hubInitialized = false;
     if (!hubInitialized) {
@@ -105,6 +106,7 @@ void SpaceCreatorProjectImpl::checkAsnFileRename()
     }
 
     m_asnFiles = asnFiles;
+    m_asn1Storage->prefetch(newAsnFiles);
 }
 
 /*!
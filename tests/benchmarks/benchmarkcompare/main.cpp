@@ -0,0 +1,150 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QTextStream>
+
+struct Result {
+    QString metric;
+    double value = 0.;
+};
+using Results = QMap<QString, Result>;
+
+/*!
+   Reads the benchmark results of \p path, which is a JSON file or a directory of JSON files.
+   The results are keyed by "<benchmark>::<function>:<tag>"
+ */
+static bool readResults(const QString &path, Results &results, QTextStream &err)
+{
+    QStringList files;
+    const QFileInfo info(path);
+    if (info.isDir()) {
+        for (const QString &name : QDir(path).entryList({ "*.json" }, QDir::Files, QDir::Name)) {
+            files.append(QDir(path).filePath(name));
+        }
+    } else {
+        files.append(path);
+    }
+
+    for (const QString &fileName : files) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            err << QObject::tr("Unable to read %1: %2").arg(fileName, file.errorString()) << '\n';
+            return false;
+        }
+        QJsonParseError error;
+        const QJsonObject root = QJsonDocument::fromJson(file.readAll(), &error).object();
+        if (error.error != QJsonParseError::NoError || root.value("format").toInt() != 1) {
+            err << QObject::tr("%1 is no benchmark result file").arg(fileName) << '\n';
+            return false;
+        }
+
+        const QString benchmark = root.value("benchmark").toString();
+        const QJsonObject entries = root.value("results").toObject();
+        for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+            const QJsonObject entry = it.value().toObject();
+            Result result;
+            result.metric = entry.value("metric").toString();
+            result.value = entry.value("value").toDouble();
+            results.insert(QString("%1::%2").arg(benchmark, it.key()), result);
+        }
+    }
+    return true;
+}
+
+/*!
+   Compares two sets of benchmark results, as written by the benchmarks with -json or SC_BENCHMARK_DIR.
+   Returns 0 if no benchmark got slower than the threshold, 1 if at least one did and 2 on wrong usage
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    a.setApplicationName(QObject::tr("Benchmark Compare"));
+
+    QCommandLineParser cmdParser;
+    cmdParser.setApplicationDescription(QObject::tr("Compares the JSON results of two benchmark runs"));
+    cmdParser.addHelpOption();
+    const QCommandLineOption thresholdOption({ "t", "threshold" },
+            QObject::tr("Changes above <percent> are reported as regressions"), QObject::tr("percent"),
+            QString::number(10));
+    cmdParser.addOption(thresholdOption);
+    cmdParser.addPositionalArgument("baseline", QObject::tr("Result file or directory of the baseline"));
+    cmdParser.addPositionalArgument("current", QObject::tr("Result file or directory to compare"));
+    cmdParser.process(a);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    bool thresholdOk = false;
+    const double threshold = cmdParser.value(thresholdOption).toDouble(&thresholdOk);
+    const QStringList paths = cmdParser.positionalArguments();
+    if (paths.size() != 2 || !thresholdOk || threshold < 0.) {
+        err << cmdParser.helpText();
+        return 2;
+    }
+
+    Results baseline;
+    Results current;
+    if (!readResults(paths.at(0), baseline, err) || !readResults(paths.at(1), current, err)) {
+        return 2;
+    }
+
+    int regressions = 0;
+    for (auto it = current.constBegin(); it != current.constEnd(); ++it) {
+        const auto baseIt = baseline.constFind(it.key());
+        if (baseIt == baseline.constEnd()) {
+            out << QString("%1: new, %2 %3").arg(it.key()).arg(it->value).arg(it->metric) << '\n';
+            continue;
+        }
+        if (baseIt->metric != it->metric) {
+            out << QString("%1: metric changed from %2 to %3").arg(it.key(), baseIt->metric, it->metric) << '\n';
+            continue;
+        }
+
+        const double change = baseIt->value > 0. ? (it->value - baseIt->value) / baseIt->value * 100. : 0.;
+        const bool regression = change > threshold;
+        if (regression) {
+            ++regressions;
+        }
+        out << QString("%1: %2 -> %3 %4 (%5%6%)%7")
+                        .arg(it.key())
+                        .arg(baseIt->value)
+                        .arg(it->value)
+                        .arg(it->metric)
+                        .arg(change >= 0. ? "+" : "")
+                        .arg(change, 0, 'f', 1)
+                        .arg(regression ? " REGRESSION" : "")
+            << '\n';
+    }
+    for (auto it = baseline.constBegin(); it != baseline.constEnd(); ++it) {
+        if (!current.contains(it.key())) {
+            out << QString("%1: removed").arg(it.key()) << '\n';
+        }
+    }
+
+    if (regressions > 0) {
+        out << QObject::tr("%1 benchmark(s) slower by more than %2%").arg(regressions).arg(threshold) << '\n';
+        return 1;
+    }
+    return 0;
+}
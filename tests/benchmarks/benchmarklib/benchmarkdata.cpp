@@ -0,0 +1,243 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "benchmarkdata.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVector>
+
+namespace benchmark {
+
+QString functionName(int function)
+{
+    return QString("Function_%1").arg(function);
+}
+
+QString messageName(int function, int interface)
+{
+    return QString("msg_%1_%2").arg(function).arg(interface);
+}
+
+/*!
+   Returns an MSC document with \p charts charts. Each chart has \p instances instances and \p messages messages.
+   Message i is sent from instance i % instances via its interface (i / instances) % interfaces
+ */
+QString generateMscDocument(int charts, int instances, int messages, int interfaces)
+{
+    QString text;
+    QTextStream stream(&text);
+    stream << "mscdocument Generated /* MSC AND */;\n";
+    stream << "    language ASN.1;\n";
+    stream << "    data dataview.asn;\n";
+    stream << "mscdocument Leaf /* MSC LEAF */;\n";
+
+    for (int chart = 0; chart < charts; ++chart) {
+        // The events are collected per instance, in the order of the messages
+        QVector<QStringList> events(instances);
+        for (int idx = 0; idx < messages; ++idx) {
+            const int source = idx % instances;
+            const int interface = (idx / instances) % interfaces;
+            const int target = (source + interface + 1) % instances;
+            const QString name = messageName(source, interface);
+            events[source].append(QString("out %1 to %2;").arg(name, functionName(target)));
+            events[target].append(QString("in %1 from %2;").arg(name, functionName(source)));
+        }
+
+        stream << "msc Chart_" << chart << ";\n";
+        for (int instance = 0; instance < instances; ++instance) {
+            stream << "instance " << functionName(instance) << ";\n";
+            for (const QString &event : qAsConst(events.at(instance))) {
+                stream << event << '\n';
+            }
+            stream << "endinstance;\n";
+        }
+        stream << "endmsc;\n";
+    }
+
+    stream << "endmscdocument;\n";
+    stream << "endmscdocument;\n";
+    stream.flush();
+    return text;
+}
+
+/*!
+   Returns the XML of an interface view with \p functions functions, each with \p interfaces connected interfaces
+ */
+QByteArray generateInterfaceView(int functions, int interfaces)
+{
+    QByteArray xml;
+    QTextStream stream(&xml);
+    stream << "<?xml version=\"1.0\"?>\n";
+    stream << "<InterfaceView asn1file=\"dataview.asn\">\n";
+
+    for (int function = 0; function < functions; ++function) {
+        const int x = (function % 20) * 30000;
+        const int y = (function / 20) * 20000;
+        stream << "<Function name=\"" << functionName(function)
+               << "\" language=\"\" is_type=\"NO\" instance_of=\"\">\n";
+        stream << "<Property name=\"Taste::coordinates\" value=\"" << x << ' ' << y << ' ' << x + 20000 << ' '
+               << y + 10000 << "\"/>\n";
+        for (int interface = 0; interface < interfaces; ++interface) {
+            stream << "<Required_Interface name=\"" << messageName(function, interface)
+                   << "\" kind=\"SPORADIC_OPERATION\"/>\n";
+        }
+        for (int interface = 0; interface < interfaces; ++interface) {
+            const int source = ((function - interface - 1) % functions + functions) % functions;
+            stream << "<Provided_Interface name=\"" << messageName(source, interface)
+                   << "\" kind=\"SPORADIC_OPERATION\"/>\n";
+        }
+        stream << "</Function>\n";
+    }
+
+    for (int function = 0; function < functions; ++function) {
+        for (int interface = 0; interface < interfaces; ++interface) {
+            const QString name = messageName(function, interface);
+            stream << "<Connection>\n";
+            stream << "<Source func_name=\"" << functionName(function) << "\" ri_name=\"" << name << "\"/>\n";
+            stream << "<Target func_name=\"" << functionName((function + interface + 1) % functions)
+                   << "\" pi_name=\"" << name << "\"/>\n";
+            stream << "</Connection>\n";
+        }
+    }
+
+    stream << "</InterfaceView>\n";
+    stream.flush();
+    return xml;
+}
+
+/*!
+   Returns the XML of an interface view with \p depth functions, each one nested in the one before
+ */
+QByteArray generateNestedInterfaceView(int depth)
+{
+    QByteArray xml;
+    QTextStream stream(&xml);
+    stream << "<?xml version=\"1.0\"?>\n";
+    stream << "<InterfaceView asn1file=\"dataview.asn\">\n";
+
+    const int size = 100 * (depth + 10);
+    for (int function = 0; function < depth; ++function) {
+        const int offset = function * 50;
+        stream << "<Function name=\"" << functionName(function)
+               << "\" language=\"\" is_type=\"NO\" instance_of=\"\">\n";
+        stream << "<Property name=\"Taste::coordinates\" value=\"" << offset << ' ' << offset << ' '
+               << size - offset << ' ' << size - offset << "\"/>\n";
+        stream << "<Provided_Interface name=\"" << messageName(function, 0) << "\" kind=\"SPORADIC_OPERATION\"/>\n";
+    }
+    for (int function = 0; function < depth; ++function) {
+        stream << "</Function>\n";
+    }
+
+    stream << "</InterfaceView>\n";
+    stream.flush();
+    return xml;
+}
+
+/*!
+   Returns the XML of a deployment view with \p nodes nodes. Each node has one processor with one partition
+   holding \p functionsPerNode functions, and a device on the bus. The nodes are connected in a ring
+ */
+QByteArray generateDeploymentView(int nodes, int functionsPerNode)
+{
+    QByteArray xml;
+    QTextStream stream(&xml);
+    stream << "<DeploymentView>\n";
+
+    for (int node = 0; node < nodes; ++node) {
+        stream << "<Node name=\"Node_" << node << "\">\n";
+        stream << "<Partition cpu=\"cpu_" << node << "\" cpu_classifier=\"ocarina_processors_x86::x86.linux\" "
+               << "cpu_platform=\"PLATFORM_NATIVE\" name=\"partition_" << node << "\">\n";
+        for (int function = 0; function < functionsPerNode; ++function) {
+            stream << "<function>" << functionName(node * functionsPerNode + function) << "</function>\n";
+        }
+        stream << "</Partition>\n";
+        stream << "<Device bus=\"bus\" name=\"device_" << node << "\" port=\"link\" proc=\"cpu_" << node
+               << "\"/>\n";
+        stream << "</Node>\n";
+    }
+    for (int node = 0; node < nodes; ++node) {
+        stream << "<Connection from_node=\"Node_" << node << "\" from_port=\"link\" to_bus=\"bus\" to_node=\"Node_"
+               << (node + 1) % nodes << "\" to_port=\"link\"/>\n";
+    }
+
+    stream << "</DeploymentView>\n";
+    stream.flush();
+    return xml;
+}
+
+/*!
+   Returns the AST XML of one ASN.1 module with \p types type assignments. Every second type is a sequence,
+   referencing the type before
+ */
+QByteArray generateAsn1Ast(int types)
+{
+    QByteArray xml;
+    QTextStream stream(&xml);
+    stream << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+    stream << "<AstRoot>\n";
+    stream << "<Asn1File FileName=\"Generated.asn\">\n";
+    stream << "<Modules>\n";
+    stream << "<Module Name=\"Generated\" Line=\"1\" CharPositionInLine=\"0\">\n";
+    stream << "<TypeAssignments>\n";
+
+    for (int type = 0; type < types; ++type) {
+        stream << "<TypeAssignment Name=\"Type" << type << "\" Line=\"" << type + 2
+               << "\" CharPositionInLine=\"0\">\n";
+        stream << "<Asn1Type Line=\"" << type + 2 << "\" CharPositionInLine=\"10\">\n";
+        if (type % 2 == 1) {
+            stream << "<SEQUENCE>\n<Constraints/>\n<WithComponentConstraints/>\n";
+            stream << "<SEQUENCE_COMPONENT Name=\"a\" Line=\"" << type + 2 << "\" CharPositionInLine=\"20\">\n";
+            stream << "<Asn1Type><INTEGER/></Asn1Type>\n";
+            stream << "</SEQUENCE_COMPONENT>\n";
+            stream << "<SEQUENCE_COMPONENT Name=\"b\" Line=\"" << type + 2 << "\" CharPositionInLine=\"30\">\n";
+            stream << "<Asn1Type><REFERENCE_TYPE Module=\"Generated\" TypeAssignment=\"Type" << type - 1
+                   << "\"/></Asn1Type>\n";
+            stream << "</SEQUENCE_COMPONENT>\n";
+            stream << "</SEQUENCE>\n";
+        } else {
+            stream << "<INTEGER/>\n";
+        }
+        stream << "</Asn1Type>\n";
+        stream << "</TypeAssignment>\n";
+    }
+
+    stream << "</TypeAssignments>\n";
+    stream << "</Module>\n";
+    stream << "</Modules>\n";
+    stream << "</Asn1File>\n";
+    stream << "</AstRoot>\n";
+    stream.flush();
+    return xml;
+}
+
+/*!
+   Writes \p data to the file \p fileName in \p dir and returns the full path of the file
+ */
+QString writeFile(const QTemporaryDir &dir, const QString &fileName, const QByteArray &data)
+{
+    const QString filePath = dir.filePath(fileName);
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qFatal("Unable to write %s", qPrintable(filePath));
+    }
+    file.write(data);
+    return filePath;
+}
+
+}
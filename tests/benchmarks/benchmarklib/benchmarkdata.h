@@ -0,0 +1,46 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+class QTemporaryDir;
+
+/*!
+   Synthetic data for the benchmarks and the performance budget tests. All generators are deterministic, so the
+   results of two runs are comparable.
+
+   The interface view and the MSC documents fit together: function \c Function_k has the required interfaces
+   \c msg_k_j, connected to the provided interface with the same name of function \c Function_(k+j+1).
+   A document generated with as many instances as functions only contains messages with a matching connection.
+ */
+namespace benchmark {
+
+QString functionName(int function);
+QString messageName(int function, int interface);
+
+QString generateMscDocument(int charts, int instances, int messages, int interfaces = 2);
+QByteArray generateInterfaceView(int functions, int interfaces = 2);
+QByteArray generateNestedInterfaceView(int depth);
+QByteArray generateDeploymentView(int nodes, int functionsPerNode = 2);
+QByteArray generateAsn1Ast(int types);
+
+QString writeFile(const QTemporaryDir &dir, const QString &fileName, const QByteArray &data);
+
+}
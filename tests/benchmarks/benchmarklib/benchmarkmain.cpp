@@ -0,0 +1,115 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "benchmarkmain.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryFile>
+#include <QTest>
+#include <QXmlStreamReader>
+
+namespace benchmark {
+
+/// Version of the JSON format written by \ref runBenchmark
+static const int kFormatVersion = 1;
+
+/*!
+   Converts the XML log of QTest in \p xmlLog to the JSON format of the benchmarks:
+   \code
+   { "benchmark": "tst_Name", "format": 1,
+     "results": { "function:tag": { "metric": "WalltimeMilliseconds", "value": 1.5, "iterations": 16 } } }
+   \endcode
+   The value is the one of a single iteration. The keys of a JSON object are sorted, so the output is stable
+ */
+QJsonObject resultsFromXml(QIODevice *xmlLog, const QString &benchmarkName)
+{
+    QJsonObject results;
+    QString functionName;
+    QXmlStreamReader xml(xmlLog);
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement) {
+            continue;
+        }
+
+        const QXmlStreamAttributes attributes = xml.attributes();
+        if (xml.name() == QLatin1String("TestFunction")) {
+            functionName = attributes.value("name").toString();
+        } else if (xml.name() == QLatin1String("BenchmarkResult")) {
+            const QString tag = attributes.value("tag").toString();
+            const QString key = tag.isEmpty() ? functionName : QString("%1:%2").arg(functionName, tag);
+            QJsonObject result;
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toDouble();
+            result["iterations"] = attributes.value("iterations").toInt();
+            results[key] = result;
+        }
+    }
+
+    QJsonObject root;
+    root["benchmark"] = benchmarkName;
+    root["format"] = kFormatVersion;
+    root["results"] = results;
+    return root;
+}
+
+/*!
+   Runs the benchmarks of \p testObject like QTest::qExec. If \p arguments contain "-json <file>" or the environment
+   variable SC_BENCHMARK_DIR is set, the results are written as JSON in addition to the plain text log.
+   Returns the result of QTest::qExec
+ */
+int runBenchmark(QObject *testObject, QStringList arguments)
+{
+    const QString benchmarkName = testObject->metaObject()->className();
+
+    QString jsonFile;
+    const int jsonIndex = arguments.indexOf("-json");
+    if (jsonIndex > 0 && jsonIndex + 1 < arguments.size()) {
+        jsonFile = arguments.at(jsonIndex + 1);
+        arguments.erase(arguments.begin() + jsonIndex, arguments.begin() + jsonIndex + 2);
+    } else if (qEnvironmentVariableIsSet("SC_BENCHMARK_DIR")) {
+        const QDir dir(qEnvironmentVariable("SC_BENCHMARK_DIR"));
+        dir.mkpath(".");
+        jsonFile = dir.filePath(benchmarkName + ".json");
+    }
+
+    if (jsonFile.isEmpty()) {
+        return QTest::qExec(testObject, arguments);
+    }
+
+    QTemporaryFile xmlLog;
+    if (!xmlLog.open()) {
+        qCritical("Unable to create the temporary log file");
+        return 1;
+    }
+    xmlLog.close();
+
+    /// With an explicit output, QTest does not print to stdout anymore. So the plain text log is requested as well
+    arguments << "-o" << xmlLog.fileName() + ",xml" << "-o" << "-,txt";
+    const int result = QTest::qExec(testObject, arguments);
+
+    QFile json(jsonFile);
+    if (!xmlLog.open() || !json.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCritical("Unable to write %s", qPrintable(jsonFile));
+        return 1;
+    }
+    json.write(QJsonDocument(resultsFromXml(&xmlLog, benchmarkName)).toJson(QJsonDocument::Indented));
+    return result;
+}
+
+}
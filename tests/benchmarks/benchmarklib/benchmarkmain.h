@@ -0,0 +1,44 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QApplication>
+#include <QJsonObject>
+#include <QStringList>
+
+class QIODevice;
+class QObject;
+
+namespace benchmark {
+
+QJsonObject resultsFromXml(QIODevice *xmlLog, const QString &benchmarkName);
+int runBenchmark(QObject *testObject, QStringList arguments);
+
+}
+
+/*!
+   Same as QTEST_MAIN, but the results can also be written as JSON. Use the argument "-json <file>" or set the
+   environment variable SC_BENCHMARK_DIR to write <benchmark>.json into that directory
+ */
+#define BENCHMARK_MAIN(TestObject)                                                                                     \
+    int main(int argc, char *argv[])                                                                                   \
+    {                                                                                                                  \
+        QApplication app(argc, argv);                                                                                  \
+        TestObject tc;                                                                                                 \
+        return benchmark::runBenchmark(&tc, app.arguments());                                                          \
+    }
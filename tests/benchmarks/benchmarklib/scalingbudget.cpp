@@ -0,0 +1,58 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "scalingbudget.h"
+
+#include <QElapsedTimer>
+#include <algorithm>
+#include <limits>
+
+namespace benchmark {
+
+/*!
+   Runs \p function and returns its run time in nanoseconds
+ */
+qint64 elapsed(const std::function<void()> &function)
+{
+    QElapsedTimer timer;
+    timer.start();
+    function();
+    return timer.nsecsElapsed();
+}
+
+/*!
+   Returns the run times of \p scenario for \p size and 4 * \p size.
+   Each size is run \p repetitions times and the fastest run is used, which filters out most of the delays caused by
+   other processes
+ */
+ScalingTimes measureScaling(const Scenario &scenario, int size, int repetitions)
+{
+    auto fastestRun = [&](int runSize) {
+        qint64 fastest = std::numeric_limits<qint64>::max();
+        for (int run = 0; run < repetitions; ++run) {
+            fastest = std::min(fastest, scenario(runSize));
+        }
+        return std::max(fastest, qint64(1));
+    };
+
+    ScalingTimes times;
+    times.small = fastestRun(size);
+    times.large = fastestRun(4 * size);
+    return times;
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#pragma once
+
+#include <QtGlobal>
+#include <functional>
+
+/*!
+   Helpers for the performance budget tests. Instead of the wall time, which depends on the load of the machine,
+   these tests check how the run time grows from a size N to 4N. A linear algorithm takes about 4 times as long,
+   an n log n one about 5 times and a quadratic one 16 times.
+ */
+namespace benchmark {
+
+/// Allowed run time ratio of 4N to N. Leaves room for n log n and for noise, but fails for quadratic behaviour
+static const double MaxScalingRatio = 8.;
+
+/// A scenario runs its setup for the given size, and returns the run time in nanoseconds of the measured part
+using Scenario = std::function<qint64(int size)>;
+
+/// The fastest run times in nanoseconds of a scenario for a size N and 4N
+struct ScalingTimes {
+    qint64 small = 1;
+    qint64 large = 1;
+
+    double ratio() const { return double(large) / double(small); }
+};
+
+qint64 elapsed(const std::function<void()> &function);
+ScalingTimes measureScaling(const Scenario &scenario, int size, int repetitions = 3);
+
+}
+
+/// Verifies that \p scenario scales at most n log n from \p size to 4 * \p size
+#define SC_VERIFY_SCALING(scenario, size)                                                                             \
+    do {                                                                                                               \
+        const benchmark::ScalingTimes scTimes = benchmark::measureScaling(scenario, size);                             \
+        QVERIFY2(scTimes.ratio() < benchmark::MaxScalingRatio,                                                         \
+                qPrintable(QString("Run time grows by %1 from size %2 (%3 ms) to %4 (%5 ms)")                          \
+                                   .arg(scTimes.ratio())                                                               \
+                                   .arg(size)                                                                          \
+                                   .arg(scTimes.small / 1e6)                                                           \
+                                   .arg(4 * size)                                                                      \
+                                   .arg(scTimes.large / 1e6)));                                                        \
+    } while (false)
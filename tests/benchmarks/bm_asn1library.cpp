@@ -0,0 +1,60 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "astxmlparser.h"
+#include "benchmarkdata.h"
+#include "benchmarkmain.h"
+#include "file.h"
+
+#include <QXmlStreamReader>
+#include <QtTest>
+
+class bm_Asn1Library : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void parseAst_data();
+    void parseAst();
+};
+
+void bm_Asn1Library::parseAst_data()
+{
+    QTest::addColumn<int>("types");
+
+    QTest::newRow("100 types") << 100;
+    QTest::newRow("1000 types") << 1000;
+    QTest::newRow("10000 types") << 10000;
+}
+
+void bm_Asn1Library::parseAst()
+{
+    QFETCH(int, types);
+    const QByteArray xml = benchmark::generateAsn1Ast(types);
+
+    QBENCHMARK {
+        QXmlStreamReader reader(xml);
+        Asn1Acn::AstXmlParser parser(reader);
+        QVERIFY(parser.parse());
+        const std::map<QString, std::unique_ptr<Asn1Acn::File>> data = parser.takeData();
+        QCOMPARE(data.size(), std::size_t { 1 });
+    }
+}
+
+BENCHMARK_MAIN(bm_Asn1Library)
+
+#include "bm_asn1library.moc"
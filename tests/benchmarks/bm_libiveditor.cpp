@@ -0,0 +1,139 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "baseitems/common/ivutils.h"
+#include "benchmarkdata.h"
+#include "benchmarkmain.h"
+#include "ivconnectionchain.h"
+#include "iveditor.h"
+#include "ivexporter.h"
+#include "ivlibrary.h"
+#include "ivmodel.h"
+#include "ivobject.h"
+#include "ivxmlreader.h"
+#include "propertytemplateconfig.h"
+
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <QtTest>
+
+class bm_LibIvEditor : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void readFile_data();
+    void readFile();
+    void exportObjects_data();
+    void exportObjects();
+    void buildConnectionChains_data();
+    void buildConnectionChains();
+
+private:
+    void addSizes();
+
+    QTemporaryDir m_dir;
+    ivm::PropertyTemplateConfig *m_config = nullptr;
+};
+
+void bm_LibIvEditor::initTestCase()
+{
+    ivm::initIVLibrary();
+    ive::initIVEditor();
+    m_config = ivm::PropertyTemplateConfig::instance();
+    m_config->init(ive::dynamicPropertiesFilePath());
+    QVERIFY(m_dir.isValid());
+}
+
+void bm_LibIvEditor::addSizes()
+{
+    QTest::addColumn<int>("functions");
+
+    QTest::newRow("10 functions") << 10;
+    QTest::newRow("100 functions") << 100;
+    QTest::newRow("1000 functions") << 1000;
+}
+
+void bm_LibIvEditor::readFile_data()
+{
+    addSizes();
+}
+
+void bm_LibIvEditor::readFile()
+{
+    QFETCH(int, functions);
+    const QString fileName = benchmark::writeFile(
+            m_dir, QString("readfile_%1.xml").arg(functions), benchmark::generateInterfaceView(functions));
+
+    QBENCHMARK {
+        ivm::IVXMLReader parser;
+        QVERIFY(parser.readFile(fileName));
+        // Nested objects are deleted by their parents
+        for (ivm::IVObject *object : parser.parsedObjects()) {
+            if (!object->parent()) {
+                delete object;
+            }
+        }
+    }
+}
+
+void bm_LibIvEditor::exportObjects_data()
+{
+    addSizes();
+}
+
+void bm_LibIvEditor::exportObjects()
+{
+    QFETCH(int, functions);
+    ivm::IVXMLReader parser;
+    QVERIFY(parser.read(benchmark::generateInterfaceView(functions)));
+    ivm::IVModel model(m_config);
+    model.initFromObjects(parser.parsedObjects());
+    const QList<ivm::IVObject *> objects = parser.parsedObjects().toList();
+    ive::IVExporter exporter;
+
+    QBENCHMARK {
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QVERIFY(exporter.exportObjects(objects, &buffer));
+    }
+}
+
+void bm_LibIvEditor::buildConnectionChains_data()
+{
+    addSizes();
+}
+
+void bm_LibIvEditor::buildConnectionChains()
+{
+    QFETCH(int, functions);
+    ivm::IVXMLReader parser;
+    QVERIFY(parser.read(benchmark::generateInterfaceView(functions)));
+    ivm::IVModel model(m_config);
+    model.initFromObjects(parser.parsedObjects());
+
+    QBENCHMARK {
+        const QList<ivm::IVConnectionChain *> chains = ivm::IVConnectionChain::build(model);
+        QVERIFY(!chains.isEmpty());
+        qDeleteAll(chains);
+    }
+}
+
+BENCHMARK_MAIN(bm_LibIvEditor)
+
+#include "bm_libiveditor.moc"
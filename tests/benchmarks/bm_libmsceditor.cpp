@@ -0,0 +1,192 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "benchmarkdata.h"
+#include "benchmarkmain.h"
+#include "chartlayoutmanager.h"
+#include "mscchart.h"
+#include "msccommandsstack.h"
+#include "msclibrary.h"
+#include "mscmodel.h"
+#include "mscreader.h"
+#include "mscwriter.h"
+#include "sharedlibrary.h"
+
+#include <QGraphicsView>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <memory>
+
+class bm_LibMscEditor : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void parseFile_data();
+    void parseFile();
+    void modelText_data();
+    void modelText();
+    void layoutChart_data();
+    void layoutChart();
+    void relayoutChart_data();
+    void relayoutChart();
+
+private:
+    void addDocumentSizes();
+    void addChartSizes();
+    std::unique_ptr<msc::MscModel> parseText(const QString &text);
+
+    QTemporaryDir m_dir;
+};
+
+void bm_LibMscEditor::initTestCase()
+{
+    shared::initSharedLibrary();
+    msc::initMscLibrary();
+    QVERIFY(m_dir.isValid());
+}
+
+/*!
+   Sizes of whole documents, for the benchmarks of the reader and the writer
+ */
+void bm_LibMscEditor::addDocumentSizes()
+{
+    QTest::addColumn<int>("charts");
+    QTest::addColumn<int>("instances");
+    QTest::addColumn<int>("messages");
+
+    QTest::newRow("1 chart 100 messages") << 1 << 5 << 100;
+    QTest::newRow("1 chart 1000 messages") << 1 << 10 << 1000;
+    QTest::newRow("10 charts 1000 messages") << 10 << 10 << 1000;
+}
+
+/*!
+   Sizes of a single chart, for the benchmarks of the layout
+ */
+void bm_LibMscEditor::addChartSizes()
+{
+    QTest::addColumn<int>("instances");
+    QTest::addColumn<int>("messages");
+
+    QTest::newRow("5 instances 50 messages") << 5 << 50;
+    QTest::newRow("10 instances 200 messages") << 10 << 200;
+    QTest::newRow("20 instances 500 messages") << 20 << 500;
+}
+
+std::unique_ptr<msc::MscModel> bm_LibMscEditor::parseText(const QString &text)
+{
+    msc::MscReader reader;
+    return std::unique_ptr<msc::MscModel>(reader.parseText(text));
+}
+
+void bm_LibMscEditor::parseFile_data()
+{
+    addDocumentSizes();
+}
+
+void bm_LibMscEditor::parseFile()
+{
+    QFETCH(int, charts);
+    QFETCH(int, instances);
+    QFETCH(int, messages);
+    const QString name = QString("%1_%2_%3.msc").arg(charts).arg(instances).arg(messages);
+    const QString fileName =
+            benchmark::writeFile(m_dir, name, benchmark::generateMscDocument(charts, instances, messages).toUtf8());
+
+    QBENCHMARK {
+        msc::MscReader reader;
+        std::unique_ptr<msc::MscModel> model(reader.parseFile(fileName));
+        QCOMPARE(model->allCharts().size(), charts);
+    }
+}
+
+void bm_LibMscEditor::modelText_data()
+{
+    addDocumentSizes();
+}
+
+void bm_LibMscEditor::modelText()
+{
+    QFETCH(int, charts);
+    QFETCH(int, instances);
+    QFETCH(int, messages);
+    std::unique_ptr<msc::MscModel> model = parseText(benchmark::generateMscDocument(charts, instances, messages));
+    QVERIFY(model);
+
+    QBENCHMARK {
+        msc::MscWriter writer;
+        QVERIFY(!writer.modelText(model.get()).isEmpty());
+    }
+}
+
+void bm_LibMscEditor::layoutChart_data()
+{
+    addChartSizes();
+}
+
+/*!
+   Measures showing a chart, which creates all items and lays them out
+ */
+void bm_LibMscEditor::layoutChart()
+{
+    QFETCH(int, instances);
+    QFETCH(int, messages);
+    std::unique_ptr<msc::MscModel> model = parseText(benchmark::generateMscDocument(1, instances, messages));
+    QVERIFY(model);
+    msc::MscChart *chart = model->allCharts().first();
+
+    msc::MscCommandsStack undoStack;
+    msc::ChartLayoutManager layoutManager(&undoStack);
+    QGraphicsView view;
+    view.setScene(layoutManager.graphicsScene());
+
+    QBENCHMARK {
+        layoutManager.setCurrentChart(chart);
+        layoutManager.setCurrentChart(nullptr);
+    }
+}
+
+void bm_LibMscEditor::relayoutChart_data()
+{
+    addChartSizes();
+}
+
+/*!
+   Measures updating the layout of a chart that is shown already
+ */
+void bm_LibMscEditor::relayoutChart()
+{
+    QFETCH(int, instances);
+    QFETCH(int, messages);
+    std::unique_ptr<msc::MscModel> model = parseText(benchmark::generateMscDocument(1, instances, messages));
+    QVERIFY(model);
+
+    msc::MscCommandsStack undoStack;
+    msc::ChartLayoutManager layoutManager(&undoStack);
+    QGraphicsView view;
+    view.setScene(layoutManager.graphicsScene());
+    layoutManager.setCurrentChart(model->allCharts().first());
+
+    QBENCHMARK {
+        layoutManager.doLayout();
+    }
+}
+
+BENCHMARK_MAIN(bm_LibMscEditor)
+
+#include "bm_libmsceditor.moc"
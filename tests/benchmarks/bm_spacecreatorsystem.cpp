@@ -0,0 +1,95 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "baseitems/common/ivutils.h"
+#include "benchmarkdata.h"
+#include "benchmarkmain.h"
+#include "iveditor.h"
+#include "ivlibrary.h"
+#include "ivmodel.h"
+#include "ivsystemchecks.h"
+#include "ivxmlreader.h"
+#include "msclibrary.h"
+#include "mscmodel.h"
+#include "mscreader.h"
+#include "propertytemplateconfig.h"
+#include "sharedlibrary.h"
+
+#include <QtTest>
+#include <memory>
+
+class bm_SpaceCreatorSystem : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void checkMessages_data();
+    void checkMessages();
+};
+
+void bm_SpaceCreatorSystem::initTestCase()
+{
+    shared::initSharedLibrary();
+    ivm::initIVLibrary();
+    ive::initIVEditor();
+    msc::initMscLibrary();
+    ivm::PropertyTemplateConfig::instance()->init(ive::dynamicPropertiesFilePath());
+}
+
+void bm_SpaceCreatorSystem::checkMessages_data()
+{
+    QTest::addColumn<int>("functions");
+    QTest::addColumn<int>("charts");
+    QTest::addColumn<int>("messages");
+
+    QTest::newRow("10 functions 1 chart 100 messages") << 10 << 1 << 100;
+    QTest::newRow("50 functions 10 charts 1000 messages") << 50 << 10 << 1000;
+    QTest::newRow("200 functions 10 charts 5000 messages") << 200 << 10 << 5000;
+}
+
+/*!
+   Checks charts that conform to the interface view, so every message has to be looked up completely
+ */
+void bm_SpaceCreatorSystem::checkMessages()
+{
+    QFETCH(int, functions);
+    QFETCH(int, charts);
+    QFETCH(int, messages);
+
+    ivm::IVXMLReader parser;
+    QVERIFY(parser.read(benchmark::generateInterfaceView(functions)));
+    ivm::IVModel ivModel(ivm::PropertyTemplateConfig::instance());
+    ivModel.initFromObjects(parser.parsedObjects());
+
+    msc::MscReader reader;
+    std::unique_ptr<msc::MscModel> mscModel(
+            reader.parseText(benchmark::generateMscDocument(charts, functions, messages)));
+    QVERIFY(mscModel);
+
+    scs::IvSystemChecks checker;
+    checker.setIvModel(&ivModel);
+    checker.setMscModel(mscModel.get());
+
+    QBENCHMARK {
+        QVERIFY(checker.checkMessages().isEmpty());
+    }
+}
+
+BENCHMARK_MAIN(bm_SpaceCreatorSystem)
+
+#include "bm_spacecreatorsystem.moc"
@@ -0,0 +1,131 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "benchmarkdata.h"
+#include "dvappmodel.h"
+#include "dveditor.h"
+#include "dvexporter.h"
+#include "dvmodel.h"
+#include "dvobject.h"
+#include "scalingbudget.h"
+#include "sharedlibrary.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QHash>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <memory>
+
+/*!
+   Performance budgets of opening, saving and closing deployment views with up to 4000 nodes
+ */
+class tstp_DvDocument : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testOpen();
+    void testSave();
+    void testClose();
+
+private:
+    QString documentFile(int nodes);
+    std::unique_ptr<dve::DVAppModel> openDocument(const QString &fileName);
+
+    QTemporaryDir m_dir;
+    QString m_templateFile;
+    QHash<int, QString> m_documentFiles;
+};
+
+/// Number of nodes of the smaller document. The larger one has 4 times as many
+static const int kNodes = 1000;
+
+void tstp_DvDocument::initTestCase()
+{
+    shared::initSharedLibrary();
+    dve::initDvEditor();
+    QVERIFY(m_dir.isValid());
+
+    /// The export uses the default template shipped with the editor
+    m_templateFile = m_dir.filePath(QLatin1String("deploymentview.tmplt"));
+    QVERIFY(QFile::copy(QLatin1String(":/defaults/templating/xml_templates/deploymentview.tmplt"), m_templateFile));
+}
+
+QString tstp_DvDocument::documentFile(int nodes)
+{
+    if (!m_documentFiles.contains(nodes)) {
+        m_documentFiles.insert(nodes,
+                benchmark::writeFile(
+                        m_dir, QString("nodes_%1.dv.xml").arg(nodes), benchmark::generateDeploymentView(nodes)));
+    }
+    return m_documentFiles.value(nodes);
+}
+
+std::unique_ptr<dve::DVAppModel> tstp_DvDocument::openDocument(const QString &fileName)
+{
+    auto model = std::make_unique<dve::DVAppModel>();
+    if (!model->load(fileName)) {
+        qWarning("Unable to load %s", qPrintable(fileName));
+    }
+    return model;
+}
+
+void tstp_DvDocument::testOpen()
+{
+    const benchmark::Scenario scenario = [this](int nodes) {
+        const QString fileName = documentFile(nodes);
+        auto model = std::make_unique<dve::DVAppModel>();
+        return benchmark::elapsed([&]() { QVERIFY(model->load(fileName)); });
+    };
+    SC_VERIFY_SCALING(scenario, kNodes);
+}
+
+void tstp_DvDocument::testSave()
+{
+    const benchmark::Scenario scenario = [this](int nodes) {
+        std::unique_ptr<dve::DVAppModel> model = openDocument(documentFile(nodes));
+        QList<dvm::DVObject *> objects;
+        for (shared::VEObject *object : model->objectsModel()->objects()) {
+            if (auto dvObject = qobject_cast<dvm::DVObject *>(object)) {
+                objects.append(dvObject);
+            }
+        }
+
+        dve::DVExporter exporter;
+        return benchmark::elapsed([&]() {
+            QBuffer buffer;
+            QVERIFY(buffer.open(QIODevice::WriteOnly));
+            QVERIFY(exporter.exportObjects(objects, &buffer, m_templateFile));
+        });
+    };
+    SC_VERIFY_SCALING(scenario, kNodes);
+}
+
+void tstp_DvDocument::testClose()
+{
+    const benchmark::Scenario scenario = [this](int nodes) {
+        std::unique_ptr<dve::DVAppModel> model = openDocument(documentFile(nodes));
+        return benchmark::elapsed([&]() { model->close(); });
+    };
+    SC_VERIFY_SCALING(scenario, kNodes);
+}
+
+QTEST_MAIN(tstp_DvDocument)
+
+#include "tstp_dvdocument.moc"
@@ -0,0 +1,182 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "benchmarkdata.h"
+#include "commandsstack.h"
+#include "interface/commands/cmdentityattributechange.h"
+#include "interface/interfacedocument.h"
+#include "iveditor.h"
+#include "ivexporter.h"
+#include "ivfunction.h"
+#include "ivlibrary.h"
+#include "ivmodel.h"
+#include "propertytemplateconfig.h"
+#include "scalingbudget.h"
+#include "sharedlibrary.h"
+
+#include <QHash>
+#include <QTemporaryDir>
+#include <QUndoStack>
+#include <QtTest>
+#include <memory>
+
+/*!
+   Performance budgets of opening, editing, saving and closing interface views with up to 10000 functions
+ */
+class tstp_IvDocument : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testOpen();
+    void testOpenNested();
+    void testEdit();
+    void testSave();
+    void testClose();
+
+private:
+    QString documentFile(int functions);
+    QString nestedDocumentFile(int depth);
+    std::unique_ptr<ive::InterfaceDocument> openDocument(const QString &fileName);
+
+    QTemporaryDir m_dir;
+    QHash<int, QString> m_documentFiles;
+    QHash<int, QString> m_nestedDocumentFiles;
+};
+
+/// Number of functions of the smaller document. The larger one has 4 times as many
+static const int kFunctions = 2500;
+/// Nesting depth of the smaller nested document
+static const int kDepth = 50;
+/// Number of renamed functions in the edit scenario
+static const int kEdits = 50;
+
+void tstp_IvDocument::initTestCase()
+{
+    shared::initSharedLibrary();
+    ivm::initIVLibrary();
+    ive::initIVEditor();
+    ivm::PropertyTemplateConfig::instance()->init(ive::dynamicPropertiesFilePath());
+    QVERIFY(m_dir.isValid());
+}
+
+QString tstp_IvDocument::documentFile(int functions)
+{
+    if (!m_documentFiles.contains(functions)) {
+        m_documentFiles.insert(functions,
+                benchmark::writeFile(m_dir, QString("functions_%1.xml").arg(functions),
+                        benchmark::generateInterfaceView(functions)));
+    }
+    return m_documentFiles.value(functions);
+}
+
+QString tstp_IvDocument::nestedDocumentFile(int depth)
+{
+    if (!m_nestedDocumentFiles.contains(depth)) {
+        m_nestedDocumentFiles.insert(depth,
+                benchmark::writeFile(
+                        m_dir, QString("nested_%1.xml").arg(depth), benchmark::generateNestedInterfaceView(depth)));
+    }
+    return m_nestedDocumentFiles.value(depth);
+}
+
+std::unique_ptr<ive::InterfaceDocument> tstp_IvDocument::openDocument(const QString &fileName)
+{
+    auto document = std::make_unique<ive::InterfaceDocument>();
+    document->init();
+    if (!document->load(fileName)) {
+        qWarning("Unable to load %s", qPrintable(fileName));
+    }
+    return document;
+}
+
+/*!
+   Loading includes reading the file, building the model and creating all items of the scene
+ */
+void tstp_IvDocument::testOpen()
+{
+    const benchmark::Scenario scenario = [this](int functions) {
+        const QString fileName = documentFile(functions);
+        auto document = std::make_unique<ive::InterfaceDocument>();
+        document->init();
+        return benchmark::elapsed([&]() { QVERIFY(document->load(fileName)); });
+    };
+    SC_VERIFY_SCALING(scenario, kFunctions);
+}
+
+void tstp_IvDocument::testOpenNested()
+{
+    const benchmark::Scenario scenario = [this](int depth) {
+        const QString fileName = nestedDocumentFile(depth);
+        auto document = std::make_unique<ive::InterfaceDocument>();
+        document->init();
+        return benchmark::elapsed([&]() { QVERIFY(document->load(fileName)); });
+    };
+    SC_VERIFY_SCALING(scenario, kDepth);
+}
+
+/*!
+   Renames some functions and undoes it again. The cost of one edit may grow with the document, but not faster
+ */
+void tstp_IvDocument::testEdit()
+{
+    const benchmark::Scenario scenario = [this](int functions) {
+        std::unique_ptr<ive::InterfaceDocument> document = openDocument(documentFile(functions));
+        QVector<ivm::IVFunction *> editedFunctions;
+        for (int idx = 0; idx < kEdits; ++idx) {
+            editedFunctions.append(document->objectsModel()->getFunction(
+                    benchmark::functionName(idx * functions / kEdits), Qt::CaseSensitive));
+        }
+
+        return benchmark::elapsed([&]() {
+            for (ivm::IVFunction *function : qAsConst(editedFunctions)) {
+                const QVariantHash attributes = { { ivm::meta::Props::token(ivm::meta::Props::Token::name),
+                        function->title() + QLatin1String("_renamed") } };
+                document->commandsStack()->push(new ive::cmd::CmdEntityAttributeChange(function, attributes));
+            }
+            while (document->undoStack()->canUndo()) {
+                document->undoStack()->undo();
+            }
+        });
+    };
+    SC_VERIFY_SCALING(scenario, kFunctions);
+}
+
+void tstp_IvDocument::testSave()
+{
+    const benchmark::Scenario scenario = [this](int functions) {
+        std::unique_ptr<ive::InterfaceDocument> document = openDocument(documentFile(functions));
+        const QString outFileName = m_dir.filePath(QString("saved_%1.xml").arg(functions));
+        return benchmark::elapsed(
+                [&]() { QVERIFY(document->exporter()->exportDocSilently(document.get(), outFileName)); });
+    };
+    SC_VERIFY_SCALING(scenario, kFunctions);
+}
+
+void tstp_IvDocument::testClose()
+{
+    const benchmark::Scenario scenario = [this](int functions) {
+        std::unique_ptr<ive::InterfaceDocument> document = openDocument(documentFile(functions));
+        return benchmark::elapsed([&]() { document->close(); });
+    };
+    SC_VERIFY_SCALING(scenario, kFunctions);
+}
+
+QTEST_MAIN(tstp_IvDocument)
+
+#include "tstp_ivdocument.moc"
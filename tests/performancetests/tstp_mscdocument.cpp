@@ -0,0 +1,209 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "benchmarkdata.h"
+#include "chartlayoutmanager.h"
+#include "commands/cmdentitynamechange.h"
+#include "mainmodel.h"
+#include "mscchart.h"
+#include "msccommandsstack.h"
+#include "msclibrary.h"
+#include "mscmessage.h"
+#include "mscmodel.h"
+#include "scalingbudget.h"
+#include "sharedlibrary.h"
+
+#include <QHash>
+#include <QTemporaryDir>
+#include <QUndoStack>
+#include <QtTest>
+#include <memory>
+
+/*!
+   Performance budgets of opening, editing, saving and closing MSC documents with up to 100000 messages
+ */
+class tstp_MscDocument : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testOpen();
+    void testChartLayout();
+    void testEdit();
+    void testSave();
+    void testClose();
+
+private:
+    QString documentFile(int messages);
+    QString chartFile(int messages);
+    std::unique_ptr<msc::MainModel> openDocument(const QString &fileName);
+    static void finishLayout(msc::MainModel *model);
+
+    QTemporaryDir m_dir;
+    QHash<QString, QString> m_files;
+};
+
+/// Number of messages of the smaller document. The larger one has 4 times as many
+static const int kMessages = 25000;
+/// Number of messages in the chart of the smaller single chart document
+static const int kChartMessages = 1000;
+/// Documents are split in charts of this many messages
+static const int kMessagesPerChart = 2500;
+static const int kInstances = 10;
+/// Number of renamed messages in the edit scenario
+static const int kEdits = 20;
+
+void tstp_MscDocument::initTestCase()
+{
+    shared::initSharedLibrary();
+    msc::initMscLibrary();
+    QVERIFY(m_dir.isValid());
+}
+
+/*!
+   Returns a document with \p messages messages, split in several charts
+ */
+QString tstp_MscDocument::documentFile(int messages)
+{
+    const QString fileName = QString("document_%1.msc").arg(messages);
+    if (!m_files.contains(fileName)) {
+        const QString text =
+                benchmark::generateMscDocument(messages / kMessagesPerChart, kInstances, kMessagesPerChart);
+        m_files.insert(fileName, benchmark::writeFile(m_dir, fileName, text.toUtf8()));
+    }
+    return m_files.value(fileName);
+}
+
+/*!
+   Returns a document with one chart of \p messages messages
+ */
+QString tstp_MscDocument::chartFile(int messages)
+{
+    const QString fileName = QString("chart_%1.msc").arg(messages);
+    if (!m_files.contains(fileName)) {
+        const QString text = benchmark::generateMscDocument(1, kInstances, messages);
+        m_files.insert(fileName, benchmark::writeFile(m_dir, fileName, text.toUtf8()));
+    }
+    return m_files.value(fileName);
+}
+
+std::unique_ptr<msc::MainModel> tstp_MscDocument::openDocument(const QString &fileName)
+{
+    auto model = std::make_unique<msc::MainModel>();
+    if (!model->loadFile(fileName)) {
+        qWarning("Unable to load %s", qPrintable(fileName));
+    }
+    finishLayout(model.get());
+    return model;
+}
+
+/*!
+   Runs a pending layout update of the shown chart right away, instead of waiting for the event loop
+ */
+void tstp_MscDocument::finishLayout(msc::MainModel *model)
+{
+    if (model->chartViewModel().layoutUpdatePending()) {
+        model->chartViewModel().doLayout();
+    }
+}
+
+/*!
+   Loading includes parsing all charts and showing the first one
+ */
+void tstp_MscDocument::testOpen()
+{
+    const benchmark::Scenario scenario = [this](int messages) {
+        const QString fileName = documentFile(messages);
+        auto model = std::make_unique<msc::MainModel>();
+        return benchmark::elapsed([&]() {
+            QVERIFY(model->loadFile(fileName));
+            finishLayout(model.get());
+        });
+    };
+    SC_VERIFY_SCALING(scenario, kMessages);
+}
+
+/*!
+   Shows one chart with many messages, which creates all items and lays them out
+ */
+void tstp_MscDocument::testChartLayout()
+{
+    const benchmark::Scenario scenario = [this](int messages) {
+        const QString fileName = chartFile(messages);
+        auto model = std::make_unique<msc::MainModel>();
+        return benchmark::elapsed([&]() {
+            QVERIFY(model->loadFile(fileName));
+            finishLayout(model.get());
+        });
+    };
+    SC_VERIFY_SCALING(scenario, kChartMessages);
+}
+
+/*!
+   Renames some messages of the shown chart and undoes it again, each followed by the layout update
+ */
+void tstp_MscDocument::testEdit()
+{
+    const benchmark::Scenario scenario = [this](int messages) {
+        std::unique_ptr<msc::MainModel> model = openDocument(chartFile(messages));
+        const QVector<msc::MscMessage *> chartMessages = model->mscModel()->allCharts().first()->messages();
+
+        return benchmark::elapsed([&]() {
+            for (int idx = 0; idx < kEdits; ++idx) {
+                msc::MscMessage *message = chartMessages.at(idx * chartMessages.size() / kEdits);
+                model->commandsStack()->push(new msc::cmd::CmdEntityNameChange(
+                        message, message->name() + QLatin1String("_renamed"), &model->chartViewModel()));
+                finishLayout(model.get());
+            }
+            while (model->undoStack()->canUndo()) {
+                model->undoStack()->undo();
+                finishLayout(model.get());
+            }
+        });
+    };
+    SC_VERIFY_SCALING(scenario, kChartMessages);
+}
+
+void tstp_MscDocument::testSave()
+{
+    const benchmark::Scenario scenario = [this](int messages) {
+        std::unique_ptr<msc::MainModel> model = openDocument(documentFile(messages));
+        const QString outFileName = m_dir.filePath(QString("saved_%1.msc").arg(messages));
+        return benchmark::elapsed([&]() { QVERIFY(model->saveMsc(outFileName)); });
+    };
+    SC_VERIFY_SCALING(scenario, kMessages);
+}
+
+/*!
+   Closing replaces the document by the initial empty one
+ */
+void tstp_MscDocument::testClose()
+{
+    const benchmark::Scenario scenario = [this](int messages) {
+        std::unique_ptr<msc::MainModel> model = openDocument(documentFile(messages));
+        return benchmark::elapsed([&]() {
+            model->initialModel();
+            finishLayout(model.get());
+        });
+    };
+    SC_VERIFY_SCALING(scenario, kMessages);
+}
+
+QTEST_MAIN(tstp_MscDocument)
+
+#include "tstp_mscdocument.moc"
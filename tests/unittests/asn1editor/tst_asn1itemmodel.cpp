@@ -20,8 +20,8 @@
 #include "sourcelocation.h"
 #include "typeassignment.h"
 #include "types/builtintypes.h"
+#include "types/userdefinedtype.h"
 
-#include <QStandardItem>
 #include <QtTest>
 #include <memory>
 
@@ -45,6 +45,10 @@ private Q_SLOTS:
     void testEnumTypeModel();
     void testChoiceTypeModel();
     void testSequenceTypeModel();
+    void testFetchOnDemand();
+    void testLargeSequenceOf();
+    void testSetValue();
+    void testOptionalCheckState();
 
 private:
     Asn1ItemModel *itemModel = nullptr;
@@ -78,9 +82,9 @@ void tst_Asn1ItemModel::testIntTypeModel()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyInt", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MyInt"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("INTEGER"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::INTEGER);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MyInt"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("INTEGER"));
+    QCOMPARE(toAsn1Type(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::INTEGER);
 }
 
 void tst_Asn1ItemModel::testRealTypeModel()
@@ -90,9 +94,9 @@ void tst_Asn1ItemModel::testRealTypeModel()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyDouble", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MyDouble"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("REAL"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::REAL);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MyDouble"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("REAL"));
+    QCOMPARE(toAsn1Type(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::REAL);
 }
 
 void tst_Asn1ItemModel::testIntTypeModelWithRange()
@@ -103,9 +107,9 @@ void tst_Asn1ItemModel::testIntTypeModelWithRange()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyInt", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MyInt"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("INTEGER (5..15)"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::INTEGER);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MyInt"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("INTEGER (5..15)"));
+    QCOMPARE(toAsn1Type(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::INTEGER);
 }
 
 void tst_Asn1ItemModel::testRealTypeModelWithRange()
@@ -116,9 +120,9 @@ void tst_Asn1ItemModel::testRealTypeModelWithRange()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyDouble", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MyDouble"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("REAL (10..50)"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::REAL);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MyDouble"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("REAL (10..50)"));
+    QCOMPARE(toAsn1Type(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::REAL);
 }
 
 void tst_Asn1ItemModel::testBoolTypeModel()
@@ -128,9 +132,9 @@ void tst_Asn1ItemModel::testBoolTypeModel()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyBool", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MyBool"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("BOOLEAN"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::BOOLEAN);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MyBool"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("BOOLEAN"));
+    QCOMPARE(toAsn1Type(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::BOOLEAN);
 }
 
 void tst_Asn1ItemModel::testEnumTypeModel()
@@ -142,10 +146,10 @@ void tst_Asn1ItemModel::testEnumTypeModel()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyEnum", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MyEnum"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("ENUMERATED"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::ENUMERATED);
-    QCOMPARE(itemModel->item(0, MODEL_VALUE_INDEX)->data(CHOICE_LIST_ROLE).toList().size(), 3);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MyEnum"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("ENUMERATED"));
+    QCOMPARE(toAsn1Type(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::ENUMERATED);
+    QCOMPARE(itemModel->index(0, MODEL_VALUE_INDEX).data(CHOICE_LIST_ROLE).toList().size(), 3);
 }
 
 void tst_Asn1ItemModel::testChoiceTypeModel()
@@ -159,20 +163,21 @@ void tst_Asn1ItemModel::testChoiceTypeModel()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyChoice", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MyChoice"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("CHOICE"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::CHOICE);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MyChoice"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("CHOICE"));
+    QCOMPARE(toAsn1Type(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)), Asn1Acn::Types::Type::CHOICE);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->rowCount(), 2);
+    const QModelIndex rootIndex = itemModel->index(0, MODEL_NAME_INDEX);
+    QCOMPARE(itemModel->childCount(rootIndex), 2);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(0)->text(), QString("choiceInt"));
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(0, MODEL_TYPE_INDEX)->text(), QString("INTEGER"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_NAME_INDEX)->child(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)),
+    QCOMPARE(itemModel->childIndex(rootIndex, 0).data().toString(), QString("choiceInt"));
+    QCOMPARE(itemModel->childIndex(rootIndex, 0, MODEL_TYPE_INDEX).data().toString(), QString("INTEGER"));
+    QCOMPARE(toAsn1Type(itemModel->childIndex(rootIndex, 0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)),
             Asn1Acn::Types::Type::INTEGER);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(1)->text(), QString("choiceReal"));
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(1, MODEL_TYPE_INDEX)->text(), QString("REAL"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_NAME_INDEX)->child(1, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)),
+    QCOMPARE(itemModel->childIndex(rootIndex, 1).data().toString(), QString("choiceReal"));
+    QCOMPARE(itemModel->childIndex(rootIndex, 1, MODEL_TYPE_INDEX).data().toString(), QString("REAL"));
+    QCOMPARE(toAsn1Type(itemModel->childIndex(rootIndex, 1, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)),
             Asn1Acn::Types::Type::REAL);
 }
 
@@ -189,28 +194,144 @@ void tst_Asn1ItemModel::testSequenceTypeModel()
     auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MySequence", location, std::move(type));
     itemModel->setAsn1Model(assignment);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->text(), QString("MySequence"));
-    QCOMPARE(itemModel->item(0, MODEL_TYPE_INDEX)->text(), QString("SEQUENCE"));
-    QVERIFY(itemModel->item(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE).isNull() == true);
+    QCOMPARE(itemModel->index(0, MODEL_NAME_INDEX).data().toString(), QString("MySequence"));
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("SEQUENCE"));
+    QVERIFY(itemModel->index(0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE).isNull() == true);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->rowCount(), 3);
+    const QModelIndex rootIndex = itemModel->index(0, MODEL_NAME_INDEX);
+    QCOMPARE(itemModel->childCount(rootIndex), 3);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(0)->text(), QString("intVal"));
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(0, MODEL_TYPE_INDEX)->text(), QString("INTEGER"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_NAME_INDEX)->child(0, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)),
+    QCOMPARE(itemModel->childIndex(rootIndex, 0).data().toString(), QString("intVal"));
+    QCOMPARE(itemModel->childIndex(rootIndex, 0, MODEL_TYPE_INDEX).data().toString(), QString("INTEGER"));
+    QCOMPARE(toAsn1Type(itemModel->childIndex(rootIndex, 0, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)),
             Asn1Acn::Types::Type::INTEGER);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(1)->text(), QString("realVal"));
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(1, MODEL_TYPE_INDEX)->text(), QString("REAL"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_NAME_INDEX)->child(1, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)),
+    QCOMPARE(itemModel->childIndex(rootIndex, 1).data().toString(), QString("realVal"));
+    QCOMPARE(itemModel->childIndex(rootIndex, 1, MODEL_TYPE_INDEX).data().toString(), QString("REAL"));
+    QCOMPARE(toAsn1Type(itemModel->childIndex(rootIndex, 1, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)),
             Asn1Acn::Types::Type::REAL);
 
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(2)->text(), QString("boolVal"));
-    QCOMPARE(itemModel->item(0, MODEL_NAME_INDEX)->child(2, MODEL_TYPE_INDEX)->text(), QString("BOOLEAN"));
-    QCOMPARE(toAsn1Type(itemModel->item(0, MODEL_NAME_INDEX)->child(2, MODEL_VALUE_INDEX)->data(ASN1TYPE_ROLE)),
+    QCOMPARE(itemModel->childIndex(rootIndex, 2).data().toString(), QString("boolVal"));
+    QCOMPARE(itemModel->childIndex(rootIndex, 2, MODEL_TYPE_INDEX).data().toString(), QString("BOOLEAN"));
+    QCOMPARE(toAsn1Type(itemModel->childIndex(rootIndex, 2, MODEL_VALUE_INDEX).data(ASN1TYPE_ROLE)),
             Asn1Acn::Types::Type::BOOLEAN);
 }
 
+void tst_Asn1ItemModel::testFetchOnDemand()
+{
+    Asn1Acn::SourceLocation location;
+    auto inner = std::make_unique<Asn1Acn::Types::Sequence>("inner");
+    inner->addChild(std::make_unique<Asn1Acn::Types::Integer>("iVal"));
+    auto type = std::make_unique<Asn1Acn::Types::Sequence>();
+    type->addChild(std::make_unique<Asn1Acn::Types::Boolean>("boolVal"));
+    type->addChild(std::move(inner));
+    auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MySequence", location, std::move(type));
+    itemModel->setAsn1Model(assignment);
+
+    const QModelIndex rootIndex = itemModel->index(0, MODEL_NAME_INDEX);
+    QVERIFY(itemModel->hasChildren(rootIndex));
+    QCOMPARE(itemModel->rowCount(rootIndex), 0);
+    QVERIFY(itemModel->canFetchMore(rootIndex));
+    QVERIFY(!itemModel->canFetchMore(itemModel->index(0, MODEL_VALUE_INDEX)));
+
+    QSignalSpy spy(itemModel, &QAbstractItemModel::rowsInserted);
+    itemModel->fetchMore(rootIndex);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(itemModel->rowCount(rootIndex), 2);
+    QVERIFY(!itemModel->canFetchMore(rootIndex));
+
+    const QModelIndex boolIndex = itemModel->index(0, MODEL_NAME_INDEX, rootIndex);
+    QVERIFY(!itemModel->hasChildren(boolIndex));
+    QVERIFY(!itemModel->canFetchMore(boolIndex));
+
+    const QModelIndex innerIndex = itemModel->index(1, MODEL_NAME_INDEX, rootIndex);
+    QCOMPARE(innerIndex.data().toString(), QString("inner"));
+    QCOMPARE(innerIndex.parent(), rootIndex);
+    QCOMPARE(itemModel->rowCount(innerIndex), 0);
+    QCOMPARE(itemModel->childCount(innerIndex), 1);
+    QCOMPARE(itemModel->childIndex(innerIndex, 0).data().toString(), QString("iVal"));
+    QCOMPARE(itemModel->rowCount(innerIndex), 1);
+    QCOMPARE(spy.count(), 2);
+}
+
+void tst_Asn1ItemModel::testLargeSequenceOf()
+{
+    const int count = 100000;
+    Asn1Acn::SourceLocation location;
+    auto elementType = std::make_unique<Asn1Acn::Types::Sequence>();
+    elementType->addChild(std::make_unique<Asn1Acn::Types::Integer>("intVal"));
+    auto elementAssignment =
+            std::make_unique<Asn1Acn::TypeAssignment>("MyElement", location, std::move(elementType));
+
+    auto type = std::make_unique<Asn1Acn::Types::SequenceOf>();
+    type->setParameters({ { "min", 1 }, { "max", count } });
+    type->addChild(std::make_unique<Asn1Acn::Types::UserdefinedType>("MyElement", "", elementAssignment.get()));
+    auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyList", location, std::move(type));
+    itemModel->setAsn1Model(assignment);
+
+    const QModelIndex rootIndex = itemModel->index(0, MODEL_NAME_INDEX);
+    QCOMPARE(itemModel->index(0, MODEL_TYPE_INDEX).data().toString(), QString("SEQUENCE OF Size(1..100000)"));
+    QCOMPARE(itemModel->index(0, MODEL_VALUE_INDEX).data().toString(), QString("1"));
+    QCOMPARE(itemModel->childCount(rootIndex), count);
+
+    const QModelIndex lastIndex = itemModel->childIndex(rootIndex, count - 1);
+    QCOMPARE(itemModel->rowCount(rootIndex), count);
+    QCOMPARE(lastIndex.data().toString(), QString("elem%1").arg(count));
+    QCOMPARE(lastIndex.sibling(lastIndex.row(), MODEL_TYPE_INDEX).data().toString(), QString("SEQUENCE"));
+    // The elements themselves are not expanded
+    QCOMPARE(itemModel->rowCount(lastIndex), 0);
+    QCOMPARE(itemModel->childCount(lastIndex), 1);
+}
+
+void tst_Asn1ItemModel::testSetValue()
+{
+    Asn1Acn::SourceLocation location;
+    auto type = std::make_unique<Asn1Acn::Types::Integer>();
+    type->setParameters({ { "min", 5 }, { "max", 15 } });
+    auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MyInt", location, std::move(type));
+    itemModel->setAsn1Model(assignment);
+
+    const QModelIndex valueIndex = itemModel->index(0, MODEL_VALUE_INDEX);
+    QCOMPARE(valueIndex.data().toString(), QString("5"));
+    QVERIFY(itemModel->flags(valueIndex).testFlag(Qt::ItemIsEditable));
+    QVERIFY(!itemModel->flags(itemModel->index(0, MODEL_NAME_INDEX)).testFlag(Qt::ItemIsEditable));
+
+    QSignalSpy spy(itemModel, &QAbstractItemModel::dataChanged);
+    QVERIFY(itemModel->setData(valueIndex, QString("12")));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(valueIndex.data().toString(), QString("12"));
+    QCOMPARE(valueIndex.data(MAX_RANGE_ROLE).toInt(), 15);
+    QVERIFY(!itemModel->setData(itemModel->index(0, MODEL_NAME_INDEX), QString("Other")));
+
+    itemModel->setAsn1Model(assignment);
+    QCOMPARE(itemModel->index(0, MODEL_VALUE_INDEX).data().toString(), QString("5"));
+}
+
+void tst_Asn1ItemModel::testOptionalCheckState()
+{
+    Asn1Acn::SourceLocation location;
+    auto type = std::make_unique<Asn1Acn::Types::Sequence>();
+    auto optional = std::make_unique<Asn1Acn::Types::Integer>("optVal");
+    optional->setParameters({ { "isOptional", true } });
+    type->addChild(std::move(optional));
+    type->addChild(std::make_unique<Asn1Acn::Types::Integer>("intVal"));
+    auto assignment = std::make_unique<Asn1Acn::TypeAssignment>("MySequence", location, std::move(type));
+    itemModel->setAsn1Model(assignment);
+
+    const QModelIndex rootIndex = itemModel->index(0, MODEL_NAME_INDEX);
+    const QModelIndex optionalIndex = itemModel->childIndex(rootIndex, 0, MODEL_IS_OPTIONAL_INDEX);
+    QVERIFY(optionalIndex.data(OPTIONAL_ROLE).toBool());
+    QVERIFY(itemModel->flags(optionalIndex).testFlag(Qt::ItemIsUserCheckable));
+    QCOMPARE(optionalIndex.data(Qt::CheckStateRole).toInt(), int(Qt::Unchecked));
+    QVERIFY(itemModel->setData(optionalIndex, Qt::Checked, Qt::CheckStateRole));
+    QCOMPARE(optionalIndex.data(Qt::CheckStateRole).toInt(), int(Qt::Checked));
+
+    const QModelIndex mandatoryIndex = itemModel->childIndex(rootIndex, 1, MODEL_IS_OPTIONAL_INDEX);
+    QVERIFY(!mandatoryIndex.data(OPTIONAL_ROLE).toBool());
+    QVERIFY(!itemModel->flags(mandatoryIndex).testFlag(Qt::ItemIsEnabled));
+    QVERIFY(!mandatoryIndex.data(Qt::CheckStateRole).isValid());
+}
+
 QTEST_APPLESS_MAIN(tst_Asn1ItemModel)
 
 #include "tst_asn1itemmodel.moc"
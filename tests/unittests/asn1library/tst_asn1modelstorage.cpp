@@ -0,0 +1,366 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "asn1modelstorage.h"
+#include "definitions.h"
+#include "file.h"
+
+#include <QCryptographicHash>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QUuid>
+#include <QtTest>
+
+using namespace Asn1Acn;
+
+/*!
+   The asn1scc compiler is not needed: the test puts the xml of all files into the asn1 cache beforehand.
+   Files not in the cache are compiled by a shell script standing in for asn1scc.
+ */
+class tst_Asn1ModelStorage : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void testPrefetch();
+    void testAsyncAccess();
+    void testSyncAccessWhileLoading();
+    void testReloadDependents();
+    void testSingleDependentAfterChange();
+    void testSingleFileDoesNotWaitForCompiler();
+    void testSyncAccessWhileParsing();
+
+private:
+    static QByteArray hash(const QByteArray &data);
+    static bool writeFile(const QString &fileName, const QByteArray &content);
+    QByteArray moduleContent(const QString &module, const QString &importedModule = QString()) const;
+    bool writeCachedXml(const QByteArray &cacheKey, const QString &fileName, const QString &module,
+            const QString &importedModule = QString()) const;
+    QString writeUncachedFile(const QString &module) const;
+    bool setCompilerStub(const QString &commands) const;
+
+    QScopedPointer<QTemporaryDir> m_dir;
+    QString m_fileA;
+    QString m_fileB;
+    QString m_fileC;
+    QString m_uuid;
+};
+
+QByteArray tst_Asn1ModelStorage::hash(const QByteArray &data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+}
+
+bool tst_Asn1ModelStorage::writeFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(content) == content.size();
+}
+
+QByteArray tst_Asn1ModelStorage::moduleContent(const QString &module, const QString &importedModule) const
+{
+    QString content = QString("-- %1\n%2 DEFINITIONS ::= BEGIN\n").arg(m_uuid, module);
+    if (!importedModule.isEmpty()) {
+        content += QString("IMPORTS Type%1 FROM %1;\n").arg(importedModule);
+    }
+    return (content + QString("Type%1 ::= INTEGER\nEND\n").arg(module)).toUtf8();
+}
+
+/*!
+   Stores the xml asn1scc would generate for \p fileName as cached xml for \p cacheKey
+ */
+bool tst_Asn1ModelStorage::writeCachedXml(const QByteArray &cacheKey, const QString &fileName, const QString &module,
+        const QString &importedModule) const
+{
+    QString imports;
+    if (!importedModule.isEmpty()) {
+        imports = QString("<ImportedModules><ImportedModule ID=\"%1\"><ImportedTypes>"
+                          "<ImportedType Name=\"Type%1\" /></ImportedTypes></ImportedModule></ImportedModules>")
+                          .arg(importedModule);
+    }
+    const QString xml = QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ASN1AST><Asn1File FileName=\"%1\">"
+                                "<Asn1Module ID=\"%2\">%3<TypeAssignments>"
+                                "<TypeAssignment Name=\"Type%2\" Line=\"3\" CharPositionInLine=\"0\">"
+                                "<Type Line=\"3\" CharPositionInLine=\"10\"><IntegerType Min=\"0\" Max=\"10\" /></Type>"
+                                "</TypeAssignment></TypeAssignments></Asn1Module></Asn1File></ASN1AST>\n")
+                                .arg(fileName, module, imports);
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/asn/";
+    return QDir().mkpath(cacheDir) && writeFile(cacheDir + cacheKey + ".xml", xml.toUtf8());
+}
+
+/*!
+   Writes the file \p module.asn with content not in the cache yet and the xml asn1scc would generate for it as
+   \p module.xml
+ */
+QString tst_Asn1ModelStorage::writeUncachedFile(const QString &module) const
+{
+    const QString fileName = m_dir->filePath(module + ".asn");
+    const QString xml = QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ASN1AST><Asn1File FileName=\"%1\">"
+                                "<Asn1Module ID=\"%2\"><TypeAssignments>"
+                                "<TypeAssignment Name=\"Type%2\" Line=\"3\" CharPositionInLine=\"0\">"
+                                "<Type Line=\"3\" CharPositionInLine=\"10\"><IntegerType Min=\"0\" Max=\"10\" /></Type>"
+                                "</TypeAssignment></TypeAssignments></Asn1Module></Asn1File></ASN1AST>\n")
+                                .arg(fileName, module);
+    if (!writeFile(fileName, moduleContent(module))
+            || !writeFile(m_dir->filePath(module + ".xml"), xml.toUtf8())) {
+        return {};
+    }
+    return fileName;
+}
+
+/*!
+   Sets a shell script running \p commands as asn1 compiler. It gets the xml output file as $1 followed by the asn.1
+   files.
+ */
+bool tst_Asn1ModelStorage::setCompilerStub(const QString &commands) const
+{
+    const QString scriptName = m_dir->filePath("asn1scc_stub.sh");
+    if (!writeFile(scriptName, QString("#!/bin/sh\n%1\n").arg(commands).toUtf8())) {
+        return false;
+    }
+    QSettings settings;
+    settings.setValue("SpaceCreator/asn1compiler", "/bin/sh");
+    settings.setValue("SpaceCreator/asn1compilerparameter", scriptName + " ");
+    return true;
+}
+
+void tst_Asn1ModelStorage::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+/*!
+   Creates the files a.asn, b.asn importing from a.asn and the independent c.asn
+ */
+void tst_Asn1ModelStorage::init()
+{
+    m_dir.reset(new QTemporaryDir);
+    QVERIFY(m_dir->isValid());
+    m_uuid = QUuid::createUuid().toString();
+    m_fileA = m_dir->filePath("a.asn");
+    m_fileB = m_dir->filePath("b.asn");
+    m_fileC = m_dir->filePath("c.asn");
+
+    const QByteArray contentA = moduleContent("ModuleA");
+    const QByteArray contentB = moduleContent("ModuleB", "ModuleA");
+    const QByteArray contentC = moduleContent("ModuleC");
+    QVERIFY(writeFile(m_fileA, contentA));
+    QVERIFY(writeFile(m_fileB, contentB));
+    QVERIFY(writeFile(m_fileC, contentC));
+
+    QVERIFY(writeCachedXml(hash(contentA), m_fileA, "ModuleA"));
+    QVERIFY(writeCachedXml(hash(contentC), m_fileC, "ModuleC"));
+    /// Files loaded together with the file they import from are cached using both contents
+    QVERIFY(writeCachedXml(hash(hash(contentB) + hash(contentA)), m_fileB, "ModuleB", "ModuleA"));
+}
+
+void tst_Asn1ModelStorage::cleanup()
+{
+    QSettings settings;
+    settings.remove("SpaceCreator/asn1compiler");
+    settings.remove("SpaceCreator/asn1compilerparameter");
+}
+
+void tst_Asn1ModelStorage::testPrefetch()
+{
+    Asn1ModelStorage storage;
+    QSignalSpy changedSpy(&storage, &Asn1ModelStorage::dataTypesChanged);
+    QSignalSpy errorSpy(&storage, &Asn1ModelStorage::error);
+
+    storage.prefetch({ m_fileA, m_fileB, m_fileC });
+    QVERIFY(storage.isLoading());
+    QTRY_VERIFY_WITH_TIMEOUT(!storage.isLoading(), 10000);
+
+    QCOMPARE(errorSpy.count(), 0);
+    /// One signal for the whole batch
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().first().toStringList(), (QStringList { m_fileA, m_fileB, m_fileC }));
+    QVERIFY(storage.contains(m_fileA));
+    QVERIFY(storage.contains(m_fileB));
+    QVERIFY(storage.contains(m_fileC));
+    QSharedPointer<File> fileB = storage.asn1DataTypes(m_fileB);
+    QVERIFY(fileB);
+    QVERIFY(fileB->definitions("ModuleB"));
+    QCOMPARE(fileB->definitions("ModuleB")->importedTypes().size(), size_t(1));
+
+    /// Loaded files are not loaded again
+    storage.prefetch({ m_fileA });
+    QVERIFY(!storage.isLoading());
+}
+
+void tst_Asn1ModelStorage::testAsyncAccess()
+{
+    Asn1ModelStorage storage;
+    QFuture<QSharedPointer<File>> future = storage.asn1DataTypesAsync(m_fileC);
+    QVERIFY(storage.isLoading());
+    /// Asking again while loading hands out the same request
+    QFuture<QSharedPointer<File>> second = storage.asn1DataTypesAsync(m_fileC);
+
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    QVERIFY(second.isFinished());
+    QVERIFY(future.result());
+    QCOMPARE(future.result(), second.result());
+    QVERIFY(future.result()->definitions("ModuleC"));
+
+    /// A loaded file is available at once
+    QFuture<QSharedPointer<File>> ready = storage.asn1DataTypesAsync(m_fileC);
+    QVERIFY(ready.isFinished());
+    QCOMPARE(ready.result(), future.result());
+
+    /// Clearing the storage cancels pending requests
+    QFuture<QSharedPointer<File>> cancelled = storage.asn1DataTypesAsync(m_fileA);
+    storage.clear();
+    QVERIFY(cancelled.isCanceled());
+    QVERIFY(!storage.isLoading());
+    QVERIFY(!storage.contains(m_fileA));
+}
+
+void tst_Asn1ModelStorage::testSyncAccessWhileLoading()
+{
+    Asn1ModelStorage storage;
+    storage.prefetch({ m_fileA, m_fileC });
+    /// Waits for the running batch instead of parsing the file a second time
+    QSharedPointer<File> fileA = storage.asn1DataTypes(m_fileA);
+    QVERIFY(fileA);
+    QVERIFY(!storage.isLoading());
+    QCOMPARE(storage.asn1DataTypes(m_fileA), fileA);
+    QVERIFY(storage.contains(m_fileC));
+}
+
+void tst_Asn1ModelStorage::testReloadDependents()
+{
+    Asn1ModelStorage storage;
+    storage.prefetch({ m_fileA, m_fileB, m_fileC });
+    storage.waitForLoaded();
+    const QSharedPointer<File> oldFileB = storage.asn1DataTypes(m_fileB);
+    const QSharedPointer<File> oldFileC = storage.asn1DataTypes(m_fileC);
+    QVERIFY(oldFileB);
+
+    const QByteArray contentA = moduleContent("ModuleA") + "-- changed\n";
+    const QByteArray contentB = moduleContent("ModuleB", "ModuleA");
+    QVERIFY(writeCachedXml(hash(contentA), m_fileA, "ModuleA"));
+    QVERIFY(writeCachedXml(hash(hash(contentB) + hash(contentA)), m_fileB, "ModuleB", "ModuleA"));
+
+    QSignalSpy changedSpy(&storage, &Asn1ModelStorage::dataTypesChanged);
+    QVERIFY(writeFile(m_fileA, contentA));
+    QTRY_VERIFY_WITH_TIMEOUT(changedSpy.count() > 0 && !storage.isLoading(), 10000);
+
+    /// The file importing from the changed one is reloaded in the same batch, the independent one is kept
+    QCOMPARE(changedSpy.count(), 1);
+    const QStringList changedFiles = changedSpy.first().first().toStringList();
+    QVERIFY(changedFiles.contains(m_fileA));
+    QVERIFY(changedFiles.contains(m_fileB));
+    QVERIFY(!changedFiles.contains(m_fileC));
+    QVERIFY(storage.asn1DataTypes(m_fileB) != oldFileB);
+    QCOMPARE(storage.asn1DataTypes(m_fileC), oldFileC);
+}
+
+void tst_Asn1ModelStorage::testSingleDependentAfterChange()
+{
+    /// A cache entry keyed by the content of b.asn alone must not be used, it doesn't cover the imported a.asn
+    const QByteArray contentB = moduleContent("ModuleB", "ModuleA");
+    QVERIFY(writeCachedXml(hash(contentB), m_fileB, "StaleModuleB", "ModuleA"));
+
+    Asn1ModelStorage storage;
+    QVERIFY(storage.asn1DataTypes(m_fileA));
+    QSharedPointer<File> fileB = storage.asn1DataTypes(m_fileB);
+    QVERIFY(fileB);
+    QVERIFY(fileB->definitions("ModuleB"));
+
+    const QByteArray contentA = moduleContent("ModuleA") + "-- changed\n";
+    QVERIFY(writeCachedXml(hash(contentA), m_fileA, "ModuleA"));
+    QVERIFY(writeCachedXml(hash(hash(contentB) + hash(contentA)), m_fileB, "ChangedModuleB", "ModuleA"));
+    QVERIFY(writeFile(m_fileA, contentA));
+
+    /// Loading the dependent alone again uses the changed content of the imported file
+    storage.clear();
+    QVERIFY(storage.asn1DataTypes(m_fileA));
+    fileB = storage.asn1DataTypes(m_fileB);
+    QVERIFY(fileB);
+    QVERIFY(fileB->definitions("ChangedModuleB"));
+
+    /// The same for a single file loaded in the background
+    storage.clear();
+    QVERIFY(storage.asn1DataTypes(m_fileA));
+    QFuture<QSharedPointer<File>> future = storage.asn1DataTypesAsync(m_fileB);
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    QVERIFY(future.result());
+    QVERIFY(future.result()->definitions("ChangedModuleB"));
+}
+
+void tst_Asn1ModelStorage::testSingleFileDoesNotWaitForCompiler()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    const QString fileD = writeUncachedFile("ModuleD");
+    QVERIFY(!fileD.isEmpty());
+    /// The compiler runs until the test writes the release file
+    const QString releaseFile = m_dir->filePath("release");
+    QVERIFY(setCompilerStub(QString("i=0\nwhile [ ! -f \"%1\" ] && [ $i -lt 200 ]; do sleep 0.05; i=$((i+1)); done\n"
+                                    "cp \"%2\" \"$1\"")
+                                    .arg(releaseFile, m_dir->filePath("ModuleD.xml"))));
+
+    Asn1ModelStorage storage;
+    QSignalSpy changedSpy(&storage, &Asn1ModelStorage::dataTypesChanged);
+    QFuture<QSharedPointer<File>> future = storage.asn1DataTypesAsync(fileD);
+    QVERIFY(storage.isLoading());
+    QTest::qWait(200);
+    QVERIFY(!future.isFinished());
+    QCOMPARE(changedSpy.count(), 0);
+
+    QVERIFY(writeFile(releaseFile, QByteArray()));
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    QVERIFY(future.result());
+    QVERIFY(future.result()->definitions("ModuleD"));
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().first().toStringList(), QStringList { fileD });
+    QVERIFY(!storage.isLoading());
+}
+
+void tst_Asn1ModelStorage::testSyncAccessWhileParsing()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    const QString fileD = writeUncachedFile("ModuleD");
+    QVERIFY(!fileD.isEmpty());
+    QVERIFY(setCompilerStub(QString("cp \"%1\" \"$1\"").arg(m_dir->filePath("ModuleD.xml"))));
+
+    Asn1ModelStorage storage;
+    QFuture<QSharedPointer<File>> future = storage.asn1DataTypesAsync(fileD);
+    /// The background parse is replaced by loading the file right away
+    QSharedPointer<File> fileData = storage.asn1DataTypes(fileD);
+    QVERIFY(fileData);
+    QVERIFY(fileData->definitions("ModuleD"));
+    QVERIFY(!storage.isLoading());
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), fileData);
+
+    /// The cancelled parse doesn't replace the loaded file
+    QTest::qWait(100);
+    QCOMPARE(storage.asn1DataTypes(fileD), fileData);
+}
+
+QTEST_GUILESS_MAIN(tst_Asn1ModelStorage)
+
+#include "tst_asn1modelstorage.moc"
@@ -22,7 +22,10 @@
 #include "typeassignment.h"
 #include "types/builtintypes.h"
 
+#include <QSettings>
 #include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QUuid>
 #include <QtTest>
 
 using namespace Asn1Acn;
@@ -44,8 +47,17 @@ private Q_SLOTS:
     void testSequenceCustomType();
     void testMixedTypes();
     void testChoiceReference();
+    void testAsyncParse();
+    void testAsyncCompilerError();
+    void testAsyncCancel();
+    void testCompilerSettingsChange();
+    void testFileSetCompilation();
 
 private:
+    QString writeCompilerStub(const QTemporaryDir &dir, const QString &commands) const;
+    QList<QFileInfo> writeAsn1Files(const QTemporaryDir &dir, int count) const;
+    bool writeFile(const QString &fileName, const QString &content) const;
+
     Asn1Reader *xmlParser = nullptr;
     Asn1Acn::Types::Type::ASN1Type toAsn1Type(const QVariant &value)
     {
@@ -301,6 +313,280 @@ void tst_Asn1Reader::testChoiceReference()
     QCOMPARE(choice2->typeName(), QString("BOOLEAN"));
 }
 
-QTEST_APPLESS_MAIN(tst_Asn1Reader)
+/*!
+   Writes a shell script standing in for asn1scc, it gets the xml output file as $1 and the asn.1 file as $2.
+   Returns the compiler command to be used.
+ */
+QString tst_Asn1Reader::writeCompilerStub(const QTemporaryDir &dir, const QString &commands) const
+{
+    const QString scriptName = dir.filePath("asn1scc_stub.sh");
+    QFile script(scriptName);
+    if (!script.open(QIODevice::WriteOnly)) {
+        return {};
+    }
+    script.write(QString("#!/bin/sh\n%1\n").arg(commands).toUtf8());
+    script.close();
+    return QString("/bin/sh %1 ").arg(scriptName);
+}
+
+/*!
+   Writes \p count asn.1 files with unique content, so the compiler output is never taken from the cache
+ */
+QList<QFileInfo> tst_Asn1Reader::writeAsn1Files(const QTemporaryDir &dir, int count) const
+{
+    QList<QFileInfo> files;
+    for (int i = 0; i < count; ++i) {
+        const QString fileName = dir.filePath(QString("file%1.asn").arg(i));
+        QFile file(fileName);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(QString("-- %1\nModuleTest DEFINITIONS ::= BEGIN\nEND\n")
+                               .arg(QUuid::createUuid().toString())
+                               .toUtf8());
+        }
+        files.append(QFileInfo(fileName));
+    }
+    return files;
+}
+
+bool tst_Asn1Reader::writeFile(const QString &fileName, const QString &content) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(content.toUtf8()) >= 0;
+}
+
+void tst_Asn1Reader::testAsyncParse()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    QStandardPaths::setTestModeEnabled(true);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    xmlParser->setCompilerCommand(
+            writeCompilerStub(dir, QString("sleep 0.1\ncp \"%1\" \"$1\"").arg(QFINDTESTDATA("number_type.xml"))));
+    xmlParser->setMaxConcurrentCompilers(2);
+    QCOMPARE(xmlParser->maxConcurrentCompilers(), 2);
+
+    const QList<QFileInfo> files = writeAsn1Files(dir, 5);
+    const QList<QFuture<Asn1Reader::ParseResult>> futures = xmlParser->parseAsn1FilesAsync(files);
+    QCOMPARE(futures.size(), files.size());
+    /// Nothing is done before the event loop runs
+    QCOMPARE(xmlParser->pendingJobsCount(), files.size());
+    for (const QFuture<Asn1Reader::ParseResult> &future : futures) {
+        QVERIFY(!future.isFinished());
+    }
+
+    for (int i = 0; i < futures.size(); ++i) {
+        QTRY_VERIFY_WITH_TIMEOUT(futures.at(i).isFinished(), 10000);
+        const Asn1Reader::ParseResult result = futures.at(i).result();
+        QCOMPARE(result.fileName, files.at(i).absoluteFilePath());
+        QVERIFY2(result.errorMessages.isEmpty(), qPrintable(result.errorMessages.join("\n")));
+        QVERIFY(result.file);
+        const Asn1Acn::Definitions *definitions = result.file->definitions("ModuleTest");
+        QVERIFY(definitions != nullptr);
+        QCOMPARE(definitions->types().size(), 3);
+    }
+    QCOMPARE(xmlParser->pendingJobsCount(), 0);
+
+    /// The second request is served from the cache
+    xmlParser->setCompilerCommand(writeCompilerStub(dir, "echo \"compiler must not run\""));
+    QFuture<Asn1Reader::ParseResult> cached = xmlParser->parseAsn1FileAsync(files.first());
+    QTRY_VERIFY_WITH_TIMEOUT(cached.isFinished(), 10000);
+    QVERIFY2(cached.result().errorMessages.isEmpty(), qPrintable(cached.result().errorMessages.join("\n")));
+    QVERIFY(cached.result().file);
+    QCOMPARE(xmlParser->pendingJobsCount(), 0);
+}
+
+void tst_Asn1Reader::testAsyncCompilerError()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    QStandardPaths::setTestModeEnabled(true);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    xmlParser->setCompilerCommand(writeCompilerStub(dir, "echo \"file.asn:2:1: error: syntax error\""));
+
+    QFuture<Asn1Reader::ParseResult> future = xmlParser->parseAsn1FileAsync(writeAsn1Files(dir, 1).first());
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    const Asn1Reader::ParseResult result = future.result();
+    QVERIFY(!result.file);
+    QCOMPARE(result.errorMessages.size(), 1);
+    QVERIFY(result.errorMessages.first().contains("syntax error"));
+
+    future = xmlParser->parseAsn1FileAsync(QFileInfo(dir.filePath("does_not_exist.asn")));
+    QVERIFY(future.isFinished());
+    QVERIFY(!future.result().file);
+    QCOMPARE(future.result().errorMessages.size(), 1);
+}
+
+void tst_Asn1Reader::testAsyncCancel()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    QStandardPaths::setTestModeEnabled(true);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    xmlParser->setCompilerCommand(
+            writeCompilerStub(dir, QString("sleep 10\ncp \"%1\" \"$1\"").arg(QFINDTESTDATA("number_type.xml"))));
+    xmlParser->setMaxConcurrentCompilers(1);
+
+    const QList<QFuture<Asn1Reader::ParseResult>> futures = xmlParser->parseAsn1FilesAsync(writeAsn1Files(dir, 3));
+    QCOMPARE(xmlParser->pendingJobsCount(), 3);
+
+    /// Cancelling a single queued job
+    QFuture<Asn1Reader::ParseResult> last = futures.last();
+    last.cancel();
+    QVERIFY(last.isCanceled());
+
+    xmlParser->cancelAll();
+    QCOMPARE(xmlParser->pendingJobsCount(), 0);
+    for (const QFuture<Asn1Reader::ParseResult> &future : futures) {
+        QVERIFY(future.isCanceled());
+        QVERIFY(future.isFinished());
+    }
+}
+
+void tst_Asn1Reader::testCompilerSettingsChange()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    QStandardPaths::setTestModeEnabled(true);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString firstStub = dir.filePath("first_stub.sh");
+    const QString secondStub = dir.filePath("second_stub.sh");
+    QVERIFY(writeFile(firstStub, "#!/bin/sh\necho \"first compiler\"\n"));
+    QVERIFY(writeFile(secondStub, "#!/bin/sh\necho \"second compiler\"\n"));
+
+    /// The stub scripts are run by the shell, passed as compiler parameter followed by the output and input files
+    QSettings settings;
+    settings.setValue("SpaceCreator/asn1compiler", "/bin/sh");
+    settings.setValue("SpaceCreator/asn1compilerparameter", firstStub + " ");
+
+    const QList<QFileInfo> files = writeAsn1Files(dir, 2);
+    QFuture<Asn1Reader::ParseResult> future = xmlParser->parseAsn1FileAsync(files.at(0));
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    QVERIFY(future.result().errorMessages.join("\n").contains("first compiler"));
+
+    /// A changed setting is used by the next compiler run of the same reader
+    settings.setValue("SpaceCreator/asn1compilerparameter", secondStub + " ");
+    future = xmlParser->parseAsn1FileAsync(files.at(1));
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    QVERIFY(future.result().errorMessages.join("\n").contains("second compiler"));
+
+    settings.remove("SpaceCreator/asn1compiler");
+    settings.remove("SpaceCreator/asn1compilerparameter");
+}
+
+void tst_Asn1Reader::testFileSetCompilation()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    QStandardPaths::setTestModeEnabled(true);
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    /// b.asn imports a.asn, c.asn is independent
+    const QString uuid = QUuid::createUuid().toString();
+    const QString fileA = dir.filePath("a.asn");
+    const QString fileB = dir.filePath("b.asn");
+    const QString fileC = dir.filePath("c.asn");
+    QVERIFY(writeFile(fileA, QString("-- %1\nModuleA DEFINITIONS ::= BEGIN\nTypeA ::= INTEGER\nEND\n").arg(uuid)));
+    QVERIFY(writeFile(fileB,
+            QString("-- %1\nModuleB DEFINITIONS ::= BEGIN\nIMPORTS TypeA FROM ModuleA;\nTypeB ::= TypeA\nEND\n")
+                    .arg(uuid)));
+    QVERIFY(writeFile(fileC, QString("-- %1\nModuleC DEFINITIONS ::= BEGIN\nTypeC ::= BOOLEAN\nEND\n").arg(uuid)));
+
+    QString xml("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ASN1AST>\n");
+    for (const QString &name : { QString("A"), QString("B"), QString("C") }) {
+        xml += QString("<Asn1File FileName=\"%1\"><Asn1Module ID=\"Module%2\"><TypeAssignments>"
+                       "<TypeAssignment Name=\"Type%2\" Line=\"3\" CharPositionInLine=\"0\">"
+                       "<Type Line=\"3\" CharPositionInLine=\"9\"><IntegerType Min=\"0\" Max=\"20\" /></Type>"
+                       "</TypeAssignment></TypeAssignments></Asn1Module></Asn1File>\n")
+                       .arg(dir.filePath(name.toLower() + ".asn"), name);
+    }
+    xml += "</ASN1AST>\n";
+    const QString xmlFile = dir.filePath("set.xml");
+    QVERIFY(writeFile(xmlFile, xml));
+
+    /// Every compiler run logs its input files as one line
+    const QString logFile = dir.filePath("compiler.log");
+    xmlParser->setCompilerCommand(writeCompilerStub(
+            dir, QString("out=\"$1\"\nshift\necho \"$@\" >> \"%1\"\ncp \"%2\" \"$out\"").arg(logFile, xmlFile)));
+    auto compilerRuns = [&logFile]() {
+        QFile log(logFile);
+        return log.open(QIODevice::ReadOnly) ? QString::fromUtf8(log.readAll()).split('\n', QString::SkipEmptyParts)
+                                             : QStringList();
+    };
+
+    const QList<QFileInfo> files { QFileInfo(fileA), QFileInfo(fileB), QFileInfo(fileC) };
+    QStringList errors;
+    std::map<QString, std::unique_ptr<Asn1Acn::File>> result = xmlParser->parseAsn1Files(files, &errors);
+    QVERIFY2(errors.isEmpty(), qPrintable(errors.join("\n")));
+    QCOMPARE(int(result.size()), 3);
+    QVERIFY(result.at(fileA)->definitions("ModuleA") != nullptr);
+    QVERIFY(result.at(fileB)->definitions("ModuleB") != nullptr);
+    QVERIFY(result.at(fileC)->definitions("ModuleC") != nullptr);
+    /// All files are compiled at once
+    QCOMPARE(compilerRuns().size(), 1);
+    QVERIFY(compilerRuns().first().contains("c.asn"));
+
+    /// Everything is cached now
+    result = xmlParser->parseAsn1Files(files, &errors);
+    QCOMPARE(int(result.size()), 3);
+    QCOMPARE(compilerRuns().size(), 1);
+
+    /// A file without imports can be read on its own from the cache written for the set
+    QVERIFY(xmlParser->parseAsn1File(QFileInfo(fileC), &errors));
+    QCOMPARE(compilerRuns().size(), 1);
+
+    /// Changing the imported file recompiles its dependents only
+    QVERIFY(writeFile(fileA, QString("-- %1\nModuleA DEFINITIONS ::= BEGIN\nTypeA ::= REAL\nEND\n").arg(uuid)));
+    result = xmlParser->parseAsn1Files(files, &errors);
+    QVERIFY2(errors.isEmpty(), qPrintable(errors.join("\n")));
+    QCOMPARE(int(result.size()), 3);
+    QCOMPARE(compilerRuns().size(), 2);
+    QVERIFY(compilerRuns().last().contains("a.asn"));
+    QVERIFY(compilerRuns().last().contains("b.asn"));
+    QVERIFY(!compilerRuns().last().contains("c.asn"));
+
+    /// Changing the importing file compiles it together with the imported one
+    QVERIFY(writeFile(fileB,
+            QString("-- %1\nModuleB DEFINITIONS ::= BEGIN\nIMPORTS TypeA FROM ModuleA;\n"
+                    "TypeB ::= SEQUENCE OF TypeA\nEND\n")
+                    .arg(uuid)));
+    result = xmlParser->parseAsn1Files(files, &errors);
+    QCOMPARE(int(result.size()), 3);
+    QCOMPARE(compilerRuns().size(), 3);
+    QVERIFY(compilerRuns().last().contains("a.asn"));
+    QVERIFY(!compilerRuns().last().contains("c.asn"));
+
+    /// A single file parsed asynchronously with the files it may import from uses the cache written for the set
+    QFuture<Asn1Reader::ParseResult> future = xmlParser->parseAsn1FileAsync(QFileInfo(fileB), files);
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    QVERIFY(future.result().file);
+    QCOMPARE(compilerRuns().size(), 3);
+
+    /// After a change of the imported file it's compiled together with it
+    QVERIFY(writeFile(fileA, QString("-- %1\nModuleA DEFINITIONS ::= BEGIN\nTypeA ::= BOOLEAN\nEND\n").arg(uuid)));
+    future = xmlParser->parseAsn1FileAsync(QFileInfo(fileB), files);
+    QTRY_VERIFY_WITH_TIMEOUT(future.isFinished(), 10000);
+    QVERIFY2(future.result().errorMessages.isEmpty(), qPrintable(future.result().errorMessages.join("\n")));
+    QVERIFY(future.result().file);
+    QVERIFY(future.result().file->definitions("ModuleB") != nullptr);
+    QCOMPARE(compilerRuns().size(), 4);
+    QVERIFY(compilerRuns().last().contains("a.asn"));
+    QVERIFY(compilerRuns().last().contains("b.asn"));
+    QVERIFY(!compilerRuns().last().contains("c.asn"));
+}
+
+QTEST_GUILESS_MAIN(tst_Asn1Reader)
 
 #include "tst_asn1reader.moc"
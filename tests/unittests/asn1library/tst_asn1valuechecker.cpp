@@ -0,0 +1,224 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "asn1valuechecker.h"
+#include "asn1valueparser.h"
+#include "sourcelocation.h"
+#include "typeassignment.h"
+#include "types/builtintypes.h"
+#include "types/labeltype.h"
+#include "types/userdefinedtype.h"
+
+#include <QtTest>
+#include <map>
+#include <memory>
+
+using namespace Asn1Acn;
+
+/*!
+   The checker has to accept exactly the values the Asn1ValueParser accepts
+ */
+class tst_Asn1ValueChecker : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testSameAsParser_data();
+    void testSameAsParser();
+    void testUnresolvedUserType();
+    void benchmarkChecker();
+    void benchmarkParser();
+
+private:
+    void addType(const QString &name, std::unique_ptr<Types::Type> type);
+    const TypeAssignment *assignment(const QString &name) const;
+
+    std::map<QString, std::unique_ptr<TypeAssignment>> m_assignments;
+};
+
+void tst_Asn1ValueChecker::addType(const QString &name, std::unique_ptr<Types::Type> type)
+{
+    m_assignments[name] = std::make_unique<TypeAssignment>(name, SourceLocation(), std::move(type));
+}
+
+const TypeAssignment *tst_Asn1ValueChecker::assignment(const QString &name) const
+{
+    const auto it = m_assignments.find(name);
+    return it != m_assignments.end() ? it->second.get() : nullptr;
+}
+
+void tst_Asn1ValueChecker::initTestCase()
+{
+    auto intType = std::make_unique<Types::Integer>();
+    intType->setParameters({ { "min", 0 }, { "max", 255 } });
+    addType("MyInt", std::move(intType));
+
+    auto realType = std::make_unique<Types::Real>();
+    realType->setParameters({ { "min", -1.5 }, { "max", 10.0 } });
+    addType("MyReal", std::move(realType));
+
+    addType("MyBool", std::make_unique<Types::Boolean>());
+
+    auto colorType = std::make_unique<Types::Enumerated>();
+    colorType->setParameters({ { "values", QStringList { "red", "green", "blue" } } });
+    addType("Color", std::move(colorType));
+
+    auto labelType = std::make_unique<Types::LabelType>("MyLabel");
+    labelType->setParameters({ { "min", 1 }, { "max", 5 } });
+    addType("MyLabel", std::move(labelType));
+
+    auto listType = std::make_unique<Types::SequenceOf>();
+    listType->setParameters({ { "min", 1 }, { "max", 3 } });
+    listType->addChild(std::make_unique<Types::UserdefinedType>("Color", "", assignment("Color")));
+    addType("ColorList", std::move(listType));
+
+    auto choiceType = std::make_unique<Types::Choice>();
+    choiceType->addChild(std::make_unique<Types::Boolean>("choice1"));
+    choiceType->addChild(std::make_unique<Types::Integer>("choice2"));
+    addType("MyChoice", std::move(choiceType));
+
+    auto innerType = std::make_unique<Types::Sequence>("inner");
+    auto innerInt = std::make_unique<Types::Integer>("iVal");
+    innerInt->setParameters({ { "min", 0 }, { "max", 9 } });
+    innerType->addChild(std::move(innerInt));
+
+    auto sequenceType = std::make_unique<Types::Sequence>();
+    auto intVal = std::make_unique<Types::Integer>("intVal");
+    intVal->setParameters({ { "min", 0 }, { "max", 255 } });
+    sequenceType->addChild(std::move(intVal));
+    sequenceType->addChild(std::make_unique<Types::Real>("realVal"));
+    sequenceType->addChild(std::make_unique<Types::Boolean>("boolVal"));
+    auto enumVal = std::make_unique<Types::UserdefinedType>("Color", "", assignment("Color"));
+    sequenceType->addChild(std::move(enumVal));
+    auto listVal = std::make_unique<Types::UserdefinedType>("ColorList", "", assignment("ColorList"));
+    sequenceType->addChild(std::move(listVal));
+    auto choiceVal = std::make_unique<Types::Choice>("choiceVal");
+    choiceVal->addChild(std::make_unique<Types::Boolean>("choiceBool"));
+    choiceVal->addChild(std::make_unique<Types::Integer>("choiceInt"));
+    sequenceType->addChild(std::move(choiceVal));
+    sequenceType->addChild(std::move(innerType));
+    sequenceType->addChild(std::make_unique<Types::IA5String>("text"));
+    addType("MySequence", std::move(sequenceType));
+}
+
+void tst_Asn1ValueChecker::testSameAsParser_data()
+{
+    QTest::addColumn<QString>("typeName");
+    QTest::addColumn<QString>("value");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("int") << "MyInt" << "42" << true;
+    QTest::newRow("int spaces") << "MyInt" << "  42 " << true;
+    QTest::newRow("int min") << "MyInt" << "0" << true;
+    QTest::newRow("int below") << "MyInt" << "-1" << false;
+    QTest::newRow("int above") << "MyInt" << "256" << false;
+    QTest::newRow("int format") << "MyInt" << "4o2" << false;
+    QTest::newRow("int empty") << "MyInt" << "" << false;
+    QTest::newRow("real") << "MyReal" << "3.14" << true;
+    QTest::newRow("real below") << "MyReal" << "-1.6" << false;
+    QTest::newRow("real format") << "MyReal" << "3.1.4" << false;
+    QTest::newRow("bool true") << "MyBool" << "TRUE" << true;
+    QTest::newRow("bool false") << "MyBool" << " FALSE" << true;
+    QTest::newRow("bool lower") << "MyBool" << "true" << false;
+    QTest::newRow("enum") << "Color" << "green" << true;
+    QTest::newRow("enum unknown") << "Color" << "yellow" << false;
+    QTest::newRow("label") << "MyLabel" << "\"abc\"" << true;
+    QTest::newRow("label unquoted") << "MyLabel" << "abcde" << true;
+    QTest::newRow("label too long") << "MyLabel" << "\"abcdef\"" << false;
+    QTest::newRow("label empty quotes") << "MyLabel" << "\"\"" << false;
+    QTest::newRow("list") << "ColorList" << "{ red, blue }" << true;
+    QTest::newRow("list too long") << "ColorList" << "{ red, blue, red, green }" << false;
+    QTest::newRow("list empty") << "ColorList" << "{}" << false;
+    QTest::newRow("list wrong item") << "ColorList" << "{ red, pink }" << false;
+    QTest::newRow("list no braces") << "ColorList" << "red, blue" << false;
+    QTest::newRow("list leading comma") << "ColorList" << "{ , red }" << false;
+    QTest::newRow("choice") << "MyChoice" << "choice1 : TRUE" << true;
+    QTest::newRow("choice unchecked value") << "MyChoice" << "choice2 : abc" << true;
+    QTest::newRow("choice unknown") << "MyChoice" << "choice3 : 5" << false;
+    QTest::newRow("sequence") << "MySequence"
+                              << "{ intVal 5, realVal 4.2, boolVal TRUE, Color red, ColorList { red, green }, "
+                                 "choiceVal choiceInt : 5, inner { iVal 3 }, text \"Hello World\" }"
+                              << true;
+    QTest::newRow("sequence partial") << "MySequence" << "{ intVal 5 }" << true;
+    QTest::newRow("sequence empty") << "MySequence" << "{ }" << true;
+    QTest::newRow("sequence nested field") << "MySequence" << "{ iVal 3 }" << true;
+    QTest::newRow("sequence nested range") << "MySequence" << "{ inner { iVal 10 } }" << false;
+    QTest::newRow("sequence range") << "MySequence" << "{ intVal 256 }" << false;
+    QTest::newRow("sequence unknown field") << "MySequence" << "{ foo 5 }" << false;
+    QTest::newRow("sequence missing value") << "MySequence" << "{ intVal ,realVal 4.2 }" << false;
+    QTest::newRow("sequence open brace") << "MySequence" << "{ inner { iVal 3 }" << false;
+    QTest::newRow("sequence no braces") << "MySequence" << "intVal 5" << false;
+    QTest::newRow("sequence list") << "MySequence" << "{ ColorList { red, pink } }" << false;
+}
+
+void tst_Asn1ValueChecker::testSameAsParser()
+{
+    QFETCH(QString, typeName);
+    QFETCH(QString, value);
+    QFETCH(bool, valid);
+
+    const TypeAssignment *typeAssignment = assignment(typeName);
+    QVERIFY(typeAssignment);
+
+    bool parserOk = false;
+    Asn1ValueParser parser;
+    parser.parseAsn1Value(typeAssignment, value, &parserOk);
+    QCOMPARE(parserOk, valid);
+
+    Asn1ValueChecker checker(typeAssignment->type());
+    QCOMPARE(checker.isValid(value), valid);
+}
+
+void tst_Asn1ValueChecker::testUnresolvedUserType()
+{
+    Types::UserdefinedType unresolved("Unknown", "", nullptr);
+    unresolved.setParameters({ { "max", 3 } });
+    Asn1ValueChecker checker(&unresolved);
+    QCOMPARE(checker.isValid("abc"), true);
+    QCOMPARE(checker.isValid("abcd"), false);
+
+    Asn1ValueChecker nullChecker(nullptr);
+    QCOMPARE(nullChecker.isValid("abc"), false);
+}
+
+void tst_Asn1ValueChecker::benchmarkChecker()
+{
+    const QString value("{ intVal 5, realVal 4.2, boolVal TRUE, Color red, ColorList { red, green }, "
+                        "choiceVal choiceInt : 5, inner { iVal 3 }, text \"Hello World\" }");
+    const Asn1ValueChecker checker(assignment("MySequence")->type());
+    QBENCHMARK {
+        QVERIFY(checker.isValid(value));
+    }
+}
+
+void tst_Asn1ValueChecker::benchmarkParser()
+{
+    const QString value("{ intVal 5, realVal 4.2, boolVal TRUE, Color red, ColorList { red, green }, "
+                        "choiceVal choiceInt : 5, inner { iVal 3 }, text \"Hello World\" }");
+    const TypeAssignment *typeAssignment = assignment("MySequence");
+    QBENCHMARK {
+        bool ok = false;
+        Asn1ValueParser parser;
+        parser.parseAsn1Value(typeAssignment, value, &ok);
+        QVERIFY(ok);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_Asn1ValueChecker)
+
+#include "tst_asn1valuechecker.moc"
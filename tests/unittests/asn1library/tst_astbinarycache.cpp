@@ -0,0 +1,298 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "astbinarycache.h"
+#include "astxmlparser.h"
+#include "file.h"
+#include "types/userdefinedtype.h"
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace Asn1Acn;
+
+class tst_AstBinaryCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRoundTrip_data();
+    void testRoundTrip();
+    void testReferencedTypes();
+    void testInvalidData();
+    void testWriteRead();
+    void benchmarkXml();
+    void benchmarkBinary();
+
+private:
+    static std::unique_ptr<File> parseXml(const QByteArray &xml);
+    static QByteArray generateXml(int count);
+    static void compareLocations(const SourceLocation &actual, const SourceLocation &expected);
+    static void compareTypes(const Types::Type *actual, const Types::Type *expected);
+    static void compareFiles(const File &actual, const File &expected);
+};
+
+std::unique_ptr<File> tst_AstBinaryCache::parseXml(const QByteArray &xml)
+{
+    QXmlStreamReader reader(xml);
+    AstXmlParser parser(reader);
+    if (!parser.parse()) {
+        return {};
+    }
+    std::map<QString, std::unique_ptr<File>> data = parser.takeData();
+    return data.empty() ? nullptr : std::move(data.begin()->second);
+}
+
+/*!
+   Generates an asn1scc xml with \p count integers, enumerations and sequences referencing them
+ */
+QByteArray tst_AstBinaryCache::generateXml(int count)
+{
+    QString xml("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ASN1AST><Asn1File FileName=\"generated.asn\">"
+                "<Asn1Module ID=\"Generated\"><TypeAssignments>\n");
+    for (int i = 0; i < count; ++i) {
+        xml += QString("<TypeAssignment Name=\"Int%1\" Line=\"%2\" CharPositionInLine=\"0\">"
+                       "<Type Line=\"%2\" CharPositionInLine=\"8\"><IntegerType Min=\"0\" Max=\"%1\" /></Type>"
+                       "</TypeAssignment>\n")
+                       .arg(i)
+                       .arg(i * 10);
+        xml += QString("<TypeAssignment Name=\"Enum%1\" Line=\"%2\" CharPositionInLine=\"0\">"
+                       "<Type Line=\"%2\" CharPositionInLine=\"9\"><EnumeratedType><EnumValues>"
+                       "<EnumValue StringValue=\"red\" /><EnumValue StringValue=\"green\" />"
+                       "<EnumValue StringValue=\"blue%1\" /></EnumValues></EnumeratedType></Type>"
+                       "</TypeAssignment>\n")
+                       .arg(i)
+                       .arg(i * 10 + 1);
+        xml += QString("<TypeAssignment Name=\"Seq%1\" Line=\"%2\" CharPositionInLine=\"0\">"
+                       "<Type Line=\"%2\" CharPositionInLine=\"8\"><SequenceType>")
+                       .arg(i)
+                       .arg(i * 10 + 2);
+        for (const QString &child : { QString("a"), QString("b"), QString("c") }) {
+            xml += QString("<SequenceOrSetChild VarName=\"%1\" Line=\"%2\" CharPositionInLine=\"4\">"
+                           "<Type Line=\"%2\" CharPositionInLine=\"6\"><ReferenceType ReferencedTypeName=\"Int%3\">"
+                           "<Type Line=\"%2\" CharPositionInLine=\"6\"><IntegerType Min=\"0\" Max=\"%3\" /></Type>"
+                           "</ReferenceType></Type></SequenceOrSetChild>")
+                           .arg(child)
+                           .arg(i * 10 + 3)
+                           .arg(i);
+        }
+        xml += "</SequenceType></Type></TypeAssignment>\n";
+    }
+    xml += "</TypeAssignments></Asn1Module></Asn1File></ASN1AST>\n";
+    return xml.toUtf8();
+}
+
+void tst_AstBinaryCache::compareLocations(const SourceLocation &actual, const SourceLocation &expected)
+{
+    QCOMPARE(actual.path(), expected.path());
+    QCOMPARE(actual.line(), expected.line());
+    QCOMPARE(actual.column(), expected.column());
+}
+
+void tst_AstBinaryCache::compareTypes(const Types::Type *actual, const Types::Type *expected)
+{
+    QCOMPARE(actual == nullptr, expected == nullptr);
+    if (!expected) {
+        return;
+    }
+    QCOMPARE(actual->typeEnum(), expected->typeEnum());
+    QCOMPARE(actual->typeName(), expected->typeName());
+    QCOMPARE(actual->label(), expected->label());
+    QCOMPARE(actual->identifier(), expected->identifier());
+    QCOMPARE(actual->parameters(), expected->parameters());
+    for (auto it = expected->parameters().cbegin(); it != expected->parameters().cend(); ++it) {
+        QCOMPARE(actual->parameters().value(it.key()).userType(), it.value().userType());
+    }
+
+    if (expected->typeEnum() == Types::Type::USERDEFINED) {
+        auto actualRef = static_cast<const Types::UserdefinedType *>(actual)->referencedType();
+        auto expectedRef = static_cast<const Types::UserdefinedType *>(expected)->referencedType();
+        QCOMPARE(actualRef == nullptr, expectedRef == nullptr);
+        if (expectedRef) {
+            QCOMPARE(actualRef->name(), expectedRef->name());
+            compareLocations(actualRef->location(), expectedRef->location());
+        }
+    }
+
+    QCOMPARE(actual->children().size(), expected->children().size());
+    for (size_t idx = 0; idx < expected->children().size(); ++idx) {
+        compareTypes(actual->children().at(idx).get(), expected->children().at(idx).get());
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void tst_AstBinaryCache::compareFiles(const File &actual, const File &expected)
+{
+    QCOMPARE(actual.name(), expected.name());
+    compareLocations(actual.location(), expected.location());
+    QCOMPARE(actual.definitionsList().size(), expected.definitionsList().size());
+    for (size_t defIdx = 0; defIdx < expected.definitionsList().size(); ++defIdx) {
+        const Definitions *actualDefs = actual.definitionsList().at(defIdx).get();
+        const Definitions *expectedDefs = expected.definitionsList().at(defIdx).get();
+        QCOMPARE(actualDefs->name(), expectedDefs->name());
+        QVERIFY(actualDefs->parent() == &actual);
+        QCOMPARE(actual.definitions(expectedDefs->name()), actualDefs);
+        compareLocations(actualDefs->location(), expectedDefs->location());
+
+        QCOMPARE(actualDefs->typeAssignmentNames(), expectedDefs->typeAssignmentNames());
+        for (size_t idx = 0; idx < expectedDefs->types().size(); ++idx) {
+            const TypeAssignment *actualType = actualDefs->types().at(idx).get();
+            const TypeAssignment *expectedType = expectedDefs->types().at(idx).get();
+            QCOMPARE(actualDefs->type(expectedType->name()), actualType);
+            compareLocations(actualType->location(), expectedType->location());
+            compareTypes(actualType->type(), expectedType->type());
+            if (QTest::currentTestFailed()) {
+                return;
+            }
+        }
+
+        QCOMPARE(actualDefs->values().size(), expectedDefs->values().size());
+        for (size_t idx = 0; idx < expectedDefs->values().size(); ++idx) {
+            const ValueAssignment *actualValue = actualDefs->values().at(idx).get();
+            const ValueAssignment *expectedValue = expectedDefs->values().at(idx).get();
+            QCOMPARE(actualValue->name(), expectedValue->name());
+            compareLocations(actualValue->location(), expectedValue->location());
+            compareTypes(actualValue->type(), expectedValue->type());
+            if (QTest::currentTestFailed()) {
+                return;
+            }
+        }
+
+        QCOMPARE(actualDefs->importedTypes().size(), expectedDefs->importedTypes().size());
+        for (size_t idx = 0; idx < expectedDefs->importedTypes().size(); ++idx) {
+            QCOMPARE(actualDefs->importedTypes().at(idx).module(), expectedDefs->importedTypes().at(idx).module());
+            QCOMPARE(actualDefs->importedTypes().at(idx).name(), expectedDefs->importedTypes().at(idx).name());
+        }
+        QCOMPARE(actualDefs->importedValues().size(), expectedDefs->importedValues().size());
+    }
+
+    QCOMPARE(actual.references().size(), expected.references().size());
+    for (size_t idx = 0; idx < expected.references().size(); ++idx) {
+        QCOMPARE(actual.references().at(idx)->name(), expected.references().at(idx)->name());
+        QCOMPARE(actual.references().at(idx)->module(), expected.references().at(idx)->module());
+        compareLocations(actual.references().at(idx)->location(), expected.references().at(idx)->location());
+    }
+    QCOMPARE(actual.referencesMap().size(), expected.referencesMap().size());
+    QCOMPARE(actual.errors().size(), expected.errors().size());
+}
+
+void tst_AstBinaryCache::testRoundTrip_data()
+{
+    QTest::addColumn<QString>("xmlFileName");
+    for (const char *name : { "number_type.xml", "boolenum_type.xml", "choice_type.xml", "choice_reference.xml",
+                 "sequence_type.xml", "sequence_custom_type.xml", "mixed_types01.xml", "testmsc3.xml" }) {
+        QTest::newRow(name) << QFINDTESTDATA(name);
+    }
+}
+
+void tst_AstBinaryCache::testRoundTrip()
+{
+    QFETCH(QString, xmlFileName);
+    QFile xmlFile(xmlFileName);
+    QVERIFY(xmlFile.open(QIODevice::ReadOnly));
+    const std::unique_ptr<File> expected = parseXml(xmlFile.readAll());
+    QVERIFY(expected);
+
+    const QByteArray data = AstBinaryCache::serialize(*expected);
+    QString errorString;
+    const std::unique_ptr<File> actual = AstBinaryCache::deserialize(data, &errorString);
+    QVERIFY2(actual, qPrintable(errorString));
+    compareFiles(*actual, *expected);
+
+    /// Serializing again gives exactly the same data
+    QCOMPARE(AstBinaryCache::serialize(*actual), data);
+}
+
+void tst_AstBinaryCache::testReferencedTypes()
+{
+    const std::unique_ptr<File> parsed = parseXml(generateXml(3));
+    QVERIFY(parsed);
+    const std::unique_ptr<File> file = AstBinaryCache::deserialize(AstBinaryCache::serialize(*parsed));
+    QVERIFY(file);
+    const Definitions *definitions = file->definitions("Generated");
+    QVERIFY(definitions);
+    const TypeAssignment *sequence = definitions->type("Seq2");
+    QVERIFY(sequence);
+    QCOMPARE(sequence->type()->children().size(), size_t(3));
+    auto child = dynamic_cast<const Types::UserdefinedType *>(sequence->type()->children().at(0).get());
+    QVERIFY(child);
+    QCOMPARE(child->identifier(), QString("a"));
+    QCOMPARE(child->module(), QString("Generated"));
+    /// The reference points into the new file, not the one that was serialized
+    QCOMPARE(child->referencedType(), definitions->type("Int2"));
+}
+
+void tst_AstBinaryCache::testInvalidData()
+{
+    const std::unique_ptr<File> file = parseXml(generateXml(2));
+    QVERIFY(file);
+    const QByteArray data = AstBinaryCache::serialize(*file);
+
+    QString errorString;
+    QVERIFY(!AstBinaryCache::deserialize(QByteArray(), &errorString));
+    QVERIFY(!errorString.isEmpty());
+    QVERIFY(!AstBinaryCache::deserialize(QByteArray("<?xml version=\"1.0\"?>")));
+
+    /// Another format version
+    QByteArray otherVersion = data;
+    otherVersion[7] = char(otherVersion.at(7) + 1);
+    QVERIFY(!AstBinaryCache::deserialize(otherVersion));
+
+    for (int size : { 8, 20, data.size() / 2, data.size() - 1 }) {
+        errorString.clear();
+        QVERIFY(!AstBinaryCache::deserialize(data.left(size), &errorString));
+        QVERIFY(!errorString.isEmpty());
+    }
+}
+
+void tst_AstBinaryCache::testWriteRead()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const std::unique_ptr<File> file = parseXml(generateXml(10));
+    QVERIFY(file);
+
+    const QString fileName = dir.filePath("cache/generated.ast");
+    QVERIFY(AstBinaryCache::write(*file, fileName));
+    const std::unique_ptr<File> readFile = AstBinaryCache::read(fileName);
+    QVERIFY(readFile);
+    compareFiles(*readFile, *file);
+
+    QVERIFY(!AstBinaryCache::read(dir.filePath("does_not_exist.ast")));
+}
+
+void tst_AstBinaryCache::benchmarkXml()
+{
+    const QByteArray xml = generateXml(1000);
+    QBENCHMARK {
+        QVERIFY(parseXml(xml));
+    }
+}
+
+void tst_AstBinaryCache::benchmarkBinary()
+{
+    const QByteArray data = AstBinaryCache::serialize(*parseXml(generateXml(1000)));
+    QBENCHMARK {
+        QVERIFY(AstBinaryCache::deserialize(data));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_AstBinaryCache)
+
+#include "tst_astbinarycache.moc"
@@ -28,6 +28,7 @@ class tst_File : public QObject
 private Q_SLOTS:
     void init();
     void testAsn1Compliance();
+    void testTypeLookup();
 
 private:
     void addAsn1Types();
@@ -63,6 +64,37 @@ void tst_File::testAsn1Compliance()
     QCOMPARE(ok, false);
 }
 
+void tst_File::testTypeLookup()
+{
+    Asn1Acn::SourceLocation location;
+    auto definitions = std::make_unique<Asn1Acn::Definitions>("FirstDef", location);
+    Asn1Acn::Definitions *firstDefinitions = definitions.get();
+    m_asn1Data->add(std::move(definitions));
+    QVERIFY(!m_asn1Data->hasType("MyBool"));
+    QVERIFY(m_asn1Data->typeFromName("MyBool") == nullptr);
+    QVERIFY(!m_asn1Data->typeAssignment("MyBool"));
+
+    // Types added to definitions already in the file are found as well
+    firstDefinitions->addType(std::make_unique<Asn1Acn::TypeAssignment>(
+            "MyBool", location, std::make_unique<Asn1Acn::Types::Boolean>()));
+    QVERIFY(m_asn1Data->hasType("MyBool"));
+    QVERIFY(m_asn1Data->typeFromName("MyBool") != nullptr);
+    QCOMPARE(m_asn1Data->typeAssignment("MyBool")->name(), QString("MyBool"));
+    QCOMPARE(&m_asn1Data->typeAssignment("MyBool"), &firstDefinitions->types().front());
+    QVERIFY(m_asn1Data->checkAsn1Compliance("TRUE", "MyBool"));
+
+    // The value is valid, if it is valid for any of the types with that name
+    auto secondDefinitions = std::make_unique<Asn1Acn::Definitions>("SecondDef", location);
+    secondDefinitions->addType(std::make_unique<Asn1Acn::TypeAssignment>(
+            "MyBool", location, std::make_unique<Asn1Acn::Types::Integer>()));
+    m_asn1Data->add(std::move(secondDefinitions));
+    QCOMPARE(m_asn1Data->typeFromName("MyBool")->typeEnum(), Asn1Acn::Types::Type::BOOLEAN);
+    QVERIFY(m_asn1Data->checkAsn1Compliance("TRUE", "MyBool"));
+    QVERIFY(m_asn1Data->checkAsn1Compliance("5", "MyBool"));
+    QVERIFY(!m_asn1Data->checkAsn1Compliance("abc", "MyBool"));
+    QVERIFY(!m_asn1Data->checkAsn1Compliance("5", "UnknownType"));
+}
+
 QTEST_APPLESS_MAIN(tst_File)
 
 #include "tst_file.moc"
@@ -45,13 +45,23 @@ void ParsedDocumentBuilderStub::run()
         auto modules = std::make_unique<Asn1Acn::File>(it.key());
         m_parsedDocuments.push_back(std::move(modules));
 
+        Q_EMIT finished();
+    } else if (value == "PARTIAL") {
+        // Every document is published on its own, before the builder is finished
+        for (auto document = m_rawDocuments.begin(); document != m_rawDocuments.end(); ++document) {
+            m_parsedDocuments.push_back(std::make_unique<Asn1Acn::File>(document.key()));
+            Q_EMIT documentsAvailable();
+        }
+
         Q_EMIT finished();
     }
 }
 
 std::vector<std::unique_ptr<Asn1Acn::File>> ParsedDocumentBuilderStub::takeDocuments()
 {
-    return std::move(m_parsedDocuments);
+    std::vector<std::unique_ptr<Asn1Acn::File>> documents;
+    documents.swap(m_parsedDocuments);
+    return documents;
 }
 
 const std::vector<Asn1Acn::ErrorMessage> &ParsedDocumentBuilderStub::errorMessages() const
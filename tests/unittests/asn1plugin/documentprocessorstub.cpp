@@ -27,6 +27,7 @@
 
 #include <QFileInfo>
 #include <QList>
+#include <algorithm>
 #include <file.h>
 
 using namespace Asn1Acn::Internal;
@@ -43,10 +44,27 @@ void DocumentProcessorStub::addToRun(const QString &filePath, const QString &doc
     m_documents.insert(filePath, docContent);
 }
 
+/*!
+   Documents with the content "PARTIAL" are passed by documentsAvailable() before the processing is finished. Each
+   document with the content "ERROR" gets an error message, which differs in each run
+ */
 void DocumentProcessorStub::run()
 {
+    static int runs = 0;
+    runs++;
+
     m_state = createState();
 
+    for (auto it = m_documents.begin(); it != m_documents.end(); it++) {
+        if (it.value() == QStringLiteral("PARTIAL"))
+            m_results.push_back(std::make_unique<Asn1Acn::File>(it.key()));
+        else if (it.value() == QStringLiteral("ERROR"))
+            m_errorMessages.push_back(Asn1Acn::ErrorMessage(Asn1Acn::SourceLocation(it.key(), 1, 0),
+                                                            QString("Error in run %1").arg(runs)));
+    }
+    if (!m_results.empty())
+        Q_EMIT documentsAvailable(m_projectName);
+
     for (auto it = m_documents.begin(); it != m_documents.end(); it++) {
         auto modules = std::make_unique<Asn1Acn::File>(it.key());
         m_results.push_back(std::move(modules));
@@ -57,7 +75,9 @@ void DocumentProcessorStub::run()
 
 std::vector<std::unique_ptr<Asn1Acn::File>> DocumentProcessorStub::takeResults()
 {
-    return std::move(m_results);
+    std::vector<std::unique_ptr<Asn1Acn::File>> results;
+    results.swap(m_results);
+    return results;
 }
 
 DocumentProcessorStub::State DocumentProcessorStub::state()
@@ -72,10 +92,13 @@ const std::vector<Asn1Acn::ErrorMessage> &DocumentProcessorStub::errorMessages()
 
 DocumentProcessorStub::State DocumentProcessorStub::createState()
 {
-    if (m_documents.empty())
+    const auto it = std::find_if(m_documents.begin(), m_documents.end(), [](const QString &content) {
+        return content != QStringLiteral("PARTIAL");
+    });
+    if (it == m_documents.end())
         return State::Successful;
 
-    const auto content = m_documents.begin().value();
+    const auto content = it.value();
 
     if (content == QStringLiteral("SUCCESS"))
         return State::Successful;
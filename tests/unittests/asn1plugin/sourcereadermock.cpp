@@ -42,5 +42,8 @@ QString SourceReaderMock::readContent(const QString &fileName) const
     if (fileName.contains("_SUCCESS_"))
         return QString("SUCCESS");
 
+    if (fileName.contains("_PARTIAL_"))
+        return QString("PARTIAL");
+
     return QString();
 }
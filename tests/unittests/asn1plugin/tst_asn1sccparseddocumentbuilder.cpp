@@ -0,0 +1,222 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 N7 Space sp. z o. o.
+** Contact: http://n7space.com
+**
+** This file is part of ASN.1/ACN Plugin for QtCreator.
+**
+** Plugin was developed under a program and funded by
+** European Space Agency.
+**
+** This Plugin is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**
+****************************************************************************/
+
+#include "tst_asn1sccparseddocumentbuilder.h"
+
+#include <QElapsedTimer>
+#include <QSet>
+#include <QSignalSpy>
+#include <QThread>
+#include <QThreadPool>
+#include <QtTest>
+#include <atomic>
+
+#include <asn1sccparseddocumentbuilder.h>
+#include <file.h>
+
+using namespace Asn1Acn::Internal;
+using namespace Asn1Acn::Internal::Tests;
+
+namespace {
+
+QHash<QString, QString> createDocuments(int count)
+{
+    QHash<QString, QString> documents;
+    for (int i = 0; i < count; ++i)
+        documents.insert(QString("/test/dir/file%1.asn").arg(i), QString("CONTENT%1").arg(i));
+    return documents;
+}
+
+/*!
+   Stands in for the asn1scc compiler: every document parses, except the ones with the content "ERROR"
+ */
+std::unique_ptr<Asn1Acn::File> parseStub(const QString &fileName, const QString &content, QStringList *)
+{
+    if (content == "ERROR")
+        return {};
+    return std::make_unique<Asn1Acn::File>(fileName);
+}
+
+} // namespace
+
+Asn1SccParsedDocumentBuilderTests::Asn1SccParsedDocumentBuilderTests(QObject *parent)
+    : QObject(parent)
+{}
+
+void Asn1SccParsedDocumentBuilderTests::test_parsesAllDocuments()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    const auto documents = createDocuments(25);
+
+    Asn1SccParsedDocumentBuilder builder(documents, parseStub, &pool);
+    QSignalSpy finishedSpy(&builder, &ParsedDocumentBuilder::finished);
+    builder.run();
+    QVERIFY(finishedSpy.wait());
+
+    const auto results = builder.takeDocuments();
+    QCOMPARE(results.size(), static_cast<size_t>(25));
+    QSet<QString> paths;
+    for (const auto &file : results)
+        paths.insert(file->location().path());
+    QCOMPARE(paths, documents.keys().toSet());
+    QVERIFY(builder.errorMessages().empty());
+}
+
+void Asn1SccParsedDocumentBuilderTests::test_errors()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+    auto documents = createDocuments(5);
+    documents.insert("/test/dir/broken.asn", "ERROR");
+
+    Asn1SccParsedDocumentBuilder builder(documents, parseStub, &pool);
+    QSignalSpy erroredSpy(&builder, &ParsedDocumentBuilder::errored);
+    builder.run();
+    QVERIFY(erroredSpy.wait());
+
+    QCOMPARE(builder.errorMessages().size(), static_cast<size_t>(1));
+    QCOMPARE(builder.errorMessages().at(0).message(), QString("Error reading file /test/dir/broken.asn"));
+    QCOMPARE(builder.takeDocuments().size(), static_cast<size_t>(5));
+}
+
+void Asn1SccParsedDocumentBuilderTests::test_boundedConcurrency()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+
+    std::atomic<int> running(0);
+    std::atomic<int> maxRunning(0);
+    auto parse = [&](const QString &fileName, const QString &content, QStringList *errors) {
+        const int current = ++running;
+        int max = maxRunning.load();
+        while (current > max && !maxRunning.compare_exchange_weak(max, current)) {}
+        QThread::msleep(5);
+        --running;
+        return parseStub(fileName, content, errors);
+    };
+
+    Asn1SccParsedDocumentBuilder builder(createDocuments(30), parse, &pool);
+    QSignalSpy finishedSpy(&builder, &ParsedDocumentBuilder::finished);
+    builder.run();
+    QVERIFY(finishedSpy.wait());
+
+    QCOMPARE(builder.takeDocuments().size(), static_cast<size_t>(30));
+    QVERIFY(maxRunning.load() <= 3);
+}
+
+void Asn1SccParsedDocumentBuilderTests::test_outdatedResultsAreDropped()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+
+    std::atomic<bool> outdated(false);
+    auto parse = [&](const QString &fileName, const QString &content, QStringList *errors) {
+        outdated = true;
+        return parseStub(fileName, content, errors);
+    };
+
+    Asn1SccParsedDocumentBuilder builder(createDocuments(10), parse, &pool);
+    builder.setOutdatedCheck([&outdated]() { return outdated.load(); });
+    QSignalSpy finishedSpy(&builder, &ParsedDocumentBuilder::finished);
+    builder.run();
+    QVERIFY(finishedSpy.wait());
+
+    QVERIFY(builder.takeDocuments().empty());
+    QVERIFY(builder.errorMessages().empty());
+}
+
+void Asn1SccParsedDocumentBuilderTests::test_outdatedDocumentsAreSkipped()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+
+    std::atomic<int> parsed(0);
+    auto parse = [&](const QString &fileName, const QString &content, QStringList *errors) {
+        ++parsed;
+        return parseStub(fileName, content, errors);
+    };
+
+    Asn1SccParsedDocumentBuilder builder(createDocuments(10), parse, &pool);
+    builder.setOutdatedCheck([]() { return true; });
+    QSignalSpy finishedSpy(&builder, &ParsedDocumentBuilder::finished);
+    builder.run();
+    QVERIFY(finishedSpy.wait());
+
+    QCOMPARE(parsed.load(), 0);
+    QVERIFY(builder.takeDocuments().empty());
+}
+
+void Asn1SccParsedDocumentBuilderTests::test_slowDocumentDoesNotHoldBackOthers()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+    const int documentsCount = 10;
+
+    std::atomic<bool> released(false);
+    auto parse = [&](const QString &fileName, const QString &content, QStringList *errors) {
+        if (content == "SLOW") {
+            QElapsedTimer timer;
+            timer.start();
+            while (!released && timer.elapsed() < 10000)
+                QThread::msleep(1);
+        }
+        return parseStub(fileName, content, errors);
+    };
+
+    // The slow document is sorted first, so all others are parsed while it runs
+    auto documents = createDocuments(documentsCount - 1);
+    documents.insert("/test/dir/a_slow.asn", "SLOW");
+    Asn1SccParsedDocumentBuilder builder(documents, parse, &pool);
+    QSignalSpy finishedSpy(&builder, &ParsedDocumentBuilder::finished);
+
+    int published = 0;
+    connect(&builder, &ParsedDocumentBuilder::documentsAvailable, this, [&]() {
+        QCOMPARE(finishedSpy.count(), 0);
+        published += static_cast<int>(builder.takeDocuments().size());
+        if (published == documentsCount - 1)
+            released = true;
+    });
+
+    builder.run();
+    QVERIFY(finishedSpy.wait(20000));
+
+    QCOMPARE(published, documentsCount - 1);
+    const auto remaining = builder.takeDocuments();
+    QCOMPARE(remaining.size(), static_cast<size_t>(1));
+    QCOMPARE(remaining.front()->location().path(), QString("/test/dir/a_slow.asn"));
+}
+
+void Asn1SccParsedDocumentBuilderTests::test_noDocuments()
+{
+    Asn1SccParsedDocumentBuilder builder({}, parseStub);
+    QSignalSpy finishedSpy(&builder, &ParsedDocumentBuilder::finished);
+    builder.run();
+    QVERIFY(finishedSpy.wait());
+
+    QVERIFY(builder.takeDocuments().empty());
+}
+
+QTEST_MAIN(Asn1SccParsedDocumentBuilderTests)
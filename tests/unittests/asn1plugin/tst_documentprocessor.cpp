@@ -142,6 +142,58 @@ void DocumentProcessorTests::test_multipleProcessors()
     }
 }
 
+void DocumentProcessorTests::test_documentsAvailable()
+{
+    m_storage->addProject(m_projectName);
+
+    DocumentProcessor *dp = new Asn1SccDocumentProcessor(m_projectName, m_docBuilderCreator, m_storage.get());
+    QSignalSpy availableSpy(dp, &DocumentProcessor::documentsAvailable);
+    QSignalSpy finishedSpy(dp, &DocumentProcessor::processingFinished);
+
+    QStringList passedPaths;
+    connect(dp, &DocumentProcessor::documentsAvailable, this, [dp, &finishedSpy, &passedPaths]() {
+        QCOMPARE(finishedSpy.count(), 0);
+        for (const auto &document : dp->takeResults())
+            passedPaths.append(document->location().path());
+    });
+
+    dp->addToRun(m_fileDir + "first", "PARTIAL");
+    dp->addToRun(m_fileDir + "second", "PARTIAL");
+    dp->run();
+
+    QCOMPARE(availableSpy.count(), 2);
+    QCOMPARE(qvariant_cast<QString>(availableSpy.at(0).at(0)), m_projectName);
+    passedPaths.sort();
+    QCOMPARE(passedPaths, QStringList({m_fileDir + "first", m_fileDir + "second"}));
+
+    // Nothing is left for the end of the processing
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(dp->state(), DocumentProcessor::State::Successful);
+    QVERIFY(dp->takeResults().empty());
+
+    delete dp;
+    m_storage->removeProject(m_projectName);
+}
+
+void DocumentProcessorTests::test_outdatedDocumentsAreNotPassed()
+{
+    m_storage->addProject(m_projectName);
+
+    DocumentProcessor *outdated = new Asn1SccDocumentProcessor(m_projectName, m_docBuilderCreator, m_storage.get());
+    DocumentProcessor *current = new Asn1SccDocumentProcessor(m_projectName, m_docBuilderCreator, m_storage.get());
+    QSignalSpy availableSpy(outdated, &DocumentProcessor::documentsAvailable);
+
+    outdated->addToRun(m_fileDir + "first", "PARTIAL");
+    outdated->run();
+
+    QCOMPARE(availableSpy.count(), 0);
+    QCOMPARE(outdated->state(), DocumentProcessor::State::Outdated);
+
+    delete outdated;
+    delete current;
+    m_storage->removeProject(m_projectName);
+}
+
 void DocumentProcessorTests::examine(DocumentProcessor *dp, const QSignalSpy &spy, const DocumentProcessor::State state,
         const QString &fileName, const QString &filePath) const
 {
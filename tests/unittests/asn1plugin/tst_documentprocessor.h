@@ -48,6 +48,8 @@ private Q_SLOTS:
     void test_error();
     void test_failed();
     void test_multipleProcessors();
+    void test_documentsAvailable();
+    void test_outdatedDocumentsAreNotPassed();
 
 private:
     void examine(DocumentProcessor *dp, const QSignalSpy &spy, const DocumentProcessor::State state,
@@ -25,12 +25,34 @@
 
 #include "tst_parseddatastorage.h"
 
+#include <QAtomicInt>
+#include <QSet>
+#include <QThread>
 #include <QtTest>
+#include <functional>
 #include <memory>
 
 using namespace Asn1Acn::Internal;
 using namespace Asn1Acn::Internal::Tests;
 
+namespace {
+
+class ReaderThread : public QThread
+{
+public:
+    explicit ReaderThread(std::function<void()> work)
+        : m_work(std::move(work))
+    {}
+
+protected:
+    void run() override { m_work(); }
+
+private:
+    std::function<void()> m_work;
+};
+
+} // namespace
+
 ParsedDataStorageTests::ParsedDataStorageTests(QObject *parent)
     : QObject(parent)
 {
@@ -231,6 +253,165 @@ void ParsedDataStorageTests::test_getFilesFromNonExistingProject()
     delete storage;
 }
 
+void ParsedDataStorageTests::test_snapshotIsImmutable()
+{
+    ParsedDataStorage storage;
+
+    const QString project("testProject");
+    storage.addProject(project);
+
+    const auto path = pathFromName("testFile");
+    addFileToProject(&storage, project, path);
+
+    const auto before = storage.snapshot();
+    const auto oldFile = before->anyFile(path.toString());
+    QVERIFY(oldFile != nullptr);
+
+    addFileToProject(&storage, project, path);
+    storage.removeFileFromProject(project, pathFromName("otherFile"));
+
+    const auto after = storage.snapshot();
+    QVERIFY(after->version > before->version);
+    QVERIFY(after->anyFile(path.toString()) != oldFile);
+
+    // The old version still holds the replaced file
+    QVERIFY(before->anyFile(path.toString()) == oldFile);
+    QCOMPARE(oldFile->name(), path.toString());
+
+    storage.removeProject(project);
+    QCOMPARE(storage.snapshot()->documentsCount(), 0);
+    QCOMPARE(after->documentsCount(), 1);
+}
+
+void ParsedDataStorageTests::test_snapshotSharesUnchangedProjects()
+{
+    ParsedDataStorage storage;
+
+    const QString firstProject("testProject1");
+    const QString secondProject("testProject2");
+    storage.addProject(firstProject);
+    storage.addProject(secondProject);
+    addFileToProject(&storage, secondProject, pathFromName("testFile"));
+
+    const auto before = storage.snapshot();
+    addFileToProject(&storage, firstProject, pathFromName("testFile"));
+    const auto after = storage.snapshot();
+
+    QCOMPARE(before->projects.size(), after->projects.size());
+    QVERIFY(before->projects.at(0) != after->projects.at(0));
+    QVERIFY(before->projects.at(1) == after->projects.at(1));
+}
+
+void ParsedDataStorageTests::test_concurrentReadersWithUpdates()
+{
+    ParsedDataStorage storage;
+
+    const int projectCount = 4;
+    const int fileCount = 20;
+    const int updateCount = 5000;
+
+    QStringList projects;
+    for (int idx = 0; idx < projectCount; ++idx) {
+        projects.append(QString("testProject%1").arg(idx));
+        storage.addProject(projects.last());
+        for (int fileIdx = 0; fileIdx < fileCount; ++fileIdx)
+            addFileToProject(&storage, projects.last(), pathFromName(QString("file%1").arg(fileIdx)));
+    }
+
+    // Paths per project, that are removed at the end of the updates
+    QSet<QString> removed;
+
+    QAtomicInt finished(0);
+    QAtomicInt errors(0);
+    QAtomicInt reads(0);
+
+    const auto readSnapshots = [&]() {
+        quint64 lastVersion = 0;
+        while (finished.loadAcquire() == 0) {
+            const auto snapshot = storage.snapshot();
+            if (snapshot->version < lastVersion)
+                errors.fetchAndAddOrdered(1);
+            lastVersion = snapshot->version;
+
+            for (const auto &project : snapshot->projects) {
+                if (project->filesByPath.size() != static_cast<int>(project->files.size()))
+                    errors.fetchAndAddOrdered(1);
+                for (const auto &file : project->files) {
+                    if (project->file(file->name()) != file.get())
+                        errors.fetchAndAddOrdered(1);
+                }
+            }
+
+            const auto path = pathFromName(QString("file%1").arg(lastVersion % fileCount));
+            if (snapshot->projectsForFile(path.toString()).isEmpty()
+                != (snapshot->anyFile(path.toString()) == nullptr))
+                errors.fetchAndAddOrdered(1);
+            storage.getFilesPathsFromProject(projects.first());
+            reads.fetchAndAddOrdered(1);
+        }
+    };
+
+    std::vector<std::unique_ptr<ReaderThread>> readers;
+    for (int idx = 0; idx < 4; ++idx) {
+        readers.push_back(std::make_unique<ReaderThread>(readSnapshots));
+        readers.back()->start();
+    }
+
+    for (int idx = 0; idx < updateCount; ++idx) {
+        const QString &project = projects.at(idx % projectCount);
+        const auto path = pathFromName(QString("file%1").arg(idx % fileCount));
+        if (idx % 7 == 0) {
+            storage.removeFileFromProject(project, path);
+            removed.insert(project + path.toString());
+        } else {
+            addFileToProject(&storage, project, path);
+            removed.remove(project + path.toString());
+        }
+    }
+
+    finished.storeRelease(1);
+    for (const auto &reader : readers)
+        QVERIFY(reader->wait(10000));
+
+    QCOMPARE(errors.loadAcquire(), 0);
+    QVERIFY(reads.loadAcquire() > 0);
+    QCOMPARE(storage.getProjectsCount(), projectCount);
+    QVERIFY(!removed.isEmpty());
+    QCOMPARE(storage.getDocumentsCount(), projectCount * fileCount - removed.size());
+}void ParsedDataStorageTests::test_addFilesInOneVersion()
+{
+    ParsedDataStorage storage;
+
+    const QString project("testProject");
+    storage.addProject(project);
+    addFileToProject(&storage, project, pathFromName("file1"));
+    addFileToProject(&storage, project, pathFromName("file2"));
+
+    const auto before = storage.snapshot();
+    const auto oldFile = before->anyFile(pathFromName("file1").toString());
+
+    std::vector<std::unique_ptr<Asn1Acn::File>> files;
+    files.push_back(std::make_unique<Asn1Acn::File>(pathFromName("file1").toString()));
+    files.push_back(std::make_unique<Asn1Acn::File>(pathFromName("file3").toString()));
+    files.push_back(std::make_unique<Asn1Acn::File>(pathFromName("file3").toString()));
+    const Asn1Acn::File *lastFile3 = files.back().get();
+    storage.addFilesToProject(project, std::move(files));
+
+    const auto after = storage.snapshot();
+    QCOMPARE(after->version, before->version + 1);
+    QCOMPARE(after->documentsCount(), 3);
+    QVERIFY(after->anyFile(pathFromName("file1").toString()) != oldFile);
+    QVERIFY(after->anyFile(pathFromName("file2").toString()) != nullptr);
+    QVERIFY(after->anyFile(pathFromName("file3").toString()) == lastFile3);
+
+    const auto projectSnapshot = after->project(project);
+    QCOMPARE(projectSnapshot->filesByPath.size(), static_cast<int>(projectSnapshot->files.size()));
+    QCOMPARE(projectSnapshot->indexes.size(), projectSnapshot->files.size());
+
+    storage.addFilesToProject(project, {});
+    QCOMPARE(storage.snapshot()->version, after->version);
+}
+
 void ParsedDataStorageTests::addFileToProject(
         ParsedDataStorage *storage, const QString &project, const Utils::FileName &filePath)
 {
@@ -54,6 +54,11 @@ private Q_SLOTS:
 
     void test_getFilesFromNonExistingProject();
 
+    void test_snapshotIsImmutable();
+    void test_snapshotSharesUnchangedProjects();
+    void test_addFilesInOneVersion();
+    void test_concurrentReadersWithUpdates();
+
 private:
     void addFileToProject(ParsedDataStorage *storage,
                           const QString &project,
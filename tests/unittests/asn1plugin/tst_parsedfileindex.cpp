@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 N7 Space sp. z o. o.
+** Contact: http://n7space.com
+**
+** This file is part of ASN.1/ACN Plugin for QtCreator.
+**
+** Plugin was developed under a program and funded by
+** European Space Agency.
+**
+** This Plugin is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 3 of the License, or
+** (at your option) any later version.
+**
+** This Plugin is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**
+****************************************************************************/
+
+#include "tst_parsedfileindex.h"
+
+#include <QtTest>
+#include <memory>
+
+#include <definitions.h>
+#include <file.h>
+#include <parseddatastorage.h>
+#include <parsedfileindex.h>
+#include <typeassignment.h>
+#include <typereference.h>
+#include <types/builtintypes.h>
+#include <valueassignment.h>
+
+using namespace Asn1Acn::Internal;
+using namespace Asn1Acn::Internal::Tests;
+
+namespace {
+
+std::unique_ptr<Asn1Acn::File> createFile(const QString &path)
+{
+    auto file = std::make_unique<Asn1Acn::File>(path);
+
+    auto defs = std::make_unique<Asn1Acn::Definitions>("Module-A", Asn1Acn::SourceLocation(path, 1, 0));
+    defs->addType(std::make_unique<Asn1Acn::TypeAssignment>("MyInteger",
+                                                            Asn1Acn::SourceLocation(path, 2, 0),
+                                                            std::make_unique<Asn1Acn::Types::Integer>()));
+    defs->addType(std::make_unique<Asn1Acn::TypeAssignment>("Other-Type",
+                                                            Asn1Acn::SourceLocation(path, 3, 0),
+                                                            std::make_unique<Asn1Acn::Types::Boolean>()));
+    defs->addValue(std::make_unique<Asn1Acn::ValueAssignment>("myValue",
+                                                              Asn1Acn::SourceLocation(path, 4, 0),
+                                                              std::make_unique<Asn1Acn::Types::Integer>()));
+    file->add(std::move(defs));
+
+    file->addTypeReference(
+        std::make_unique<Asn1Acn::TypeReference>("MyInteger", "Module-A", Asn1Acn::SourceLocation(path, 5, 1)));
+    file->addTypeReference(
+        std::make_unique<Asn1Acn::TypeReference>("MyInteger", "Module-B", Asn1Acn::SourceLocation(path, 6, 1)));
+    file->addTypeReference(
+        std::make_unique<Asn1Acn::TypeReference>("MyInteger", "Module-A", Asn1Acn::SourceLocation(path, 7, 1)));
+
+    return file;
+}
+
+} // namespace
+
+ParsedFileIndexTests::ParsedFileIndexTests(QObject *parent)
+    : QObject(parent)
+{}
+
+void ParsedFileIndexTests::test_references()
+{
+    const auto file = createFile("/test/file.asn");
+    const ParsedFileIndex index(*file);
+
+    const auto references = index.references("Module-A", "MyInteger");
+    QCOMPARE(references.size(), 2);
+    QCOMPARE(references.at(0)->location().line(), 5);
+    QCOMPARE(references.at(1)->location().line(), 7);
+
+    QCOMPARE(index.references("Module-B", "MyInteger").size(), 1);
+    QVERIFY(index.references("Module-A", "Other-Type").isEmpty());
+}
+
+void ParsedFileIndexTests::test_referencesFromStorage()
+{
+    ParsedDataStorage storage;
+    storage.addProject("project1");
+    storage.addProject("project2");
+    storage.addFileToProject("project1", createFile("/test/file1.asn"));
+    storage.addFileToProject("project2", createFile("/test/file2.asn"));
+
+    auto references = storage.snapshot()->references("Module-A", "MyInteger");
+    QCOMPARE(references.size(), 4);
+    QCOMPARE(references.first()->location().path(), QString("/test/file1.asn"));
+    QCOMPARE(references.last()->location().path(), QString("/test/file2.asn"));
+
+    storage.removeFileFromProject("project1", Utils::FileName::fromString("/test/file1.asn"));
+    references = storage.snapshot()->references("Module-A", "MyInteger");
+    QCOMPARE(references.size(), 2);
+    QCOMPARE(references.first()->location().path(), QString("/test/file2.asn"));
+}
+
+void ParsedFileIndexTests::test_referencesAfterUpdates()
+{
+    ParsedDataStorage storage;
+    storage.addProject("project1");
+    storage.addProject("project2");
+    storage.addFileToProject("project1", createFile("/test/file1.asn"));
+    storage.addFileToProject("project1", createFile("/test/file2.asn"));
+    storage.addFileToProject("project2", createFile("/test/file3.asn"));
+
+    // A replaced file only keeps the references of its new version, after the ones of the other files
+    const auto before = storage.snapshot();
+    storage.addFileToProject("project1", createFile("/test/file1.asn"));
+    auto references = storage.snapshot()->references("Module-A", "MyInteger");
+    QCOMPARE(references.size(), 6);
+    QCOMPARE(references.at(0)->location().path(), QString("/test/file2.asn"));
+    QCOMPARE(references.at(2)->location().path(), QString("/test/file3.asn"));
+    QCOMPARE(references.at(4)->location().path(), QString("/test/file1.asn"));
+    QCOMPARE(references.at(5)->location().path(), QString("/test/file1.asn"));
+    QCOMPARE(before->references("Module-A", "MyInteger").size(), 6);
+    QCOMPARE(before->references("Module-A", "MyInteger").first()->location().path(),
+             QString("/test/file1.asn"));
+
+    storage.removeProject("project2");
+    references = storage.snapshot()->references("Module-A", "MyInteger");
+    QCOMPARE(references.size(), 4);
+    for (const auto reference : references)
+        QVERIFY(reference->location().path() != QString("/test/file3.asn"));
+
+    storage.removeFileFromProject("project1", Utils::FileName::fromString("/test/file1.asn"));
+    storage.removeFileFromProject("project1", Utils::FileName::fromString("/test/file2.asn"));
+    QVERIFY(storage.snapshot()->references("Module-A", "MyInteger").isEmpty());
+    QVERIFY(storage.snapshot()->referencesByType.isEmpty());
+}
+
+void ParsedFileIndexTests::test_names()
+{
+    const auto file = createFile("/test/file.asn");
+    const ParsedFileIndex index(*file);
+
+    QCOMPARE(static_cast<int>(index.modules().size()), 1);
+    const auto &module = index.modules().front();
+    QCOMPARE(module.definitions->name(), QString("Module-A"));
+    QCOMPARE(static_cast<int>(module.names.size()), 3);
+    QCOMPARE(module.names.at(0).node->name(), QString("MyInteger"));
+    QCOMPARE(module.names.at(2).node->name(), QString("myValue"));
+
+    const auto patternMask = ParsedFileIndex::characterMask("myint");
+    QVERIFY(ParsedFileIndex::mayMatch(module.names.at(0).mask, patternMask));
+    QVERIFY(!ParsedFileIndex::mayMatch(module.names.at(1).mask, patternMask));
+    QVERIFY(!ParsedFileIndex::mayMatch(module.names.at(2).mask, patternMask));
+}
+
+void ParsedFileIndexTests::test_characterMask()
+{
+    QCOMPARE(ParsedFileIndex::characterMask("abc"), ParsedFileIndex::characterMask("CBA"));
+    QCOMPARE(ParsedFileIndex::characterMask("a-b_c*?"), ParsedFileIndex::characterMask("abc"));
+    QCOMPARE(ParsedFileIndex::characterMask(""), quint64(0));
+    QVERIFY(ParsedFileIndex::characterMask("a1") != ParsedFileIndex::characterMask("a2"));
+
+    // Camel case and wildcard patterns only need the letters to be present
+    const auto nameMask = ParsedFileIndex::characterMask("MyIntegerType");
+    QVERIFY(ParsedFileIndex::mayMatch(nameMask, ParsedFileIndex::characterMask("MIT")));
+    QVERIFY(ParsedFileIndex::mayMatch(nameMask, ParsedFileIndex::characterMask("my*type")));
+    QVERIFY(ParsedFileIndex::mayMatch(nameMask, ParsedFileIndex::characterMask("")));
+    QVERIFY(!ParsedFileIndex::mayMatch(nameMask, ParsedFileIndex::characterMask("MyReal")));
+}
+
+QTEST_MAIN(ParsedFileIndexTests)
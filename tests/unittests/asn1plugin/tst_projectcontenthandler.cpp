@@ -199,6 +199,40 @@ void ProjectContentHandlerTests::test_fileInMultipleProjectContentChanged()
     removeProject(secondProjectName);
 }
 
+void ProjectContentHandlerTests::test_partialResultsWithErrors()
+{
+    const QString projectName("TestProjectName_1");
+    const auto partialPath = Utils::FileName::fromString("TestFileName_1_PARTIAL_");
+    const auto errorPath = Utils::FileName::fromString("TestFileName_2_ERROR_");
+    addProject(projectName);
+
+    fileListChanged(projectName, {partialPath.toString(), errorPath.toString()});
+
+    // The file published before the errors keeps its content and isn't replaced
+    const auto firstRun = m_storage->snapshot();
+    const auto partialFile = m_storage->getFileForPathFromProject(projectName, partialPath);
+    QVERIFY(partialFile != nullptr);
+    QVERIFY(partialFile->errors().empty());
+    const auto errorFile = m_storage->getFileForPathFromProject(projectName, errorPath);
+    QVERIFY(errorFile != nullptr);
+    QCOMPARE(errorFile->errors().size(), static_cast<size_t>(1));
+    const QString firstError = errorFile->errors().front().message();
+
+    fileListChanged(projectName, {partialPath.toString(), errorPath.toString()});
+
+    // Stored files aren't changed, a file with other errors is replaced by a copy
+    QVERIFY(m_storage->getFileForPathFromProject(projectName, partialPath) != partialFile);
+    const auto newErrorFile = m_storage->getFileForPathFromProject(projectName, errorPath);
+    QVERIFY(newErrorFile != errorFile);
+    QCOMPARE(newErrorFile->errors().size(), static_cast<size_t>(1));
+    QVERIFY(newErrorFile->errors().front().message() != firstError);
+    QCOMPARE(firstRun->project(projectName)->file(errorPath.toString()), errorFile);
+    QCOMPARE(errorFile->errors().front().message(), firstError);
+
+    fileListChanged(projectName, QStringList());
+    removeProject(projectName);
+}
+
 void ProjectContentHandlerTests::addProject(const QString &projectName)
 {
     QSignalSpy spyAboutToUpdate(m_guard, &ModelValidityGuard::modelAboutToChange);
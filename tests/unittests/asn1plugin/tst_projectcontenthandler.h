@@ -56,6 +56,8 @@ private Q_SLOTS:
     void test_fileContentChangedNoProject();
     void test_fileInMultipleProjectContentChanged();
 
+    void test_partialResultsWithErrors();
+
 private:
     void addProject(const QString &projectName);
     void removeProject(const QString &projectName);
@@ -37,6 +37,7 @@ private Q_SLOTS:
     void initTestCase();
     void tst_setAttr_Autoname();
     void tst_reqIfaceAutorename();
+    void tst_kindCache();
 };
 
 void tst_IVInterface::initTestCase()
@@ -158,6 +159,33 @@ void tst_IVInterface::tst_reqIfaceAutorename()
     QVERIFY(provIface5->title() != title);
 }
 
+void tst_IVInterface::tst_kindCache()
+{
+    const QString kindToken = ivm::meta::Props::token(ivm::meta::Props::Token::kind);
+
+    ivm::IVModel model(cfg);
+    std::unique_ptr<ivm::IVFunction> func = std::make_unique<ivm::IVFunction>();
+    model.addObject(func.get());
+    std::unique_ptr<ivm::IVInterfaceProvided> iface { ivm::testutils::createProvidedIface(
+            func.get(), QLatin1String("PI")) };
+    func->addChild(iface.get());
+    model.addObject(iface.get());
+
+    iface->setEntityAttribute(kindToken, QString("Cyclic"));
+    QCOMPARE(iface->kind(), ivm::IVInterface::OperationKind::Cyclic);
+
+    iface->setEntityAttribute(kindToken, QString("Protected"));
+    QCOMPARE(iface->kind(), ivm::IVInterface::OperationKind::Protected);
+
+    QVERIFY(iface->setKind(ivm::IVInterface::OperationKind::Unprotected));
+    QCOMPARE(iface->entityAttributeValue<QString>(kindToken), QString("Unprotected"));
+    QCOMPARE(iface->kind(), ivm::IVInterface::OperationKind::Unprotected);
+
+    /// Without the attribute, a provided interface falls back to its default kind
+    iface->removeEntityAttribute(kindToken);
+    QCOMPARE(iface->kind(), ivm::IVInterface::OperationKind::Sporadic);
+}
+
 QTEST_APPLESS_MAIN(tst_IVInterface)
 
 #include "tst_ivinterface.moc"
@@ -40,6 +40,7 @@ private Q_SLOTS:
     void testManageMixed();
     void testConnectionQuery();
     void testAvailableFunctionTypes();
+    void testObjectByName();
 
 private:
     ivm::PropertyTemplateConfig *m_dynPropConfig;
@@ -367,6 +368,43 @@ void tst_IVModel::testAvailableFunctionTypes()
     }
 }
 
+void tst_IVModel::testObjectByName()
+{
+    ivm::IVModel model(m_dynPropConfig);
+    const QString nameToken = ivm::meta::Props::token(ivm::meta::Props::Token::name);
+    auto fn1 = new ivm::IVFunction("Fn1");
+    auto fn2 = new ivm::IVFunction("Fn2");
+    model.addObjects<ivm::IVObject *>({ fn1, fn2 });
+    QCOMPARE(model.getObjectByName("Fn1"), fn1);
+    QCOMPARE(model.getObjectByName("Fn2"), fn2);
+
+    // A removed name is removed from the index
+    fn1->removeEntityAttribute(nameToken);
+    QCOMPARE(model.getObjectByName("Fn1"), nullptr);
+
+    // Replacing all attributes updates the index, with and without a name
+    EntityAttributes attributes = fn2->entityAttributes();
+    attributes.remove(nameToken);
+    fn2->setEntityAttributes(attributes);
+    QCOMPARE(model.getObjectByName("Fn2"), nullptr);
+    attributes.insert(nameToken, EntityAttribute(nameToken, "Fn3", EntityAttribute::Type::Attribute));
+    fn2->setEntityAttributes(attributes);
+    QCOMPARE(model.getObjectByName("Fn3"), fn2);
+
+    // On equal names the object added first is returned, whatever its type
+    auto fnType = new ivm::IVFunctionType("Twin");
+    auto fn = new ivm::IVFunction("Twin");
+    model.addObjects<ivm::IVObject *>({ fnType, fn });
+    QCOMPARE(model.getObjectByName("Twin"), fnType);
+    QCOMPARE(model.getObjectByName("Twin", ivm::IVObject::Type::Function), fn);
+
+    // Renaming does not change the order
+    fnType->setTitle("Other");
+    QCOMPARE(model.getObjectByName("Twin"), fn);
+    fnType->setTitle("Twin");
+    QCOMPARE(model.getObjectByName("Twin"), fnType);
+}
+
 QTEST_APPLESS_MAIN(tst_IVModel)
 
 #include "tst_ivmodel.moc"
@@ -17,7 +17,9 @@
 
 #include "ivfunction.h"
 #include "ivlibrary.h"
+#include "ivmodel.h"
 #include "ivnamevalidator.h"
+#include "propertytemplateconfig.h"
 
 #include <QStandardPaths>
 #include <QTest>
@@ -30,6 +32,9 @@ private Q_SLOTS:
     void initTestCase();
     void test_functionName_data();
     void test_functionName();
+    void test_nextNameFor();
+    void test_nextNamesFor();
+    void test_nameIndexFollowsRename();
 };
 
 void tst_IVNameValidator::initTestCase()
@@ -67,6 +72,62 @@ void tst_IVNameValidator::test_functionName()
     QCOMPARE(ok, expectedResult);
 }
 
+void tst_IVNameValidator::test_nextNameFor()
+{
+    ivm::IVModel model(ivm::PropertyTemplateConfig::instance());
+    for (int i = 0; i < 10; ++i) {
+        auto fn = new ivm::IVFunction();
+        fn->setModel(&model);
+        fn->removeEntityAttribute(ivm::meta::Props::token(ivm::meta::Props::Token::name));
+        fn->setTitle(ivm::IVNameValidator::nextNameFor(fn));
+        QVERIFY(model.getFunction(fn->title(), Qt::CaseSensitive) == nullptr);
+        QVERIFY(model.addObject(fn));
+    }
+    QCOMPARE(model.objectsCount(ivm::IVObject::Type::Function), 10);
+}
+
+void tst_IVNameValidator::test_nextNamesFor()
+{
+    ivm::IVModel model(ivm::PropertyTemplateConfig::instance());
+    auto fn1 = new ivm::IVFunction(QLatin1String("Function_2"));
+    auto fn2 = new ivm::IVFunction(QLatin1String("Function_4"));
+    model.addObjects(QVector<ivm::IVObject *> { fn1, fn2 });
+
+    ivm::IVFunction newFn;
+    newFn.setModel(&model);
+    newFn.removeEntityAttribute(ivm::meta::Props::token(ivm::meta::Props::Token::name));
+
+    const int count = 500;
+    const QStringList names = ivm::IVNameValidator::nextNamesFor(&newFn, count);
+    QCOMPARE(names.size(), count);
+    QStringList uniqueNames = names;
+    QCOMPARE(uniqueNames.removeDuplicates(), 0);
+    for (const QString &name : names) {
+        QVERIFY(ivm::IVNameValidator::isValidName(name));
+        QVERIFY(model.getFunction(name, Qt::CaseSensitive) == nullptr);
+    }
+    QVERIFY(!names.contains(QLatin1String("Function_2")));
+    QVERIFY(!names.contains(QLatin1String("Function_4")));
+}
+
+void tst_IVNameValidator::test_nameIndexFollowsRename()
+{
+    ivm::IVModel model(ivm::PropertyTemplateConfig::instance());
+    auto fn = new ivm::IVFunction(QLatin1String("Alpha"));
+    QVERIFY(model.addObject(fn));
+    QCOMPARE(model.getFunction(QLatin1String("alpha"), Qt::CaseInsensitive), fn);
+    QVERIFY(model.getFunction(QLatin1String("alpha"), Qt::CaseSensitive) == nullptr);
+
+    fn->setTitle(QLatin1String("Beta"));
+    QVERIFY(model.getFunction(QLatin1String("Alpha"), Qt::CaseSensitive) == nullptr);
+    QCOMPARE(model.getFunction(QLatin1String("Beta"), Qt::CaseSensitive), fn);
+
+    QVERIFY(model.removeObject(fn));
+    QVERIFY(model.getFunction(QLatin1String("Beta"), Qt::CaseSensitive) == nullptr);
+    QCOMPARE(model.objectsCount(ivm::IVObject::Type::Function), 0);
+    delete fn;
+}
+
 QTEST_APPLESS_MAIN(tst_IVNameValidator)
 
 #include "tst_ivnamevalidator.moc"
@@ -47,6 +47,7 @@ private Q_SLOTS:
     void test_setTitle();
     void test_coordinatesConverting();
     void test_coordinatesType();
+    void test_coordinatesCache();
     void test_hasAttributes();
     void test_hasProperties();
 };
@@ -253,6 +254,35 @@ void tst_IVObject::test_hasProperties()
     QCOMPARE(obj.entityAttributes().size(), propsCount);
 }
 
+void tst_IVObject::test_coordinatesCache()
+{
+    const QString coordinatesToken = ivm::meta::Props::token(ivm::meta::Props::Token::coordinates);
+    const QVector<qint32> coordinates { 10, 20, 30, 40 };
+    const QVector<qint32> movedCoordinates { 50, 60, 70, 80 };
+
+    IVObjectImp obj;
+    QVERIFY(obj.coordinates().isEmpty());
+
+    obj.setEntityProperty(coordinatesToken, ivm::IVObject::coordinatesToString(coordinates));
+    QCOMPARE(obj.coordinates(), coordinates);
+
+    obj.setEntityProperty(coordinatesToken, ivm::IVObject::coordinatesToString(movedCoordinates));
+    QCOMPARE(obj.coordinates(), movedCoordinates);
+
+    obj.removeEntityAttribute(coordinatesToken);
+    QVERIFY(obj.coordinates().isEmpty());
+
+    obj.setCoordinates(coordinates);
+    EntityAttributes attrs = obj.entityAttributes();
+    attrs[coordinatesToken].setValue(ivm::IVObject::coordinatesToString(movedCoordinates));
+    obj.setEntityAttributes(attrs);
+    QCOMPARE(obj.coordinates(), movedCoordinates);
+
+    attrs.remove(coordinatesToken);
+    obj.setEntityAttributes(attrs);
+    QVERIFY(obj.coordinates().isEmpty());
+}
+
 QTEST_APPLESS_MAIN(tst_IVObject)
 
 #include "tst_ivobject.moc"
@@ -42,6 +42,7 @@ private Q_SLOTS:
     void tst_systemAttrs();
     void tst_scopeValidation();
     void tst_attrValidators();
+    void tst_propertyTemplateLookup();
 
 private:
     ivm::PropertyTemplateConfig *m_dynPropConfig;
@@ -384,6 +385,26 @@ void tst_AttributesConfigure::tst_attrValidators()
     QVERIFY(!attrTemplate.validate(&connection));
 }
 
+void tst_AttributesConfigure::tst_propertyTemplateLookup()
+{
+    ivm::IVFunction fn;
+    ivm::IVComment comment;
+
+    const QString nameToken = ivm::meta::Props::token(ivm::meta::Props::Token::name);
+    ivm::PropertyTemplate *nameTemplate = m_dynPropConfig->propertyTemplateForObject(&fn, nameToken);
+    QVERIFY(nameTemplate != nullptr);
+    QCOMPARE(nameTemplate->name(), nameToken);
+    QVERIFY(m_dynPropConfig->hasPropertyTemplateForObject(&fn, nameToken));
+
+    const QList<ivm::PropertyTemplate *> fnTemplates = m_dynPropConfig->propertyTemplatesForObject(&fn);
+    for (ivm::PropertyTemplate *attr : fnTemplates) {
+        QCOMPARE(m_dynPropConfig->propertyTemplateForObject(&fn, attr->name())->name(), attr->name());
+    }
+
+    QCOMPARE(m_dynPropConfig->propertyTemplateForObject(&fn, QLatin1String("not_existing_attribute")), nullptr);
+    QCOMPARE(m_dynPropConfig->propertyTemplateForObject(&comment, nameToken), nullptr);
+}
+
 QTEST_MAIN(tst_AttributesConfigure)
 
 #include "tst_attributesconfigure.moc"
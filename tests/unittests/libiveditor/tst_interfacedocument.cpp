@@ -24,7 +24,13 @@
 #include "ivmodel.h"
 #include "ivtestutils.h"
 
+#include <QDateTime>
+#include <QDir>
 #include <QObject>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QUuid>
 #include <QtTest>
 #include <memory>
 
@@ -37,8 +43,13 @@ private Q_SLOTS:
     void init();
 
     void test_checkAllInterfacesForAsn1Compliance();
+    void test_asn1FileLoadedInBackground();
+    void test_loadAvailableComponents();
 
 private:
+    static bool writeFile(const QString &fileName, const QString &content);
+    void writeComponent(const QString &componentPath, const QString &functionName, const QDateTime &lastModified);
+
     std::unique_ptr<ive::InterfaceDocument> ivDoc;
 };
 
@@ -80,6 +91,124 @@ void tst_InterfaceDocument::test_checkAllInterfacesForAsn1Compliance()
     QCOMPARE(ok, false);
 }
 
+bool tst_InterfaceDocument::writeFile(const QString &fileName, const QString &content)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(content.toUtf8()) >= 0;
+}
+
+void tst_InterfaceDocument::test_asn1FileLoadedInBackground()
+{
+#ifdef Q_OS_WIN
+    QSKIP("The compiler stub is a shell script");
+#endif
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString asnFile = dir.filePath("types.asn");
+    const QString xmlFile = dir.filePath("types.xml");
+    QVERIFY(writeFile(asnFile,
+            QString("-- %1\nTypes DEFINITIONS ::= BEGIN\nMyInt ::= INTEGER (0..10)\nEND\n")
+                    .arg(QUuid::createUuid().toString())));
+    QVERIFY(writeFile(xmlFile,
+            QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ASN1AST><Asn1File FileName=\"%1\">"
+                    "<Asn1Module ID=\"Types\"><TypeAssignments>"
+                    "<TypeAssignment Name=\"MyInt\" Line=\"3\" CharPositionInLine=\"0\">"
+                    "<Type Line=\"3\" CharPositionInLine=\"9\"><IntegerType Min=\"0\" Max=\"10\" /></Type>"
+                    "</TypeAssignment></TypeAssignments></Asn1Module></Asn1File></ASN1AST>\n")
+                    .arg(asnFile)));
+
+    // The shell script standing in for asn1scc runs until the test writes the release file
+    const QString releaseFile = dir.filePath("release");
+    const QString compilerStub = dir.filePath("asn1scc_stub.sh");
+    QVERIFY(writeFile(compilerStub,
+            QString("#!/bin/sh\ni=0\nwhile [ ! -f \"%1\" ] && [ $i -lt 200 ]; do sleep 0.05; i=$((i+1)); done\n"
+                    "cp \"%2\" \"$1\"\n")
+                    .arg(releaseFile, xmlFile)));
+    QSettings settings;
+    settings.setValue("SpaceCreator/asn1compiler", "/bin/sh");
+    settings.setValue("SpaceCreator/asn1compilerparameter", compilerStub + " ");
+
+    auto fn1 = new ivm::IVFunction("Fn1");
+    ivDoc->objectsModel()->addObject(fn1);
+    auto if1 = ivm::testutils::createIface(fn1, ivm::IVInterface::InterfaceType::Provided, "If1");
+    if1->addParam(ivm::InterfaceParameter("IfaceParam", ivm::BasicParameter::Type::Other, "InvalidType"));
+    QSignalSpy errorSpy(ivDoc.get(), &ive::InterfaceDocument::asn1ParameterErrorDetected);
+
+    ivDoc->setPath(dir.filePath("interfaceview.xml"));
+    ivDoc->setAsn1FileName("types.asn");
+
+    // Setting the file returns while the compiler is still running
+    Asn1Acn::Asn1ModelStorage *storage = ivDoc->asn1ModelStorage();
+    QVERIFY(storage->isLoading());
+    QVERIFY(!storage->contains(asnFile));
+    QCOMPARE(errorSpy.count(), 0);
+
+    // The interfaces are checked once the types are loaded
+    QVERIFY(writeFile(releaseFile, QString()));
+    QTRY_COMPARE_WITH_TIMEOUT(errorSpy.count(), 1, 10000);
+    QVERIFY(storage->contains(asnFile));
+    QVERIFY(storage->asn1DataTypes(asnFile)->hasType("MyInt"));
+
+    settings.remove("SpaceCreator/asn1compiler");
+    settings.remove("SpaceCreator/asn1compilerparameter");
+}
+
+void tst_InterfaceDocument::writeComponent(
+        const QString &componentPath, const QString &functionName, const QDateTime &lastModified)
+{
+    QVERIFY(QDir().mkpath(componentPath));
+    QFile file(componentPath + QDir::separator() + "interfaceview.xml");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QString("<InterfaceView>\n"
+                       "<Function name=\"%1\" language=\"C\" is_type=\"NO\" instance_of=\"\">\n"
+                       "</Function>\n"
+                       "</InterfaceView>\n")
+                       .arg(functionName)
+                       .toUtf8());
+    QVERIFY(file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+}
+
+void tst_InterfaceDocument::test_loadAvailableComponents()
+{
+    QTemporaryDir componentsDir;
+    QTemporaryDir sharedTypesDir;
+    QVERIFY(componentsDir.isValid());
+    QVERIFY(sharedTypesDir.isValid());
+    qputenv("TASTE_COMPONENTS_LIBRARY", componentsDir.path().toUtf8());
+    qputenv("TASTE_SHARED_TYPES", sharedTypesDir.path().toUtf8());
+
+    const QDateTime created = QDateTime::currentDateTime().addDays(-1);
+    writeComponent(componentsDir.path() + "/CompA", "CompA", created);
+    writeComponent(componentsDir.path() + "/CompB", "CompB", created);
+
+    QSignalSpy loadedSpy(ivDoc.get(), &ive::InterfaceDocument::availableComponentsLoaded);
+    ivm::IVModel *model = ivDoc->importModel();
+
+    ivDoc->loadAvailableComponents();
+    QVERIFY(loadedSpy.wait());
+    ivm::IVFunction *compA = model->getFunction("CompA", Qt::CaseSensitive);
+    QVERIFY(compA != nullptr);
+    QVERIFY(model->getFunction("CompB", Qt::CaseSensitive) != nullptr);
+
+    // Unchanged components are kept, a changed one is parsed again
+    writeComponent(componentsDir.path() + "/CompB", "CompC", created.addSecs(60));
+    ivDoc->loadAvailableComponents();
+    QVERIFY(loadedSpy.wait());
+    QCOMPARE(model->getFunction("CompA", Qt::CaseSensitive), compA);
+    QVERIFY(model->getFunction("CompB", Qt::CaseSensitive) == nullptr);
+    QVERIFY(model->getFunction("CompC", Qt::CaseSensitive) != nullptr);
+
+    // Removed components are unloaded
+    QVERIFY(QDir(componentsDir.path() + "/CompA").removeRecursively());
+    ivDoc->loadAvailableComponents();
+    QVERIFY(loadedSpy.wait());
+    QVERIFY(model->getFunction("CompA", Qt::CaseSensitive) == nullptr);
+    QVERIFY(model->getFunction("CompC", Qt::CaseSensitive) != nullptr);
+
+    qunsetenv("TASTE_COMPONENTS_LIBRARY");
+    qunsetenv("TASTE_SHARED_TYPES");
+}
+
 QTEST_MAIN(tst_InterfaceDocument)
 
 #include "tst_interfacedocument.moc"
@@ -19,6 +19,7 @@
 #include "graphicsviewutils.h"
 #include "interface/graphicsitemhelpers.h"
 #include "interface/ivconnectiongraphicsitem.h"
+#include "interface/ivconnectionlayoutmanager.h"
 #include "interface/ivfunctiongraphicsitem.h"
 #include "interface/ivfunctiontypegraphicsitem.h"
 #include "interface/ivinterfacegraphicsitem.h"
@@ -28,6 +29,9 @@
 #include <QDebug>
 #include <QGraphicsScene>
 #include <QPainter>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QtConcurrent>
 #include <QtTest>
 
 class tst_IVConnectionGraphicsItem : public QObject
@@ -37,6 +41,7 @@ class tst_IVConnectionGraphicsItem : public QObject
 private Q_SLOTS:
     void initTestCase();
     void tst_Overlapping();
+    void tst_ScheduledLayout();
 
 private:
     bool checkIntersections(ive::IVConnectionGraphicsItem *connection);
@@ -126,6 +131,79 @@ void tst_IVConnectionGraphicsItem::tst_Overlapping()
     QVERIFY(!checkIntersections(connection));
 }
 
+void tst_IVConnectionGraphicsItem::tst_ScheduledLayout()
+{
+    QGraphicsScene scene;
+    auto parentFunc1 = new ive::IVFunctionGraphicsItem(nullptr);
+    scene.addItem(parentFunc1);
+    parentFunc1->setBoundingRect(QRectF(0., 0., 200., 200.));
+    auto ifaceItem1 = new ive::IVInterfaceGraphicsItem(nullptr, parentFunc1);
+    ifaceItem1->setBoundingRect(QRectF(0, 0, 10, 10));
+    ifaceItem1->setPos(parentFunc1->mapFromScene(QPointF(200, 100)));
+
+    auto parentFunc2 = new ive::IVFunctionGraphicsItem(nullptr);
+    scene.addItem(parentFunc2);
+    parentFunc2->setBoundingRect(QRectF(400., 0., 200., 200.));
+    auto ifaceItem2 = new ive::IVInterfaceGraphicsItem(nullptr, parentFunc2);
+    ifaceItem2->setBoundingRect(QRectF(0, 0, 10, 10));
+    ifaceItem2->setPos(parentFunc2->mapFromScene(QPointF(400, 100)));
+
+    auto connection = new ive::IVConnectionGraphicsItem(nullptr, ifaceItem1, ifaceItem2);
+    scene.addItem(connection);
+    connection->init();
+    ifaceItem1->addConnection(connection);
+    ifaceItem2->addConnection(connection);
+    connection->layout();
+    const QVector<QPointF> routedPoints = connection->points();
+    QVERIFY(routedPoints.size() >= 2);
+    QVERIFY(!checkIntersections(connection));
+
+    ive::IVConnectionLayoutManager *manager = ive::IVConnectionLayoutManager::instance(&scene);
+    QVERIFY(manager);
+    QCOMPARE(ive::IVConnectionLayoutManager::instance(&scene), manager);
+
+    /// The current path is kept until the scheduled layout is done
+    const QVector<QPointF> oldPoints { routedPoints.first(), QPointF(300, 300), routedPoints.last() };
+    connection->setPoints(oldPoints);
+    manager->scheduleLayout(connection);
+    manager->scheduleLayout(connection);
+    QVERIFY(manager->hasPendingLayouts());
+    QCOMPARE(connection->points(), oldPoints);
+
+    manager->waitForDone();
+    QVERIFY(!manager->hasPendingLayouts());
+    QCOMPARE(connection->points(), routedPoints);
+
+    /// Batched layout of several connections gives the same result as a single one
+    connection->setPoints(oldPoints);
+    manager->layoutNow({ connection, connection });
+    QCOMPARE(connection->points(), routedPoints);
+
+    /// Moving an end while the route is computed routes the connection again for the new ends.
+    /// The only pool thread is kept busy, so the route can't be computed before the end was moved
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(1);
+    QSemaphore poolBlocked;
+    QFuture<void> blocker = QtConcurrent::run([&poolBlocked]() { poolBlocked.acquire(); });
+    connection->setPoints(oldPoints);
+    manager->scheduleLayout(connection);
+    QTest::qWait(10);
+    QVERIFY(manager->hasPendingLayouts());
+    ifaceItem2->setPos(parentFunc2->mapFromScene(QPointF(400, 150)));
+    poolBlocked.release();
+    blocker.waitForFinished();
+    manager->waitForDone();
+    pool->setMaxThreadCount(maxThreadCount);
+
+    QVERIFY(!manager->hasPendingLayouts());
+    ive::ConnectionRoute movedEnds;
+    QVERIFY(connection->routeEnds(&movedEnds));
+    QVERIFY(connection->lastRoute().hasSameEnds(movedEnds));
+    QVERIFY(connection->points() != routedPoints);
+    QVERIFY(!checkIntersections(connection));
+}
+
 bool tst_IVConnectionGraphicsItem::checkIntersections(ive::IVConnectionGraphicsItem *connection)
 {
     const QRectF itemRect = shared::graphicsviewutils::getNearestIntersectedRect(
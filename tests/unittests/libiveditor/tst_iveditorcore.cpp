@@ -45,6 +45,8 @@ private Q_SLOTS:
     void test_addFromNestedConnection();
     void test_addRootToNestedConnections();
     void test_addToExistingInterface();
+    void test_nameSets();
+    void test_namesInModelOrder();
 
 private:
     std::unique_ptr<ive::IVEditorCore> ivCore;
@@ -188,6 +190,61 @@ void tst_IVEditorCore::test_addToExistingInterface()
     QCOMPARE(connections.size(), 2);
 }
 
+void tst_IVEditorCore::test_nameSets()
+{
+    ivm::IVFunction *funcF1 = ivCore->addFunction("f1");
+    ivm::IVFunction *funcF2 = ivCore->addFunction("f2");
+    QVERIFY(ivCore->hasFunctionName("F1"));
+    QVERIFY(!ivCore->hasFunctionName("f3"));
+    QCOMPARE(ivCore->ivFunctionsNames().size(), 2);
+
+    ivm::IVConnection *connection = ivm::testutils::createConnection(funcF1, funcF2, "init");
+    QVERIFY(ivCore->hasConnectionName("Init"));
+    QCOMPARE(ivCore->ivConnectionNames(), QStringList { "init" });
+
+    // rename of the connection by its interfaces
+    ivCore->renameIVConnection("init", "doIt", "f1", "f2");
+    QVERIFY(!ivCore->hasConnectionName("init"));
+    QVERIFY(ivCore->hasConnectionName("doit"));
+    QCOMPARE(ivCore->ivConnectionNames(), QStringList { "doIt" });
+
+    // rename of a function
+    funcF1->setTitle("g1");
+    QVERIFY(!ivCore->hasFunctionName("f1"));
+    QVERIFY(ivCore->hasFunctionName("G1"));
+
+    // remove
+    ivm::IVModel *ivModel = ivCore->document()->objectsModel();
+    ivModel->removeObject(connection);
+    QVERIFY(!ivCore->hasConnectionName("doIt"));
+    QVERIFY(ivCore->ivConnectionNames().isEmpty());
+    ivModel->removeObject(funcF2);
+    QVERIFY(!ivCore->hasFunctionName("f2"));
+    QCOMPARE(ivCore->ivFunctionsNames(), QStringList { "g1" });
+    QCOMPARE(ivCore->allIVFunctions().size(), 1);
+}
+
+void tst_IVEditorCore::test_namesInModelOrder()
+{
+    QStringList names;
+    QVector<ivm::IVFunction *> functions;
+    for (int idx = 0; idx < 20; ++idx) {
+        names << QString("fn%1").arg((idx * 7) % 20);
+        functions << ivCore->addFunction(names.last());
+    }
+    QCOMPARE(ivCore->ivFunctionsNames(), names);
+    QCOMPARE(ivCore->allIVFunctions(), functions);
+
+    // removing keeps the order of the others
+    ivm::IVModel *ivModel = ivCore->document()->objectsModel();
+    for (int idx = functions.size() - 2; idx >= 0; idx -= 2) {
+        ivModel->removeObject(functions.takeAt(idx));
+        names.removeAt(idx);
+    }
+    QCOMPARE(ivCore->ivFunctionsNames(), names);
+    QCOMPARE(ivCore->allIVFunctions(), functions);
+}
+
 QTEST_MAIN(tst_IVEditorCore)
 
 #include "tst_iveditorcore.moc"
@@ -0,0 +1,231 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "messageconformance.h"
+#include "mscchart.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
+#include "systemchecks.h"
+
+#include <QtTest>
+
+using namespace msc;
+
+/*!
+   Accepts all messages called "ok" and counts the checks
+ */
+class CountingChecks : public SystemChecks
+{
+public:
+    bool checkMessage(const MscMessage *message) const override { return message->name() == "ok"; }
+
+    QVector<bool> checkMessageList(const QVector<const MscMessage *> &messages) const override
+    {
+        ++listChecks;
+        checkedMessages += messages.size();
+        return SystemChecks::checkMessageList(messages);
+    }
+
+    void reset()
+    {
+        listChecks = 0;
+        checkedMessages = 0;
+    }
+
+    mutable int listChecks = 0;
+    mutable int checkedMessages = 0;
+};
+
+class tst_MessageConformance : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void testBatchedCheck();
+    void testMessageChange();
+    void testInstanceRename();
+    void testIvDataReset();
+    void testIvDataChanged();
+    void testRemovedMessage();
+
+private:
+    MscMessage *addMessage(const QString &name, MscInstance *source, MscInstance *target);
+
+    MscChart *m_chart = nullptr;
+    MscInstance *m_instanceA = nullptr;
+    MscInstance *m_instanceB = nullptr;
+    MscInstance *m_instanceC = nullptr;
+    CountingChecks *m_checks = nullptr;
+    MessageConformance *m_conformance = nullptr;
+    QVector<MscMessage *> m_changed;
+};
+
+MscMessage *tst_MessageConformance::addMessage(const QString &name, MscInstance *source, MscInstance *target)
+{
+    auto message = new MscMessage(name, source, target, m_chart);
+    m_chart->addInstanceEvent(message, { { source, -1 }, { target, -1 } });
+    return message;
+}
+
+void tst_MessageConformance::init()
+{
+    m_chart = new MscChart("Chart");
+    m_instanceA = new MscInstance("A", m_chart);
+    m_instanceB = new MscInstance("B", m_chart);
+    m_instanceC = new MscInstance("C", m_chart);
+    m_chart->addInstance(m_instanceA);
+    m_chart->addInstance(m_instanceB);
+    m_chart->addInstance(m_instanceC);
+    for (int idx = 0; idx < 50; ++idx) {
+        addMessage("ok", m_instanceA, m_instanceB);
+        addMessage("wrong", m_instanceB, m_instanceC);
+    }
+
+    m_checks = new CountingChecks;
+    m_conformance = new MessageConformance;
+    m_conformance->setSystemChecker(m_checks);
+    m_conformance->setChart(m_chart);
+    m_changed.clear();
+    connect(m_conformance, &MessageConformance::statusChanged, this,
+            [this](const QVector<MscMessage *> &messages) { m_changed += messages; });
+}
+
+void tst_MessageConformance::cleanup()
+{
+    delete m_conformance;
+    m_conformance = nullptr;
+    delete m_checks;
+    m_checks = nullptr;
+    delete m_chart;
+    m_chart = nullptr;
+}
+
+void tst_MessageConformance::testBatchedCheck()
+{
+    const QVector<MscMessage *> messages = m_chart->messages();
+    QCOMPARE(m_conformance->isConform(messages.at(0)), true);
+    QCOMPARE(m_checks->listChecks, 1);
+    QCOMPARE(m_checks->checkedMessages, 100);
+    QCOMPARE(m_changed.size(), 100);
+
+    int conformCount = 0;
+    for (MscMessage *message : messages) {
+        conformCount += m_conformance->isConform(message) ? 1 : 0;
+    }
+    QCOMPARE(conformCount, 50);
+    QCOMPARE(m_checks->listChecks, 1);
+}
+
+void tst_MessageConformance::testMessageChange()
+{
+    m_conformance->update();
+    m_checks->reset();
+    m_changed.clear();
+
+    MscMessage *message = m_chart->messages().at(0);
+    message->setName("wrong");
+    // the check is deferred, all changes of one cycle are checked together
+    QCOMPARE(m_checks->listChecks, 0);
+    QTRY_COMPARE(m_changed.size(), 1);
+    QCOMPARE(m_changed.first(), message);
+    QCOMPARE(m_checks->checkedMessages, 1);
+    QCOMPARE(m_conformance->isConform(message), false);
+
+    // unrelated changes do not trigger a check
+    message->setParameters({ MscParameter("5") });
+    m_conformance->update();
+    QCOMPARE(m_checks->checkedMessages, 1);
+
+    // same status, no notification
+    m_changed.clear();
+    message->setTargetInstance(m_instanceC);
+    m_conformance->update();
+    QCOMPARE(m_checks->checkedMessages, 2);
+    QVERIFY(m_changed.isEmpty());
+}
+
+void tst_MessageConformance::testInstanceRename()
+{
+    m_conformance->update();
+    m_checks->reset();
+
+    m_instanceC->setName("D");
+    m_conformance->update();
+    QCOMPARE(m_checks->listChecks, 1);
+    QCOMPARE(m_checks->checkedMessages, 50);
+}
+
+void tst_MessageConformance::testIvDataReset()
+{
+    m_conformance->update();
+    m_checks->reset();
+
+    Q_EMIT m_checks->ivDataReset();
+    m_conformance->update();
+    QCOMPARE(m_checks->listChecks, 1);
+    QCOMPARE(m_checks->checkedMessages, 100);
+}
+
+void tst_MessageConformance::testIvDataChanged()
+{
+    m_conformance->update();
+    m_checks->reset();
+
+    // messages from or to an instance of the name
+    Q_EMIT m_checks->ivDataChanged({ "a" });
+    m_conformance->update();
+    QCOMPARE(m_checks->checkedMessages, 50);
+
+    // messages of the name
+    m_checks->reset();
+    Q_EMIT m_checks->ivDataChanged({ "wrong", "unknown" });
+    m_conformance->update();
+    QCOMPARE(m_checks->checkedMessages, 50);
+
+    m_checks->reset();
+    Q_EMIT m_checks->ivDataChanged({ "unknown" });
+    m_conformance->update();
+    QCOMPARE(m_checks->listChecks, 0);
+
+    // no names, everything might be affected
+    Q_EMIT m_checks->ivDataChanged({});
+    m_conformance->update();
+    QCOMPARE(m_checks->checkedMessages, 100);
+}
+
+void tst_MessageConformance::testRemovedMessage()
+{
+    m_conformance->update();
+    m_checks->reset();
+
+    MscMessage *message = m_chart->messages().at(1);
+    m_chart->removeInstanceEvent(message);
+    message->setName("ok");
+    m_conformance->update();
+    QCOMPARE(m_checks->listChecks, 0);
+
+    // messages outside of the chart are checked directly
+    QCOMPARE(m_conformance->isConform(message), true);
+    QCOMPARE(m_checks->listChecks, 0);
+    delete message;
+}
+
+QTEST_MAIN(tst_MessageConformance)
+
+#include "tst_messageconformance.moc"
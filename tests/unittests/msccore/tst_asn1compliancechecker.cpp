@@ -0,0 +1,246 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "asn1compliancechecker.h"
+#include "definitions.h"
+#include "file.h"
+#include "mscchart.h"
+#include "mscdocument.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
+#include "mscmessagedeclaration.h"
+#include "mscmessagedeclarationlist.h"
+#include "mscmodel.h"
+#include "typeassignment.h"
+#include "types/builtintypes.h"
+
+#include <QtTest>
+
+using namespace msc;
+
+class tst_Asn1ComplianceChecker : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void testFailureLocations();
+    void testNoDeclarations();
+    void testWithoutAsn1Data();
+    void testSameAsSingleMessageCheck();
+    void benchmarkBulkCheck();
+    void benchmarkSingleMessageChecks();
+
+private:
+    QSharedPointer<Asn1Acn::File> createAsn1Types() const;
+    MscChart *addChart(const QString &name);
+    MscMessage *addMessage(MscChart *chart, const QString &name, const QStringList &parameters);
+    void generateMessages(int count);
+
+    MscModel *m_model = nullptr;
+    MscDocument *m_document = nullptr;
+};
+
+void tst_Asn1ComplianceChecker::init()
+{
+    m_model = new MscModel;
+    m_document = new MscDocument("Doc01", m_model);
+    m_model->addDocument(m_document);
+
+    auto intDeclaration = new MscMessageDeclaration;
+    intDeclaration->setNames({ "sendInt" });
+    intDeclaration->setTypeRefList({ "MyInt" });
+    m_document->messageDeclarations()->append(intDeclaration);
+
+    auto pairDeclaration = new MscMessageDeclaration;
+    pairDeclaration->setNames({ "sendPair", "sendPair2" });
+    pairDeclaration->setTypeRefList({ "MyInt", "MySequence" });
+    m_document->messageDeclarations()->append(pairDeclaration);
+}
+
+void tst_Asn1ComplianceChecker::cleanup()
+{
+    delete m_model;
+    m_model = nullptr;
+    m_document = nullptr;
+}
+
+QSharedPointer<Asn1Acn::File> tst_Asn1ComplianceChecker::createAsn1Types() const
+{
+    Asn1Acn::SourceLocation location;
+    auto definitions = std::make_unique<Asn1Acn::Definitions>("TestDef", location);
+
+    auto intType = std::make_unique<Asn1Acn::Types::Integer>();
+    intType->setParameters({ { "min", 0 }, { "max", 255 } });
+    definitions->addType(std::make_unique<Asn1Acn::TypeAssignment>("MyInt", location, std::move(intType)));
+
+    auto sequenceType = std::make_unique<Asn1Acn::Types::Sequence>();
+    auto intVal = std::make_unique<Asn1Acn::Types::Integer>("intVal");
+    intVal->setParameters({ { "min", 0 }, { "max", 9 } });
+    sequenceType->addChild(std::move(intVal));
+    sequenceType->addChild(std::make_unique<Asn1Acn::Types::Boolean>("boolVal"));
+    definitions->addType(
+            std::make_unique<Asn1Acn::TypeAssignment>("MySequence", location, std::move(sequenceType)));
+
+    auto asn1Data = QSharedPointer<Asn1Acn::File>::create("/dummy/path");
+    asn1Data->add(std::move(definitions));
+    return asn1Data;
+}
+
+MscChart *tst_Asn1ComplianceChecker::addChart(const QString &name)
+{
+    auto chart = new MscChart(name, m_document);
+    m_document->addChart(chart);
+    chart->addInstance(new MscInstance("Instance01", chart));
+    return chart;
+}
+
+MscMessage *tst_Asn1ComplianceChecker::addMessage(
+        MscChart *chart, const QString &name, const QStringList &parameters)
+{
+    MscInstance *instance = chart->instances().first();
+    auto message = new MscMessage(name, chart);
+    message->setSourceInstance(instance);
+    MscParameterList parameterList;
+    for (const QString &parameter : parameters) {
+        parameterList.append(MscParameter(parameter));
+    }
+    message->setParameters(parameterList);
+    chart->addInstanceEvent(message, { { instance, -1 } });
+    return message;
+}
+
+/*!
+   Fills one chart with \p count messages, every 100th message has an invalid parameter
+ */
+void tst_Asn1ComplianceChecker::generateMessages(int count)
+{
+    MscChart *chart = addChart("Generated");
+    for (int idx = 0; idx < count; ++idx) {
+        const QString intValue = QString::number(idx % 100 == 0 ? 300 : idx % 256);
+        addMessage(chart, "sendPair", { intValue, QString("{ intVal %1, boolVal TRUE }").arg(idx % 10) });
+    }
+}
+
+void tst_Asn1ComplianceChecker::testFailureLocations()
+{
+    MscChart *chart1 = addChart("Chart01");
+    addMessage(chart1, "sendInt", { "5" });
+    MscMessage *wrongValue = addMessage(chart1, "sendPair", { "5", "{ intVal 10, boolVal TRUE }" });
+    MscChart *chart2 = addChart("Chart02");
+    MscMessage *wrongCount = addMessage(chart2, "sendInt", { "5", "6" });
+    addMessage(chart2, "undeclared", { "foo" });
+
+    const Asn1ComplianceChecker checker(createAsn1Types(), m_document->messageDeclarations());
+    const Asn1ComplianceChecker::Failures failures = checker.check(m_model->allCharts());
+    QCOMPARE(failures.size(), 2);
+
+    const Asn1ComplianceChecker::Failure &valueFailure = failures.at(0);
+    QVERIFY(valueFailure.reason == Asn1ComplianceChecker::Failure::Reason::InvalidParameter);
+    QVERIFY(valueFailure.chart == chart1);
+    QVERIFY(valueFailure.message == wrongValue);
+    QCOMPARE(valueFailure.parameterIndex, 1);
+    QCOMPARE(valueFailure.parameter, QString("{ intVal 10, boolVal TRUE }"));
+    QCOMPARE(valueFailure.typeName, QString("MySequence"));
+
+    const Asn1ComplianceChecker::Failure &countFailure = failures.at(1);
+    QVERIFY(countFailure.reason == Asn1ComplianceChecker::Failure::Reason::ParameterCount);
+    QVERIFY(countFailure.chart == chart2);
+    QVERIFY(countFailure.message == wrongCount);
+    QCOMPARE(countFailure.parameterIndex, -1);
+}
+
+void tst_Asn1ComplianceChecker::testNoDeclarations()
+{
+    MscChart *chart = addChart("Chart01");
+    addMessage(chart, "sendInt", { "5" });
+
+    const Asn1ComplianceChecker checker(createAsn1Types(), nullptr);
+    const Asn1ComplianceChecker::Failures failures = checker.check({ chart });
+    QCOMPARE(failures.size(), 1);
+    QVERIFY(failures.first().reason == Asn1ComplianceChecker::Failure::Reason::NoDeclarations);
+}
+
+void tst_Asn1ComplianceChecker::testWithoutAsn1Data()
+{
+    MscChart *chart = addChart("Chart01");
+    addMessage(chart, "sendInt", { "foo" });
+    addMessage(chart, "sendInt", {});
+
+    // Only the number of parameters can be checked
+    const Asn1ComplianceChecker checker({}, m_document->messageDeclarations());
+    const Asn1ComplianceChecker::Failures failures = checker.check({ chart });
+    QCOMPARE(failures.size(), 1);
+    QVERIFY(failures.first().reason == Asn1ComplianceChecker::Failure::Reason::ParameterCount);
+}
+
+void tst_Asn1ComplianceChecker::testSameAsSingleMessageCheck()
+{
+    generateMessages(1000);
+    MscChart *chart = addChart("Chart01");
+    addMessage(chart, "sendPair2", { "7", "{ iVal 3 }" });
+    addMessage(chart, "sendPair2", { "7", "{ intVal 3 }" });
+    m_model->setAsn1TypesData(createAsn1Types());
+
+    int faultyCount = 0;
+    for (MscChart *modelChart : m_model->allCharts()) {
+        for (MscMessage *message : modelChart->messages()) {
+            if (!m_model->checkMessageAsn1Compliance(*message)) {
+                ++faultyCount;
+            }
+        }
+    }
+
+    QStringList faultyMessages;
+    QCOMPARE(m_model->checkAllMessagesForAsn1Compliance(&faultyMessages), false);
+    QCOMPARE(faultyMessages.size(), faultyCount);
+    QCOMPARE(faultyMessages.size(), 11);
+    QCOMPARE(faultyMessages.first(), QString("sendPair(300, { intVal 0, boolVal TRUE })"));
+}
+
+void tst_Asn1ComplianceChecker::benchmarkBulkCheck()
+{
+    generateMessages(50000);
+    const Asn1ComplianceChecker checker(createAsn1Types(), m_document->messageDeclarations());
+    const QVector<MscChart *> charts = m_model->allCharts();
+
+    QBENCHMARK {
+        QCOMPARE(checker.check(charts).size(), 500);
+    }
+}
+
+void tst_Asn1ComplianceChecker::benchmarkSingleMessageChecks()
+{
+    generateMessages(50000);
+    m_model->setAsn1TypesData(createAsn1Types());
+    const QVector<MscMessage *> messages = m_model->allCharts().first()->messages();
+
+    QBENCHMARK {
+        int faultyCount = 0;
+        for (MscMessage *message : messages) {
+            if (!m_model->checkMessageAsn1Compliance(*message)) {
+                ++faultyCount;
+            }
+        }
+        QCOMPARE(faultyCount, 500);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_Asn1ComplianceChecker)
+
+#include "tst_asn1compliancechecker.moc"
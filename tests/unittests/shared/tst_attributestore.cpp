@@ -0,0 +1,139 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "attributestore.h"
+
+#include <QtConcurrent>
+#include <QtTest>
+
+class tst_AttributeStore : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testInterning();
+    void testConcurrentInterning();
+    void testSetAndFind();
+    void testRemove();
+    void testToHash();
+};
+
+void tst_AttributeStore::testInterning()
+{
+    const shared::AttributeId id = shared::AttributeNameTable::intern("tst_name");
+    QVERIFY(id != shared::AttributeId::Invalid);
+    QCOMPARE(shared::AttributeNameTable::intern("tst_name"), id);
+    QCOMPARE(shared::AttributeNameTable::find("tst_name"), id);
+    QCOMPARE(shared::AttributeNameTable::name(id), QString("tst_name"));
+
+    const int count = shared::AttributeNameTable::count();
+    QCOMPARE(shared::AttributeNameTable::find("tst_never_interned"), shared::AttributeId::Invalid);
+    QCOMPARE(shared::AttributeNameTable::count(), count);
+    QCOMPARE(shared::AttributeNameTable::intern(QString()), shared::AttributeId::Invalid);
+}
+
+void tst_AttributeStore::testConcurrentInterning()
+{
+    using NameId = QPair<QString, shared::AttributeId>;
+    QVector<int> indexes;
+    for (int idx = 0; idx < 2000; ++idx) {
+        indexes.append(idx);
+    }
+
+    /// Many threads look up and add the same names at the same time, each name has to get exactly one id
+    const QVector<NameId> ids = QtConcurrent::blockingMapped<QVector<NameId>>(indexes, [](int idx) -> NameId {
+        const QString name = QString("tst_concurrent_%1").arg(idx % 100);
+        const shared::AttributeId id = shared::AttributeNameTable::intern(name);
+        if (shared::AttributeNameTable::name(id) != name || shared::AttributeNameTable::find(name) != id) {
+            return { name, shared::AttributeId::Invalid };
+        }
+        return { name, id };
+    });
+
+    QHash<QString, shared::AttributeId> idsByName;
+    for (const auto &entry : ids) {
+        QVERIFY(entry.second != shared::AttributeId::Invalid);
+        QCOMPARE(idsByName.value(entry.first, entry.second), entry.second);
+        idsByName.insert(entry.first, entry.second);
+    }
+    QCOMPARE(idsByName.size(), 100);
+}
+
+void tst_AttributeStore::testSetAndFind()
+{
+    const shared::AttributeId nameId = shared::AttributeNameTable::intern("name");
+    const shared::AttributeId kindId = shared::AttributeNameTable::intern("kind");
+
+    shared::AttributeStore store;
+    QVERIFY(store.isEmpty());
+    QCOMPARE(store.find(nameId), nullptr);
+
+    store.set(nameId, QString("Fn1"), EntityAttribute::Type::Attribute);
+    store.set(kindId, QString("Sporadic"), EntityAttribute::Type::Property);
+    QCOMPARE(store.size(), 2);
+    QCOMPARE(store.value(nameId).toString(), QString("Fn1"));
+
+    store.set(nameId, QString("Fn2"), EntityAttribute::Type::Attribute);
+    QCOMPARE(store.size(), 2);
+    QCOMPARE(store.value(nameId).toString(), QString("Fn2"));
+
+    const EntityAttribute attr = store.attribute(kindId);
+    QCOMPARE(attr.name(), QString("kind"));
+    QCOMPARE(attr.value().toString(), QString("Sporadic"));
+    QVERIFY(attr.isProperty());
+
+    store.set(shared::AttributeId::Invalid, 1, EntityAttribute::Type::Attribute);
+    QCOMPARE(store.size(), 2);
+}
+
+void tst_AttributeStore::testRemove()
+{
+    const shared::AttributeId nameId = shared::AttributeNameTable::intern("name");
+    const shared::AttributeId kindId = shared::AttributeNameTable::intern("kind");
+
+    shared::AttributeStore store;
+    store.set(nameId, QString("Fn1"), EntityAttribute::Type::Attribute);
+    store.set(kindId, QString("Sporadic"), EntityAttribute::Type::Attribute);
+
+    QVERIFY(store.remove(nameId));
+    QVERIFY(!store.remove(nameId));
+    QVERIFY(!store.contains(nameId));
+    QVERIFY(store.contains(kindId));
+
+    store.clear();
+    QVERIFY(store.isEmpty());
+}
+
+void tst_AttributeStore::testToHash()
+{
+    const shared::AttributeId nameId = shared::AttributeNameTable::intern("name");
+    const shared::AttributeId coordId = shared::AttributeNameTable::intern("Taste::coordinates");
+
+    shared::AttributeStore store;
+    store.set(nameId, QString("Fn1"), EntityAttribute::Type::Attribute);
+    store.set(coordId, QString("100 200"), EntityAttribute::Type::Property);
+
+    const EntityAttributes attrs = store.toHash();
+    QCOMPARE(attrs.size(), 2);
+    QCOMPARE(attrs.value("name"), EntityAttribute("name", QString("Fn1"), EntityAttribute::Type::Attribute));
+    QCOMPARE(attrs.value("Taste::coordinates"),
+            EntityAttribute("Taste::coordinates", QString("100 200"), EntityAttribute::Type::Property));
+}
+
+QTEST_APPLESS_MAIN(tst_AttributeStore)
+
+#include "tst_attributestore.moc"
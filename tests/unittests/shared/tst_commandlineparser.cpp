@@ -52,6 +52,8 @@ private Q_SLOTS:
     // Arguments valid for both. Skipping Unknown and DropUnsavedChangesSilently
     void testCmdArgumentOpenStringTemplateFile();
     void testCmdArgumentExportToFile();
+    void testCmdArgumentTraceFile();
+    void testCmdArgumentMemoryReportFile();
 
     void initTestCase();
     void testCoverage();
@@ -209,6 +211,55 @@ void tst_CommandLineParser::testCmdArgumentExportToFile()
     QCOMPARE(argFromParserIV, fileName);
 }
 
+void tst_CommandLineParser::testCmdArgumentTraceFile()
+{
+    const QCommandLineOption cmdTraceFile = CommandLineParser::positionalArg(CommandLineParser::Positional::TraceFile);
+    const QString fileName("trace.json");
+    const QStringList args = { QApplication::instance()->applicationFilePath(),
+        QString("--%1=%2").arg(cmdTraceFile.names().first(), fileName) };
+
+    CommandLineParser parserMSC;
+    m_pluginMSC.populateCommandLineArguments(&parserMSC);
+    parserMSC.process(args);
+
+    QVERIFY(!parserMSC.isSet(CommandLineParser::Positional::Unknown));
+    QVERIFY(parserMSC.isSet(CommandLineParser::Positional::TraceFile));
+    QCOMPARE(parserMSC.value(CommandLineParser::Positional::TraceFile), fileName);
+
+    CommandLineParser parserIV;
+    m_pluginIV.populateCommandLineArguments(&parserIV);
+    parserIV.process(args);
+
+    QVERIFY(!parserIV.isSet(CommandLineParser::Positional::Unknown));
+    QVERIFY(parserIV.isSet(CommandLineParser::Positional::TraceFile));
+    QCOMPARE(parserIV.value(CommandLineParser::Positional::TraceFile), fileName);
+}
+
+void tst_CommandLineParser::testCmdArgumentMemoryReportFile()
+{
+    const QCommandLineOption cmdReportFile =
+            CommandLineParser::positionalArg(CommandLineParser::Positional::MemoryReportFile);
+    const QString fileName("memory.json");
+    const QStringList args = { QApplication::instance()->applicationFilePath(),
+        QString("--%1=%2").arg(cmdReportFile.names().first(), fileName) };
+
+    CommandLineParser parserMSC;
+    m_pluginMSC.populateCommandLineArguments(&parserMSC);
+    parserMSC.process(args);
+
+    QVERIFY(!parserMSC.isSet(CommandLineParser::Positional::Unknown));
+    QVERIFY(parserMSC.isSet(CommandLineParser::Positional::MemoryReportFile));
+    QCOMPARE(parserMSC.value(CommandLineParser::Positional::MemoryReportFile), fileName);
+
+    CommandLineParser parserIV;
+    m_pluginIV.populateCommandLineArguments(&parserIV);
+    parserIV.process(args);
+
+    QVERIFY(!parserIV.isSet(CommandLineParser::Positional::Unknown));
+    QVERIFY(parserIV.isSet(CommandLineParser::Positional::MemoryReportFile));
+    QCOMPARE(parserIV.value(CommandLineParser::Positional::MemoryReportFile), fileName);
+}
+
 void tst_CommandLineParser::initTestCase()
 {
     ivm::initIVLibrary();
@@ -0,0 +1,214 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "connectionrouter.h"
+#include "graphicsviewutils.h"
+
+#include <QtTest>
+
+using namespace shared::graphicsviewutils;
+
+class tst_ConnectionRouter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testIndexQuery();
+    void testSegmentIntersection();
+    void testStraightRoute();
+    void testRouteAroundObstacle();
+    void testRouteWithDirections();
+    void testNoRoute();
+    void testDenseLayout();
+    void testLargeLayout();
+    void benchmarkRouter_data();
+    void benchmarkRouter();
+
+private:
+    static QList<QRectF> generateLayout(int size);
+    static bool isOrthogonal(const QVector<QPointF> &points);
+};
+
+/*!
+   Generates a \p size x \p size grid of function boxes, every odd row is shifted to block straight routes
+ */
+QList<QRectF> tst_ConnectionRouter::generateLayout(int size)
+{
+    QList<QRectF> rects;
+    for (int row = 0; row < size; ++row) {
+        for (int column = 0; column < size; ++column) {
+            const qreal shift = row % 2 ? 60 : 0;
+            rects.append(QRectF(column * 150 + shift, row * 120, 80 + (column * 7 + row * 3) % 20, 50));
+        }
+    }
+    return rects;
+}
+
+bool tst_ConnectionRouter::isOrthogonal(const QVector<QPointF> &points)
+{
+    for (int idx = 1; idx < points.size(); ++idx) {
+        if (!qFuzzyCompare(points.at(idx - 1).x(), points.at(idx).x())
+                && !qFuzzyCompare(points.at(idx - 1).y(), points.at(idx).y())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_ConnectionRouter::testIndexQuery()
+{
+    const ObstacleIndex index({ QRectF(0, 0, 100, 100), QRectF(500, 500, 100, 100), QRectF(1000, 0, 50, 50) });
+    QCOMPARE(index.boundingRect(), QRectF(0, 0, 1050, 600));
+    QCOMPARE(index.query(QRectF(10, 10, 20, 20)), QVector<int> { 0 });
+    QCOMPARE(index.query(QRectF(0, 0, 1100, 700)), (QVector<int> { 0, 1, 2 }));
+    QVERIFY(index.query(QRectF(2000, 2000, 10, 10)).isEmpty());
+    /// Degenerated areas
+    QCOMPARE(index.query(QRectF(QPointF(550, 0), QPointF(550, 700))), QVector<int> { 1 });
+    QVERIFY(ObstacleIndex().query(QRectF(0, 0, 10, 10)).isEmpty());
+}
+
+void tst_ConnectionRouter::testSegmentIntersection()
+{
+    const ObstacleIndex index({ QRectF(100, 100, 100, 100) });
+    QVERIFY(index.intersects(QPointF(50, 150), QPointF(250, 150)));
+    QVERIFY(index.intersects(QPointF(150, 50), QPointF(150, 120)));
+    /// Running along an edge or ending on it is not crossing
+    QVERIFY(!index.intersects(QPointF(50, 100), QPointF(250, 100)));
+    QVERIFY(!index.intersects(QPointF(50, 150), QPointF(100, 150)));
+    QVERIFY(!index.intersects(QPointF(0, 0), QPointF(300, 0)));
+    QVERIFY(index.intersects(QPointF(50, 50), QPointF(250, 250)));
+    QVERIFY(index.intersects(QVector<QPointF> { QPointF(0, 0), QPointF(150, 0), QPointF(150, 300) }));
+}
+
+void tst_ConnectionRouter::testStraightRoute()
+{
+    const ObstacleIndex index({ QRectF(100, 100, 100, 100) });
+    const ConnectionRouter router(index);
+    const QVector<QPointF> points = router.route(QPointF(0, 50), QPointF(300, 50));
+    QCOMPARE(points, (QVector<QPointF> { QPointF(0, 50), QPointF(300, 50) }));
+}
+
+void tst_ConnectionRouter::testRouteAroundObstacle()
+{
+    const QRectF obstacle(100, 0, 100, 100);
+    const ObstacleIndex index({ obstacle });
+    const ConnectionRouter router(index);
+    const QVector<QPointF> points = router.route(QPointF(0, 50), QPointF(300, 50));
+    QVERIFY(points.size() >= 4);
+    QCOMPARE(points.first(), QPointF(0, 50));
+    QCOMPARE(points.last(), QPointF(300, 50));
+    QVERIFY(isOrthogonal(points));
+    QVERIFY(router.isRouteValid(points));
+    QVERIFY(!shared::graphicsviewutils::intersects(obstacle, QPolygonF(points)));
+}
+
+void tst_ConnectionRouter::testRouteWithDirections()
+{
+    const QRectF source(0, 0, 100, 100);
+    const QRectF target(300, 200, 100, 100);
+    const ObstacleIndex index({ source, target });
+    const QVector<QPointF> points = createConnectionPath(index, QPointF(100, 50), source, QPointF(300, 250), target);
+    QVERIFY(points.size() >= 2);
+    QCOMPARE(points.first(), QPointF(100, 50));
+    QCOMPARE(points.last(), QPointF(300, 250));
+    QVERIFY(isOrthogonal(points));
+    QVERIFY(!index.intersects(points));
+    /// A single bend is enough: out to the right, down, and into the target
+    QVERIFY(points.size() <= 4);
+}
+
+void tst_ConnectionRouter::testNoRoute()
+{
+    /// The start point is enclosed by obstacles
+    const ObstacleIndex index({ QRectF(-100, -100, 200, 50), QRectF(-100, 50, 200, 50), QRectF(-100, -50, 50, 100),
+            QRectF(50, -50, 50, 100) });
+    const ConnectionRouter router(index);
+    QVERIFY(router.route(QPointF(0, 0), QPointF(500, 0)).isEmpty());
+}
+
+void tst_ConnectionRouter::testDenseLayout()
+{
+    const QList<QRectF> rects = generateLayout(10);
+    const ObstacleIndex index(rects);
+    const QRectF source = rects.first();
+    const QRectF target = rects.last();
+    const QPointF startPos(source.right(), source.center().y());
+    const QPointF endPos(target.left(), target.center().y());
+    const QVector<QPointF> points = createConnectionPath(index, startPos, source, endPos, target);
+    QVERIFY(points.size() >= 2);
+    QCOMPARE(points.first(), startPos);
+    QCOMPARE(points.last(), endPos);
+    QVERIFY(isOrthogonal(points));
+    QVERIFY(!index.intersects(points));
+}
+
+void tst_ConnectionRouter::testLargeLayout()
+{
+    /// More than 1000 functions, the A* router itself has to find the routes and not the fallback search
+    const int size = 33;
+    const QList<QRectF> rects = generateLayout(size);
+    QVERIFY(rects.size() > 1000);
+    const ObstacleIndex index(rects);
+    const ConnectionRouter router(index);
+
+    const QVector<QPair<int, int>> connections { { 0, 1 }, { size * 16 + 16, size * 17 + 17 },
+        { 0, rects.size() - 1 }, { size - 1, rects.size() - size } };
+    for (const QPair<int, int> &connection : connections) {
+        const QRectF source = rects.at(connection.first);
+        const QRectF target = rects.at(connection.second);
+        const QPointF startPos(source.right(), source.center().y());
+        const QPointF endPos(target.left(), target.center().y());
+        const QVector<QPointF> points = router.route(
+                QLineF(startPos, startPos + QPointF(20, 0)), QLineF(endPos, endPos - QPointF(20, 0)));
+        QVERIFY(points.size() >= 2);
+        QCOMPARE(points.first(), startPos);
+        QCOMPARE(points.last(), endPos);
+        QVERIFY(isOrthogonal(points));
+        QVERIFY(!index.intersects(points));
+    }
+}
+
+void tst_ConnectionRouter::benchmarkRouter_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("25 functions") << 5;
+    QTest::newRow("100 functions") << 10;
+    QTest::newRow("400 functions") << 20;
+    QTest::newRow("1600 functions") << 40;
+}
+
+void tst_ConnectionRouter::benchmarkRouter()
+{
+    QFETCH(int, size);
+    const QList<QRectF> rects = generateLayout(size);
+
+    QBENCHMARK {
+        /// Route one connection from each function of the first column to the mirrored function of the last one
+        const ObstacleIndex index(rects);
+        for (int row = 0; row < size; ++row) {
+            const QRectF source = rects.at(row * size);
+            const QRectF target = rects.at((size - row - 1) * size + size - 1);
+            const QVector<QPointF> points = createConnectionPath(index, QPointF(source.right(), source.center().y()),
+                    source, QPointF(target.left(), target.center().y()), target);
+            QVERIFY(!points.isEmpty());
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_ConnectionRouter)
+
+#include "tst_connectionrouter.moc"
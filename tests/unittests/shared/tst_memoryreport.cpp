@@ -0,0 +1,208 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "asn1modelstorage.h"
+#include "definitions.h"
+#include "file.h"
+#include "ivfunction.h"
+#include "ivlibrary.h"
+#include "ivmodel.h"
+#include "memoryreport.h"
+#include "mscchart.h"
+#include "mscdocument.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
+#include "mscmodel.h"
+#include "propertytemplateconfig.h"
+#include "sharedlibrary.h"
+#include "typeassignment.h"
+#include "types/builtintypes.h"
+
+#include <QGraphicsRectItem>
+#include <QGraphicsScene>
+#include <QGraphicsTextItem>
+#include <QJsonObject>
+#include <QUndoCommand>
+#include <QUndoStack>
+#include <QtTest>
+
+using shared::MemoryReport;
+
+class tst_MemoryReport : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void testAdd();
+    void testJson();
+    void testModel();
+    void testScene();
+    void testUndoStack();
+    void testMscModel();
+    void testAsn1File();
+};
+
+void tst_MemoryReport::initTestCase()
+{
+    shared::initSharedLibrary();
+    ivm::initIVLibrary();
+}
+
+void tst_MemoryReport::testAdd()
+{
+    MemoryReport report;
+    QCOMPARE(report.totalBytes(), qint64(0));
+    QVERIFY(report.categories().isEmpty());
+
+    report.add("b.second", 2, 100);
+    report.add("a.first", 1, 10);
+    report.add("b.second", 3, 50);
+
+    QCOMPARE(report.categories(), QStringList({ "a.first", "b.second" }));
+    QCOMPARE(report.entry("b.second").count, qint64(5));
+    QCOMPARE(report.entry("b.second").bytes, qint64(150));
+    QCOMPARE(report.entry("unknown").count, qint64(0));
+    QCOMPARE(report.totalBytes(), qint64(160));
+}
+
+void tst_MemoryReport::testJson()
+{
+    MemoryReport report;
+    report.add("undo.commands", 4, 400);
+
+    const QJsonObject json = report.toJson();
+    QCOMPARE(json.value("totalBytes").toInt(), 400);
+    const QJsonObject entry = json.value("categories").toObject().value("undo.commands").toObject();
+    QCOMPARE(entry.value("count").toInt(), 4);
+    QCOMPARE(entry.value("bytes").toInt(), 400);
+}
+
+void tst_MemoryReport::testModel()
+{
+    ivm::IVModel model(ivm::PropertyTemplateConfig::instance());
+    int attributeCount = 0;
+    for (int idx = 0; idx < 10; ++idx) {
+        auto function = new ivm::IVFunction(QString("Function_%1").arg(idx), &model);
+        QVERIFY(model.addObject(function));
+        attributeCount += function->attributeStore().size();
+    }
+
+    MemoryReport report;
+    report.addModel(&model);
+    QCOMPARE(report.entry("ve.IVFunction").count, qint64(10));
+    QCOMPARE(report.entry("ve.IVFunction").bytes, qint64(10 * MemoryReport::ObjectBytes));
+    QCOMPARE(report.entry("ve.attributes").count, qint64(attributeCount));
+
+    // A long attribute value adds its text
+    model.objects().values().first()->setEntityAttribute("memory_test", QString(1000, 'x'));
+    MemoryReport changedReport;
+    changedReport.addModel(&model);
+    QCOMPARE(changedReport.entry("ve.attributes").count, qint64(attributeCount + 1));
+    QVERIFY(changedReport.entry("ve.attributes").bytes > report.entry("ve.attributes").bytes + 2000);
+}
+
+void tst_MemoryReport::testScene()
+{
+    QGraphicsScene scene;
+    for (int idx = 0; idx < 3; ++idx) {
+        scene.addRect(QRectF(idx * 20, 0, 10, 10));
+    }
+    QGraphicsTextItem *label = scene.addText("Hello World");
+    scene.addText("Second label");
+
+    MemoryReport report;
+    report.addScene(&scene);
+    QCOMPARE(report.entry("scene.items").count, qint64(5));
+    QCOMPARE(report.entry("scene.textDocuments").count, qint64(2));
+
+    // Items sharing a document count it once
+    auto sharedLabel = new QGraphicsTextItem;
+    sharedLabel->setDocument(label->document());
+    scene.addItem(sharedLabel);
+    MemoryReport sharedReport;
+    sharedReport.addScene(&scene);
+    QCOMPARE(sharedReport.entry("scene.items").count, qint64(6));
+    QCOMPARE(sharedReport.entry("scene.textDocuments").count, qint64(2));
+}
+
+void tst_MemoryReport::testUndoStack()
+{
+    QUndoStack stack;
+    stack.push(new QUndoCommand("first"));
+    auto macro = new QUndoCommand("macro");
+    new QUndoCommand("child 1", macro);
+    new QUndoCommand("child 2", macro);
+    stack.push(macro);
+
+    MemoryReport report;
+    report.addUndoStack(&stack);
+    QCOMPARE(report.entry("undo.commands").count, qint64(4));
+}
+
+void tst_MemoryReport::testMscModel()
+{
+    msc::MscModel model;
+    auto document = new msc::MscDocument("Doc01", &model);
+    model.addDocument(document);
+    auto chart = new msc::MscChart("Chart01", document);
+    document->addChart(chart);
+    auto instanceA = new msc::MscInstance("A", chart);
+    chart->addInstance(instanceA);
+    auto instanceB = new msc::MscInstance("B", chart);
+    chart->addInstance(instanceB);
+    for (int idx = 0; idx < 20; ++idx) {
+        auto message = new msc::MscMessage(QString("msg_%1").arg(idx), instanceA, instanceB, chart);
+        chart->addInstanceEvent(message, { { instanceA, -1 }, { instanceB, -1 } });
+    }
+
+    MemoryReport report;
+    model.addToMemoryReport(&report);
+    QCOMPARE(report.entry("msc.documents").count, qint64(1));
+    QCOMPARE(report.entry("msc.charts").count, qint64(1));
+    QCOMPARE(report.entry("msc.instances").count, qint64(2));
+    // Each message is in the lists of both instances, but is counted once
+    QCOMPARE(report.entry("msc.events.Message").count, qint64(20));
+    // One list per instance plus the orphan events
+    QCOMPARE(report.entry("msc.eventVectors").count, qint64(3));
+}
+
+void tst_MemoryReport::testAsn1File()
+{
+    Asn1Acn::SourceLocation location;
+    auto definitions = std::make_unique<Asn1Acn::Definitions>("TestDef", location);
+    definitions->addType(std::make_unique<Asn1Acn::TypeAssignment>(
+            "MyInt", location, std::make_unique<Asn1Acn::Types::Integer>()));
+    auto sequenceType = std::make_unique<Asn1Acn::Types::Sequence>();
+    sequenceType->addChild(std::make_unique<Asn1Acn::Types::Integer>("intVal"));
+    sequenceType->addChild(std::make_unique<Asn1Acn::Types::Boolean>("boolVal"));
+    definitions->addType(
+            std::make_unique<Asn1Acn::TypeAssignment>("MySequence", location, std::move(sequenceType)));
+    Asn1Acn::File file("/dummy/path");
+    file.add(std::move(definitions));
+
+    MemoryReport report;
+    Asn1Acn::Asn1ModelStorage::addToMemoryReport(&file, &report);
+    QCOMPARE(report.entry("asn1.files").count, qint64(1));
+    QCOMPARE(report.entry("asn1.definitions").count, qint64(1));
+    QCOMPARE(report.entry("asn1.typeAssignments").count, qint64(2));
+    QCOMPARE(report.entry("asn1.types").count, qint64(4));
+}
+
+QTEST_MAIN(tst_MemoryReport)
+
+#include "tst_memoryreport.moc"
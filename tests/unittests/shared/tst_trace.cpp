@@ -0,0 +1,193 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "trace.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QtConcurrent>
+#include <QtTest>
+
+using shared::Trace;
+
+class tst_Trace : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanup();
+    void testDisabled();
+    void testTraceFile();
+    void testNestedSpans();
+    void testThreads();
+    void testAsyncSpan();
+
+private:
+    static QJsonArray events(const QJsonObject &trace, const QString &phase);
+    static QJsonObject event(const QJsonObject &trace, const QString &name);
+};
+
+void tst_Trace::cleanup()
+{
+    Trace::stop();
+}
+
+QJsonArray tst_Trace::events(const QJsonObject &trace, const QString &phase)
+{
+    QJsonArray result;
+    for (const QJsonValue &value : trace.value("traceEvents").toArray()) {
+        if (value.toObject().value("ph").toString() == phase) {
+            result.append(value);
+        }
+    }
+    return result;
+}
+
+QJsonObject tst_Trace::event(const QJsonObject &trace, const QString &name)
+{
+    for (const QJsonValue &value : trace.value("traceEvents").toArray()) {
+        if (value.toObject().value("name").toString() == name) {
+            return value.toObject();
+        }
+    }
+    return {};
+}
+
+void tst_Trace::testDisabled()
+{
+    QVERIFY(!Trace::isEnabled());
+    {
+        SC_TRACE_SCOPE("test", "notRecorded");
+    }
+
+    QVERIFY(Trace::start());
+    QVERIFY(!Trace::start());
+    QVERIFY(Trace::stop());
+    QVERIFY(!Trace::isEnabled());
+    QVERIFY(events(Trace::toJson(), "X").isEmpty());
+}
+
+void tst_Trace::testTraceFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("trace.json");
+
+    QVERIFY(Trace::start(fileName));
+    QCOMPARE(Trace::fileName(), fileName);
+    {
+        SC_TRACE_SCOPE("test", "span", "detail text");
+    }
+    QVERIFY(Trace::stop());
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const QJsonObject trace = QJsonDocument::fromJson(file.readAll(), &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(trace.value("displayTimeUnit").toString(), QString("ms"));
+
+    const QJsonArray spans = events(trace, "X");
+    QCOMPARE(spans.size(), 1);
+    const QJsonObject span = spans.first().toObject();
+    QCOMPARE(span.value("name").toString(), QString("span"));
+    QCOMPARE(span.value("cat").toString(), QString("test"));
+    QCOMPARE(span.value("pid").toDouble(), double(QCoreApplication::applicationPid()));
+    QVERIFY(span.value("tid").isDouble());
+    QVERIFY(span.value("ts").toDouble() >= 0.);
+    QVERIFY(span.value("dur").toDouble() >= 0.);
+    QCOMPARE(span.value("args").toObject().value("detail").toString(), QString("detail text"));
+
+    // Every thread is named by a metadata event
+    bool threadNamed = false;
+    for (const QJsonValue &value : events(trace, "M")) {
+        const QJsonObject metadata = value.toObject();
+        if (metadata.value("tid") == span.value("tid")) {
+            threadNamed = metadata.value("name").toString() == "thread_name"
+                    && !metadata.value("args").toObject().value("name").toString().isEmpty();
+        }
+    }
+    QVERIFY(threadNamed);
+}
+
+void tst_Trace::testNestedSpans()
+{
+    QVERIFY(Trace::start());
+    {
+        SC_TRACE_SCOPE("test", "outer");
+        {
+            SC_TRACE_SCOPE("test", "inner");
+            QTest::qWait(2);
+        }
+    }
+    Trace::stop();
+
+    const QJsonObject trace = Trace::toJson();
+    QCOMPARE(events(trace, "X").size(), 2);
+    const QJsonObject outer = event(trace, "outer");
+    const QJsonObject inner = event(trace, "inner");
+    QCOMPARE(inner.value("tid"), outer.value("tid"));
+
+    const double outerBegin = outer.value("ts").toDouble();
+    const double innerBegin = inner.value("ts").toDouble();
+    QVERIFY(innerBegin >= outerBegin);
+    QVERIFY(innerBegin + inner.value("dur").toDouble() <= outerBegin + outer.value("dur").toDouble());
+    QVERIFY(inner.value("dur").toDouble() >= 1000.);
+}
+
+void tst_Trace::testThreads()
+{
+    QVERIFY(Trace::start());
+    {
+        SC_TRACE_SCOPE("test", "main");
+    }
+    QThreadPool pool;
+    QtConcurrent::run(&pool, []() { SC_TRACE_SCOPE("test", "worker"); }).waitForFinished();
+    Trace::stop();
+
+    const QJsonObject trace = Trace::toJson();
+    const QJsonValue mainThread = event(trace, "main").value("tid");
+    const QJsonValue workerThread = event(trace, "worker").value("tid");
+    QVERIFY(mainThread.isDouble());
+    QVERIFY(workerThread.isDouble());
+    QVERIFY(mainThread != workerThread);
+}
+
+void tst_Trace::testAsyncSpan()
+{
+    QVERIFY(Trace::start());
+    const qint64 begin = Trace::timestamp();
+    Trace::addAsyncSpan("test", "process", begin, begin + 500, "file.asn");
+    Trace::addAsyncSpan("test", "process", begin + 100, begin + 200, "other.asn");
+    Trace::stop();
+
+    const QJsonObject trace = Trace::toJson();
+    const QJsonArray begins = events(trace, "b");
+    const QJsonArray ends = events(trace, "e");
+    QCOMPARE(begins.size(), 2);
+    QCOMPARE(ends.size(), 2);
+    QVERIFY(begins.at(0).toObject().value("id") != begins.at(1).toObject().value("id"));
+    QCOMPARE(begins.at(0).toObject().value("id"), ends.at(0).toObject().value("id"));
+    QCOMPARE(ends.at(0).toObject().value("ts").toDouble() - begins.at(0).toObject().value("ts").toDouble(), 500.);
+    QCOMPARE(begins.at(0).toObject().value("args").toObject().value("detail").toString(), QString("file.asn"));
+}
+
+QTEST_MAIN(tst_Trace)
+
+#include "tst_trace.moc"
@@ -16,6 +16,7 @@
 */
 
 #include "baseitems/common/coordinatesconverter.h"
+#include "baseitems/common/ivutils.h"
 #include "chartitem.h"
 #include "commandsstack.h"
 #include "interface/interfacedocument.h"
@@ -27,11 +28,14 @@
 #include "ivsystemchecks.h"
 #include "ivtestutils.h"
 #include "mainmodel.h"
+#include "messageconformance.h"
 #include "mscchart.h"
 #include "msceditorcore.h"
 #include "mscinstance.h"
 #include "mscmessage.h"
 #include "mscmodel.h"
+#include "projectmodelloader.h"
+#include "propertytemplateconfig.h"
 #include "sharedlibrary.h"
 
 #include <QGraphicsScene>
@@ -62,6 +66,8 @@ private Q_SLOTS:
     void testCorrespondMessage();
 
     void testCheckMessage();
+    void testIvChangeUpdatesConformance();
+    void testModelOnlyChecks();
 
 private:
     msc::ChartItem m_chartItem;
@@ -74,6 +80,7 @@ void tst_IvSystemChecks::initTestCase()
     QStandardPaths::setTestModeEnabled(true);
     ive::initIVEditor();
     shared::initSharedLibrary();
+    ivm::PropertyTemplateConfig::instance()->init(ive::dynamicPropertiesFilePath());
     auto converter = msc::CoordinatesConverter::instance();
     converter->setDPI(QPointF(109., 109.), QPointF(96., 96.));
 }
@@ -333,6 +340,88 @@ void tst_IvSystemChecks::testCheckMessage()
     QCOMPARE(m_checker->checkMessage(message1), true);
 }
 
+void tst_IvSystemChecks::testIvChangeUpdatesConformance()
+{
+    msc::MscChart *chart = m_mscCore->mainModel()->mscModel()->documents().at(0)->documents().at(0)->charts().at(0);
+    auto instance1 = new msc::MscInstance("Dummy1", chart);
+    chart->addInstance(instance1);
+    auto instance2 = new msc::MscInstance("Dummy2", chart);
+    chart->addInstance(instance2);
+    auto message = new msc::MscMessage("Msg1", chart);
+    message->setSourceInstance(instance1);
+    message->setTargetInstance(instance2);
+    chart->addInstanceEvent(message, { { instance1, -1 }, { instance2, -1 } });
+
+    QSharedPointer<ive::IVEditorCore> ivPlugin(new ive::IVEditorCore);
+    m_checker->setIvCore(ivPlugin);
+    ivm::IVModel *ivModel = ivPlugin->document()->objectsModel();
+    auto sourceFunc = new ivm::IVFunction("Dummy1");
+    ivModel->addObject(sourceFunc);
+    auto targetFunc = new ivm::IVFunction("Dummy2");
+    ivModel->addObject(targetFunc);
+
+    msc::MessageConformance conformance;
+    conformance.setSystemChecker(m_checker.get());
+    conformance.setChart(chart);
+    QCOMPARE(conformance.isConform(message), false);
+
+    // Adding the connection to the IV model
+    ivm::IVConnection *connection = ivm::testutils::createConnection(sourceFunc, targetFunc, "Msg1");
+    QTRY_COMPARE(conformance.isConform(message), true);
+
+    // Renaming the function of the target instance
+    targetFunc->setTitle("Other");
+    QTRY_COMPARE(conformance.isConform(message), false);
+    targetFunc->setTitle("Dummy2");
+    QTRY_COMPARE(conformance.isConform(message), true);
+
+    // Removing the connection
+    ivModel->removeObject(connection);
+    delete connection;
+    QTRY_COMPARE(conformance.isConform(message), false);
+}
+
+void tst_IvSystemChecks::testModelOnlyChecks()
+{
+    const QString ivFileName = QFINDTESTDATA("interfaceview.xml");
+    const QString mscFileName = QFINDTESTDATA("Taste07.msc");
+    scs::ProjectModelLoader loader;
+    QVERIFY(loader.load({ ivFileName, mscFileName }));
+
+    scs::IvSystemChecks checker;
+    QCOMPARE(checker.hasValidSystem(), false);
+    QVERIFY(checker.functionsNames().isEmpty());
+    QVERIFY(checker.allConnectionsAsDeclaration().isEmpty());
+
+    checker.setIvModel(loader.ivModel(ivFileName));
+    checker.setMscModel(loader.mscModel(mscFileName));
+    QCOMPARE(checker.hasValidSystem(), true);
+
+    // Function_Oioioi is no function of the interface view
+    const QVector<QPair<msc::MscChart *, msc::MscInstance *>> instances = checker.checkInstanceNames();
+    QCOMPARE(instances.size(), 1);
+    QCOMPARE(instances.first().second->name(), QString("Function_Oioioi"));
+    QVERIFY(checker.checkInstanceRelations().isEmpty());
+
+    // The message "dummy" is sent by Function_Oioioi
+    const QVector<QPair<msc::MscChart *, msc::MscMessage *>> messages = checker.checkMessages();
+    QCOMPARE(messages.size(), 1);
+    QCOMPARE(messages.first().second->name(), QString("dummy"));
+
+    QStringList functions = checker.functionsNames();
+    functions.sort();
+    QCOMPARE(functions,
+            (QStringList { "Function_1", "Function_33", "Function_B", "Function_G", "Function_HH" }));
+    QStringList connections = checker.connectionNames();
+    connections.sort();
+    QCOMPARE(connections, (QStringList { "done", "init", "notch" }));
+    QCOMPARE(checker.connectionNamesFromTo("Function_1", "Function_B"), QStringList { "notch" });
+
+    const QVector<msc::MscMessageDeclaration *> declarations = checker.allConnectionsAsDeclaration();
+    QCOMPARE(declarations.size(), 3);
+    qDeleteAll(declarations);
+}
+
 QTEST_MAIN(tst_IvSystemChecks)
 
 #include "tst_ivsystemchecks.moc"
@@ -0,0 +1,211 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "baseitems/common/coordinatesconverter.h"
+#include "chartindex.h"
+#include "mainmodel.h"
+#include "mscchart.h"
+#include "msceditor.h"
+#include "msceditorcore.h"
+#include "mscinstance.h"
+#include "mscmessage.h"
+#include "mscmodel.h"
+#include "mscnameindex.h"
+#include "sharedlibrary.h"
+#include "spacecreatorproject.h"
+
+#include <QTemporaryDir>
+#include <QtTest>
+#include <memory>
+
+/*!
+   Project with a file list set by the test, counting how often all MSC cores are requested
+ */
+class TestProject : public scs::SpaceCreatorProject
+{
+public:
+    void setFiles(const QStringList &files)
+    {
+        m_files = files;
+        purgeNonProjectData();
+    }
+
+    QStringList projectFiles(const QString &suffix) const override
+    {
+        QStringList files;
+        for (const QString &file : m_files) {
+            if (file.endsWith(suffix)) {
+                files.append(file);
+            }
+        }
+        return files;
+    }
+
+    QVector<QSharedPointer<msc::MSCEditorCore>> allMscCores() const override
+    {
+        ++allMscCoresCount;
+        return scs::SpaceCreatorProject::allMscCores();
+    }
+
+    mutable int allMscCoresCount = 0;
+
+private:
+    QStringList m_files;
+};
+
+class tst_MscNameIndex : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void testInstancesAddedRemoved();
+    void testMessagesAddedRemoved();
+    void testFilesAddedRemoved();
+
+private:
+    QString copyMscFile(const QString &name) const;
+    msc::MscChart *chart(const QString &fileName, const QString &chartName) const;
+
+    QTemporaryDir m_dir;
+    std::unique_ptr<TestProject> m_project;
+    std::unique_ptr<scs::MscNameIndex> m_index;
+};
+
+void tst_MscNameIndex::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    msc::initMscEditor();
+    shared::initSharedLibrary();
+    auto converter = msc::CoordinatesConverter::instance();
+    converter->setDPI(QPointF(109., 109.), QPointF(96., 96.));
+    QVERIFY(m_dir.isValid());
+    QVERIFY(QFile::copy(QFINDTESTDATA("Taste07.asn"), m_dir.filePath("Taste07.asn")));
+}
+
+void tst_MscNameIndex::init()
+{
+    m_index.reset();
+    m_project = std::make_unique<TestProject>();
+    m_index = std::make_unique<scs::MscNameIndex>();
+    m_index->setStorage(m_project.get());
+}
+
+QString tst_MscNameIndex::copyMscFile(const QString &name) const
+{
+    const QString fileName = m_dir.filePath(name);
+    QFile::remove(fileName);
+    QFile::copy(QFINDTESTDATA("Taste07.msc"), fileName);
+    return fileName;
+}
+
+msc::MscChart *tst_MscNameIndex::chart(const QString &fileName, const QString &chartName) const
+{
+    for (msc::MscChart *chart : m_project->mscData(fileName)->mainModel()->mscModel()->allCharts()) {
+        if (chart->name() == chartName) {
+            return chart;
+        }
+    }
+    return nullptr;
+}
+
+void tst_MscNameIndex::testInstancesAddedRemoved()
+{
+    const QString fileName = copyMscFile("instances.msc");
+    m_project->setFiles({ fileName });
+    msc::MscChart *mscChart = chart(fileName, "Document_1_msc");
+    QVERIFY(mscChart != nullptr);
+
+    QCOMPARE(m_index->instanceCharts("Function_Oioioi").size(), 1);
+    QVERIFY(m_index->instanceCharts("NewInstance").isEmpty());
+
+    auto instance = new msc::MscInstance("NewInstance", mscChart);
+    mscChart->addInstance(instance);
+    scs::MscNameIndex::ChartsByCore charts = m_index->instanceCharts("newinstance");
+    QCOMPARE(charts.size(), 1);
+    QCOMPARE(charts.begin().value(), QVector<msc::MscChart *>({ mscChart }));
+
+    mscChart->removeInstance(instance);
+    delete instance;
+    QVERIFY(m_index->instanceCharts("NewInstance").isEmpty());
+
+    msc::MscInstance *oioioi = mscChart->instanceByName("Function_Oioioi");
+    QVERIFY(oioioi != nullptr);
+    oioioi->setName("Renamed");
+    QVERIFY(m_index->instanceCharts("Function_Oioioi").isEmpty());
+    QCOMPARE(m_index->instanceCharts("Renamed").size(), 1);
+}
+
+void tst_MscNameIndex::testMessagesAddedRemoved()
+{
+    const QString fileName = copyMscFile("messages.msc");
+    m_project->setFiles({ fileName });
+    msc::MscChart *mscChart = chart(fileName, "Untitled_MSC");
+    QVERIFY(mscChart != nullptr);
+
+    QCOMPARE(m_index->messageCharts("notch").begin().value().size(), 2);
+    QVERIFY(m_index->messageCharts("newMessage").isEmpty());
+
+    msc::MscInstance *source = mscChart->instanceByName("Function_1");
+    msc::MscInstance *target = mscChart->instanceByName("Function_B");
+    auto message = new msc::MscMessage("newMessage", source, target, mscChart);
+    mscChart->addInstanceEvent(message, { { source, -1 }, { target, -1 } });
+    scs::MscNameIndex::ChartsByCore charts = m_index->messageCharts("NEWMESSAGE");
+    QCOMPARE(charts.size(), 1);
+    QCOMPARE(charts.begin().value(), QVector<msc::MscChart *>({ mscChart }));
+
+    mscChart->removeInstanceEvent(message);
+    delete message;
+    QVERIFY(m_index->messageCharts("newMessage").isEmpty());
+    QCOMPARE(m_index->messageCharts("notch").begin().value().size(), 2);
+}
+
+void tst_MscNameIndex::testFilesAddedRemoved()
+{
+    const QString firstFile = copyMscFile("first.msc");
+    const QString secondFile = copyMscFile("second.msc");
+
+    m_project->setFiles({ firstFile });
+    QCOMPARE(m_index->instanceCharts("Function_1").size(), 1);
+    const int allCoresCount = m_project->allMscCoresCount;
+
+    /// Without a change of the project files, lookups don't query all cores of the storage
+    m_index->instanceCharts("Function_B");
+    m_index->messageCharts("notch");
+    QCOMPARE(m_project->allMscCoresCount, allCoresCount);
+
+    m_project->setFiles({ firstFile, secondFile });
+    scs::MscNameIndex::ChartsByCore charts = m_index->instanceCharts("Function_1");
+    QCOMPARE(charts.size(), 2);
+    QVERIFY(charts.contains(m_project->mscData(firstFile).data()));
+    QVERIFY(charts.contains(m_project->mscData(secondFile).data()));
+
+    m_project->setFiles({ secondFile });
+    charts = m_index->instanceCharts("Function_1");
+    QCOMPARE(charts.size(), 1);
+    QVERIFY(charts.contains(m_project->mscData(secondFile).data()));
+
+    m_project->setFiles({});
+    QVERIFY(m_index->instanceCharts("Function_1").isEmpty());
+    QVERIFY(m_index->messageCharts("notch").isEmpty());
+}
+
+QTEST_MAIN(tst_MscNameIndex)
+
+#include "tst_mscnameindex.moc"
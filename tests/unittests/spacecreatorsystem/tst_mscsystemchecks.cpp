@@ -37,6 +37,7 @@ private Q_SLOTS:
 
     void testInstanceExists();
     void testMessagesExists();
+    void testRenameUpdatesIndex();
 
 private:
     std::unique_ptr<scs::MscSystemChecks> m_checker;
@@ -77,6 +78,24 @@ void tst_MscSystemChecks::testMessagesExists()
     QCOMPARE(m_checker->mscMessagesExist("notch", "Function_1", "Function_B"), true);
 }
 
+void tst_MscSystemChecks::testRenameUpdatesIndex()
+{
+    const QString mscFileName = QFINDTESTDATA("/Taste07.msc");
+    m_project->mscData(mscFileName);
+
+    QCOMPARE(m_checker->mscInstancesExist("Function_1"), true);
+    QCOMPARE(m_checker->mscInstancesExist("function_1"), false);
+
+    m_checker->changeMscInstanceName("Function_1", "Renamed_1");
+    QCOMPARE(m_checker->mscInstancesExist("Function_1"), false);
+    QCOMPARE(m_checker->mscInstancesExist("Renamed_1"), true);
+    QCOMPARE(m_checker->mscMessagesExist("notch", "Renamed_1", "Function_B"), true);
+
+    m_checker->changeMscMessageName("notch", "notch2", "Renamed_1", "Function_B");
+    QCOMPARE(m_checker->mscMessagesExist("notch", "Renamed_1", "Function_B"), false);
+    QCOMPARE(m_checker->mscMessagesExist("notch2", "Renamed_1", "Function_B"), true);
+}
+
 QTEST_MAIN(tst_MscSystemChecks)
 
 #include "tst_mscsystemchecks.moc"
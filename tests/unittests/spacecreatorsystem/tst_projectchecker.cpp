@@ -0,0 +1,155 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "baseitems/common/ivutils.h"
+#include "iveditor.h"
+#include "projectchecker.h"
+#include "propertytemplateconfig.h"
+#include "sharedlibrary.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QTemporaryDir>
+#include <QtTest>
+
+class tst_ProjectChecker : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testConsistentProject();
+    void testInconsistentProject();
+    void testMissingProject();
+    void testCheckProjects();
+
+private:
+    void createProject(const QString &directory, const QByteArray &mscData) const;
+
+    QTemporaryDir m_dir;
+};
+
+/// Both instances are IV functions and the message is their connection
+static const QByteArray kConsistentMsc = "mscdocument Doc /* MSC LEAF */;\n"
+                                         "msc Chart;\n"
+                                         "instance Function_1;\n"
+                                         "out notch to Function_B;\n"
+                                         "endinstance;\n"
+                                         "instance Function_B;\n"
+                                         "in notch from Function_1;\n"
+                                         "endinstance;\n"
+                                         "endmsc;\n"
+                                         "endmscdocument;\n";
+
+/// Function_Oioioi is no IV function, so its message can't be a connection either
+static const QByteArray kInconsistentMsc = "mscdocument Doc /* MSC LEAF */;\n"
+                                           "msc Chart;\n"
+                                           "instance Function_Oioioi;\n"
+                                           "out dummy to env;\n"
+                                           "endinstance;\n"
+                                           "endmsc;\n"
+                                           "endmscdocument;\n";
+
+void tst_ProjectChecker::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    ive::initIVEditor();
+    shared::initSharedLibrary();
+    ivm::PropertyTemplateConfig::instance()->init(ive::dynamicPropertiesFilePath());
+    QVERIFY(m_dir.isValid());
+}
+
+void tst_ProjectChecker::createProject(const QString &directory, const QByteArray &mscData) const
+{
+    QVERIFY(QDir().mkpath(directory));
+    QVERIFY(QFile::copy(QFINDTESTDATA("interfaceview.xml"), QDir(directory).filePath("interfaceview.xml")));
+    QFile mscFile(QDir(directory).filePath("chart.msc"));
+    QVERIFY(mscFile.open(QIODevice::WriteOnly));
+    mscFile.write(mscData);
+}
+
+void tst_ProjectChecker::testConsistentProject()
+{
+    const QString directory = m_dir.filePath("consistent");
+    createProject(directory, kConsistentMsc);
+
+    const QJsonObject report = scs::ProjectChecker::checkProject(directory);
+    QCOMPARE(report.value("project").toString(), directory);
+    QCOMPARE(report.value("ok").toBool(), true);
+    QVERIFY(report.value("errors").isArray());
+    QVERIFY(report.value("errors").toArray().isEmpty());
+    QVERIFY(report.value("issues").isArray());
+    QVERIFY(report.value("issues").toArray().isEmpty());
+}
+
+void tst_ProjectChecker::testInconsistentProject()
+{
+    const QString directory = m_dir.filePath("inconsistent");
+    createProject(directory, kInconsistentMsc);
+
+    const QJsonObject report = scs::ProjectChecker::checkProject(directory);
+    QCOMPARE(report.value("ok").toBool(), false);
+    QVERIFY(report.value("errors").toArray().isEmpty());
+
+    const QJsonArray issues = report.value("issues").toArray();
+    QCOMPARE(issues.size(), 2);
+    for (const QJsonValue &value : issues) {
+        const QJsonObject issue = value.toObject();
+        QCOMPARE(issue.value("file").toString(), QDir(directory).filePath("chart.msc"));
+        QCOMPARE(issue.value("chart").toString(), QString("Chart"));
+        QVERIFY(!issue.value("details").toString().isEmpty());
+    }
+    QCOMPARE(issues.at(0).toObject().value("check").toString(), QString("instanceName"));
+    QCOMPARE(issues.at(0).toObject().value("entity").toString(), QString("Function_Oioioi"));
+    QCOMPARE(issues.at(1).toObject().value("check").toString(), QString("message"));
+    QCOMPARE(issues.at(1).toObject().value("entity").toString(), QString("dummy"));
+}
+
+void tst_ProjectChecker::testMissingProject()
+{
+    const QJsonObject report = scs::ProjectChecker::checkProject(m_dir.filePath("missing"));
+    QCOMPARE(report.value("ok").toBool(), false);
+    QCOMPARE(report.value("errors").toArray().size(), 1);
+    QVERIFY(report.value("issues").toArray().isEmpty());
+}
+
+void tst_ProjectChecker::testCheckProjects()
+{
+    const QString consistent = m_dir.filePath("all/consistent");
+    const QString inconsistent = m_dir.filePath("all/inconsistent");
+    createProject(consistent, kConsistentMsc);
+    createProject(inconsistent, kInconsistentMsc);
+
+    const scs::ProjectChecker checker(2);
+    QJsonObject report = checker.checkProjects({ consistent });
+    QCOMPARE(report.value("ok").toBool(), true);
+
+    report = checker.checkProjects({ consistent, inconsistent });
+    QCOMPARE(report.value("ok").toBool(), false);
+    const QJsonArray projects = report.value("projects").toArray();
+    QCOMPARE(projects.size(), 2);
+    QCOMPARE(projects.at(0).toObject().value("project").toString(), consistent);
+    QCOMPARE(projects.at(0).toObject().value("ok").toBool(), true);
+    QCOMPARE(projects.at(1).toObject().value("project").toString(), inconsistent);
+    QCOMPARE(projects.at(1).toObject().value("ok").toBool(), false);
+}
+
+QTEST_MAIN(tst_ProjectChecker)
+
+#include "tst_projectchecker.moc"
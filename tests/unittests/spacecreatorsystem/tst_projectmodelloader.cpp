@@ -0,0 +1,159 @@
+/*
+   Copyright (C) 2021 European Space Agency - <maxime.perrotin@esa.int>
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 2 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-2.1.html>.
+*/
+
+#include "baseitems/common/ivutils.h"
+#include "dvmodel.h"
+#include "ivfunction.h"
+#include "iveditor.h"
+#include "ivmodel.h"
+#include "mscmodel.h"
+#include "mscreader.h"
+#include "projectmodelloader.h"
+#include "propertytemplateconfig.h"
+#include "sharedlibrary.h"
+
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtTest>
+#include <memory>
+
+class tst_ProjectModelLoader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testLoadFiles();
+    void testModelsLiveInLoaderThread();
+    void testBrokenFiles();
+    void testLoadDirectory();
+    void benchmarkSyntheticProject();
+
+private:
+    void createSyntheticProject(const QString &directory, int mscFilesCount) const;
+};
+
+void tst_ProjectModelLoader::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    ive::initIVEditor();
+    shared::initSharedLibrary();
+    ivm::PropertyTemplateConfig::instance()->init(ive::dynamicPropertiesFilePath());
+}
+
+/*!
+   Creates a project with one interface view and \p mscFilesCount copies of the test msc file, in several folders
+ */
+void tst_ProjectModelLoader::createSyntheticProject(const QString &directory, int mscFilesCount) const
+{
+    QDir dir(directory);
+    QVERIFY(QFile::copy(QFINDTESTDATA("interfaceview.xml"), dir.filePath("interfaceview.xml")));
+    const QString mscFileName = QFINDTESTDATA("Taste07.msc");
+    for (int idx = 0; idx < mscFilesCount; ++idx) {
+        const QString subDir = QString("msc%1").arg(idx / 50);
+        dir.mkpath(subDir);
+        QVERIFY(QFile::copy(mscFileName, dir.filePath(QString("%1/chart%2.msc").arg(subDir).arg(idx))));
+    }
+}
+
+void tst_ProjectModelLoader::testLoadFiles()
+{
+    const QString ivFileName = QFINDTESTDATA("interfaceview.xml");
+    const QString mscFileName = QFINDTESTDATA("Taste07.msc");
+    const QString dvFileName = QString(EXAMPLES_DIR) + "deploymentview/DeploymentView.dv.xml";
+
+    scs::ProjectModelLoader loader;
+    QVERIFY(loader.load({ ivFileName, mscFileName, dvFileName }));
+    QVERIFY(loader.errorMessages().isEmpty());
+
+    ivm::IVModel *ivModel = loader.ivModel(ivFileName);
+    QVERIFY(ivModel != nullptr);
+    QVERIFY(ivModel->getFunction("Function_1", Qt::CaseSensitive) != nullptr);
+
+    msc::MscReader reader;
+    std::unique_ptr<msc::MscModel> expected(reader.parseFile(mscFileName));
+    msc::MscModel *mscModel = loader.mscModel(mscFileName);
+    QVERIFY(mscModel != nullptr);
+    QCOMPARE(mscModel->allCharts().size(), expected->allCharts().size());
+
+    dvm::DVModel *dvModel = loader.dvModel(dvFileName);
+    QVERIFY(dvModel != nullptr);
+    QVERIFY(!dvModel->objects().isEmpty());
+
+    QCOMPARE(loader.mscFiles(), QStringList { mscFileName });
+    QCOMPARE(loader.allMscModels().size(), 1);
+}
+
+void tst_ProjectModelLoader::testModelsLiveInLoaderThread()
+{
+    scs::ProjectModelLoader loader;
+    QVERIFY(loader.load({ QFINDTESTDATA("interfaceview.xml"), QFINDTESTDATA("Taste07.msc") }));
+
+    for (const QString &fileName : loader.ivFiles()) {
+        QCOMPARE(loader.ivModel(fileName)->thread(), QThread::currentThread());
+    }
+    for (msc::MscModel *model : loader.allMscModels()) {
+        QCOMPARE(model->thread(), QThread::currentThread());
+        QCOMPARE(model->parent(), &loader);
+    }
+}
+
+void tst_ProjectModelLoader::testBrokenFiles()
+{
+    QTemporaryDir dir;
+    const QString brokenMsc = dir.filePath("broken.msc");
+    QFile file(brokenMsc);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("msc broken; instance foo");
+    file.close();
+
+    scs::ProjectModelLoader loader;
+    QCOMPARE(loader.load({ brokenMsc, dir.filePath("unknown.txt"), QFINDTESTDATA("Taste07.msc") }), false);
+    QCOMPARE(loader.errorMessages().isEmpty(), false);
+    QCOMPARE(loader.mscModel(brokenMsc), nullptr);
+    QVERIFY(loader.mscModel(QFINDTESTDATA("Taste07.msc")) != nullptr);
+}
+
+void tst_ProjectModelLoader::testLoadDirectory()
+{
+    QTemporaryDir dir;
+    createSyntheticProject(dir.path(), 20);
+
+    scs::ProjectModelLoader loader;
+    QVERIFY(loader.loadDirectory(dir.path()));
+    QCOMPARE(loader.ivFiles().size(), 1);
+    QCOMPARE(loader.mscFiles().size(), 20);
+}
+
+void tst_ProjectModelLoader::benchmarkSyntheticProject()
+{
+    QTemporaryDir dir;
+    createSyntheticProject(dir.path(), 499);
+    const QStringList files = scs::ProjectModelLoader::projectFiles(dir.path());
+    QCOMPARE(files.size(), 500);
+
+    QBENCHMARK {
+        scs::ProjectModelLoader loader;
+        QVERIFY(loader.load(files));
+        QCOMPARE(loader.mscFiles().size(), 499);
+    }
+}
+
+QTEST_MAIN(tst_ProjectModelLoader)
+
+#include "tst_projectmodelloader.moc"